@@ -1,7 +0,0 @@
-#ifndef FAST_H
-#define FAST_H
-
-#include "fast9.h"
-#include "nonmax.h"
-
-#endif
@@ -294,32 +294,28 @@ namespace Pii
       {
         PiiMatrix<U> result(PiiMatrix<U>::uninitialized(iRows, 1));
         for (int r=0; r<iRows; ++r)
-          {
-            U sum(0);
-            Row row = mat.rowBegin(r);
-            for (int c=0; c<iCols; ++c)
-              sum += U(row[c]);
-            *result[r] = sum;
-          }
+          *result[r] = sumN<U>(mat.rowBegin(r), iCols);
         return result;
       }
   }
 
+  /// @hide
   template <class UnaryFunction, class InputMatrix, class OutputMatrix>
-  void cumulativeSum(const InputMatrix& matrix,
-                     OutputMatrix& result,
-                     UnaryFunction func,
-                     CumulativeSumMode mode)
+  void cumulativeSumRows(const InputMatrix& matrix,
+                         OutputMatrix& result,
+                         UnaryFunction func,
+                         CumulativeSumMode mode,
+                         int firstRow, int lastRow)
   {
     typedef typename UnaryFunction::result_type U;
     typedef typename OutputMatrix::row_iterator OutputRow;
     typedef typename InputMatrix::const_row_iterator InputRow;
 
-    const int iRows = matrix.rows(), iCols = matrix.columns();
+    const int iCols = matrix.columns();
 
     // Handle first row specially
-    InputRow pSource = matrix.rowBegin(0);
-    OutputRow pTarget = result[int(mode)] + int(mode);
+    InputRow pSource = matrix.rowBegin(firstRow);
+    OutputRow pTarget = result[firstRow+int(mode)] + int(mode);
     *pTarget = func(*pSource);
     for (int c=1; c<iCols; ++c)
       pTarget[c] = pTarget[c-1] + func(pSource[c]);
@@ -328,7 +324,7 @@ namespace Pii
     OutputRow pPrevTarget = pTarget;
 
     // Next rows add to the previous one
-    for (int r=1; r<iRows; ++r)
+    for (int r=firstRow+1; r<lastRow; ++r)
       {
         // Pointers to the current rows
         pSource = matrix.rowBegin(r);
@@ -350,10 +346,91 @@ namespace Pii
       }
   }
 
+  // Calculates the cumulative sums of row bands independently. In
+  // the second phase, adds the sum of all rows above each band.
+  template <class UnaryFunction, class InputMatrix, class OutputMatrix>
+  struct ParallelCumulativeSum
+  {
+    typedef typename UnaryFunction::result_type U;
+
+    ParallelCumulativeSum(const InputMatrix& matrix, OutputMatrix& result,
+                          UnaryFunction func, CumulativeSumMode mode, int bands) :
+      matrix(matrix), result(result), func(func), mode(mode), iBands(bands),
+      matOffsets(bands, matrix.columns()), bAddOffsets(false)
+    {}
+
+    int bandStart(int band) const { return int(qint64(matrix.rows()) * band / iBands); }
+
+    void operator() (int begin, int end, int band)
+    {
+      if (!bAddOffsets)
+        cumulativeSumRows(matrix, result, func, mode, begin, end);
+      else if (band > 0)
+        {
+          const int iCols = matrix.columns(), iBorder = int(mode);
+          const U* pOffset = matOffsets[band];
+          for (int r=begin; r<end; ++r)
+            {
+              typename OutputMatrix::row_iterator pTarget = result[r+iBorder] + iBorder;
+              for (int c=0; c<iCols; ++c)
+                pTarget[c] += pOffset[c];
+            }
+        }
+    }
+
+    // Calculates the total sum of rows above each band.
+    void collectOffsets()
+    {
+      const int iCols = matrix.columns(), iBorder = int(mode);
+      for (int b=1; b<iBands; ++b)
+        {
+          typename OutputMatrix::const_row_iterator pLast = result[bandStart(b)-1+iBorder] + iBorder;
+          const U* pPrevOffset = matOffsets[b-1];
+          U* pOffset = matOffsets[b];
+          for (int c=0; c<iCols; ++c)
+            pOffset[c] = pPrevOffset[c] + U(pLast[c]);
+        }
+      bAddOffsets = true;
+    }
+
+    const InputMatrix& matrix;
+    OutputMatrix& result;
+    UnaryFunction func;
+    CumulativeSumMode mode;
+    int iBands;
+    PiiMatrix<U> matOffsets;
+    bool bAddOffsets;
+  };
+  /// @endhide
+
+  template <class UnaryFunction, class InputMatrix, class OutputMatrix>
+  void cumulativeSum(const InputMatrix& matrix,
+                     OutputMatrix& result,
+                     UnaryFunction func,
+                     CumulativeSumMode mode,
+                     int threads)
+  {
+    const int iRows = matrix.rows();
+    const int iMinBandSize = reductionMinBandRows(matrix.columns());
+    const int iBands = parallelBandCount(iRows, threads, iMinBandSize);
+    if (iBands <= 1)
+      {
+        if (iRows > 0)
+          cumulativeSumRows(matrix, result, func, mode, 0, iRows);
+        return;
+      }
+
+    ParallelCumulativeSum<UnaryFunction,InputMatrix,OutputMatrix> sum(matrix, result, func, mode, iBands);
+    parallelFor(iRows, sum, threads, iMinBandSize);
+    sum.collectOffsets();
+    parallelFor(iRows, sum, threads, iMinBandSize);
+  }
+
   template <class UnaryFunction, class Matrix>
   PiiMatrix<typename UnaryFunction::result_type> cumulativeSum(const Matrix& matrix,
                                                                UnaryFunction func,
-                                                               CumulativeSumMode mode)
+                                                               CumulativeSumMode mode,
+                                                               int threads)
   {
     typedef typename UnaryFunction::result_type U;
     // HACK the enum value equals to the size of border
@@ -366,7 +443,7 @@ namespace Pii
     if (matrix.isEmpty())
       return matResult;
 
-    cumulativeSum(matrix, matResult, func, mode);
+    cumulativeSum(matrix, matResult, func, mode, threads);
     return matResult;
   }
 
@@ -498,12 +575,29 @@ namespace Pii
     delete[] pSum;
   }
 
-  template <class U, class Matrix> U var(const Matrix& mat, U* average)
+  /// @hide
+  template <class U, class Matrix> U squaredDeviationSum(const Matrix& mat, U avg)
   {
-    U avg = mean<U>(mat);
     U sum(0);
     for (typename Matrix::const_iterator i = mat.begin(); i != mat.end(); ++i)
       sum += square(U(*i) - avg);
+    return sum;
+  }
+
+  template <class U, class T> U squaredDeviationSum(const PiiMatrix<T>& mat, U avg)
+  {
+    typename Accumulator<U>::Type sum;
+    const int iRows = mat.rows(), iColumns = mat.columns();
+    for (int r=0; r<iRows; ++r)
+      sum += sumOfSquaresN(mat[r], iColumns, avg);
+    return sum.value();
+  }
+  /// @endhide
+
+  template <class U, class Matrix> U var(const Matrix& mat, U* average)
+  {
+    U avg = mean<U>(mat);
+    U sum = squaredDeviationSum(mat, avg);
     if (average != 0)
       *average = avg;
     return sum != 0 ? (sum / (mat.rows() * mat.columns())) : 0;
@@ -533,34 +627,71 @@ namespace Pii
     else
       {
         for (int r=0; r<iRows; ++r)
-          {
-            typename Matrix::const_row_iterator sourceRow = mat.rowBegin(r);
-            U tmpSum = 0;
-            U tmpMean = matMean(r,0);
-            for (int c=0; c<iColumns; ++c)
-              {
-                U diff = (U)sourceRow[c] - tmpMean;
-                tmpSum += diff*diff;
-              }
-            matVar(r,0) = tmpSum / mat.columns();
-          }
+          matVar(r,0) = sumOfSquaresN(mat.rowBegin(r), iColumns, matMean(r,0)) / mat.columns();
       }
     return matVar;
   }
 
+  /// @hide
+  // Accumulates the upper triangle of (x-mu)' * (x-mu) over a band
+  // of measurements.
+  template <class T> struct CovarianceBand
+  {
+    CovarianceBand(const PiiMatrix<T>& mat, const PiiMatrix<double>& mu, PiiMatrix<double>* bands) :
+      mat(mat), mu(mu), bands(bands)
+    {}
+
+    void operator() (int begin, int end, int band)
+    {
+      const int iColumns = mat.columns();
+      PiiMatrix<double>& result = bands[band];
+      result = PiiMatrix<double>(iColumns, iColumns);
+      PiiMatrix<double> matX(PiiMatrix<double>::uninitialized(1, iColumns));
+      double* pX = matX[0];
+      const double* pMu = mu[0];
+      for (int r=begin; r<end; ++r)
+        {
+          const T* pRow = mat[r];
+          for (int c=0; c<iColumns; ++c)
+            pX[c] = double(pRow[c]) - pMu[c];
+          for (int i=0; i<iColumns; ++i)
+            {
+              const double dXi = pX[i];
+              double* pResult = result[i];
+              for (int j=i; j<iColumns; ++j)
+                pResult[j] += dXi * pX[j];
+            }
+        }
+    }
+
+    const PiiMatrix<T>& mat;
+    const PiiMatrix<double>& mu;
+    PiiMatrix<double>* bands;
+  };
+  /// @endhide
+
   template <class T> PiiMatrix<double> covariance(const PiiMatrix<T>& mat,
-                                                  PiiMatrix<double>* meanMatrix)
+                                                  PiiMatrix<double>* meanMatrix,
+                                                  int threads)
   {
     // Mean of all dimensions
     PiiMatrix<double> mu = mean<double>(mat, Vertically);
-    PiiMatrix<double> result(mat.columns(), mat.columns());
-    for (int r=mat.rows(); r--; )
-      {
-        PiiMatrix<double> x(mat(r,0,1,-1));
-        x -= mu;
-        // (x-mu)' * (x-mu) produces a M-by-M matrix
-        result += transpose(x) * x;
-      }
+    const int iColumns = mat.columns();
+    // Each measurement costs about M*M/2 multiplications.
+    const int iMinBandSize = reductionMinBandRows(qMax(1, iColumns * iColumns / 2));
+    std::vector<PiiMatrix<double> > vecBands(qMax(1, parallelBandCount(mat.rows(), threads, iMinBandSize)));
+    CovarianceBand<T> band(mat, mu, &vecBands[0]);
+    parallelFor(mat.rows(), band, threads, iMinBandSize);
+
+    PiiMatrix<double> result(vecBands[0]);
+    if (result.isEmpty())
+      result = PiiMatrix<double>(iColumns, iColumns);
+    for (std::size_t i=1; i<vecBands.size(); ++i)
+      result += vecBands[i];
+    // Mirror the upper triangle
+    for (int i=1; i<iColumns; ++i)
+      for (int j=0; j<i; ++j)
+        result(i,j) = result(j,i);
     result /= (mat.rows() - 1);
     // Store mean value
     if (meanMatrix != 0)
@@ -579,12 +710,12 @@ namespace Pii
         PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(1, iCols));
         T* pResultRow = matResult.row(0);
         std::memcpy(pResultRow, mat[0], sizeof(T)*iCols);
+        // Select instead of branching to let the compiler vectorize.
         for (int r=1; r<iRows; ++r)
           {
             const T* pSourceRow = mat.row(r);
             for (int c=0; c<iCols; ++c)
-              if (compare(pSourceRow[c], pResultRow[c]))
-                pResultRow[c] = pSourceRow[c];
+              pResultRow[c] = compare(pSourceRow[c], pResultRow[c]) ? pSourceRow[c] : pResultRow[c];
           }
         return matResult;
       }
@@ -595,9 +726,7 @@ namespace Pii
           {
             const T* pRow = mat.row(r);
             T extremum(pRow[0]);
-            for (int c=1; c<iCols; ++c)
-              if (compare(pRow[c], extremum))
-                extremum = pRow[c];
+            extremumN(pRow, iCols, extremum, compare);
             matResult(r,0) = extremum;
           }
         return matResult;
@@ -615,6 +744,26 @@ namespace Pii
   }
 
 
+  /// @hide
+  template <class Matrix> inline bool minMaxRows(const Matrix&,
+                                                 typename Matrix::value_type*,
+                                                 typename Matrix::value_type*)
+  {
+    return false;
+  }
+
+  template <class T> bool minMaxRows(const PiiMatrix<T>& mat, T* minimum, T* maximum)
+  {
+    T tMin(mat(0,0)), tMax(tMin);
+    const int iRows = mat.rows(), iColumns = mat.columns();
+    for (int r=0; r<iRows; ++r)
+      minMaxN(mat[r], iColumns, tMin, tMax);
+    *minimum = tMin;
+    *maximum = tMax;
+    return true;
+  }
+  /// @endhide
+
   template <class Matrix> void minMax(const Matrix& mat,
                                       typename Matrix::value_type* minimum,
                                       typename Matrix::value_type* maximum,
@@ -623,6 +772,10 @@ namespace Pii
   {
     if (mat.isEmpty())
       return;
+    // Without locations, find the values branch-free row by row.
+    if (minR == 0 && minC == 0 && maxR == 0 && maxC == 0 &&
+        minMaxRows(mat, minimum, maximum))
+      return;
     typename Matrix::const_iterator minIt = mat.begin(), maxIt = mat.begin();
     for (typename Matrix::const_iterator it = mat.begin(); it != mat.end(); ++it)
       {
@@ -1036,6 +1189,18 @@ namespace Pii
     else return mingtguess;
   }
 
+  template <class Matrix> typename Matrix::value_type median(const Matrix& mat)
+  {
+    typedef typename Matrix::value_type T;
+    std::vector<T> vecValues(mat.begin(), mat.end());
+    if (vecValues.empty())
+      return T(0);
+    // Same element as returned by medianN()
+    typename std::vector<T>::iterator middle = vecValues.begin() + (vecValues.size()-1)/2;
+    std::nth_element(vecValues.begin(), middle, vecValues.end());
+    return *middle;
+  }
+
   template <class Iterator> typename std::iterator_traits<Iterator>::value_type median3(Iterator p)
   {
     typename std::iterator_traits<Iterator>::value_type tmp;
@@ -1122,7 +1287,7 @@ namespace Pii
           {
             typename Matrix::row_iterator row = mat.rowBegin(r);
             // Calculate the squared length of a vector
-            double dNormalizer = innerProductN(row, iColumns, row, 0.0);
+            double dNormalizer = sumOfSquaresN(row, iColumns, 0.0);
             if (dNormalizer != 0)
               // Divide each element by the length
               transformN(row, iColumns, row, std::bind2nd(std::multiplies<double>(), 1.0/sqrt(dNormalizer)));
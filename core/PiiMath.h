@@ -23,6 +23,7 @@
 #include "PiiHeap.h"
 #include "PiiMatrixValue.h"
 #include "PiiPreprocessor.h"
+#include "PiiReduction.h"
 
 #include <cstdlib>
 #include <complex>
@@ -780,17 +781,27 @@ namespace Pii
   template <class UnaryFunction, class Matrix>
   PiiMatrix<typename UnaryFunction::result_type> cumulativeSum(const Matrix& matrix,
                                                                UnaryFunction func,
-                                                               CumulativeSumMode mode);
+                                                               CumulativeSumMode mode,
+                                                               int threads = 1);
   /**
    * This version uses a preallocated output matrix. It is the
    * responsibility of the caller to make sure the output has correct
    * size.
+   *
+   * If *threads* is not one, the input is split into row bands whose
+   * cumulative sums are calculated in parallel. The last row of each
+   * band is then propagated to the bands below it. Zero means the
+   * number of processor cores. Small matrices are always processed
+   * in a single thread. With integer types, the result is always
+   * identical. With floating-point types, the order of additions
+   * changes, which may cause differences in rounding.
    */
   template <class UnaryFunction, class InputMatrix, class OutputMatrix>
   void cumulativeSum(const InputMatrix& matrix,
                      OutputMatrix& result,
                      UnaryFunction func,
-                     CumulativeSumMode mode);
+                     CumulativeSumMode mode,
+                     int threads = 1);
 
   /**
    * Calculates two-dimensional cumulative sum of a matrix. In
@@ -822,6 +833,10 @@ namespace Pii
    *
    * @param mode calculation mode
    *
+   * @param threads the maximum number of threads. The default is one.
+   * See [cumulativeSum(const InputMatrix&, OutputMatrix&, UnaryFunction,
+   * CumulativeSumMode, int)] for details.
+   *
    * ~~~(c++)
    * using namespace Pii;
    *
@@ -846,9 +861,10 @@ namespace Pii
    * ~~~
    */
   template <class U, class Matrix> inline PiiMatrix<U> cumulativeSum(const Matrix& mat,
-                                                                     CumulativeSumMode mode = OrdinaryCumulativeSum)
+                                                                     CumulativeSumMode mode = OrdinaryCumulativeSum,
+                                                                     int threads = 1)
   {
-    return cumulativeSum(mat, Cast<typename Matrix::value_type,U>(), mode);
+    return cumulativeSum(mat, Cast<typename Matrix::value_type,U>(), mode, threads);
   }
 
   /**
@@ -959,6 +975,21 @@ namespace Pii
                            T(0));
   }
 
+  /**
+   * Returns the sum of all entries in a matrix. This overload sums
+   * the rows with the [reduction] kernels. Floating-point sums are
+   * compensated, which makes the result more accurate than that of a
+   * running sum.
+   */
+  template <class T, class U> T sum(const PiiMatrix<U>& mat)
+  {
+    typename Accumulator<T>::Type result;
+    const int iRows = mat.rows(), iColumns = mat.columns();
+    for (int r=0; r<iRows; ++r)
+      accumulateSumN<T>(mat[r], iColumns, result);
+    return result.value();
+  }
+
   /**
    * Returns the mean of all entries in a matrix. Returns the value as
    * a (possibly) different type, denoted by the template parameter
@@ -1023,11 +1054,17 @@ namespace Pii
    * you need this value later, provide a placeholder for it here. The
    * mean will be a 1xM row matrix.
    *
+   * @param threads the maximum number of threads. Zero means the
+   * number of processor cores. Each thread accumulates the products
+   * of a band of measurements, and the partial results are summed at
+   * the end. Small inputs are always processed in a single thread.
+   *
    * @return a MxM covariance matrix. Diagonal elements represent the
    * variances of the M dimensions. The covariance matrix is
    * symmetric.
    */
-  template <class T> PiiMatrix<double> covariance(const PiiMatrix<T>& mat, PiiMatrix<double>* mean = 0);
+  template <class T> PiiMatrix<double> covariance(const PiiMatrix<T>& mat, PiiMatrix<double>* mean = 0,
+                                                  int threads = 1);
 
   /**
    * Calculates the mean of matrix elements in the specified direction.
@@ -1221,12 +1258,12 @@ namespace Pii
   typename std::iterator_traits<Iterator>::value_type medianN(Iterator data, int len);
 
   /**
-   * Returns the median of all elements in `mat`.
+   * Returns the median of all elements in `mat`. If the number of
+   * elements is even, the smaller one of the two middle values will
+   * be returned. The elements are copied to a temporary buffer and
+   * partially sorted in linear time.
    */
-  template <class Matrix> typename Matrix::value_type median(const Matrix& mat)
-  {
-    return medianN(mat.begin(), mat.rows() * mat.columns());
-  }
+  template <class Matrix> typename Matrix::value_type median(const Matrix& mat);
 
   /**
    * Median of three values optimized to the theoretical maximum
@@ -2691,6 +2728,22 @@ namespace Pii
     return maxIn(collection.begin(), collection.end());
   }
 
+  /**
+   * Returns the maximum of all elements in *mat*, or the smallest
+   * possible value of `T` if the matrix is empty. This overload finds
+   * the maximum without branches, row by row.
+   */
+  template <class T> T max(const PiiMatrix<T>& mat)
+  {
+    if (mat.isEmpty())
+      return Numeric<T>::minValue();
+    T maximum(mat(0,0));
+    const int iRows = mat.rows(), iColumns = mat.columns();
+    for (int r=0; r<iRows; ++r)
+      extremumN(mat[r], iColumns, maximum, std::greater<T>());
+    return maximum;
+  }
+
   /**
    * Returns the minimum value in [*begin*, *end*).
    */
@@ -2713,6 +2766,21 @@ namespace Pii
     return minIn(collection.begin(), collection.end());
   }
 
+  /**
+   * Returns the minimum of all elements in *mat*, or the largest
+   * possible value of `T` if the matrix is empty.
+   */
+  template <class T> T min(const PiiMatrix<T>& mat)
+  {
+    if (mat.isEmpty())
+      return Numeric<T>::maxValue();
+    T minimum(mat(0,0));
+    const int iRows = mat.rows(), iColumns = mat.columns();
+    for (int r=0; r<iRows; ++r)
+      extremumN(mat[r], iColumns, minimum, std::less<T>());
+    return minimum;
+  }
+
 
   /**
    * Raises all values in a matrix to nth (integer) power.
@@ -0,0 +1,159 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIIPARALLEL_H
+#define _PIIPARALLEL_H
+
+#include "PiiGlobal.h"
+
+#ifndef PII_NO_QT
+#  include <QThread>
+#  include <QVarLengthArray>
+#endif
+
+/// @hide
+#ifndef PII_NO_QT
+template <class Function> class PiiParallelBand : public QThread
+{
+public:
+  PiiParallelBand(Function& function, int begin, int end, int index) :
+    _function(function), _iBegin(begin), _iEnd(end), _iIndex(index)
+  {}
+
+protected:
+  void run() { _function(_iBegin, _iEnd, _iIndex); }
+
+private:
+  Function& _function;
+  int _iBegin, _iEnd, _iIndex;
+};
+#endif
+/// @endhide
+
+namespace Pii
+{
+  /**
+   * @group parallel Data-parallel Processing
+   *
+   * Functions for splitting a large, uniform task (such as processing
+   * the rows of an image) into contiguous bands that are processed
+   * in separate threads.
+   */
+
+  /**
+   * Returns the number of threads that should be used for a parallel
+   * task. If *requested* is positive, it will be returned as such.
+   * Otherwise, the number of processor cores is returned. If Qt is
+   * not available, this function always returns one.
+   */
+  inline int threadCount(int requested = 0)
+  {
+    if (requested > 0)
+      return requested;
+#ifndef PII_NO_QT
+    return qMax(1, QThread::idealThreadCount());
+#else
+    return 1;
+#endif
+  }
+
+  /**
+   * Returns the number of bands [parallelFor()] would split *count*
+   * work items into, given at most *threads* threads and at least
+   * *minBandSize* items per band. Use this function to preallocate
+   * per-band accumulators.
+   */
+  inline int parallelBandCount(int count, int threads = 0, int minBandSize = 1)
+  {
+    if (count <= 0)
+      return 0;
+    int iBands = qMin(threadCount(threads), count / qMax(1, minBandSize));
+    return qMax(1, iBands);
+  }
+
+  /**
+   * Splits [0, *count*) into contiguous bands and calls
+   * `function(begin, end, bandIndex)` for each band in a separate
+   * thread. The calling thread processes the last band itself, and
+   * the function returns once all bands have been processed.
+   *
+   * @param count the total number of work items (e.g. image rows)
+   *
+   * @param function a function object that will be called
+   * concurrently from many threads. It must not throw and must not
+   * modify data shared with other bands without synchronization. The
+   * `bandIndex` argument is in [0, parallelBandCount()) and can be
+   * used to address per-band accumulators.
+   *
+   * @param threads the maximum number of threads. Zero means the
+   * number of processor cores.
+   *
+   * @param minBandSize the minimum number of items in a band. Use
+   * this to prevent splitting small tasks so finely that thread
+   * creation dominates.
+   *
+   * ~~~(c++)
+   * struct RowSum
+   * {
+   *   RowSum(const PiiMatrix<int>& mat, int* sums) : mat(mat), sums(sums) {}
+   *   void operator() (int begin, int end, int band) const
+   *   {
+   *     for (int r=begin; r<end; ++r)
+   *       sums[band] += Pii::sumN<int>(mat[r], mat.columns());
+   *   }
+   *   const PiiMatrix<int>& mat;
+   *   int* sums;
+   * };
+   *
+   * QVector<int> vecSums(Pii::parallelBandCount(mat.rows()));
+   * RowSum sum(mat, vecSums.data());
+   * Pii::parallelFor(mat.rows(), sum);
+   * ~~~
+   */
+  template <class Function> void parallelFor(int count, Function& function, int threads = 0, int minBandSize = 1)
+  {
+    const int iBands = parallelBandCount(count, threads, minBandSize);
+    if (iBands == 0)
+      return;
+#ifndef PII_NO_QT
+    if (iBands > 1)
+      {
+        QVarLengthArray<PiiParallelBand<Function>*, 16> lstBands(iBands-1);
+        for (int i=0; i<iBands-1; ++i)
+          {
+            lstBands[i] = new PiiParallelBand<Function>(function,
+                                                        int(qint64(count) * i / iBands),
+                                                        int(qint64(count) * (i+1) / iBands),
+                                                        i);
+            lstBands[i]->start();
+          }
+        function(int(qint64(count) * (iBands-1) / iBands), count, iBands-1);
+        for (int i=0; i<iBands-1; ++i)
+          {
+            lstBands[i]->wait();
+            delete lstBands[i];
+          }
+        return;
+      }
+#endif
+    // Without threads (or with one band), process bands sequentially.
+    for (int i=0; i<iBands; ++i)
+      function(int(qint64(count) * i / iBands), int(qint64(count) * (i+1) / iBands), i);
+  }
+
+  /// @endgroup
+}
+
+#endif //_PIIPARALLEL_H
@@ -85,6 +85,42 @@ namespace Pii
    * copy of matrix' data.
    */
   template <class T> QImage matrixToQImage(const PiiMatrix<T>& matrix);
+
+  /**
+   * Converts a PiiMatrix to a QImage without copying data, if
+   * possible. If the type and memory layout of *matrix* are directly
+   * compatible with QImage, the returned image will be a read-only
+   * view to the matrix' data. It holds a reference to the data buffer
+   * of *matrix*, which will be released once the last copy of the
+   * image is destroyed. The matrix can be safely modified or destroyed
+   * while the image is alive: the modification just detaches the
+   * matrix, and painting the image will not be affected.
+   *
+   * Zero-copy conversion is possible if
+   *
+   * - `T` is `unsigned char` (requires Qt 5.5 or newer, the image
+   *   will be QImage::Format_Grayscale8) or
+   *   `PiiColor4<unsigned char>` (requires Qt 5, the image will be
+   *   QImage::Format_RGB32) and
+   *
+   * - the first row of the matrix and its stride are aligned to four
+   *   bytes. All matrices allocated by PiiMatrix satisfy this
+   *   requirement, but submatrices may not.
+   *
+   * In all other cases, this function is equivalent to
+   * [matrixToQImage()].
+   *
+   * Since the result is read-only, calling a non-const function such
+   * as `QImage::scanLine()` or `QImage::setColorTable()` on it will
+   * make a deep copy of the data.
+   *
+   * ~~~(c++)
+   * PiiMatrix<uchar> matFrame(camera.frame());
+   * QImage img(Pii::toQImage(matFrame)); // no copy
+   * matFrame = PiiMatrix<uchar>(); // img is still valid
+   * ~~~
+   */
+  template <class T> QImage toQImage(const PiiMatrix<T>& matrix);
 }
 
 /**
@@ -384,6 +420,56 @@ namespace Pii
     return result;
   }
 
+  /// @hide
+  template <class T> void releaseQImageMatrix(void* matrix)
+  {
+    delete static_cast<PiiMatrix<T>*>(matrix);
+  }
+
+  template <class T> bool isQImageCompatible(const PiiMatrix<T>& matrix)
+  {
+    return !matrix.isEmpty() &&
+      (matrix.stride() & 3) == 0 &&
+      (reinterpret_cast<quintptr>(matrix.row(0)) & 3) == 0;
+  }
+
+#if QT_VERSION >= 0x050000
+  template <class T> QImage wrapMatrix(const PiiMatrix<T>& matrix, QImage::Format format)
+  {
+    // The cleanup function releases our reference to matrix data
+    // once the last copy of the image is gone.
+    return QImage(reinterpret_cast<const uchar*>(matrix.row(0)),
+                  matrix.columns(), matrix.rows(), int(matrix.stride()),
+                  format,
+                  &releaseQImageMatrix<T>,
+                  new PiiMatrix<T>(matrix));
+  }
+#endif
+  /// @endhide
+
+  template <class T> QImage toQImage(const PiiMatrix<T>& matrix)
+  {
+    return matrixToQImage(matrix);
+  }
+
+  template <> inline QImage toQImage(const PiiMatrix<uchar>& matrix)
+  {
+#if QT_VERSION >= 0x050500
+    if (isQImageCompatible(matrix))
+      return wrapMatrix(matrix, QImage::Format_Grayscale8);
+#endif
+    return matrixToQImage(matrix);
+  }
+
+  template <> inline QImage toQImage(const PiiMatrix<PiiColor4<uchar> >& matrix)
+  {
+#if QT_VERSION >= 0x050000
+    if (isQImageCompatible(matrix))
+      return wrapMatrix(matrix, QImage::Format_RGB32);
+#endif
+    return matrixToQImage(matrix);
+  }
+
   template <class T> QImage* createQImage(PiiMatrix<T>& matrix)
   {
     return Pii::IfClass<Pii::IsColor<T>,
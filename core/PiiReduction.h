@@ -0,0 +1,427 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIIREDUCTION_H
+#define _PIIREDUCTION_H
+
+#include "PiiMatrix.h"
+#include "PiiParallel.h"
+#include "PiiTypeTraits.h"
+#include "PiiMathDefs.h"
+
+#include <cmath>
+#include <vector>
+
+namespace Pii
+{
+  /**
+   * @group reduction Reductions
+   *
+   * Building blocks for fast reductions over matrices. The row
+   * kernels keep four independent partial results, which breaks the
+   * dependency between successive additions and lets the compiler
+   * vectorize the loops. Rows are summed in blocks of
+   * [ReductionBlockSize] elements, and block sums of floating-point
+   * types are added with Kahan's compensated summation. The result
+   * is usually more accurate than a naive running sum.
+   */
+
+  /**
+   * The number of elements summed with plain additions before the
+   * partial sum is moved to a (possibly compensated) accumulator.
+   */
+  enum { ReductionBlockSize = 256 };
+
+  /**
+   * An accumulator that uses Kahan's compensated summation to reduce
+   * round-off errors.
+   *
+   * ~~~(c++)
+   * Pii::CompensatedSum<float> sum;
+   * for (int i=0; i<10000000; ++i)
+   *   sum += 0.1f;
+   * // sum.value() is much closer to 1e6 than a plain float sum.
+   * ~~~
+   */
+  template <class T> class CompensatedSum
+  {
+  public:
+    CompensatedSum(T initialValue = T(0)) : _sum(initialValue), _compensation(0) {}
+
+    CompensatedSum& operator+= (T value)
+    {
+      T y = value - _compensation;
+      T t = _sum + y;
+      _compensation = (t - _sum) - y;
+      _sum = t;
+      return *this;
+    }
+
+    CompensatedSum& operator+= (const CompensatedSum& other)
+    {
+      *this += other._sum;
+      return *this += -other._compensation;
+    }
+
+    /**
+     * Returns the accumulated sum.
+     */
+    T value() const { return _sum - _compensation; }
+
+  private:
+    T _sum, _compensation;
+  };
+
+  /**
+   * An accumulator that just adds values. Used for types that don't
+   * need compensation.
+   */
+  template <class T> class PlainSum
+  {
+  public:
+    PlainSum(T initialValue = T(0)) : _sum(initialValue) {}
+
+    PlainSum& operator+= (T value) { _sum += value; return *this; }
+    PlainSum& operator+= (const PlainSum& other) { _sum += other._sum; return *this; }
+
+    T value() const { return _sum; }
+
+  private:
+    T _sum;
+  };
+
+  /**
+   * Selects the accumulator type for `T`. Floating-point types use
+   * CompensatedSum, all others PlainSum.
+   */
+  template <class T> struct Accumulator
+  {
+    typedef typename IfClass<IsFloatingPoint<T>, CompensatedSum<T>, PlainSum<T> >::Type Type;
+  };
+
+  /// @hide
+  template <class U, class Row> inline U sumBlock(Row row, int begin, int end)
+  {
+    U s0(0), s1(0), s2(0), s3(0);
+    int i = begin;
+    for (; i < end-3; i += 4)
+      {
+        s0 += U(row[i]);
+        s1 += U(row[i+1]);
+        s2 += U(row[i+2]);
+        s3 += U(row[i+3]);
+      }
+    for (; i < end; ++i)
+      s0 += U(row[i]);
+    return (s0 + s1) + (s2 + s3);
+  }
+
+  template <class U, class Row> inline U sumOfSquaresBlock(Row row, int begin, int end, U shift)
+  {
+    U s0(0), s1(0), s2(0), s3(0);
+    int i = begin;
+    for (; i < end-3; i += 4)
+      {
+        U d0 = U(row[i]) - shift, d1 = U(row[i+1]) - shift,
+          d2 = U(row[i+2]) - shift, d3 = U(row[i+3]) - shift;
+        s0 += d0*d0;
+        s1 += d1*d1;
+        s2 += d2*d2;
+        s3 += d3*d3;
+      }
+    for (; i < end; ++i)
+      {
+        U d = U(row[i]) - shift;
+        s0 += d*d;
+      }
+    return (s0 + s1) + (s2 + s3);
+  }
+  /// @endhide
+
+  /**
+   * Adds the sum of *n* elements starting at *row* to *accumulator*.
+   * `U` is the type used in summation.
+   */
+  template <class U, class Row, class Acc> void accumulateSumN(Row row, int n, Acc& accumulator)
+  {
+    for (int i=0; i<n; i += ReductionBlockSize)
+      accumulator += sumBlock<U>(row, i, qMin(n, i + ReductionBlockSize));
+  }
+
+  /**
+   * Returns the sum of *n* elements starting at *row* as `U`.
+   *
+   * ~~~(c++)
+   * PiiMatrix<uchar> img(100, 100);
+   * int iRowSum = Pii::sumN<int>(img[0], img.columns());
+   * ~~~
+   */
+  template <class U, class Row> U sumN(Row row, int n)
+  {
+    typename Accumulator<U>::Type sum;
+    accumulateSumN<U>(row, n, sum);
+    return sum.value();
+  }
+
+  /**
+   * Returns the sum of squared differences between *n* elements
+   * starting at *row* and *shift*. With *shift* = 0, returns the sum
+   * of squares.
+   */
+  template <class U, class Row> U sumOfSquaresN(Row row, int n, U shift = U(0))
+  {
+    typename Accumulator<U>::Type sum;
+    for (int i=0; i<n; i += ReductionBlockSize)
+      sum += sumOfSquaresBlock<U>(row, i, qMin(n, i + ReductionBlockSize), shift);
+    return sum.value();
+  }
+
+  /**
+   * Finds the minimum and maximum of *n* (at least one) elements
+   * starting at *row* without branches. The results will be combined
+   * with the initial values of *minimum* and *maximum*.
+   */
+  template <class Row, class T> void minMaxN(Row row, int n, T& minimum, T& maximum)
+  {
+    T min0(minimum), min1(minimum), max0(maximum), max1(maximum);
+    int i = 0;
+    for (; i < n-1; i += 2)
+      {
+        T v0(row[i]), v1(row[i+1]);
+        min0 = v0 < min0 ? v0 : min0;
+        max0 = v0 > max0 ? v0 : max0;
+        min1 = v1 < min1 ? v1 : min1;
+        max1 = v1 > max1 ? v1 : max1;
+      }
+    if (i < n)
+      {
+        T v(row[i]);
+        min0 = v < min0 ? v : min0;
+        max0 = v > max0 ? v : max0;
+      }
+    minimum = min1 < min0 ? min1 : min0;
+    maximum = max1 > max0 ? max1 : max0;
+  }
+
+  /**
+   * Finds the extreme value of *n* elements starting at *row* without
+   * branches. *compare* is a binary predicate that returns `true` if
+   * its first argument should replace the second one as the extreme
+   * value. The result will be combined with the initial value of
+   * *extremum*.
+   *
+   * ~~~(c++)
+   * PiiMatrix<int> mat(1, 4, 3, 1, 4, 2);
+   * int iMax = mat(0,0);
+   * Pii::extremumN(mat[0], 4, iMax, std::greater<int>());
+   * // iMax = 4
+   * ~~~
+   */
+  template <class Row, class T, class BinaryPredicate>
+  void extremumN(Row row, int n, T& extremum, BinaryPredicate compare)
+  {
+    T e0(extremum), e1(extremum), e2(extremum), e3(extremum);
+    int i = 0;
+    for (; i < n-3; i += 4)
+      {
+        T v0(row[i]), v1(row[i+1]), v2(row[i+2]), v3(row[i+3]);
+        e0 = compare(v0, e0) ? v0 : e0;
+        e1 = compare(v1, e1) ? v1 : e1;
+        e2 = compare(v2, e2) ? v2 : e2;
+        e3 = compare(v3, e3) ? v3 : e3;
+      }
+    for (; i < n; ++i)
+      {
+        T v(row[i]);
+        e0 = compare(v, e0) ? v : e0;
+      }
+    e0 = compare(e1, e0) ? e1 : e0;
+    e2 = compare(e3, e2) ? e3 : e2;
+    extremum = compare(e2, e0) ? e2 : e0;
+  }
+
+  /**
+   * Summary statistics of a set of values, calculated in a single
+   * pass with [statistics()]. `T` is the type of the values and `U`
+   * the type used in calculations.
+   *
+   * The sums are internally calculated relative to the first value,
+   * which keeps the variance accurate even if the mean is large
+   * compared to the spread of values.
+   */
+  template <class T, class U = double> class Statistics
+  {
+  public:
+    /**
+     * Creates statistics for an empty set with the given reference
+     * value.
+     */
+    Statistics(T shift = T(0)) :
+      _iCount(0), _shift(U(shift)), _minimum(shift), _maximum(shift)
+    {}
+
+    /**
+     * Returns the number of values.
+     */
+    int count() const { return _iCount; }
+    /**
+     * Returns the sum of all values.
+     */
+    U sum() const { return _shift * U(_iCount) + _sum.value(); }
+    /**
+     * Returns the sum of squares of all values.
+     */
+    U sumOfSquares() const
+    {
+      return _sumOfSquares.value() + U(2) * _shift * _sum.value() + U(_iCount) * _shift * _shift;
+    }
+    /**
+     * Returns the mean, or zero if there are no values.
+     */
+    U mean() const { return _iCount != 0 ? _shift + _sum.value() / U(_iCount) : U(0); }
+    /**
+     * Returns the (population) variance, or zero if there are no
+     * values. This is the same value [Pii::var()] would return.
+     */
+    U var() const
+    {
+      if (_iCount == 0)
+        return U(0);
+      U s = _sum.value();
+      U v = (_sumOfSquares.value() - s * s / U(_iCount)) / U(_iCount);
+      return v > U(0) ? v : U(0);
+    }
+    /**
+     * Returns the standard deviation.
+     */
+    U std() const { return U(std::sqrt(double(var()))); }
+    /**
+     * Returns the smallest value. If there are no values, returns the
+     * reference value.
+     */
+    T minimum() const { return _minimum; }
+    /**
+     * Returns the largest value. If there are no values, returns the
+     * reference value.
+     */
+    T maximum() const { return _maximum; }
+
+    /**
+     * Adds *n* values starting at *row* to the statistics.
+     */
+    template <class Row> void addN(Row row, int n)
+    {
+      if (n <= 0)
+        return;
+      for (int i=0; i<n; i += ReductionBlockSize)
+        {
+          int iEnd = qMin(n, i + ReductionBlockSize);
+          _sum += sumBlock<U>(row, i, iEnd) - U(iEnd - i) * _shift;
+          _sumOfSquares += sumOfSquaresBlock<U>(row, i, iEnd, _shift);
+        }
+      minMaxN(row, n, _minimum, _maximum);
+      _iCount += n;
+    }
+
+    /**
+     * Merges *other* into these statistics. Both must have been
+     * created with the same reference value.
+     */
+    Statistics& operator+= (const Statistics& other)
+    {
+      if (other._iCount == 0)
+        return *this;
+      _sum += other._sum;
+      _sumOfSquares += other._sumOfSquares;
+      _minimum = qMin(_minimum, other._minimum);
+      _maximum = qMax(_maximum, other._maximum);
+      _iCount += other._iCount;
+      return *this;
+    }
+
+  private:
+    int _iCount;
+    U _shift;
+    typename Accumulator<U>::Type _sum, _sumOfSquares;
+    T _minimum, _maximum;
+  };
+
+  /// @hide
+  template <class Matrix, class S> struct StatisticsBand
+  {
+    StatisticsBand(const Matrix& mat, S* bands) : mat(mat), bands(bands) {}
+
+    void operator() (int begin, int end, int band)
+    {
+      const int iColumns = mat.columns();
+      for (int r=begin; r<end; ++r)
+        bands[band].addN(mat.rowBegin(r), iColumns);
+    }
+
+    const Matrix& mat;
+    S* bands;
+  };
+
+  // Minimum number of elements per band in parallel reductions
+  enum { ReductionMinBandElements = 65536 };
+
+  inline int reductionMinBandRows(int columns)
+  {
+    return qMax(1, int(ReductionMinBandElements) / qMax(1, columns));
+  }
+  /// @endhide
+
+  /**
+   * Calculates the sum, sum of squares, minimum and maximum of all
+   * elements in *mat* in a single pass. `U` is the type used in
+   * calculations. Large matrices are split into row bands that are
+   * processed in parallel.
+   *
+   * @param mat the input matrix
+   *
+   * @param threads the maximum number of threads. Zero means the
+   * number of processor cores. Matrices with less than 65536 elements
+   * per thread will be processed with fewer threads. The default is
+   * one.
+   *
+   * ~~~(c++)
+   * PiiMatrix<uchar> img(PiiImage::readGrayImage("image.jpg"));
+   * Pii::Statistics<uchar> stats = Pii::statistics<double>(img);
+   * double dMean = stats.mean(), dVar = stats.var();
+   * uchar ucMax = stats.maximum();
+   * ~~~
+   */
+  template <class U, class Matrix>
+  Statistics<typename Matrix::value_type, U> statistics(const Matrix& mat, int threads = 1)
+  {
+    typedef Statistics<typename Matrix::value_type, U> S;
+    if (mat.isEmpty())
+      return S();
+
+    const int iRows = mat.rows(), iColumns = mat.columns();
+    const int iMinBandSize = reductionMinBandRows(iColumns);
+    std::vector<S> vecBands(parallelBandCount(iRows, threads, iMinBandSize), S(*mat.rowBegin(0)));
+    StatisticsBand<Matrix,S> band(mat, &vecBands[0]);
+    parallelFor(iRows, band, threads, iMinBandSize);
+
+    for (std::size_t i=1; i<vecBands.size(); ++i)
+      vecBands[0] += vecBands[i];
+    return vecBands[0];
+  }
+
+  /// @endgroup
+}
+
+#endif //_PIIREDUCTION_H
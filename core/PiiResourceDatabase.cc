@@ -15,6 +15,9 @@
 
 #include "PiiResourceDatabase.h"
 
+#include <algorithm>
+#include <iterator>
+
 namespace Pii
 {
   Subject subject;
@@ -23,6 +26,60 @@ namespace Pii
   Attribute attribute("");
   ResourceType resourceType;
   StatementId statementId;
+
+  static void addId(ResourceIndex::Hash& hash, const QString& key, int id)
+  {
+    QVector<int>& ids = hash[key];
+    // Ids are almost always added in ascending order.
+    if (ids.isEmpty() || ids.last() < id)
+      ids.append(id);
+    else
+      ids.insert(std::lower_bound(ids.begin(), ids.end(), id), id);
+  }
+
+  static void removeId(ResourceIndex::Hash& hash, const QString& key, int id)
+  {
+    QVector<int>& ids = hash[key];
+    QVector<int>::iterator i = std::lower_bound(ids.begin(), ids.end(), id);
+    if (i != ids.end() && *i == id)
+      ids.erase(i);
+    if (ids.isEmpty())
+      hash.remove(key);
+  }
+
+  void ResourceIndex::add(const PiiResourceStatement& statement)
+  {
+    addId(hashSubjects, statement.subject(), statement.id());
+    addId(hashPredicates, statement.predicate(), statement.id());
+    addId(hashObjects, statement.object(), statement.id());
+  }
+
+  void ResourceIndex::remove(const PiiResourceStatement& statement)
+  {
+    removeId(hashSubjects, statement.subject(), statement.id());
+    removeId(hashPredicates, statement.predicate(), statement.id());
+    removeId(hashObjects, statement.object(), statement.id());
+  }
+
+  QVector<int> ResourceIndex::intersect(const QVector<int>& ids1, const QVector<int>& ids2)
+  {
+    QVector<int> vecResult;
+    vecResult.reserve(qMin(ids1.size(), ids2.size()));
+    std::set_intersection(ids1.begin(), ids1.end(), ids2.begin(), ids2.end(), std::back_inserter(vecResult));
+    return vecResult;
+  }
+
+  QVector<int> ResourceIndex::unite(const QVector<int>& ids1, const QVector<int>& ids2)
+  {
+    if (ids1.isEmpty())
+      return ids2;
+    if (ids2.isEmpty())
+      return ids1;
+    QVector<int> vecResult;
+    vecResult.reserve(ids1.size() + ids2.size());
+    std::set_union(ids1.begin(), ids1.end(), ids2.begin(), ids2.end(), std::back_inserter(vecResult));
+    return vecResult;
+  }
 }
 
 PiiResourceDatabase::PiiResourceDatabase() :
@@ -86,6 +143,7 @@ int PiiResourceDatabase::addStatement(const PiiResourceStatement& statement)
   int id = generateId();
   copy.setId(id);
   d->lstStatements.push_back(copy);
+  d->index.add(copy);
   return id;
 }
 
@@ -122,14 +180,29 @@ void PiiResourceDatabase::removeStatements(const QList<int>& ids)
 
 void PiiResourceDatabase::removeStatement(int id)
 {
-  for (int i=0; i<d->lstStatements.size(); ++i)
+  int iIndex = indexOf(id);
+  if (iIndex != -1)
     {
-      if (d->lstStatements[i].id() == id)
-        {
-          d->lstStatements.removeAt(i);
-          return;
-        }
+      d->index.remove(d->lstStatements[iIndex]);
+      d->lstStatements.removeAt(iIndex);
+    }
+}
+
+int PiiResourceDatabase::indexOf(int id) const
+{
+  // Ids are generated in ascending order.
+  int iLow = 0, iHigh = d->lstStatements.size()-1;
+  while (iLow <= iHigh)
+    {
+      int iMiddle = (iLow + iHigh) / 2, iMiddleId = d->lstStatements[iMiddle].id();
+      if (iMiddleId < id)
+        iLow = iMiddle + 1;
+      else if (iMiddleId > id)
+        iHigh = iMiddle - 1;
+      else
+        return iMiddle;
     }
+  return -1;
 }
 
 QList<PiiResourceStatement> PiiResourceDatabase::statements() const
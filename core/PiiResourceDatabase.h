@@ -24,9 +24,36 @@
 #endif
 
 #include <QStringList>
+#include <QHash>
+#include <QVector>
 
 #include <functional>
 
+/// @hide
+namespace Pii
+{
+  // Hash indexes used by PiiResourceDatabase to answer queries
+  // without scanning all statements. Each index maps a subject,
+  // predicate or object to the ids of the statements that contain
+  // it. The id lists are in ascending order, which is also the order
+  // of statements in the database.
+  struct PII_CORE_EXPORT ResourceIndex
+  {
+    typedef QHash<QString, QVector<int> > Hash;
+
+    void add(const PiiResourceStatement& statement);
+    void remove(const PiiResourceStatement& statement);
+
+    // Returns the ids in both (sorted) lists.
+    static QVector<int> intersect(const QVector<int>& ids1, const QVector<int>& ids2);
+    // Returns the ids in either of the (sorted) lists.
+    static QVector<int> unite(const QVector<int>& ids1, const QVector<int>& ids2);
+
+    Hash hashSubjects, hashPredicates, hashObjects;
+  };
+}
+/// @endhide
+
 /**
  * A database that stores statements about resources.
  * PiiResourceDatabase is based upon the idea of making statements
@@ -163,6 +190,16 @@ public:
    * global instances of *selector* *structures* Pii::Subject,
    * Pii::Predicate etc. One can equally well use Pii::Subject(),
    * Pii::Predicate() etc. in their place.
+   *
+   * The database maintains hash indexes of subjects, predicates and
+   * objects. Equality comparisons of subjects, predicates, objects,
+   * attributes and statement ids are looked up in the indexes, and
+   * the results are combined according to the logical operators in
+   * the filter. Only the candidates found this way are tested
+   * against the full filter. If a filter cannot be answered from the
+   * indexes (for example, `Pii::subject != "MyOperation"`), all
+   * statements will be scanned. Statements are always returned in
+   * the order they were added.
    */
   template <class Filter> QList<PiiResourceStatement> select(Filter filter) const;
 
@@ -268,46 +305,22 @@ private:
   class Data
   {
   public:
+    // Statements in ascending id order
     QList<PiiResourceStatement> lstStatements;
+    Pii::ResourceIndex index;
   } *d;
 
   int generateId();
+  // Returns the position of the statement with the given id in
+  // lstStatements, or -1 if there is no such statement.
+  int indexOf(int id) const;
+  // Fills ids with the ids of the statements that may match filter,
+  // if the filter can be answered from the indexes.
+  template <class Filter> bool plan(const Filter& filter, QVector<int>& ids) const;
 
   PII_DISABLE_COPY(PiiResourceDatabase);
 };
 
-template <class Filter> QList<PiiResourceStatement> PiiResourceDatabase::select(Filter filter) const
-{
-  QList<PiiResourceStatement> lstResult;
-  for (int i=0; i<d->lstStatements.size(); ++i)
-    if (filter(d->lstStatements[i]))
-      lstResult.push_back(d->lstStatements[i]);
-  return lstResult;
-}
-
-template <class Selector, class Filter>
-QList<typename Selector::ValueType> PiiResourceDatabase::select(Selector selector, Filter filter) const
-{
-  typedef typename Selector::ValueType ValueType;
-  QList<ValueType> lstResult;
-  for (int i=0; i<d->lstStatements.size(); ++i)
-    if (filter(d->lstStatements[i]))
-      {
-        ValueType selected = selector(d->lstStatements[i]);
-        if (!lstResult.contains(selected))
-          lstResult.push_back(selected);
-      }
-  return lstResult;
-}
-
-template <class Filter> int PiiResourceDatabase::findFirst(Filter filter) const
-{
-  for (int i=0; i<d->lstStatements.size(); ++i)
-    if (filter(d->lstStatements[i]))
-      return d->lstStatements[i].id();
-  return -1;
-}
-
 /// @hide
 namespace Pii
 {
@@ -324,8 +337,67 @@ namespace Pii
     const Filter* self() const { return static_cast<const Filter*>(this); }
 
     inline NotFilter<Filter> operator! () const;
+
+    // Stores the ids of the statements that may match the filter to
+    // ids. Returns false if the indexes cannot be used. Subclasses
+    // override this function if they can do better than scanning.
+    bool plan(const ResourceIndex&, QVector<int>&) const { return false; }
   };
 
+  // Query planning for a selector compared to a value. The overloads
+  // below the selector definitions do the actual work. By default, a
+  // comparison can be planned if the selector is valid for a subset
+  // of the statements only.
+  template <class Selector> bool planSelector(const ResourceIndex&, const Selector&, QVector<int>&)
+  {
+    return false;
+  }
+
+  template <class Selector, class BinaryPredicate, class T>
+  bool planComparison(const ResourceIndex& index, const Selector& select, const BinaryPredicate&, const T&,
+                      QVector<int>& ids)
+  {
+    return planSelector(index, select, ids);
+  }
+
+  // Combine the plans of the operands of a logical operator.
+  template <class BinaryPredicate, class Filter1, class Filter2>
+  bool planComposition(const ResourceIndex&, const BinaryPredicate&, const Filter1&, const Filter2&,
+                       QVector<int>&)
+  {
+    return false;
+  }
+
+  template <class Filter1, class Filter2>
+  bool planComposition(const ResourceIndex& index, const std::logical_and<bool>&,
+                       const Filter1& filter1, const Filter2& filter2, QVector<int>& ids)
+  {
+    // Either operand suffices to restrict the candidates.
+    QVector<int> vecIds1, vecIds2;
+    bool bPlan1 = filter1.plan(index, vecIds1), bPlan2 = filter2.plan(index, vecIds2);
+    if (bPlan1 && bPlan2)
+      ids = ResourceIndex::intersect(vecIds1, vecIds2);
+    else if (bPlan1)
+      ids = vecIds1;
+    else if (bPlan2)
+      ids = vecIds2;
+    else
+      return false;
+    return true;
+  }
+
+  template <class Filter1, class Filter2>
+  bool planComposition(const ResourceIndex& index, const std::logical_or<bool>&,
+                       const Filter1& filter1, const Filter2& filter2, QVector<int>& ids)
+  {
+    // Both operands need to be restricted.
+    QVector<int> vecIds1, vecIds2;
+    if (!filter1.plan(index, vecIds1) || !filter2.plan(index, vecIds2))
+      return false;
+    ids = ResourceIndex::unite(vecIds1, vecIds2);
+    return true;
+  }
+
   // A function object that composes the results of two other filters
   // using a logical operator (BinaryPredicate).
   template <class BinaryPredicate, class Filter1, class Filter2>
@@ -340,6 +412,11 @@ namespace Pii
       return predicate(filter1(statement), filter2(statement));
     }
 
+    bool plan(const ResourceIndex& index, QVector<int>& ids) const
+    {
+      return planComposition(index, predicate, filter1, filter2, ids);
+    }
+
     const BinaryPredicate& predicate;
     const Filter1& filter1;
     const Filter2& filter2;
@@ -401,6 +478,11 @@ namespace Pii
       return compare(select(statement), value) && select;
     }
 
+    bool plan(const ResourceIndex& index, QVector<int>& ids) const
+    {
+      return planComparison(index, select, compare, value, ids);
+    }
+
     const Selector& select;
     const BinaryPredicate& compare;
     ValueType value;
@@ -435,6 +517,19 @@ namespace Pii
       return false;
     }
 
+    bool plan(const ResourceIndex& index, QVector<int>& ids) const
+    {
+      ids.clear();
+      for (int i=0; i<lstValues.size(); ++i)
+        {
+          QVector<int> vecIds;
+          if (!planComparison(index, select, compare, lstValues[i], vecIds))
+            return false;
+          ids = ResourceIndex::unite(ids, vecIds);
+        }
+      return true;
+    }
+
     const Selector& select;
     const BinaryPredicate& compare;
     const QList<ValueType>& lstValues;
@@ -589,6 +684,63 @@ namespace Pii
     return ResourceIdToInt<Selector>(select);
   }
 
+  // Index lookups for equality comparisons
+  inline bool planComparison(const ResourceIndex& index, const Subject&, const std::equal_to<QString>&,
+                             const QString& value, QVector<int>& ids)
+  {
+    ids = index.hashSubjects.value(value);
+    return true;
+  }
+
+  inline bool planComparison(const ResourceIndex& index, const Predicate&, const std::equal_to<QString>&,
+                             const QString& value, QVector<int>& ids)
+  {
+    ids = index.hashPredicates.value(value);
+    return true;
+  }
+
+  inline bool planComparison(const ResourceIndex& index, const Object&, const std::equal_to<QString>&,
+                             const QString& value, QVector<int>& ids)
+  {
+    ids = index.hashObjects.value(value);
+    return true;
+  }
+
+  inline bool planComparison(const ResourceIndex& index, const Attribute& select, const std::equal_to<QString>&,
+                             const QString& value, QVector<int>& ids)
+  {
+    ids = ResourceIndex::intersect(index.hashPredicates.value(select.strPredicate),
+                                   index.hashObjects.value(value));
+    return true;
+  }
+
+  inline bool planComparison(const ResourceIndex&, const StatementId&, const std::equal_to<int>&,
+                             int value, QVector<int>& ids)
+  {
+    ids = QVector<int>(1, value);
+    return true;
+  }
+
+  // An attribute is valid only for statements with a matching
+  // predicate, whatever the comparison.
+  inline bool planSelector(const ResourceIndex& index, const Attribute& select, QVector<int>& ids)
+  {
+    ids = index.hashPredicates.value(select.strPredicate);
+    return true;
+  }
+
+  template <class T, class Selector>
+  bool planSelector(const ResourceIndex& index, const ResourceStringTo<T,Selector>& select, QVector<int>& ids)
+  {
+    return planSelector(index, select.select, ids);
+  }
+
+  template <class Selector>
+  bool planSelector(const ResourceIndex& index, const ResourceIdToInt<Selector>& select, QVector<int>& ids)
+  {
+    return planSelector(index, select.select, ids);
+  }
+
   template <class Filter1, class Filter2>
   ComposeFilter<std::logical_and<bool>, Filter1, Filter2> operator&& (const ResourceFilterBase<Filter1>& f1,
                                                                       const ResourceFilterBase<Filter2>& f2)
@@ -603,6 +755,24 @@ namespace Pii
     return orFilter(*f1.self(), *f2.self());
   }
 
+  // Calls the plan() function of resource filters. Custom function
+  // objects cannot be planned.
+  template <bool isResourceFilter> struct ResourcePlanner
+  {
+    template <class Filter> static bool plan(const Filter& filter, const ResourceIndex& index, QVector<int>& ids)
+    {
+      return filter.plan(index, ids);
+    }
+  };
+
+  template <> struct ResourcePlanner<false>
+  {
+    template <class Filter> static bool plan(const Filter&, const ResourceIndex&, QVector<int>&)
+    {
+      return false;
+    }
+  };
+
   extern PII_CORE_EXPORT Subject subject;
   extern PII_CORE_EXPORT Predicate predicate;
   extern PII_CORE_EXPORT Object object;
@@ -612,4 +782,68 @@ namespace Pii
 }
 /// @endhide
 
+template <class Filter> bool PiiResourceDatabase::plan(const Filter& filter, QVector<int>& ids) const
+{
+  return Pii::ResourcePlanner<Pii::IsBaseOf<Pii::ResourceFilterBase<Filter>, Filter>::boolValue>
+    ::plan(filter, d->index, ids);
+}
+
+template <class Filter> QList<PiiResourceStatement> PiiResourceDatabase::select(Filter filter) const
+{
+  QList<PiiResourceStatement> lstResult;
+  QVector<int> vecIds;
+  if (plan(filter, vecIds))
+    {
+      for (int i=0; i<vecIds.size(); ++i)
+        {
+          int iIndex = indexOf(vecIds[i]);
+          if (iIndex != -1 && filter(d->lstStatements[iIndex]))
+            lstResult.push_back(d->lstStatements[iIndex]);
+        }
+    }
+  else
+    {
+      for (int i=0; i<d->lstStatements.size(); ++i)
+        if (filter(d->lstStatements[i]))
+          lstResult.push_back(d->lstStatements[i]);
+    }
+  return lstResult;
+}
+
+template <class Selector, class Filter>
+QList<typename Selector::ValueType> PiiResourceDatabase::select(Selector selector, Filter filter) const
+{
+  typedef typename Selector::ValueType ValueType;
+  QList<ValueType> lstResult;
+  QList<PiiResourceStatement> lstStatements(select(filter));
+  for (int i=0; i<lstStatements.size(); ++i)
+    {
+      ValueType selected = selector(lstStatements[i]);
+      if (!lstResult.contains(selected))
+        lstResult.push_back(selected);
+    }
+  return lstResult;
+}
+
+template <class Filter> int PiiResourceDatabase::findFirst(Filter filter) const
+{
+  QVector<int> vecIds;
+  if (plan(filter, vecIds))
+    {
+      for (int i=0; i<vecIds.size(); ++i)
+        {
+          int iIndex = indexOf(vecIds[i]);
+          if (iIndex != -1 && filter(d->lstStatements[iIndex]))
+            return vecIds[i];
+        }
+    }
+  else
+    {
+      for (int i=0; i<d->lstStatements.size(); ++i)
+        if (filter(d->lstStatements[i]))
+          return d->lstStatements[i].id();
+    }
+  return -1;
+}
+
 #endif //_PIIRESOURCEDATABASE_H
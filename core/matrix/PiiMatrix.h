@@ -202,6 +202,14 @@ public:
    */
   int capacity() const { return d->iCapacity; }
 
+  /**
+   * Returns `true` if the data of this matrix is shared with another
+   * matrix. A buffer pool can use this function to find out whether
+   * a previously returned matrix is no longer used by anyone else
+   * and can thus be reused without reallocation.
+   */
+  bool isShared() const { return d->iRefCount != 1; }
+
   /**
    * Releases all memory allocated by the matrix and resizes the
    * matrix to 0-by-0.
@@ -414,6 +422,24 @@ public:
                                                          const_cast<T*>(data))->makeImmutable())
   {}
 
+  /**
+   * Constructs a read-only *rows*-by-*columns* matrix that references
+   * *data* in a buffer owned by *owner*. The matrix reserves *owner*
+   * and releases it once the matrix and all of its shallow copies
+   * have been destroyed. Like with the constructor above, *data* will
+   * be copied before the matrix is modified. This makes it possible
+   * to share large external buffers, such as memory-mapped files,
+   * without copying.
+   *
+   * Note that *stride* is always in bytes.
+   */
+  PiiMatrix(int rows, int columns, const T* data, PiiSharedObject* owner, std::size_t stride) :
+    PiiTypelessMatrix(PiiMatrixData::createReferenceData(rows, columns,
+                                                         qMax(stride, sizeof(T)*columns),
+                                                         const_cast<T*>(data),
+                                                         owner)->makeImmutable())
+  {}
+
   /**
    * Constructs a *rows*-by-*columns* matrix that uses *data* as
    * its data buffer. This is an overloaded constructor that behaves
@@ -14,6 +14,7 @@
  */
 
 #include "PiiMatrixData.h"
+#include <PiiSharedObject.h>
 #include <cstdlib>
 #include <cstring>
 #include <new>
@@ -46,6 +47,8 @@ void PiiMatrixData::destroy()
     std::free(pBuffer);
   else if (pSourceData != 0)
     pSourceData->release();
+  if (pBufferOwner != 0)
+    pBufferOwner->release();
   std::free(this);
 }
 
@@ -79,6 +82,15 @@ PiiMatrixData* PiiMatrixData::createReferenceData(int rows, int columns, std::si
   return pData;
 }
 
+PiiMatrixData* PiiMatrixData::createReferenceData(int rows, int columns, std::size_t stride, void* buffer,
+                                                  PiiSharedObject* owner)
+{
+  PiiMatrixData* pData = createReferenceData(rows, columns, stride, buffer);
+  owner->reserve();
+  pData->pBufferOwner = owner;
+  return pData;
+}
+
 PiiMatrixData* PiiMatrixData::clone(int capacity, std::size_t bytesPerRow)
 {
   PiiMatrixData* pData;
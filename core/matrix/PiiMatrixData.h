@@ -19,6 +19,8 @@
 #include <PiiGlobal.h>
 #include <PiiAtomicInt.h>
 
+class PiiSharedObject;
+
 /// @internal
 struct PII_CORE_EXPORT PiiMatrixData
 {
@@ -34,7 +36,8 @@ struct PII_CORE_EXPORT PiiMatrixData
     iCapacity(0),
     bufferType(InternalBuffer),
     pSourceData(0),
-    pBuffer(0)
+    pBuffer(0),
+    pBufferOwner(0)
   {}
 
   PiiMatrixData(int rows, int columns, std::size_t stride) :
@@ -46,7 +49,8 @@ struct PII_CORE_EXPORT PiiMatrixData
     iCapacity(rows),
     bufferType(InternalBuffer),
     pSourceData(0),
-    pBuffer(0)
+    pBuffer(0),
+    pBufferOwner(0)
   {}
 
   PiiAtomicInt iRefCount;
@@ -65,6 +69,9 @@ struct PII_CORE_EXPORT PiiMatrixData
   PiiMatrixData* pSourceData;
   // Points to the first element of the matrix.
   void* pBuffer;
+  // If non-zero, owns an external buffer (such as a memory-mapped
+  // file) and is released when this data is destroyed.
+  PiiSharedObject* pBufferOwner;
 
   void* row(int index) { return static_cast<char*>(pBuffer) + iStride * index; }
   const void* row(int index) const { return static_cast<const char*>(pBuffer) + iStride * index; }
@@ -96,6 +103,8 @@ struct PII_CORE_EXPORT PiiMatrixData
   static PiiMatrixData* createUninitializedData(int rows, int columns, std::size_t bytesPerRow, std::size_t stride = 0);
   static PiiMatrixData* createInitializedData(int rows, int columns, std::size_t bytesPerRow, std::size_t stride = 0);
   static PiiMatrixData* createReferenceData(int rows, int columns, std::size_t stride, void* buffer);
+  static PiiMatrixData* createReferenceData(int rows, int columns, std::size_t stride, void* buffer,
+                                            PiiSharedObject* owner);
 
   void destroy();
 };
@@ -23,6 +23,7 @@
 #include <PiiBinaryObject.h>
 #include <PiiSerializationException.h>
 #include <PiiSerialization.h>
+#include <cstring>
 
 /// @hide
 
@@ -36,6 +37,9 @@ namespace PiiSerialization
     int iRows = mat.rows(), iCols = mat.columns();
     archive << PII_NVP("rows", iRows);
     archive << PII_NVP("cols", iCols);
+    // Aligned data can be referenced in place if the archive is
+    // memory-mapped when reading.
+    archive.alignRawData();
     unsigned int uiBytes = iCols*sizeof(T);
     for (int r=0; r<iRows; ++r)
       archive.writeRawData(mat[r], uiBytes);
@@ -51,11 +55,33 @@ namespace PiiSerialization
     if (iRows < 0 || iCols < 0)
       PII_SERIALIZATION_ERROR(InvalidDataFormat);
 
-    mat.resize(iRows, iCols);
+    archive.alignRawData();
+    std::size_t iRowBytes = std::size_t(iCols) * sizeof(T);
+
+    // Try to reference mapped memory first. The data is read-only and
+    // will be copied if the matrix is modified.
+    PiiSharedObject* pOwner = 0;
+    const void* pData = iRows > 0 && iCols > 0 ? archive.mapRawData(qint64(iRowBytes) * iRows, pOwner) : 0;
+    if (pData != 0)
+      {
+        // The largest power of two that divides sizeof(T) is a safe
+        // upper bound for the alignment requirement of T.
+        const std::size_t iAlignment = sizeof(T) & (~sizeof(T) + 1);
+        if (reinterpret_cast<std::size_t>(pData) % iAlignment == 0)
+          {
+            mat = PiiMatrix<T>(iRows, iCols, static_cast<const T*>(pData), pOwner, iRowBytes);
+            return;
+          }
+        // Misaligned (shouldn't happen with aligned archives)
+        mat = PiiMatrix<T>::uninitialized(iRows, iCols);
+        for (int r=0; r<iRows; ++r)
+          std::memcpy(mat[r], static_cast<const char*>(pData) + r*iRowBytes, iRowBytes);
+        return;
+      }
 
-    unsigned int uiBytes = iCols*sizeof(T);
+    mat.resize(iRows, iCols);
     for (int r=0; r<iRows; ++r)
-      archive.readRawData(mat[r], uiBytes);
+      archive.readRawData(mat[r], qint64(iRowBytes));
   }
 
   template <class Archive, class T>
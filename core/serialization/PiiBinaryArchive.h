@@ -18,6 +18,7 @@
 
 #define PII_BINARY_ARCHIVE_ID "Into Bin"
 #define PII_BINARY_ARCHIVE_ID_LEN 8
-#define PII_BINARY_ARCHIVE_VERSION 0
+// Version 1 adds alignment padding before raw data blocks.
+#define PII_BINARY_ARCHIVE_VERSION 1
 
 #endif //_PIIBINARYARCHIVE_H
@@ -14,12 +14,82 @@
  */
 
 #include "PiiBinaryInputArchive.h"
+#include <PiiSharedObject.h>
+#include <QFile>
+#include <climits>
 
 PII_DEFINE_SERIALIZER(PiiBinaryInputArchive);
 PII_DEFINE_FACTORY_MAP(PiiBinaryInputArchive);
 
-PiiBinaryInputArchive::PiiBinaryInputArchive(QIODevice* d) : QDataStream(d)
+// A read-only memory map that is shared by the archive and all data
+// referencing it.
+class PiiBinaryInputArchive::Mapping : public PiiSharedObject
 {
+public:
+  Mapping(const QString& fileName) :
+    file(fileName),
+    pData(0),
+    iSize(0)
+  {
+    if (file.open(QIODevice::ReadOnly))
+      {
+        iSize = file.size();
+        if (iSize > 0)
+          pData = file.map(0, iSize);
+      }
+  }
+
+  ~Mapping()
+  {
+    if (pData != 0)
+      file.unmap(pData);
+  }
+
+  QFile file;
+  uchar* pData;
+  qint64 iSize;
+};
+
+PiiBinaryInputArchive::PiiBinaryInputArchive(QIODevice* d) :
+  QDataStream(d),
+  _pMapping(0)
+{
+  readHeader();
+}
+
+PiiBinaryInputArchive::PiiBinaryInputArchive(QIODevice* d, bool memoryMap) :
+  QDataStream(d),
+  _pMapping(0)
+{
+  readHeader();
+  // Only aligned data can be used in place.
+  if (memoryMap && minorVersion() >= 1)
+    map();
+}
+
+PiiBinaryInputArchive::~PiiBinaryInputArchive()
+{
+  if (_pMapping != 0)
+    _pMapping->release();
+}
+
+void PiiBinaryInputArchive::map()
+{
+  QFile* pFile = qobject_cast<QFile*>(device());
+  if (pFile == 0 || pFile->isSequential() || pFile->fileName().isEmpty())
+    return;
+
+  _pMapping = new Mapping(pFile->fileName());
+  if (_pMapping->pData == 0)
+    {
+      _pMapping->release();
+      _pMapping = 0;
+    }
+}
+
+void PiiBinaryInputArchive::readHeader()
+{
+  QIODevice* d = device();
   if (!d->isOpen())
     PII_SERIALIZATION_ERROR(StreamNotOpen);
 
@@ -42,12 +112,48 @@ PiiBinaryInputArchive::PiiBinaryInputArchive(QIODevice* d) : QDataStream(d)
   setMinorVersion(iVersion);
 }
 
-void PiiBinaryInputArchive::readRawData(void* ptr, unsigned int size)
+void PiiBinaryInputArchive::readRawData(void* ptr, qint64 size)
 {
-  if (QDataStream::readRawData(static_cast<char*>(ptr), size) != int(size))
+  // QDataStream reads at most INT_MAX bytes at a time.
+  char* pData = static_cast<char*>(ptr);
+  while (size > 0)
+    {
+      int iChunk = int(qMin(size, qint64(INT_MAX)));
+      if (QDataStream::readRawData(pData, iChunk) != iChunk)
+        PII_SERIALIZATION_ERROR(StreamError);
+      pData += iChunk;
+      size -= iChunk;
+    }
+}
+
+void PiiBinaryInputArchive::alignRawData()
+{
+  // Version 0 has no padding.
+  if (minorVersion() < 1)
+    return;
+
+  quint16 usPadding;
+  QDataStream::operator>> (usPadding);
+  if (usPadding > 0 && skipRawData(usPadding) != int(usPadding))
     PII_SERIALIZATION_ERROR(StreamError);
 }
 
+const void* PiiBinaryInputArchive::mapRawData(qint64 size, PiiSharedObject*& owner)
+{
+  if (_pMapping == 0)
+    return 0;
+
+  QIODevice* d = device();
+  qint64 iPos = d->pos();
+  if (iPos < 0 || size < 0 || iPos + size > _pMapping->iSize)
+    return 0;
+  if (!d->seek(iPos + size))
+    PII_SERIALIZATION_ERROR(StreamError);
+
+  owner = _pMapping;
+  return _pMapping->pData + iPos;
+}
+
 PiiBinaryInputArchive& PiiBinaryInputArchive::operator>> (QString& value)
 {
   // Read the raw bytes
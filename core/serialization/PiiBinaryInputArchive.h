@@ -23,10 +23,27 @@
 #include "PiiArchiveMacros.h"
 #include "PiiBinaryArchive.h"
 
+class PiiSharedObject;
+
 /**
  * PiiBinaryInputArchive reads raw binary data. The binary format is
  * platform-dependent.
  *
+ * If the archive is read from a file, it can optionally be
+ * memory-mapped. In this case, aligned raw data blocks (see
+ * PiiBinaryOutputArchive) will not be copied but referenced directly
+ * in the mapped memory. For example, large [PiiMatrix] objects
+ * become read-only references to the mapped pages. They will be
+ * copied only when modified. The mapping stays alive until all such
+ * references have been destroyed. The file must not be modified
+ * while it is mapped.
+ *
+ * ~~~(c++)
+ * QFile file("model.bin");
+ * file.open(QIODevice::ReadOnly);
+ * PiiGenericBinaryInputArchive ia(&file, true);
+ * ia >> PII_NVP("model", largeSampleSet);
+ * ~~~
  */
 class PII_SERIALIZATION_EXPORT PiiBinaryInputArchive :
   public PiiInputArchive<PiiBinaryInputArchive>,
@@ -43,7 +60,27 @@ public:
    */
   PiiBinaryInputArchive(QIODevice* d);
 
-  void readRawData(void* ptr, unsigned int size);
+  /**
+   * Construct a new binary input archive that reads the given I/O
+   * device. If *memoryMap* is `true` and *d* is a QFile that
+   * contains aligned raw data blocks, the file will be mapped into
+   * memory, and data blocks will be read from the mapped memory
+   * without copying. If the file cannot be mapped, the archive works
+   * as if *memoryMap* was `false`.
+   */
+  PiiBinaryInputArchive(QIODevice* d, bool memoryMap);
+
+  ~PiiBinaryInputArchive();
+
+  void readRawData(void* ptr, qint64 size);
+  void alignRawData();
+  const void* mapRawData(qint64 size, PiiSharedObject*& owner);
+
+  /**
+   * Returns `true` if the archive is memory-mapped, and `false`
+   * otherwise.
+   */
+  bool isMemoryMapped() const { return _pMapping != 0; }
 
   PiiBinaryInputArchive& operator>> (QString& value);
 
@@ -59,6 +96,14 @@ public:
 protected:
   void startDelim() {}
   void endDelim() {}
+
+private:
+  class Mapping;
+
+  void readHeader();
+  void map();
+
+  Mapping* _pMapping;
 };
 
 PII_DECLARE_SERIALIZER(PiiBinaryInputArchive);
@@ -18,8 +18,29 @@
 PII_DEFINE_SERIALIZER(PiiBinaryOutputArchive);
 PII_DEFINE_FACTORY_MAP(PiiBinaryOutputArchive);
 
-PiiBinaryOutputArchive::PiiBinaryOutputArchive(QIODevice* d) : QDataStream(d)
+PiiBinaryOutputArchive::PiiBinaryOutputArchive(QIODevice* d) :
+  QDataStream(d),
+  _uiBlobAlignment(0)
 {
+  writeHeader();
+}
+
+PiiBinaryOutputArchive::PiiBinaryOutputArchive(QIODevice* d, unsigned int blobAlignment) :
+  QDataStream(d),
+  _uiBlobAlignment(0)
+{
+  if (blobAlignment > 0)
+    {
+      _uiBlobAlignment = 1;
+      while (_uiBlobAlignment < blobAlignment && _uiBlobAlignment < 4096)
+        _uiBlobAlignment <<= 1;
+    }
+  writeHeader();
+}
+
+void PiiBinaryOutputArchive::writeHeader()
+{
+  QIODevice* d = device();
   if (!d->isOpen())
     PII_SERIALIZATION_ERROR(StreamNotOpen);
 
@@ -27,9 +48,32 @@ PiiBinaryOutputArchive::PiiBinaryOutputArchive(QIODevice* d) : QDataStream(d)
   if (d->write(PII_BINARY_ARCHIVE_ID, PII_BINARY_ARCHIVE_ID_LEN) != PII_BINARY_ARCHIVE_ID_LEN)
     PII_SERIALIZATION_ERROR(StreamError);
 
-  // Store archive version
+  // Store archive version. Version 0 has no alignment padding, and
+  // is used unless alignment was requested to keep the output
+  // readable by old versions.
   *this << PII_ARCHIVE_VERSION;
-  *this << PII_BINARY_ARCHIVE_VERSION;
+  *this << (_uiBlobAlignment != 0 ? PII_BINARY_ARCHIVE_VERSION : 0);
+}
+
+void PiiBinaryOutputArchive::alignRawData()
+{
+  if (_uiBlobAlignment == 0)
+    return;
+
+  // The amount of padding is stored so that the reader doesn't need
+  // to know the alignment or even the position in the stream.
+  quint16 usPadding = 0;
+  if (!device()->isSequential())
+    {
+      qint64 iPos = device()->pos() + qint64(sizeof(usPadding));
+      usPadding = quint16((_uiBlobAlignment - iPos % _uiBlobAlignment) % _uiBlobAlignment);
+    }
+  QDataStream::operator<< (usPadding);
+  if (usPadding > 0)
+    {
+      static const char zeros[4096] = { 0 };
+      writeRawData(zeros, usPadding);
+    }
 }
 
 void PiiBinaryOutputArchive::writeRawData(const void* ptr, unsigned int size)
@@ -27,6 +27,19 @@
  * Binary output archive stores data in a raw binary format. The
  * binary format is platform-dependent.
  *
+ * By default, data is written without any padding. If a *blob
+ * alignment* is given in the constructor, large blocks of raw data
+ * (such as the contents of [PiiMatrix] objects) will be aligned in
+ * the output file. This makes it possible to use the data in place
+ * when the archive is read through a memory map (see
+ * PiiBinaryInputArchive).
+ *
+ * ~~~(c++)
+ * QFile file("model.bin");
+ * file.open(QIODevice::WriteOnly);
+ * PiiGenericBinaryOutputArchive oa(&file, 64u);
+ * oa << PII_NVP("model", largeSampleSet);
+ * ~~~
  */
 class PII_SERIALIZATION_EXPORT PiiBinaryOutputArchive :
   public PiiOutputArchive<PiiBinaryOutputArchive>,
@@ -43,7 +56,24 @@ public:
    */
   PiiBinaryOutputArchive(QIODevice* d);
 
+  /**
+   * Construct a new binary output archive that aligns raw data
+   * blocks to multiples of *blobAlignment* bytes in the output file.
+   * The alignment will be rounded up to the closest power of two and
+   * limited to 4096. Zero means no alignment, and produces a file
+   * that can be read with older versions of PiiBinaryInputArchive.
+   * The alignment is only effective on random-access devices.
+   */
+  PiiBinaryOutputArchive(QIODevice* d, unsigned int blobAlignment);
+
   void writeRawData(const void* ptr, unsigned int size);
+  void alignRawData();
+
+  /**
+   * Returns the alignment of raw data blocks in bytes, or zero if
+   * data is not aligned.
+   */
+  unsigned int blobAlignment() const { return _uiBlobAlignment; }
 
   PiiBinaryOutputArchive& operator<< (const QString& value);
   PiiBinaryOutputArchive& operator<< (const char* value);
@@ -56,6 +86,11 @@ public:
 protected:
   void startDelim() {}
   void endDelim() {}
+
+private:
+  void writeHeader();
+
+  unsigned int _uiBlobAlignment;
 };
 
 PII_DECLARE_SERIALIZER(PiiBinaryOutputArchive);
@@ -116,20 +116,27 @@ namespace PiiSerialization
   }
 }
 
+template <class Archive> PiiSerializationFactory* PiiSerializationFactory::findFactory(const char* className)
+{
+  // Try archive-specific factory first
+  PiiSerializationFactory* pFactory = factory<Archive>(className);
+  // If this is already the default factory, fail. Otherwise try the
+  // default factory.
+  if (pFactory == 0 && !Pii::IsSame<Archive, PiiSerialization::Void>::boolValue)
+    pFactory = factory<PiiSerialization::Void>(className);
+  return pFactory;
+}
+
 template <class T, class Archive> T* PiiSerializationFactory::create(const char* className, Archive& archive)
 {
   if (PiiSerialization::isDynamicType((T*)0))
     {
-      // Try archive-specific factory first
-      PiiSerializationFactory* pFactory = factory<Archive>(className);
+      PiiSerializationFactory* pFactory = findFactory<Archive>(className);
+      // The class may live in a library that hasn't been loaded yet.
+      if (pFactory == 0 && loadClass(className))
+        pFactory = findFactory<Archive>(className);
       if (pFactory == 0)
-        {
-          // If this is already the default factory, fail
-          if (Pii::IsSame<Archive, PiiSerialization::Void>::boolValue ||
-              // Otherwise try the default factory
-              (pFactory = factory<PiiSerialization::Void>(className)) == 0)
-            return 0;
-        }
+        return 0;
       return reinterpret_cast<T*>(pFactory->create(&archive));
     }
   return create<T>(archive);
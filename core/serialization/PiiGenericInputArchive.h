@@ -53,7 +53,9 @@ public:
   virtual PiiGenericInputArchive& operator>>(bool& value) = 0;
   virtual PiiGenericInputArchive& operator>>(char*& value) = 0;
   virtual PiiGenericInputArchive& operator>>(QString& value) = 0;
-  virtual void readRawData(void* ptr, unsigned int size) = 0;
+  virtual void readRawData(void* ptr, qint64 size) = 0;
+  virtual void alignRawData() = 0;
+  virtual const void* mapRawData(qint64 size, PiiSharedObject*& owner) = 0;
 
   PII_DEFAULT_INPUT_OPERATORS(PiiGenericInputArchive)
 private:
@@ -77,6 +79,7 @@ template <class Archive> class PiiGenericInputArchive::Impl :
 {
 public:
   Impl(QIODevice* d) : Archive(d) {}
+  template <class Param> Impl(QIODevice* d, Param param) : Archive(d, param) {}
 
   int majorVersion() const { return Archive::majorVersion(); }
   int minorVersion() const { return Archive::minorVersion(); }
@@ -99,7 +102,9 @@ public:
   PII_STREAM_OP(char*&)
   PII_STREAM_OP(QString&)
 #undef PII_STREAM_OP
-  virtual void readRawData(void* ptr, unsigned int size) { Archive::readRawData(ptr, size); }
+  virtual void readRawData(void* ptr, qint64 size) { Archive::readRawData(ptr, size); }
+  virtual void alignRawData() { Archive::alignRawData(); }
+  virtual const void* mapRawData(qint64 size, PiiSharedObject*& owner) { return Archive::mapRawData(size, owner); }
 
   PII_DEFAULT_INPUT_OPERATORS(PiiGenericInputArchive)
 
@@ -28,6 +28,8 @@
 #include "PiiSmartPtr.h"
 #include "PiiDynamicTypeFunctions.h"
 
+class PiiSharedObject;
+
 /// @internal
 struct PiiArchivePointerInfo
 {
@@ -126,13 +128,38 @@ public:
     if (size != 0)
       {
         PiiSmartPtr<T[]> tmpPtr(new T[size]);
-        self()->readRawData(tmpPtr, size*sizeof(T));
+        self()->readRawData(tmpPtr, qint64(size)*sizeof(T));
         ptr = tmpPtr.release();
       }
     else
       ptr = 0;
   }
 
+  /**
+   * Skips the alignment padding written by
+   * PiiOutputArchive::alignRawData(). The default implementation does
+   * nothing.
+   */
+  void alignRawData() {}
+
+  /**
+   * Returns a pointer to the next *size* bytes of raw data in memory
+   * and skips them, if the archive is able to provide the data
+   * without copying (e.g. from a memory-mapped file). The memory is
+   * read-only and owned by *owner*, which must be
+   * [reserved](PiiSharedObject::reserve()) by the caller for as long
+   * as the data is in use. Returns 0 and leaves the archive untouched
+   * if the data is not available. In this case, the data must be
+   * read with `readRawData()`. The default implementation always
+   * returns 0.
+   */
+  const void* mapRawData(qint64 size, PiiSharedObject*& owner)
+  {
+    Q_UNUSED(size);
+    Q_UNUSED(owner);
+    return 0;
+  }
+
   /**
    * Analogous to PiiOutputArchive::operator<<(T&). This function
    * calls Archive::load(value).
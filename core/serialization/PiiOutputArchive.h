@@ -78,6 +78,15 @@ public:
       self()->writeRawData(ptr, sizeof(T)*size);
   }
 
+  /**
+   * Prepares the archive for a large block of raw data. Archives
+   * that support aligned data blocks pad the output so that the raw
+   * data written next starts at an aligned position. The default
+   * implementation does nothing. Each call must be matched by a call
+   * to PiiInputArchive::alignRawData() when reading.
+   */
+  void alignRawData() {}
+
   /**
    * This operator is defined for both input and output archives,
    * which makes it possible to serialize and deserialize data with a
@@ -17,6 +17,28 @@
 
 PII_DEFINE_FACTORY_MAP(PiiSerialization::Void);
 
+static PiiSerializationFactory::ClassLoader* classLoaderPtr()
+{
+  static PiiSerializationFactory::ClassLoader pLoader = 0;
+  return &pLoader;
+}
+
+void PiiSerializationFactory::setClassLoader(ClassLoader loader)
+{
+  *classLoaderPtr() = loader;
+}
+
+PiiSerializationFactory::ClassLoader PiiSerializationFactory::classLoader()
+{
+  return *classLoaderPtr();
+}
+
+bool PiiSerializationFactory::loadClass(const char* className)
+{
+  ClassLoader pLoader = *classLoaderPtr();
+  return pLoader != 0 && (*pLoader)(className);
+}
+
 QList<const char*> PiiSerializationFactory::keys(MapType* map)
 {
   QList<const char*> lstResult;
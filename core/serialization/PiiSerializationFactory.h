@@ -290,6 +290,34 @@ public:
     return keys(map<Archive>());
   }
 
+  /**
+   * A function that makes the named class available. The function
+   * should return `true` if it did something that may have registered
+   * a factory for *className* (such as loading a shared library), and
+   * `false` otherwise.
+   */
+  typedef bool (*ClassLoader)(const char* className);
+
+  /**
+   * Sets the function that will be called when no factory can be
+   * found for a class name. This makes it possible to defer loading
+   * shared libraries until their classes are actually needed. If
+   * *loader* is 0 (the default), missing classes fail immediately.
+   */
+  static void setClassLoader(ClassLoader loader);
+  /**
+   * Returns the current class loader.
+   */
+  static ClassLoader classLoader();
+
+  /**
+   * Calls the current class loader to make *className* available.
+   * Returns `false` if there is no class loader or if the loader
+   * failed, `true` otherwise. A successful call doesn't guarantee
+   * that a factory for *className* exists afterwards.
+   */
+  static bool loadClass(const char* className);
+
   /// @internal
   template <class T, class Archive> static T* create(const char* className, Archive& archive);
   // NOTE: the implementation of this function is in
@@ -348,6 +376,7 @@ protected:
 
 private:
   static QList<const char*> keys(MapType* map);
+  template <class Archive> static PiiSerializationFactory* findFactory(const char* className);
 };
 
 template <class Archive> PiiSerializationFactory::MapType* PiiSerializationFactory::map()
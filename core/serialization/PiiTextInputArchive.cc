@@ -53,14 +53,14 @@ PiiTextInputArchive::PiiTextInputArchive(QIODevice* d) : QTextStream(d)
   setMinorVersion(iVersion);
 }
 
-void PiiTextInputArchive::readRawData(void* ptr, unsigned int size)
+void PiiTextInputArchive::readRawData(void* ptr, qint64 size)
 {
   startDelim();
   // Base64 encoded data has no spaces.
   QString strEncoded;
   QTextStream::operator>>(strEncoded);
   QByteArray decoded(QByteArray::fromBase64(strEncoded.toLatin1()));
-  if (int(size) != decoded.size())
+  if (size != qint64(decoded.size()))
     PII_SERIALIZATION_ERROR(InvalidDataFormat);
   std::memcpy(ptr, decoded.constData(), size);
 }
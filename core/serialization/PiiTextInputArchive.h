@@ -58,7 +58,7 @@ public:
    * Read raw binary data from the text archive. The data is base64
    * decoded after reading.
    */
-  void readRawData(void* ptr, unsigned int size);
+  void readRawData(void* ptr, qint64 size);
 
   PiiTextInputArchive& operator>> (QString& value);
 
@@ -133,4 +133,12 @@ namespace Pii
   template <class T> inline T stringTo(const QString& number, bool* ok = 0) { return number.to<T>(ok); }
 }
 
+#ifdef PII_CXX11
+// Makes QString usable as a QHash key.
+namespace std
+{
+  template <> struct hash<QString> : hash<std::string> {};
+}
+#endif
+
 #endif //_QSTRING_H
@@ -0,0 +1,403 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "PiiImagePyramid.h"
+
+#include <PiiParallel.h>
+#include <PiiSynchronized.h>
+
+#include <QCache>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPainter>
+#include <QHash>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+
+namespace
+{
+  const int iTileSize = 256;
+
+  // Tiles are identified by (level, row, column), packed into a
+  // single key.
+  inline quint64 tileKey(int level, int column, int row)
+  {
+    return quint64(level) << 48 | quint64(row) << 24 | quint64(column);
+  }
+  inline int keyLevel(quint64 key) { return int(key >> 48); }
+  inline int keyRow(quint64 key) { return int((key >> 24) & 0xffffff); }
+  inline int keyColumn(quint64 key) { return int(key & 0xffffff); }
+
+  // The size of the image at the given level. Each level rounds up.
+  inline int levelLength(int length, int level)
+  {
+    return (length + (1 << level) - 1) >> level;
+  }
+
+  // Area of a tile in the coordinates of its own level.
+  inline QRect levelTileRect(const QSize& imageSize, int level, int column, int row)
+  {
+    return QRect(column * iTileSize, row * iTileSize, iTileSize, iTileSize) &
+      QRect(0, 0, levelLength(imageSize.width(), level), levelLength(imageSize.height(), level));
+  }
+
+  struct DrawCommand
+  {
+    DrawCommand() {}
+    DrawCommand(const QImage& img, const QRectF& tgt, const QRectF& src) :
+      image(img), target(tgt), source(src)
+    {}
+    QImage image;
+    QRectF target, source;
+  };
+}
+
+class PiiImagePyramid::Worker : public QThread
+{
+public:
+  Worker(PiiImagePyramid* pyramid) : _pPyramid(pyramid) {}
+
+protected:
+  void run() { _pPyramid->generateTiles(); }
+
+private:
+  PiiImagePyramid* _pPyramid;
+};
+
+class PiiImagePyramid::Data
+{
+public:
+  Data() :
+    iLevelCount(0),
+    iGeneration(0),
+    iThreadCount(0),
+    bRunning(false),
+    cache(262144)
+  {}
+
+  QImage image;
+  int iLevelCount;
+  // Incremented whenever the image changes. Tiles created for an old
+  // generation are thrown away.
+  int iGeneration;
+  int iThreadCount;
+  bool bRunning;
+
+  QMutex mutex;
+  QWaitCondition queueCondition;
+  QCache<quint64, QImage> cache;
+  QList<quint64> lstQueue;
+  // Tiles being generated, mapped to the generation they are
+  // generated for. A tile of an old generation doesn't prevent
+  // queuing the same tile for the current image.
+  QHash<quint64,int> hashInProgress;
+  QList<Worker*> lstWorkers;
+};
+
+PiiImagePyramid::PiiImagePyramid(QObject* parent) :
+  QObject(parent),
+  d(new Data)
+{
+}
+
+PiiImagePyramid::~PiiImagePyramid()
+{
+  stopWorkers();
+  delete d;
+}
+
+void PiiImagePyramid::setImage(const QImage& image)
+{
+  QMutexLocker lock(&d->mutex);
+  if (image.cacheKey() == d->image.cacheKey())
+    return;
+
+  d->image = image;
+  ++d->iGeneration;
+  d->cache.clear();
+  d->lstQueue.clear();
+
+  d->iLevelCount = 0;
+  if (!image.isNull())
+    {
+      int iLength = qMax(image.width(), image.height());
+      do
+        ++d->iLevelCount;
+      while (levelLength(iLength, d->iLevelCount - 1) > iTileSize);
+    }
+}
+
+QImage PiiImagePyramid::image() const
+{
+  QMutexLocker lock(&d->mutex);
+  return d->image;
+}
+
+int PiiImagePyramid::levelCount() const
+{
+  QMutexLocker lock(&d->mutex);
+  return d->iLevelCount;
+}
+
+int PiiImagePyramid::tileSize() { return iTileSize; }
+
+int PiiImagePyramid::levelForScale(double scale) const
+{
+  const int iMaxLevel = qMax(0, levelCount() - 1);
+  int iLevel = 0;
+  // Go up as long as the next level still has at least the displayed
+  // resolution.
+  while (iLevel < iMaxLevel && scale * (2 << iLevel) <= 1.0)
+    ++iLevel;
+  return iLevel;
+}
+
+QRect PiiImagePyramid::tileArea(int level, int column, int row) const
+{
+  QMutexLocker lock(&d->mutex);
+  QRect rect = levelTileRect(d->image.size(), level, column, row);
+  return QRect(rect.x() << level, rect.y() << level,
+               rect.width() << level, rect.height() << level) & d->image.rect();
+}
+
+bool PiiImagePyramid::tile(int level, int column, int row, QImage* tile)
+{
+  QMutexLocker lock(&d->mutex);
+  quint64 key = tileKey(level, column, row);
+  QImage* pTile = d->cache.object(key);
+  if (pTile != 0)
+    {
+      *tile = *pTile;
+      return true;
+    }
+  if (d->hashInProgress.value(key, -1) != d->iGeneration && !d->lstQueue.contains(key))
+    {
+      d->lstQueue.append(key);
+      if (d->lstWorkers.isEmpty())
+        {
+          d->bRunning = true;
+          for (int i=Pii::threadCount(d->iThreadCount); i--; )
+            {
+              d->lstWorkers << new Worker(this);
+              d->lstWorkers.last()->start(QThread::LowPriority);
+            }
+        }
+      d->queueCondition.wakeOne();
+    }
+  return false;
+}
+
+void PiiImagePyramid::paint(QPainter* painter, const QPointF& origin, double xScale, double yScale,
+                            const QRect& exposedArea)
+{
+  if (xScale <= 0 || yScale <= 0)
+    return;
+
+  const int iLevel = levelForScale(qMax(xScale, yScale));
+  QList<DrawCommand> lstCommands;
+  QList<quint64> lstMissing;
+  QRectF imageTarget;
+
+  synchronized (d->mutex)
+    {
+      if (d->image.isNull())
+        return;
+      const QSize imageSize(d->image.size());
+      imageTarget = QRectF(origin.x(), origin.y(),
+                           imageSize.width() * xScale, imageSize.height() * yScale);
+
+      // Exposed area in source image coordinates
+      QRectF exposedSource = QRectF((exposedArea.left() - origin.x()) / xScale,
+                                    (exposedArea.top() - origin.y()) / yScale,
+                                    exposedArea.width() / xScale,
+                                    exposedArea.height() / yScale) & QRectF(d->image.rect());
+      if (exposedSource.isEmpty())
+        return;
+
+      const int iTileSpan = iTileSize << iLevel;
+      const int iFirstColumn = int(exposedSource.left()) / iTileSpan,
+        iLastColumn = int(qMin(exposedSource.right(), imageSize.width() - 1.0)) / iTileSpan,
+        iFirstRow = int(exposedSource.top()) / iTileSpan,
+        iLastRow = int(qMin(exposedSource.bottom(), imageSize.height() - 1.0)) / iTileSpan;
+
+      for (int r=iFirstRow; r<=iLastRow; ++r)
+        for (int c=iFirstColumn; c<=iLastColumn; ++c)
+          {
+            QRect tileRect = levelTileRect(imageSize, iLevel, c, r);
+            const double dLevelScale = 1 << iLevel;
+            QRectF target(origin.x() + tileRect.x() * dLevelScale * xScale,
+                          origin.y() + tileRect.y() * dLevelScale * yScale,
+                          tileRect.width() * dLevelScale * xScale,
+                          tileRect.height() * dLevelScale * yScale);
+            quint64 key = tileKey(iLevel, c, r);
+            QImage* pTile = d->cache.object(key);
+            if (pTile != 0)
+              {
+                lstCommands << DrawCommand(*pTile, target, QRectF(pTile->rect()));
+                continue;
+              }
+            lstMissing << key;
+
+            // Use a coarser tile as a placeholder, if one is available.
+            for (int iCoarse = iLevel + 1; iCoarse < d->iLevelCount; ++iCoarse)
+              {
+                const int iShift = iCoarse - iLevel;
+                QImage* pCoarse = d->cache.object(tileKey(iCoarse, c >> iShift, r >> iShift));
+                if (pCoarse != 0)
+                  {
+                    const double dDivisor = 1 << iShift;
+                    QRectF source(tileRect.x() / dDivisor - (c >> iShift) * iTileSize,
+                                  tileRect.y() / dDivisor - (r >> iShift) * iTileSize,
+                                  tileRect.width() / dDivisor,
+                                  tileRect.height() / dDivisor);
+                    lstCommands << DrawCommand(*pCoarse, target, source);
+                    break;
+                  }
+              }
+          }
+
+      // Tiles that are no longer visible needn't be generated.
+      d->lstQueue.clear();
+    }
+
+  for (int i=0; i<lstMissing.size(); ++i)
+    {
+      QImage dummy;
+      tile(keyLevel(lstMissing[i]), keyColumn(lstMissing[i]), keyRow(lstMissing[i]), &dummy);
+    }
+
+  painter->save();
+  painter->setClipRect(imageTarget & QRectF(exposedArea), Qt::IntersectClip);
+  painter->setRenderHint(QPainter::SmoothPixmapTransform, iLevel > 0 || qMax(xScale, yScale) < 1.0);
+  for (int i=0; i<lstCommands.size(); ++i)
+    painter->drawImage(lstCommands[i].target, lstCommands[i].image, lstCommands[i].source);
+  painter->restore();
+}
+
+void PiiImagePyramid::generateTiles()
+{
+  for (;;)
+    {
+      QMutexLocker lock(&d->mutex);
+      while (d->bRunning && d->lstQueue.isEmpty())
+        d->queueCondition.wait(&d->mutex);
+      if (!d->bRunning)
+        return;
+
+      quint64 key = d->lstQueue.takeFirst();
+      QImage source(d->image);
+      int iGeneration = d->iGeneration;
+      d->hashInProgress.insert(key, iGeneration);
+      lock.unlock();
+
+      QImage tile(createTile(source, key, iGeneration));
+
+      lock.relock();
+      // If the image was changed meanwhile, another worker may be
+      // generating the same tile for the new image.
+      if (d->hashInProgress.value(key, -1) == iGeneration)
+        d->hashInProgress.remove(key);
+      lock.unlock();
+
+      if (!tile.isNull())
+        emit tileReady();
+    }
+}
+
+QImage PiiImagePyramid::createTile(const QImage& source, quint64 key, int generation)
+{
+  synchronized (d->mutex)
+    {
+      if (generation != d->iGeneration)
+        return QImage();
+      QImage* pTile = d->cache.object(key);
+      if (pTile != 0)
+        return *pTile;
+    }
+
+  const int iLevel = keyLevel(key), iColumn = keyColumn(key), iRow = keyRow(key);
+  const QImage::Format format = source.hasAlphaChannel() ?
+    QImage::Format_ARGB32_Premultiplied : QImage::Format_RGB32;
+  QRect tileRect = levelTileRect(source.size(), iLevel, iColumn, iRow);
+  QImage tile;
+
+  if (iLevel == 0)
+    tile = source.copy(tileRect).convertToFormat(format);
+  else
+    {
+      // Downsample the four tiles on the finer level.
+      tile = QImage(tileRect.size(), format);
+      tile.fill(0);
+      QPainter p(&tile);
+      p.setRenderHint(QPainter::SmoothPixmapTransform);
+      p.setCompositionMode(QPainter::CompositionMode_Source);
+      QRect childLevelRect(0, 0,
+                           levelLength(source.width(), iLevel - 1),
+                           levelLength(source.height(), iLevel - 1));
+      for (int r=0; r<2; ++r)
+        for (int c=0; c<2; ++c)
+          {
+            const int iChildColumn = iColumn * 2 + c, iChildRow = iRow * 2 + r;
+            if (!childLevelRect.contains(iChildColumn * iTileSize, iChildRow * iTileSize))
+              continue;
+            QImage child(createTile(source, tileKey(iLevel - 1, iChildColumn, iChildRow), generation));
+            if (child.isNull())
+              return QImage();
+            p.drawImage(QRectF(c * iTileSize / 2, r * iTileSize / 2,
+                               child.width() / 2.0, child.height() / 2.0),
+                        child);
+          }
+    }
+
+  synchronized (d->mutex)
+    {
+      if (generation != d->iGeneration)
+        return QImage();
+      d->cache.insert(key, new QImage(tile), qMax(1, tile.byteCount() / 1024));
+    }
+  return tile;
+}
+
+void PiiImagePyramid::stopWorkers()
+{
+  synchronized (d->mutex)
+    {
+      d->bRunning = false;
+      d->queueCondition.wakeAll();
+    }
+  for (int i=0; i<d->lstWorkers.size(); ++i)
+    {
+      d->lstWorkers[i]->wait();
+      delete d->lstWorkers[i];
+    }
+  d->lstWorkers.clear();
+}
+
+void PiiImagePyramid::setCacheSize(int cacheSize)
+{
+  QMutexLocker lock(&d->mutex);
+  d->cache.setMaxCost(qMax(1, cacheSize));
+}
+
+int PiiImagePyramid::cacheSize() const
+{
+  QMutexLocker lock(&d->mutex);
+  return d->cache.maxCost();
+}
+
+void PiiImagePyramid::setThreadCount(int threadCount) { d->iThreadCount = threadCount; }
+int PiiImagePyramid::threadCount() const { return d->iThreadCount; }
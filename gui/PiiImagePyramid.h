@@ -0,0 +1,169 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIIIMAGEPYRAMID_H
+#define _PIIIMAGEPYRAMID_H
+
+#include <QObject>
+#include <QImage>
+#include <QRect>
+
+#include "PiiGui.h"
+
+class QPainter;
+
+/**
+ * A tiled, multi-resolution representation of a large image.
+ * PiiImagePyramid splits an image into 256-by-256 tiles at a number
+ * of resolution levels. Level zero is the original image, and each
+ * successive level halves the resolution until the whole image fits
+ * into a single tile.
+ *
+ * Tiles are generated on demand by a pool of worker threads and
+ * stored in a least-recently-used cache. The [paint()] function
+ * never waits for tiles to be generated. Instead, it draws the tiles
+ * that are already available, fills the missing ones from coarser
+ * levels, if possible, and requests the missing tiles to be
+ * generated. Once a requested tile is ready, [tileReady()] will be
+ * emitted, and the caller should repaint.
+ *
+ * ~~~(c++)
+ * PiiImagePyramid* pPyramid = new PiiImagePyramid(this);
+ * connect(pPyramid, SIGNAL(tileReady()), this, SLOT(update()));
+ * pPyramid->setImage(QImage("huge.png"));
+ *
+ * // In paintEvent()
+ * QPainter p(this);
+ * pPyramid->paint(&p, QPointF(0, 0), 0.1, 0.1, event->rect());
+ * ~~~
+ */
+class PII_GUI_EXPORT PiiImagePyramid : public QObject
+{
+  Q_OBJECT
+
+public:
+  PiiImagePyramid(QObject* parent = 0);
+  ~PiiImagePyramid();
+
+  /**
+   * Sets the source image. All cached tiles will be discarded unless
+   * *image* is a shallow copy of the current image. The image will be
+   * shallow-copied. If the caller modifies the image afterwards, the
+   * pyramid will retain the old data until setImage() is called
+   * again.
+   */
+  void setImage(const QImage& image);
+  /**
+   * Returns the source image.
+   */
+  QImage image() const;
+
+  /**
+   * Returns the number of resolution levels. An empty image has no
+   * levels.
+   */
+  int levelCount() const;
+
+  /**
+   * Returns the width and height of a (full) tile in pixels.
+   */
+  static int tileSize();
+
+  /**
+   * Returns the resolution level that should be used for drawing the
+   * image at the given *scale*. The level is the coarsest one whose
+   * resolution is still at least the displayed resolution. The
+   * returned value is in [0, levelCount()-1].
+   */
+  int levelForScale(double scale) const;
+
+  /**
+   * Returns the area the tile at (*column*, *row*) on the given
+   * *level* covers, in the coordinates of the source image.
+   */
+  QRect tileArea(int level, int column, int row) const;
+
+  /**
+   * Fetches the tile at (*column*, *row*) on the given *level*. If
+   * the tile is in the cache, it will be stored to *tile*, and `true`
+   * will be returned. Otherwise, the tile will be queued for
+   * generation and `false` returned. This function never blocks
+   * while tiles are being generated.
+   */
+  bool tile(int level, int column, int row, QImage* tile);
+
+  /**
+   * Paints the visible part of the image.
+   *
+   * @param painter the painter to draw with
+   *
+   * @param origin the location of the top left corner of the source
+   * image in the painter's coordinates
+   *
+   * @param xScale horizontal scaling factor
+   *
+   * @param yScale vertical scaling factor
+   *
+   * @param exposedArea the area to be painted, in the painter's
+   * coordinates
+   *
+   * Any previously queued tiles that are not needed for painting
+   * *exposedArea* are removed from the queue.
+   */
+  void paint(QPainter* painter, const QPointF& origin, double xScale, double yScale,
+             const QRect& exposedArea);
+
+  /**
+   * Sets the maximum amount of memory the tile cache may use, in
+   * kilobytes. The default is 262144 (256 MB).
+   */
+  void setCacheSize(int cacheSize);
+  /**
+   * Returns the maximum size of the tile cache in kilobytes.
+   */
+  int cacheSize() const;
+
+  /**
+   * Sets the number of worker threads that generate tiles. Zero means
+   * the number of processor cores. The default is zero. The workers
+   * are started when the first tile is requested. Changing the value
+   * afterwards has no effect.
+   */
+  void setThreadCount(int threadCount);
+  /**
+   * Returns the number of worker threads.
+   */
+  int threadCount() const;
+
+signals:
+  /**
+   * Emitted (from a worker thread) whenever a requested tile has been
+   * generated.
+   */
+  void tileReady();
+
+private:
+  class Worker;
+  friend class Worker;
+  void generateTiles();
+  QImage createTile(const QImage& source, quint64 key, int generation);
+  void stopWorkers();
+
+  class Data;
+  Data* d;
+  PII_DISABLE_COPY(PiiImagePyramid);
+};
+
+#endif //_PIIIMAGEPYRAMID_H
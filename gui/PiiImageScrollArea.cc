@@ -329,7 +329,8 @@ template <class T> void PiiImageScrollArea::view(const PiiMatrix<T>& image, int
 {
   if (!image.isEmpty())
     {
-      QImage *pImage = Pii::createQImage(image);
+      // Wraps gray and 32-bit color images without copying.
+      QImage *pImage = new QImage(Pii::toQImage(image));
       d->pImageViewport->setImage(pImage, layer);
       delete d->lstImages[layer];
       d->lstImages[layer] = pImage;
@@ -15,6 +15,7 @@
 
 #include "PiiImageViewport.h"
 #include "PiiImageOverlay.h"
+#include "PiiImagePyramid.h"
 #include <PiiMath.h>
 
 #include <QAction>
@@ -37,6 +38,7 @@ PiiImageViewport::Data::Data() :
   pUpdater(0),
   pAdapter(0),
   selectionMode(Area),
+  bTiledRendering(false),
   bDrawGrid(false),
   dHLineStart(0),
   dHLineStep(0),
@@ -57,6 +59,11 @@ PiiImageViewport::Data::~Data()
   qDeleteAll(lstLayers);
 }
 
+PiiImageViewport::Layer::~Layer()
+{
+  delete pPyramid;
+}
+
 PiiImageViewport::PiiImageViewport(QImage* pImage, QWidget *parent) :
   QWidget(parent),
   d(new Data)
@@ -130,6 +137,41 @@ void PiiImageViewport::setDrawGrid(bool drawGrid)
 
 bool PiiImageViewport::drawGrid() const { return d->bDrawGrid; }
 
+void PiiImageViewport::setTiledRendering(bool tiledRendering)
+{
+  d->bTiledRendering = tiledRendering;
+  updatePyramids();
+  if (!tiledRendering)
+    updateImage();
+  update();
+}
+
+bool PiiImageViewport::tiledRendering() const { return d->bTiledRendering; }
+
+void PiiImageViewport::updatePyramids()
+{
+  for (int i=0; i<d->lstLayers.size(); ++i)
+    {
+      Layer* pLayer = d->lstLayers[i];
+      if (d->bTiledRendering)
+        {
+          if (pLayer->pPyramid == 0)
+            {
+              pLayer->pPyramid = new PiiImagePyramid;
+              connect(pLayer->pPyramid, SIGNAL(tileReady()), this, SLOT(update()), Qt::QueuedConnection);
+            }
+          // Cheap if the image hasn't changed.
+          synchronized (d->imageLock)
+            pLayer->pPyramid->setImage(*pLayer->pImage);
+        }
+      else
+        {
+          delete pLayer->pPyramid;
+          pLayer->pPyramid = 0;
+        }
+    }
+}
+
 void PiiImageViewport::updateZoomFactors()
 {
   if (d->dAspectRatio >= 1)
@@ -674,8 +716,6 @@ void PiiImageViewport::paintEvent(QPaintEvent* event)
 {
   //QWidget::paintEvent(event);
 
-  d->imageLock.lock();
-
   QPainter p(this);
   QRect paintRect = event->rect();
 
@@ -683,6 +723,19 @@ void PiiImageViewport::paintEvent(QPaintEvent* event)
   // portions in the image.
   p.fillRect(paintRect, palette().brush(backgroundRole()));
 
+  // In tiled mode, whatever is ready will be composited right away.
+  if (d->bTiledRendering)
+    {
+      if (!d->imageRect.isNull())
+        {
+          paintTiles(&p, paintRect);
+          paintOverlays(&p);
+        }
+      return;
+    }
+
+  d->imageLock.lock();
+
   // Draw image only if there is one
   if (!d->prescaledImage.isNull())
     {
@@ -715,107 +768,126 @@ void PiiImageViewport::paintEvent(QPaintEvent* event)
 
       d->imageLock.unlock();
 
-      QRect tempWindow = p.window();
-      p.setWindow(d->visibleArea);
-      // Draw the overlays.
-      for (int i = 0; i < d->overlays.size(); ++i)
-        // Some optimization. Draw the overlay only, if it is in the
-        // visible area.
-        if (d->overlays.at(i)->enabled() && d->overlays.at(i)->intersects(d->visibleArea))
-          d->overlays.at(i)->paint((&p), d->bShowOverlayColoring);
-
-      p.setWindow(tempWindow);
+      paintOverlays(&p);
+    }
+  else
+    d->imageLock.unlock();
+}
 
-      // Draw the selection rectangle with dashed line and color white/black
-      if (!d->selectionArea.isNull())
+void PiiImageViewport::paintTiles(QPainter* p, const QRect& paintRect)
+{
+  // Location of the image origin in widget coordinates
+  QPointF origin(-d->visibleArea.x() * d->dXScale, -d->visibleArea.y() * d->dYScale);
+  for (int i=0; i<d->lstLayers.size(); ++i)
+    {
+      Layer* pLayer = d->lstLayers[i];
+      if (pLayer->bVisible && pLayer->pPyramid != 0)
         {
-          p.setPen(Qt::NoPen);
-          p.setBrush(QColor(0,0,255,10));
-          p.drawRect(d->selectionArea);
+          p->setOpacity(pLayer->dOpacity);
+          pLayer->pPyramid->paint(p, origin, d->dXScale, d->dYScale, paintRect);
+        }
+    }
+  p->setOpacity(1.0);
+}
 
-          QPen pen(QColor(0,0,0));
-          p.setPen(pen);
-          p.setBrush(Qt::NoBrush);
-          p.drawRect(d->selectionArea);
+void PiiImageViewport::paintOverlays(QPainter* p)
+{
+  QRect tempWindow = p->window();
+  p->setWindow(d->visibleArea);
+  // Draw the overlays.
+  for (int i = 0; i < d->overlays.size(); ++i)
+    // Some optimization. Draw the overlay only, if it is in the
+    // visible area.
+    if (d->overlays.at(i)->enabled() && d->overlays.at(i)->intersects(d->visibleArea))
+      d->overlays.at(i)->paint(p, d->bShowOverlayColoring);
 
-          if (d->selectionMode == Area)
-            p.drawLine(d->mousePressPoint, d->mouseCurrPoint);
+  p->setWindow(tempWindow);
 
-          pen.setColor(QColor(255,255,255));
-          pen.setStyle(Qt::DashLine);
-          p.setPen(pen);
-          p.drawRect(d->selectionArea);
-          if (d->selectionMode == Area)
-            p.drawLine(d->mousePressPoint, d->mouseCurrPoint);
-        }
+  // Draw the selection rectangle with dashed line and color white/black
+  if (!d->selectionArea.isNull())
+    {
+      p->setPen(Qt::NoPen);
+      p->setBrush(QColor(0,0,255,10));
+      p->drawRect(d->selectionArea);
+
+      QPen pen(QColor(0,0,0));
+      p->setPen(pen);
+      p->setBrush(Qt::NoBrush);
+      p->drawRect(d->selectionArea);
+
+      if (d->selectionMode == Area)
+        p->drawLine(d->mousePressPoint, d->mouseCurrPoint);
+
+      pen.setColor(QColor(255,255,255));
+      pen.setStyle(Qt::DashLine);
+      p->setPen(pen);
+      p->drawRect(d->selectionArea);
+      if (d->selectionMode == Area)
+        p->drawLine(d->mousePressPoint, d->mouseCurrPoint);
+    }
 
-      // Draw grid if enabled
-      if (d->bDrawGrid)
+  // Draw grid if enabled
+  if (d->bDrawGrid)
+    {
+      QRectF gridRect = QRectF(d->pixelSize.width() * d->visibleArea.x(),
+                               d->pixelSize.height() * d->visibleArea.y(),
+                               d->pixelSize.width() * d->visibleArea.width(),
+                               d->pixelSize.height() * d->visibleArea.height());
+      double w = gridRect.width();
+      double h = gridRect.height();
+
+      // Calculate horizontal lines if necessary
+      if (gridRect.top() != d->previousGridRect.top() ||
+          gridRect.bottom() != d->previousGridRect.bottom())
         {
-          QRectF gridRect = QRectF(d->pixelSize.width() * d->visibleArea.x(),
-                                   d->pixelSize.height() * d->visibleArea.y(),
-                                   d->pixelSize.width() * d->visibleArea.width(),
-                                   d->pixelSize.height() * d->visibleArea.height());
-          double w = gridRect.width();
-          double h = gridRect.height();
-
-          // Calculate horizontal lines if necessary
-          if (gridRect.top() != d->previousGridRect.top() ||
-              gridRect.bottom() != d->previousGridRect.bottom())
+          d->dHLineStep = d->pAdapter->gridSpacing(d->dYScale/d->pixelSize.height(), Pii::Vertically);
+          if (d->dHLineStep > 0)
             {
-              d->dHLineStep = d->pAdapter->gridSpacing(d->dYScale/d->pixelSize.height(), Pii::Vertically);
-              if (d->dHLineStep > 0)
-                {
-                  d->iHLineCount = h / d->dHLineStep + 2;
-
-                  double dMod = fmod(gridRect.top(), d->dHLineStep);
-                  d->dHLineStart = gridRect.top() - dMod;
-                }
-              else
-                d->dHLineStart = d->iHLineCount = 0;
-            }
+              d->iHLineCount = h / d->dHLineStep + 2;
 
-          // Calculate vertical lines if necessary
-          if (gridRect.left() != d->previousGridRect.left() ||
-              gridRect.right() != d->previousGridRect.right())
-            {
-              d->dVLineStep = d->pAdapter->gridSpacing(d->dXScale/d->pixelSize.width(), Pii::Horizontally);
-              if (d->dVLineStep > 0)
-                {
-                  d->iVLineCount = w / d->dVLineStep + 2;
-
-                  double dMod = fmod(gridRect.left(), d->dVLineStep);
-                  d->dVLineStart = gridRect.left() - dMod;
-                }
-              else
-                d->dVLineStart = d->iVLineCount = 0;
+              double dMod = fmod(gridRect.top(), d->dHLineStep);
+              d->dHLineStart = gridRect.top() - dMod;
             }
-          d->previousGridRect = gridRect;
-
-          QPen pen(Qt::DotLine);
-          pen.setColor(QColor(130,130,130));
-          p.setPen(pen);
-          p.setBrush(Qt::NoBrush);
+          else
+            d->dHLineStart = d->iHLineCount = 0;
+        }
 
-          // Draw horizontal grid lines
-          for (int i=0; i<d->iHLineCount; i++)
+      // Calculate vertical lines if necessary
+      if (gridRect.left() != d->previousGridRect.left() ||
+          gridRect.right() != d->previousGridRect.right())
+        {
+          d->dVLineStep = d->pAdapter->gridSpacing(d->dXScale/d->pixelSize.width(), Pii::Horizontally);
+          if (d->dVLineStep > 0)
             {
-              double y = d->dYScale * ((d->dHLineStart + (double)i*d->dHLineStep) / d->pixelSize.height() - (double)d->visibleArea.y());
-              p.drawLine(QLineF(0, y, width(), y));
-            }
+              d->iVLineCount = w / d->dVLineStep + 2;
 
-          // Draw vertical grid lines
-          for (int i=0; i<d->iVLineCount; i++)
-            {
-              double x = d->dXScale * ((d->dVLineStart + (double)i*d->dVLineStep) / d->pixelSize.width() - (double)d->visibleArea.x());
-              p.drawLine(QLineF(x, 0, x, height()));
+              double dMod = fmod(gridRect.left(), d->dVLineStep);
+              d->dVLineStart = gridRect.left() - dMod;
             }
+          else
+            d->dVLineStart = d->iVLineCount = 0;
         }
+      d->previousGridRect = gridRect;
 
-    }
-  else
-    d->imageLock.unlock();
+      QPen pen(Qt::DotLine);
+      pen.setColor(QColor(130,130,130));
+      p->setPen(pen);
+      p->setBrush(Qt::NoBrush);
+
+      // Draw horizontal grid lines
+      for (int i=0; i<d->iHLineCount; i++)
+        {
+          double y = d->dYScale * ((d->dHLineStart + (double)i*d->dHLineStep) / d->pixelSize.height() - (double)d->visibleArea.y());
+          p->drawLine(QLineF(0, y, width(), y));
+        }
 
+      // Draw vertical grid lines
+      for (int i=0; i<d->iVLineCount; i++)
+        {
+          double x = d->dXScale * ((d->dVLineStart + (double)i*d->dVLineStep) / d->pixelSize.width() - (double)d->visibleArea.x());
+          p->drawLine(QLineF(x, 0, x, height()));
+        }
+    }
 }
 
 double PiiImageViewport::gridSpacing(double pixelsPerUnit, Pii::MatrixDirection) const
@@ -1170,7 +1242,16 @@ double PiiImageViewport::zoom() const { return d->dZoomFactor; }
 double PiiImageViewport::xScale() const { return d->dXScale; }
 double PiiImageViewport::yScale() const { return d->dYScale; }
 QSizeF PiiImageViewport::pixelSize() const {  return d->pixelSize; }
-void PiiImageViewport::updateImage() { d->pUpdater->refresh(); }
+void PiiImageViewport::updateImage()
+{
+  if (d->bTiledRendering)
+    {
+      updatePyramids();
+      update();
+    }
+  else
+    d->pUpdater->refresh();
+}
 
 /************************* PiiImageViewportUpdater **************************/
 PiiImageViewportUpdater::PiiImageViewportUpdater(PiiImageViewport* parent) :
@@ -30,6 +30,7 @@ class QMenu;
 class PiiImageOverlay;
 class PiiRectangleOverlay;
 class PiiImageViewport;
+class PiiImagePyramid;
 
 /**
  * @internal
@@ -157,6 +158,19 @@ class PII_GUI_EXPORT PiiImageViewport : public QWidget, public PiiImageViewportA
    */
   Q_PROPERTY(bool drawGrid READ drawGrid WRITE setDrawGrid);
 
+  /**
+   * Enables tiled rendering for very large images. By default, the
+   * visible part of the image is rescaled into a single buffer
+   * whenever the visible area or the zoom factor changes. With huge
+   * images, this makes zooming and panning slow. If tiled rendering
+   * is enabled, each layer is split into a [tile
+   * pyramid](PiiImagePyramid) that is built on the background by
+   * worker threads, and painting only composites the visible tiles
+   * at the closest resolution level. Tiles that are not ready yet are
+   * temporarily drawn from coarser levels. The default is `false`.
+   */
+  Q_PROPERTY(bool tiledRendering READ tiledRendering WRITE setTiledRendering);
+
   friend class PiiImageScrollArea;
   friend class PiiImageViewportUpdater;
 
@@ -324,6 +338,8 @@ public:
   double yScale() const;
   void setDrawGrid(bool drawGrid);
   bool drawGrid() const;
+  void setTiledRendering(bool tiledRendering);
+  bool tiledRendering() const;
 
   QString toolTipForPoint(const QPoint& point) const;
   QString toolTipForSelection(const QRect& area) const;
@@ -476,9 +492,10 @@ protected:
   /// @hide
   struct Layer
   {
-    Layer() : pImage(&image), dOpacity(1), bVisible(true) {}
-    Layer(QImage* i, qreal o) : pImage(i != 0 ? i : &image), dOpacity(o), bVisible(true) {}
-    Layer(const QImage& i, qreal o) : image(i), pImage(&image), dOpacity(o), bVisible(true) {}
+    Layer() : pImage(&image), dOpacity(1), bVisible(true), pPyramid(0) {}
+    Layer(QImage* i, qreal o) : pImage(i != 0 ? i : &image), dOpacity(o), bVisible(true), pPyramid(0) {}
+    Layer(const QImage& i, qreal o) : image(i), pImage(&image), dOpacity(o), bVisible(true), pPyramid(0) {}
+    ~Layer();
 
     void setImage(QImage* im)
     {
@@ -509,6 +526,10 @@ protected:
     QImage* pImage;
     qreal dOpacity;
     bool bVisible;
+    /*
+     * Tile pyramid of the image, if tiled rendering is enabled.
+     */
+    PiiImagePyramid* pPyramid;
   };
 
   class Data
@@ -586,6 +607,8 @@ protected:
 
     SelectionMode selectionMode;
 
+    bool bTiledRendering;
+
     // For grid
     bool bDrawGrid;
     QRectF previousGridRect;
@@ -629,6 +652,10 @@ private:
 
   QRect startRendering();
   void endRendering(QRect visibleArea);
+
+  void paintTiles(QPainter* p, const QRect& paintRect);
+  void paintOverlays(QPainter* p);
+  void updatePyramids();
 };
 
 Q_DECLARE_METATYPE(PiiImageViewport::FitMode);
@@ -70,15 +70,11 @@ template <class T> void PiiMatrixNormalizer::normalize(const PiiVariant& obj)
     }
   else
     {
+      // Mean and variance in a single pass
+      Pii::Statistics<T> stats(Pii::statistics<double>(mat));
+      preShift = -stats.mean();
       if (d->dVariance != 0)
-        {
-          double mean;
-          double variance = Pii::var<double>(mat, &mean);
-          preShift = -mean;
-          scale = d->dVariance/variance;
-        }
-      else
-        preShift = -Pii::mean<double>(mat);
+        scale = d->dVariance/stats.var();
 
       postShift = d->dMean;
     }
@@ -97,13 +93,16 @@ template <class T> PiiMatrix<double> PiiMatrixNormalizer::normalizeAs(const PiiM
                                                                       double scale,
                                                                       double postShift)
 {
-  PiiMatrix<double> matResult(matrix);
-  if (preShift != 0)
-    matResult += preShift;
-  if (scale != 1.0)
-    matResult *= scale;
-  if (postShift != 0)
-    matResult += postShift;
+  // Shift, scale and shift again in a single pass.
+  PiiMatrix<double> matResult(PiiMatrix<double>::uninitialized(matrix.rows(), matrix.columns()));
+  const int iRows = matrix.rows(), iColumns = matrix.columns();
+  for (int r=0; r<iRows; ++r)
+    {
+      const T* pSource = matrix[r];
+      double* pTarget = matResult[r];
+      for (int c=0; c<iColumns; ++c)
+        pTarget[c] = (double(pSource[c]) + preShift) * scale + postShift;
+    }
   return matResult;
 }
 
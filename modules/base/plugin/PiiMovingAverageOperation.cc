@@ -25,7 +25,13 @@ PiiMovingAverageOperation::Data::Data() :
   dRangeMax(0),
   dRange(0),
   uiType(PiiVariant::InvalidType),
-  bForceInputType(false)
+  bForceInputType(false),
+  bIncremental(true),
+  iResyncInterval(1024),
+  iResyncCounter(0),
+  bVariance(false), bMinimum(false), bMaximum(false),
+  iFrontIndex(0),
+  iBackCount(0)
 {
 }
 
@@ -34,19 +40,43 @@ PiiMovingAverageOperation::PiiMovingAverageOperation() :
 {
   addSocket(new PiiInputSocket("input"));
   addSocket(new PiiOutputSocket("average"));
+  addSocket(new PiiOutputSocket("variance"));
+  addSocket(new PiiOutputSocket("minimum"));
+  addSocket(new PiiOutputSocket("maximum"));
 }
 
 void PiiMovingAverageOperation::check(bool reset)
 {
   PII_D;
   PiiDefaultOperation::check(reset);
+
+  d->bVariance = outputAt(1)->isConnected();
+  d->bMinimum = outputAt(2)->isConnected();
+  d->bMaximum = outputAt(3)->isConnected();
+  if ((d->bVariance || d->bMinimum || d->bMaximum) &&
+      (!d->bIncremental || d->dRange != 0))
+    PII_THROW(PiiExecutionException, tr("Variance, minimum and maximum can only be calculated in incremental mode without a circular range."));
+
   if (reset)
     {
       d->uiType = PiiVariant::InvalidType;
       d->lstBuffer.clear();
+      clearWindow();
     }
 }
 
+void PiiMovingAverageOperation::clearWindow()
+{
+  PII_D;
+  d->iResyncCounter = 0;
+  d->varSum = d->varSumOfSquares = PiiVariant();
+  d->vecFrontMinimum.clear();
+  d->vecFrontMaximum.clear();
+  d->iFrontIndex = 0;
+  d->varBackMinimum = d->varBackMaximum = PiiVariant();
+  d->iBackCount = 0;
+}
+
 void PiiMovingAverageOperation::process()
 {
   PiiVariant obj = readInput();
@@ -87,6 +117,12 @@ template <class T> void PiiMovingAverageOperation::matrixAverage(const PiiVarian
 template <class T, class ResultType> void PiiMovingAverageOperation::averageTemplate(const PiiVariant& obj)
 {
   PII_D;
+  if (d->bIncremental && d->dRange == 0)
+    {
+      incrementalAverage<T,ResultType>(obj);
+      return;
+    }
+
   if (d->lstBuffer.isEmpty())
     {
       d->lstBuffer << obj;
@@ -141,6 +177,370 @@ template <class T, class ResultType> void PiiMovingAverageOperation::averageTemp
     emitObject(result);
 }
 
+template <class T> struct WindowElement { typedef T Type; };
+template <class T> struct WindowElement<PiiMatrix<T> > { typedef T Type; };
+
+// Element-wise kernels for the incremental mode. Scalars and matrices
+// are handled by overloads. The matrix versions go through the data
+// row by row and fuse all updates into a single pass.
+struct WindowKernel
+{
+  template <class T> static inline bool sameSize(const T&, const T&) { return true; }
+  template <class T> static inline bool sameSize(const PiiMatrix<T>& a, const PiiMatrix<T>& b)
+  {
+    return a.rows() == b.rows() && a.columns() == b.columns();
+  }
+
+  // sum += added - *removed
+  template <class S, class T> static inline void slide(S& sum, const T* added, const T* removed)
+  {
+    if (added != 0) sum += S(*added);
+    if (removed != 0) sum -= S(*removed);
+  }
+  template <class S, class T> static void slide(PiiMatrix<S>& sum, const PiiMatrix<T>* added, const PiiMatrix<T>* removed)
+  {
+    const int iColumns = sum.columns();
+    for (int r=0; r<sum.rows(); ++r)
+      {
+        S* pSum = sum.row(r);
+        if (added != 0 && removed != 0)
+          {
+            const T* pAdded = added->row(r), *pRemoved = removed->row(r);
+            for (int c=0; c<iColumns; ++c)
+              pSum[c] += S(pAdded[c]) - S(pRemoved[c]);
+          }
+        else if (added != 0)
+          {
+            const T* pAdded = added->row(r);
+            for (int c=0; c<iColumns; ++c)
+              pSum[c] += S(pAdded[c]);
+          }
+        else if (removed != 0)
+          {
+            const T* pRemoved = removed->row(r);
+            for (int c=0; c<iColumns; ++c)
+              pSum[c] -= S(pRemoved[c]);
+          }
+      }
+  }
+
+  // sum += added² - removed²
+  template <class S, class T> static inline void slideSquares(S& sum, const T* added, const T* removed)
+  {
+    if (added != 0) sum += S(*added) * S(*added);
+    if (removed != 0) sum -= S(*removed) * S(*removed);
+  }
+  template <class S, class T> static void slideSquares(PiiMatrix<S>& sum, const PiiMatrix<T>* added, const PiiMatrix<T>* removed)
+  {
+    const int iColumns = sum.columns();
+    for (int r=0; r<sum.rows(); ++r)
+      {
+        S* pSum = sum.row(r);
+        if (added != 0 && removed != 0)
+          {
+            const T* pAdded = added->row(r), *pRemoved = removed->row(r);
+            for (int c=0; c<iColumns; ++c)
+              {
+                S a = S(pAdded[c]), b = S(pRemoved[c]);
+                pSum[c] += a*a - b*b;
+              }
+          }
+        else if (added != 0)
+          {
+            const T* pAdded = added->row(r);
+            for (int c=0; c<iColumns; ++c)
+              pSum[c] += S(pAdded[c]) * S(pAdded[c]);
+          }
+        else if (removed != 0)
+          {
+            const T* pRemoved = removed->row(r);
+            for (int c=0; c<iColumns; ++c)
+              pSum[c] -= S(pRemoved[c]) * S(pRemoved[c]);
+          }
+      }
+  }
+
+  // Zero-initialized accumulator of the same size as value.
+  template <class S, class T> static inline S zero(const T&) { return S(0); }
+  template <class S, class T> static inline S zero(const PiiMatrix<T>& value)
+  {
+    return S(value.rows(), value.columns());
+  }
+
+  template <class S> static inline S mean(const S& sum, int count)
+  {
+    S result(sum);
+    result /= count;
+    return result;
+  }
+  template <class S> static PiiMatrix<S> mean(const PiiMatrix<S>& sum, int count)
+  {
+    const int iColumns = sum.columns();
+    const S scale = S(1) / S(count);
+    PiiMatrix<S> result(PiiMatrix<S>::uninitialized(sum.rows(), iColumns));
+    for (int r=0; r<sum.rows(); ++r)
+      {
+        const S* pSum = sum.row(r);
+        S* pResult = result.row(r);
+        for (int c=0; c<iColumns; ++c)
+          pResult[c] = pSum[c] * scale;
+      }
+    return result;
+  }
+
+  // E[x²] - E[x]², clamped to zero to hide cancellation errors.
+  template <class S> static inline S variance(const S& sumOfSquares, const S& mean, int count)
+  {
+    return qMax(S(0), sumOfSquares / S(count) - mean * mean);
+  }
+  template <class S> static PiiMatrix<S> variance(const PiiMatrix<S>& sumOfSquares, const PiiMatrix<S>& mean, int count)
+  {
+    const int iColumns = mean.columns();
+    const S scale = S(1) / S(count);
+    PiiMatrix<S> result(PiiMatrix<S>::uninitialized(mean.rows(), iColumns));
+    for (int r=0; r<mean.rows(); ++r)
+      {
+        const S* pSquares = sumOfSquares.row(r), *pMean = mean.row(r);
+        S* pResult = result.row(r);
+        for (int c=0; c<iColumns; ++c)
+          {
+            S var = pSquares[c] * scale - pMean[c] * pMean[c];
+            pResult[c] = var > 0 ? var : 0;
+          }
+      }
+    return result;
+  }
+
+  // target = min(target, value) or max(target, value)
+  template <class T> static inline void minimize(T& target, const T& value) { if (value < target) target = value; }
+  template <class T> static inline void maximize(T& target, const T& value) { if (value > target) target = value; }
+  template <class T> static void minimize(PiiMatrix<T>& target, const PiiMatrix<T>& value)
+  {
+    const int iColumns = target.columns();
+    for (int r=0; r<target.rows(); ++r)
+      {
+        T* pTarget = target.row(r);
+        const T* pValue = value.row(r);
+        for (int c=0; c<iColumns; ++c)
+          pTarget[c] = pValue[c] < pTarget[c] ? pValue[c] : pTarget[c];
+      }
+  }
+  template <class T> static void maximize(PiiMatrix<T>& target, const PiiMatrix<T>& value)
+  {
+    const int iColumns = target.columns();
+    for (int r=0; r<target.rows(); ++r)
+      {
+        T* pTarget = target.row(r);
+        const T* pValue = value.row(r);
+        for (int c=0; c<iColumns; ++c)
+          pTarget[c] = pValue[c] > pTarget[c] ? pValue[c] : pTarget[c];
+      }
+  }
+
+  template <class T> static inline T minimum(const T& a, const T& b) { return b < a ? b : a; }
+  template <class T> static inline T maximum(const T& a, const T& b) { return b > a ? b : a; }
+  template <class T> static PiiMatrix<T> minimum(const PiiMatrix<T>& a, const PiiMatrix<T>& b)
+  {
+    return PiiMatrix<T>(a.mapped(Pii::Min<T>(), b));
+  }
+  template <class T> static PiiMatrix<T> maximum(const PiiMatrix<T>& a, const PiiMatrix<T>& b)
+  {
+    return PiiMatrix<T>(a.mapped(Pii::Max<T>(), b));
+  }
+};
+
+// Running variance and extrema are not defined for complex numbers.
+struct ComplexWindowHandler
+{
+  template <class T, class ResultType> static inline void slideStatisticsImpl(const T*, const T*) {}
+  template <class T, class ResultType> static inline void resyncStatisticsImpl() {}
+  template <class T, class ResultType> static inline void emitStatisticsImpl(const ResultType&) {}
+};
+
+template <class T, class ResultType> void PiiMovingAverageOperation::incrementalAverage(const PiiVariant& obj)
+{
+  PII_D;
+  typedef typename WindowElement<T>::Type ElementType;
+  if (Pii::IsComplex<ElementType>::boolValue && (d->bVariance || d->bMinimum || d->bMaximum))
+    PII_THROW(PiiExecutionException, tr("Variance, minimum and maximum cannot be calculated for complex numbers."));
+
+  const T value(obj.valueAs<T>());
+  if (d->lstBuffer.isEmpty())
+    {
+      clearWindow();
+      d->uiType = Pii::typeId<T>();
+      d->varSum = PiiVariant(WindowKernel::zero<ResultType>(value));
+      if (d->bVariance)
+        d->varSumOfSquares = d->varSum;
+    }
+  else
+    {
+      if (obj.type() != d->uiType)
+        PII_THROW(PiiExecutionException, tr("Cannot average objects of different type."));
+      if (!WindowKernel::sameSize(value, d->lstBuffer.first().valueAs<T>()))
+        PII_THROW(PiiExecutionException, tr("Cannot average matrices of different size."));
+    }
+
+  d->lstBuffer << obj;
+
+  // Add the new object and subtract the oldest one on a single pass.
+  const T* pRemoved = 0;
+  T removed;
+  if (d->lstBuffer.size() > d->iWindowSize)
+    {
+      removed = d->lstBuffer.takeFirst().valueAs<T>();
+      pRemoved = &removed;
+    }
+  WindowKernel::slide(d->varSum.valueAs<ResultType>(), &value, pRemoved);
+  slideStatistics<T,ResultType>(&value, pRemoved);
+
+  // The window size may have been decreased.
+  while (d->lstBuffer.size() > d->iWindowSize)
+    {
+      removed = d->lstBuffer.takeFirst().valueAs<T>();
+      WindowKernel::slide(d->varSum.valueAs<ResultType>(), static_cast<const T*>(0), &removed);
+      slideStatistics<T,ResultType>(0, &removed);
+    }
+
+  if (d->iResyncInterval > 0 && ++d->iResyncCounter >= d->iResyncInterval)
+    resync<T,ResultType>();
+
+  ResultType result(WindowKernel::mean(d->varSum.valueAs<ResultType>(), d->lstBuffer.size()));
+  emitStatistics<T,ResultType>(result);
+
+  if (d->bForceInputType)
+    emitObject((T)result);
+  else
+    emitObject(result);
+}
+
+template <class T, class ResultType> void PiiMovingAverageOperation::resync()
+{
+  PII_D;
+  QLinkedList<PiiVariant>::iterator i = d->lstBuffer.begin();
+  ResultType sum(WindowKernel::zero<ResultType>((*i).valueAs<T>()));
+  for (; i != d->lstBuffer.end(); ++i)
+    {
+      const T value((*i).valueAs<T>());
+      WindowKernel::slide(sum, &value, static_cast<const T*>(0));
+    }
+  d->varSum = PiiVariant(sum);
+  resyncStatistics<T,ResultType>();
+  d->iResyncCounter = 0;
+}
+
+template <class T, class ResultType> void PiiMovingAverageOperation::slideStatisticsImpl(const T* added, const T* removed)
+{
+  PII_D;
+  if (d->bVariance)
+    WindowKernel::slideSquares(d->varSumOfSquares.valueAs<ResultType>(), added, removed);
+
+  if (!d->bMinimum && !d->bMaximum)
+    return;
+
+  // The window is split into two stacks. New objects are pushed to
+  // the back, which only stores its extrema. Old objects are popped
+  // from the front, which stores the extrema of each suffix. Once the
+  // front runs empty, the whole window is moved to it.
+  if (added != 0)
+    {
+      if (d->iBackCount++ == 0)
+        {
+          d->varBackMinimum = d->varBackMaximum = PiiVariant(*added);
+        }
+      else
+        {
+          if (d->bMinimum) WindowKernel::minimize(d->varBackMinimum.valueAs<T>(), *added);
+          if (d->bMaximum) WindowKernel::maximize(d->varBackMaximum.valueAs<T>(), *added);
+        }
+    }
+  if (removed != 0)
+    {
+      if (d->iFrontIndex < d->vecFrontMinimum.size())
+        {
+          // Release the memory as soon as possible.
+          d->vecFrontMinimum[d->iFrontIndex] = d->vecFrontMaximum[d->iFrontIndex] = PiiVariant();
+          ++d->iFrontIndex;
+        }
+      else
+        rebuildExtrema<T>();
+    }
+}
+
+template <class T> void PiiMovingAverageOperation::rebuildExtrema()
+{
+  PII_D;
+  const int iCount = d->lstBuffer.size();
+  d->vecFrontMinimum.fill(PiiVariant(), iCount);
+  d->vecFrontMaximum.fill(PiiVariant(), iCount);
+  d->iFrontIndex = 0;
+  d->iBackCount = 0;
+  d->varBackMinimum = d->varBackMaximum = PiiVariant();
+  if (iCount == 0)
+    return;
+
+  QLinkedList<PiiVariant>::iterator i = d->lstBuffer.end();
+  --i;
+  T minimum((*i).valueAs<T>()), maximum(minimum);
+  d->vecFrontMinimum[iCount-1] = d->vecFrontMaximum[iCount-1] = *i;
+  for (int j=iCount-2; j>=0; --j)
+    {
+      --i;
+      const T value((*i).valueAs<T>());
+      if (d->bMinimum)
+        {
+          minimum = WindowKernel::minimum(minimum, value);
+          d->vecFrontMinimum[j] = PiiVariant(minimum);
+        }
+      if (d->bMaximum)
+        {
+          maximum = WindowKernel::maximum(maximum, value);
+          d->vecFrontMaximum[j] = PiiVariant(maximum);
+        }
+    }
+}
+
+template <class T, class ResultType> void PiiMovingAverageOperation::resyncStatisticsImpl()
+{
+  PII_D;
+  if (!d->bVariance)
+    return;
+  QLinkedList<PiiVariant>::iterator i = d->lstBuffer.begin();
+  ResultType sum(WindowKernel::zero<ResultType>((*i).valueAs<T>()));
+  for (; i != d->lstBuffer.end(); ++i)
+    {
+      const T value((*i).valueAs<T>());
+      WindowKernel::slideSquares(sum, &value, static_cast<const T*>(0));
+    }
+  d->varSumOfSquares = PiiVariant(sum);
+}
+
+template <class T, class ResultType> void PiiMovingAverageOperation::emitStatisticsImpl(const ResultType& average)
+{
+  PII_D;
+  if (d->bVariance)
+    outputAt(1)->emitObject(WindowKernel::variance(d->varSumOfSquares.valueAs<ResultType>(), average,
+                                                   d->lstBuffer.size()));
+
+  bool bFront = d->iFrontIndex < d->vecFrontMinimum.size(), bBack = d->iBackCount > 0;
+  if (d->bMinimum)
+    {
+      if (bFront && bBack)
+        outputAt(2)->emitObject(WindowKernel::minimum(d->vecFrontMinimum[d->iFrontIndex].valueAs<T>(),
+                                                      d->varBackMinimum.valueAs<T>()));
+      else
+        outputAt(2)->emitObject(bFront ? d->vecFrontMinimum[d->iFrontIndex] : d->varBackMinimum);
+    }
+  if (d->bMaximum)
+    {
+      if (bFront && bBack)
+        outputAt(3)->emitObject(WindowKernel::maximum(d->vecFrontMaximum[d->iFrontIndex].valueAs<T>(),
+                                                      d->varBackMaximum.valueAs<T>()));
+      else
+        outputAt(3)->emitObject(bFront ? d->vecFrontMaximum[d->iFrontIndex] : d->varBackMaximum);
+    }
+}
+
 template <class T> void PiiMovingAverageOperation::addImpl(T& op1, T op2, int index)
 {
   PII_D;
@@ -201,6 +601,21 @@ template <class T> void PiiMovingAverageOperation::scale(T& result, int cnt)
   Pii::IfClass<Pii::IsPrimitive<T>, PiiMovingAverageOperation, AggregateHandler>::Type::scaleImpl(result, cnt);
 }
 
+template <class T, class ResultType> void PiiMovingAverageOperation::slideStatistics(const T* added, const T* removed)
+{
+  Pii::IfClass<Pii::IsComplex<typename WindowElement<T>::Type>, ComplexWindowHandler, PiiMovingAverageOperation>::Type::template slideStatisticsImpl<T,ResultType>(added, removed);
+}
+
+template <class T, class ResultType> void PiiMovingAverageOperation::resyncStatistics()
+{
+  Pii::IfClass<Pii::IsComplex<typename WindowElement<T>::Type>, ComplexWindowHandler, PiiMovingAverageOperation>::Type::template resyncStatisticsImpl<T,ResultType>();
+}
+
+template <class T, class ResultType> void PiiMovingAverageOperation::emitStatistics(const ResultType& average)
+{
+  Pii::IfClass<Pii::IsComplex<typename WindowElement<T>::Type>, ComplexWindowHandler, PiiMovingAverageOperation>::Type::template emitStatisticsImpl<T,ResultType>(average);
+}
+
 void PiiMovingAverageOperation::setWindowSize(int windowSize) { _d()->iWindowSize = windowSize; }
 int PiiMovingAverageOperation::windowSize() const { return _d()->iWindowSize; }
 void PiiMovingAverageOperation::setRangeMin(double rangeMin) { PII_D; d->dRangeMin = rangeMin; d->dRange = d->dRangeMax-d->dRangeMin; }
@@ -209,3 +624,7 @@ void PiiMovingAverageOperation::setRangeMax(double rangeMax) { PII_D; d->dRangeM
 double PiiMovingAverageOperation::rangeMax() const { return _d()->dRangeMax; }
 void PiiMovingAverageOperation::setForceInputType(bool forceInputType) { _d()->bForceInputType = forceInputType; }
 bool PiiMovingAverageOperation::forceInputType() const { return _d()->bForceInputType; }
+void PiiMovingAverageOperation::setIncremental(bool incremental) { _d()->bIncremental = incremental; }
+bool PiiMovingAverageOperation::incremental() const { return _d()->bIncremental; }
+void PiiMovingAverageOperation::setResyncInterval(int resyncInterval) { _d()->iResyncInterval = resyncInterval; }
+int PiiMovingAverageOperation::resyncInterval() const { return _d()->iResyncInterval; }
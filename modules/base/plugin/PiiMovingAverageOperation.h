@@ -18,6 +18,7 @@
 
 #include <PiiDefaultOperation.h>
 #include <QLinkedList>
+#include <QVector>
 
 /**
  * Calculate the moving average over a window of a predefined size.
@@ -38,6 +39,25 @@
  * long int in input result in double output, others result in float
  * output.
  *
+ * @out variance - the variance over the last N entries. The output
+ * type is the same as that of `average`. Only calculated if the
+ * output is connected. Not available for complex numbers.
+ *
+ * @out minimum - the minimum over the last N entries. The type of the
+ * output is the same as that of the input. If the input is a matrix,
+ * the minimum is calculated element-wise. Only calculated if the
+ * output is connected. Not available for complex numbers.
+ *
+ * @out maximum - the maximum over the last N entries. See `minimum`.
+ *
+ * In the [incremental] mode, the cost of processing an object is
+ * independent of [windowSize]. The average is maintained as a running
+ * sum to which the newest object is added and from which the oldest
+ * one is subtracted. The `variance` output uses a running sum of
+ * squares in the same way. The `minimum` and `maximum` outputs use two
+ * stacks of partial extrema, which makes their amortized cost two
+ * element-wise comparisons per object, but doubles the memory needed
+ * by the window buffer.
  */
 class PiiMovingAverageOperation : public PiiDefaultOperation
 {
@@ -70,6 +90,27 @@ class PiiMovingAverageOperation : public PiiDefaultOperation
    */
   Q_PROPERTY(bool forceInputType READ forceInputType WRITE setForceInputType);
 
+  /**
+   * Enables the incremental mode. If this flag is `true`, a running
+   * sum over the window is updated with one addition and one
+   * subtraction per incoming object. Otherwise, the whole window will
+   * be summed up again for each object. The incremental mode is not
+   * used if a circular range (see [rangeMin]) is set. The `variance`,
+   * `minimum` and `maximum` outputs can only be connected in the
+   * incremental mode. The default value is `true`.
+   */
+  Q_PROPERTY(bool incremental READ incremental WRITE setIncremental);
+
+  /**
+   * The number of objects after which the running sums are
+   * recalculated from the buffered objects in the [incremental] mode.
+   * Subtracting evicted objects from a floating-point sum accumulates
+   * rounding errors, and the periodic resynchronization keeps them
+   * bounded. Zero disables resynchronization, which is safe if the
+   * input consists of small integers. The default value is 1024.
+   */
+  Q_PROPERTY(int resyncInterval READ resyncInterval WRITE setResyncInterval);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   PiiMovingAverageOperation();
@@ -82,6 +123,10 @@ public:
   double rangeMax() const;
   void setForceInputType(bool forceInputType);
   bool forceInputType() const;
+  void setIncremental(bool incremental);
+  bool incremental() const;
+  void setResyncInterval(int resyncInterval);
+  int resyncInterval() const;
 
 protected:
   void process();
@@ -100,12 +145,34 @@ private:
     unsigned int uiType;
     QLinkedList<PiiVariant> lstBuffer;
     bool bForceInputType;
+    bool bIncremental;
+    int iResyncInterval;
+    int iResyncCounter;
+    bool bVariance, bMinimum, bMaximum;
+    PiiVariant varSum, varSumOfSquares;
+    // Suffix extrema of the oldest part of the window ("front"),
+    // starting at iFrontIndex, and the extrema of the iBackCount
+    // newest objects ("back").
+    QVector<PiiVariant> vecFrontMinimum, vecFrontMaximum;
+    int iFrontIndex;
+    PiiVariant varBackMinimum, varBackMaximum;
+    int iBackCount;
   };
   PII_D_FUNC;
 
   template <class T> void average(const PiiVariant& obj);
   template <class T> void matrixAverage(const PiiVariant& obj);
   template <class T, class ResultType> void averageTemplate(const PiiVariant& obj);
+  template <class T, class ResultType> void incrementalAverage(const PiiVariant& obj);
+  template <class T, class ResultType> void resync();
+  template <class T, class ResultType> void slideStatisticsImpl(const T* added, const T* removed);
+  template <class T, class ResultType> void resyncStatisticsImpl();
+  template <class T, class ResultType> void emitStatisticsImpl(const ResultType& average);
+  template <class T, class ResultType> void slideStatistics(const T* added, const T* removed);
+  template <class T, class ResultType> void resyncStatistics();
+  template <class T, class ResultType> void emitStatistics(const ResultType& average);
+  template <class T> void rebuildExtrema();
+  void clearWindow();
   template <class T> void addImpl(T& op1, T op2, int index);
   template <class T> void scaleImpl(T& result, int cnt);
   template <class T> void add(T& op1, const T& op2, int index);
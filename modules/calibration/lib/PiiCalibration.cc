@@ -17,6 +17,7 @@
 
 #include <cstring>
 #include <QCoreApplication>
+#include <QVector>
 
 #ifndef PII_NO_OPENCV
 #  include <PiiOpenCv.h>
@@ -696,13 +697,13 @@ namespace PiiCalibration
    * Remapping functions
    ************************************************************************/
 
-  template <class UnaryFunction>
-  PiiMatrix<PiiPoint<typename UnaryFunction::result_type > > undistortMap(int rows, int columns,
-                                                                          const CameraParameters& intrinsic,
-                                                                          const UnaryFunction& func)
+  // Calls sink.setRow(r, points) for each row of the undistortion
+  // map with the source coordinates as doubles.
+  template <class Sink>
+  void createUndistortMap(int rows, int columns,
+                          const CameraParameters& intrinsic,
+                          Sink& sink)
   {
-    typedef PiiPoint<typename UnaryFunction::result_type> PointType;
-
     // Four corners in (distorted) image coordinates
     PiiMatrix<double> matCorners(4,2,
                                  0.0, 0.0,
@@ -719,33 +720,50 @@ namespace PiiCalibration
     double dXStep = (matMaxCorners(0) - matMinCorners(0)) / columns;
     double dYStep = (matMaxCorners(1) - matMinCorners(1)) / rows;
 
-    //Pii::matlabPrint(std::cout, matMinCorners);
-    //Pii::matlabPrint(std::cout, matMaxCorners);
-
-    //Pii::matlabPrint(std::cout, matUndistortedCorners);
-
-    //std::cout << dXStep << " " << dYStep << "\n";
-    //std::cout.flush();
-
-
-    // Result image is the same size as the input
-    PiiMatrix<PointType> matResult(rows, columns);
+    // Only one row of double coordinates is needed at a time.
+    QVector<PiiPoint<double> > vecRow(columns);
     double dY = matMinCorners(1);
-    double dNewX, dNewY;
     for (int r=0; r<rows; ++r, dY += dYStep)
       {
         double dX = matMinCorners(0);
-        //std::cout << "(" << r << ") -> (" << dY << "," << dX << ")\n";
-        PointType* pResultRow = matResult[r];
         for (int c=0; c<columns; ++c, dX += dXStep)
           {
             // Map normalized coordinates to distorted image
             // coordinates
-            normalizedToPixelCoordinates(intrinsic, dX, dY, &dNewX, &dNewY);
-            pResultRow[c] = PointType(func(dNewX), func(dNewY));
+            normalizedToPixelCoordinates(intrinsic, dX, dY, &vecRow[c].x, &vecRow[c].y);
           }
+        sink.setRow(r, vecRow.constData());
       }
-    return matResult;
+  }
+
+  template <class UnaryFunction> struct UndistortMapSink
+  {
+    typedef PiiPoint<typename UnaryFunction::result_type> PointType;
+
+    UndistortMapSink(int rows, int columns, const UnaryFunction& func) :
+      matResult(rows, columns), func(func)
+    {}
+
+    void setRow(int row, const PiiPoint<double>* points)
+    {
+      PointType* pResultRow = matResult[row];
+      for (int c=0; c<matResult.columns(); ++c)
+        pResultRow[c] = PointType(func(points[c].x), func(points[c].y));
+    }
+
+    PiiMatrix<PointType> matResult;
+    UnaryFunction func;
+  };
+
+  template <class UnaryFunction>
+  PiiMatrix<PiiPoint<typename UnaryFunction::result_type > > undistortMap(int rows, int columns,
+                                                                          const CameraParameters& intrinsic,
+                                                                          const UnaryFunction& func)
+  {
+    // Result image is the same size as the input
+    UndistortMapSink<UnaryFunction> sink(rows, columns, func);
+    createUndistortMap(rows, columns, intrinsic, sink);
+    return sink.matResult;
   }
 
   PiiImage::DoubleCoordinateMap undistortMap(int rows, int columns,
@@ -759,4 +777,13 @@ namespace PiiCalibration
   {
     return undistortMap(rows, columns, intrinsic, Pii::Round<int>());
   }
+
+  PiiCompactCoordinateMap undistortMapCompact(int rows, int columns,
+                                              const CameraParameters& intrinsic,
+                                              int tileSize)
+  {
+    PiiCompactCoordinateMap map(rows, columns, rows, columns, tileSize);
+    createUndistortMap(rows, columns, intrinsic, map);
+    return map;
+  }
 }
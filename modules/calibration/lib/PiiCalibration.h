@@ -534,6 +534,18 @@ namespace PiiCalibration
   PII_CALIBRATION_EXPORT PiiImage::IntCoordinateMap undistortMapInt(int rows, int columns,
                                                                     const CameraParameters& intrinsic);
 
+  /**
+   * Creates a compact fixed-point undistortion map. The map produces
+   * the same coordinates as undistortMap(), but takes six bytes per
+   * pixel instead of 16. The full-precision map is never stored in
+   * memory.
+   *
+   * @param tileSize see PiiCompactCoordinateMap::tileSize().
+   */
+  PII_CALIBRATION_EXPORT PiiCompactCoordinateMap undistortMapCompact(int rows, int columns,
+                                                                     const CameraParameters& intrinsic,
+                                                                     int tileSize = 0);
+
   /**
    * Removes lens distortions from *sourceImage*. This function first
    * creates an undistortion map with undistortMap() and then applies
@@ -18,7 +18,10 @@
 #include <PiiYdinTypes.h>
 
 PiiUndistortOperation::Data::Data() :
-  interpolation(Pii::LinearInterpolation)
+  interpolation(Pii::LinearInterpolation),
+  bCompactMap(true),
+  iTileSize(0),
+  iUndistortThreadCount(0)
 {
   intrinsic.focalLength.x = 1000;
   intrinsic.focalLength.y = 1000;
@@ -60,6 +63,7 @@ void PiiUndistortOperation::invalidate()
   PII_D;
   d->dmatMap.resize(0,0);
   d->imatMap.resize(0,0);
+  d->mapCompactMaps.clear();
 }
 
 void PiiUndistortOperation::process()
@@ -74,11 +78,40 @@ void PiiUndistortOperation::process()
     }
 }
 
+PiiCalibration::CameraParameters PiiUndistortOperation::intrinsicFor(int rows, int columns) const
+{
+  PiiCalibration::CameraParameters intrinsic(_d()->intrinsic);
+  if (Pii::isNan(intrinsic.center.x))
+    intrinsic.center.x = double(columns/2 - 0.5);
+  if (Pii::isNan(intrinsic.center.y))
+    intrinsic.center.y = double(rows/2 - 0.5);
+  return intrinsic;
+}
+
+const PiiCompactCoordinateMap& PiiUndistortOperation::compactMapFor(int rows, int columns)
+{
+  PII_D;
+  QPair<int,int> size(rows, columns);
+  QMap<QPair<int,int>, PiiCompactCoordinateMap>::iterator i = d->mapCompactMaps.find(size);
+  if (i == d->mapCompactMaps.end())
+    i = d->mapCompactMaps.insert(size, PiiCalibration::undistortMapCompact(rows, columns,
+                                                                           intrinsicFor(rows, columns),
+                                                                           d->iTileSize));
+  return i.value();
+}
+
 template <class T> void PiiUndistortOperation::undistort(const PiiVariant& obj)
 {
   PII_D;
   PiiMatrix<T> matImage(obj.valueAs<PiiMatrix<T> >());
 
+  if (d->interpolation == Pii::LinearInterpolation && d->bCompactMap)
+    {
+      emitObject(PiiImage::remap(matImage, compactMapFor(matImage.rows(), matImage.columns()),
+                                 d->iUndistortThreadCount));
+      return;
+    }
+
   PiiTypelessMatrix* pMat = d->interpolation == Pii::LinearInterpolation ?
     static_cast<PiiTypelessMatrix*>(&d->dmatMap) :
     static_cast<PiiTypelessMatrix*>(&d->imatMap);
@@ -86,11 +119,7 @@ template <class T> void PiiUndistortOperation::undistort(const PiiVariant& obj)
   if (pMat->rows() != matImage.rows() ||
       pMat->columns() != matImage.columns())
     {
-      PiiCalibration::CameraParameters intrinsic(_d()->intrinsic);
-      if (Pii::isNan(intrinsic.center.x))
-        intrinsic.center.x = double(matImage.columns()/2 - 0.5);
-      if (Pii::isNan(intrinsic.center.y))
-        intrinsic.center.y = double(matImage.rows()/2 - 0.5);
+      PiiCalibration::CameraParameters intrinsic(intrinsicFor(matImage.rows(), matImage.columns()));
       if (d->interpolation == Pii::LinearInterpolation)
         d->dmatMap = PiiCalibration::undistortMap(matImage.rows(), matImage.columns(), intrinsic);
       else
@@ -155,3 +184,9 @@ PiiVariant PiiUndistortOperation::cameraParameters() const
 
 void PiiUndistortOperation::setInterpolation(Pii::Interpolation interpolation) { _d()->interpolation = interpolation; }
 Pii::Interpolation PiiUndistortOperation::interpolation() const { return _d()->interpolation; }
+void PiiUndistortOperation::setCompactMap(bool compactMap) { _d()->bCompactMap = compactMap; }
+bool PiiUndistortOperation::compactMap() const { return _d()->bCompactMap; }
+void PiiUndistortOperation::setTileSize(int tileSize) { _d()->iTileSize = tileSize; invalidate(); }
+int PiiUndistortOperation::tileSize() const { return _d()->iTileSize; }
+void PiiUndistortOperation::setUndistortThreadCount(int undistortThreadCount) { _d()->iUndistortThreadCount = undistortThreadCount; }
+int PiiUndistortOperation::undistortThreadCount() const { return _d()->iUndistortThreadCount; }
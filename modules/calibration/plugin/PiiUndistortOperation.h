@@ -18,6 +18,8 @@
 
 #include <PiiDefaultOperation.h>
 #include "PiiCalibration.h"
+#include <QMap>
+#include <QPair>
 
 /**
  * Corrects lens distortion.
@@ -97,6 +99,28 @@ class PiiUndistortOperation : public PiiDefaultOperation
    */
   Q_PROPERTY(Pii::Interpolation interpolation READ interpolation WRITE setInterpolation);
 
+  /**
+   * Use a compact fixed-point undistortion map with linear
+   * interpolation. A floating-point map takes 16 bytes per pixel,
+   * and reading it dominates the processing time with large images.
+   * The compact map (see PiiCompactCoordinateMap) takes six bytes per
+   * pixel and quantizes the interpolation weights to 1/128 of a pixel.
+   * The default value is `true`.
+   */
+  Q_PROPERTY(bool compactMap READ compactMap WRITE setCompactMap);
+  /**
+   * The size of the tiles in which the compact map is applied. Zero
+   * means that images are processed row by row, which is the best
+   * choice for ordinary lens distortions. The default value is zero.
+   */
+  Q_PROPERTY(int tileSize READ tileSize WRITE setTileSize);
+  /**
+   * The maximum number of threads used for applying the compact map
+   * to a single image. Zero means the number of processor cores.
+   * The default value is zero.
+   */
+  Q_PROPERTY(int undistortThreadCount READ undistortThreadCount WRITE setUndistortThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   PiiUndistortOperation();
@@ -126,6 +150,12 @@ protected:
   PiiVariant cameraParameters() const;
   void setInterpolation(Pii::Interpolation interpolation);
   Pii::Interpolation interpolation() const;
+  void setCompactMap(bool compactMap);
+  bool compactMap() const;
+  void setTileSize(int tileSize);
+  int tileSize() const;
+  void setUndistortThreadCount(int undistortThreadCount);
+  int undistortThreadCount() const;
 
 private:
   /// @internal
@@ -137,12 +167,19 @@ private:
     PiiCalibration::CameraParameters intrinsic;
     PiiImage::DoubleCoordinateMap dmatMap;
     PiiImage::IntCoordinateMap imatMap;
+    // Compact maps for each input resolution seen so far.
+    QMap<QPair<int,int>, PiiCompactCoordinateMap> mapCompactMaps;
     Pii::Interpolation interpolation;
+    bool bCompactMap;
+    int iTileSize;
+    int iUndistortThreadCount;
   };
   PII_D_FUNC;
 
   template <class T> void undistort(const PiiVariant& obj);
   void invalidate();
+  PiiCalibration::CameraParameters intrinsicFor(int rows, int columns) const;
+  const PiiCompactCoordinateMap& compactMapFor(int rows, int columns);
 };
 
 
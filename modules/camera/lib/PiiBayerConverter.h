@@ -18,7 +18,11 @@
 
 #include <PiiMatrix.h>
 #include <PiiColor.h>
+#include <PiiParallel.h>
 #include <PiiCameraGlobal.h>
+#include "PiiCamera.h"
+
+#include <limits>
 
 namespace PiiCamera
 {
@@ -591,6 +595,7 @@ namespace PiiCamera
                              decoder.interpolatorG00.bottomLeft(row0, row1),
                              decoder.interpolatorB00.bottomLeft(row0, row1));
 
+        ++row0; ++row1;
         // Bottom Row
         for (c = 1; c<encoded.columns()-1; ++c, ++row0, ++row1)
           {
@@ -616,6 +621,358 @@ namespace PiiCamera
       }
   }
 
+  /**
+   * Interpolation methods for [demosaic()].
+   *
+   * - `BilinearInterpolation` - missing color channels are averaged
+   * from the nearest neighbors that carry the channel. The result is
+   * identical to that of [bayerToRgb()].
+   *
+   * - `EdgeAwareInterpolation` - the green channel is interpolated
+   * along the direction of the smaller gradient (Hamilton-Adams), and
+   * red and blue are reconstructed from color differences to the
+   * interpolated green. This reduces the color fringes and zipper
+   * artifacts bilinear interpolation produces at sharp edges. Pixels
+   * on the image border are interpolated bilinearly.
+   */
+  enum BayerInterpolation
+    {
+      BilinearInterpolation,
+      EdgeAwareInterpolation
+    };
+
+  /// @hide
+  template <class T> inline void storeBayerPixel(T& target, int r, int g, int b, int shift)
+  {
+    target = T(((r + g + b) / 3) >> shift);
+  }
+
+  template <class T> inline void storeBayerPixel(PiiColor<T>& target, int r, int g, int b, int shift)
+  {
+    target = PiiColor<T>(T(r >> shift), T(g >> shift), T(b >> shift));
+  }
+
+  template <class T> inline void storeBayerPixel(PiiColor4<T>& target, int r, int g, int b, int shift)
+  {
+    target = PiiColor4<T>(T(r >> shift), T(g >> shift), T(b >> shift));
+  }
+
+  template <class T, class U> class BayerDemosaicer
+  {
+  public:
+    BayerDemosaicer(const PiiMatrix<T>& encoded, PiiMatrix<U>& result,
+                    ImageFormat format, BayerInterpolation interpolation, int shift) :
+      _encoded(encoded),
+      _pResult(reinterpret_cast<char*>(result.row(0))),
+      _iStride(result.stride()),
+      _iRows(encoded.rows()),
+      _iColumns(encoded.columns()),
+      _iRedRow(format == BayerGBRGFormat || format == BayerBGGRFormat ? 1 : 0),
+      _iRedColumn(format == BayerGRBGFormat || format == BayerBGGRFormat ? 1 : 0),
+      _iShift(shift),
+      _iMaxValue(std::numeric_limits<T>::max()),
+      _interpolation(interpolation)
+    {}
+
+    void operator() (int begin, int end, int /*band*/)
+    {
+      if (_interpolation == EdgeAwareInterpolation)
+        edgeAwareBand(begin, end);
+      else
+        {
+          for (int r=begin; r<end; ++r)
+            {
+              if (r == 0 || r == _iRows-1)
+                borderRow(r);
+              else if (isRedRow(r))
+                bilinearRow<true>(r);
+              else
+                bilinearRow<false>(r);
+            }
+        }
+    }
+
+  private:
+    U* resultRow(int r) const { return reinterpret_cast<U*>(_pResult + r * _iStride); }
+    bool isRedRow(int r) const { return ((r ^ _iRedRow) & 1) == 0; }
+    // 0 = red, 1 = green, 2 = blue
+    int channel(int r, int c) const
+    {
+      bool bColor = ((c ^ _iRedColumn) & 1) == (isRedRow(r) ? 0 : 1);
+      return bColor ? (isRedRow(r) ? 0 : 2) : 1;
+    }
+
+    void add(int r, int c, int& sum, int& count) const
+    {
+      if (r >= 0 && r < _iRows && c >= 0 && c < _iColumns)
+        {
+          sum += _encoded(r,c);
+          ++count;
+        }
+    }
+    int straight(int r, int c) const
+    {
+      int iSum = 0, iCount = 0;
+      add(r-1, c, iSum, iCount); add(r, c-1, iSum, iCount);
+      add(r, c+1, iSum, iCount); add(r+1, c, iSum, iCount);
+      return iSum / iCount;
+    }
+    int diagonal(int r, int c) const
+    {
+      int iSum = 0, iCount = 0;
+      add(r-1, c-1, iSum, iCount); add(r-1, c+1, iSum, iCount);
+      add(r+1, c-1, iSum, iCount); add(r+1, c+1, iSum, iCount);
+      return iSum / iCount;
+    }
+    int vertical(int r, int c) const
+    {
+      int iSum = 0, iCount = 0;
+      add(r-1, c, iSum, iCount); add(r+1, c, iSum, iCount);
+      return iSum / iCount;
+    }
+    int horizontal(int r, int c) const
+    {
+      int iSum = 0, iCount = 0;
+      add(r, c-1, iSum, iCount); add(r, c+1, iSum, iCount);
+      return iSum / iCount;
+    }
+
+    // Bilinear interpolation with bounds checking. Averaging the
+    // neighbors that fall inside the image reproduces the border
+    // handling of bayerToRgb().
+    void borderPixel(int r, int c, U& target) const
+    {
+      int iCenter = _encoded(r,c);
+      switch (channel(r,c))
+        {
+        case 0:
+          storeBayerPixel(target, iCenter, straight(r,c), diagonal(r,c), _iShift);
+          break;
+        case 2:
+          storeBayerPixel(target, diagonal(r,c), straight(r,c), iCenter, _iShift);
+          break;
+        default:
+          if (isRedRow(r))
+            storeBayerPixel(target, horizontal(r,c), iCenter, vertical(r,c), _iShift);
+          else
+            storeBayerPixel(target, vertical(r,c), iCenter, horizontal(r,c), _iShift);
+        }
+    }
+
+    void borderRow(int r) const
+    {
+      U* pTarget = resultRow(r);
+      for (int c=0; c<_iColumns; ++c)
+        borderPixel(r, c, pTarget[c]);
+    }
+
+    // x is the non-green channel present on the row (red on red
+    // rows), y the other one.
+    template <bool redRow> void store(U& target, int x, int g, int y) const
+    {
+      if (redRow)
+        storeBayerPixel(target, x, g, y, _iShift);
+      else
+        storeBayerPixel(target, y, g, x, _iShift);
+    }
+
+    template <bool redRow> void bilinearRow(int r) const
+    {
+      const T* p0 = _encoded.row(r-1), *p1 = _encoded.row(r), *p2 = _encoded.row(r+1);
+      U* pTarget = resultRow(r);
+      const int iLast = _iColumns-1;
+      borderPixel(r, 0, pTarget[0]);
+      int c = 1;
+      // Make c point to a non-green pixel so that the loop can step
+      // two pixels at a time without testing parity.
+      if (channel(r,c) == 1 && c < iLast)
+        {
+          store<redRow>(pTarget[c], (p1[c-1] + p1[c+1]) >> 1, p1[c], (p0[c] + p2[c]) >> 1);
+          ++c;
+        }
+      for (; c+1 < iLast; c += 2)
+        {
+          store<redRow>(pTarget[c],
+                        p1[c],
+                        (p0[c] + p1[c-1] + p1[c+1] + p2[c]) >> 2,
+                        (p0[c-1] + p0[c+1] + p2[c-1] + p2[c+1]) >> 2);
+          const int c1 = c+1;
+          store<redRow>(pTarget[c1], (p1[c] + p1[c1+1]) >> 1, p1[c1], (p0[c1] + p2[c1]) >> 1);
+        }
+      if (c < iLast)
+        store<redRow>(pTarget[c],
+                      p1[c],
+                      (p0[c] + p1[c-1] + p1[c+1] + p2[c]) >> 2,
+                      (p0[c-1] + p0[c+1] + p2[c-1] + p2[c+1]) >> 2);
+      if (iLast > 0)
+        borderPixel(r, iLast, pTarget[iLast]);
+    }
+
+    int clamp(int value) const { return value < 0 ? 0 : value > _iMaxValue ? _iMaxValue : value; }
+
+    // Interpolates the green channel on row r into green.
+    void greenRow(int r, int* green) const
+    {
+      const bool bBorderRow = r == 0 || r == _iRows-1;
+      const bool bWideRow = r > 1 && r < _iRows-2;
+      const T* p1 = _encoded.row(r);
+      for (int c=0; c<_iColumns; ++c)
+        {
+          if (channel(r,c) == 1)
+            green[c] = p1[c];
+          else if (bBorderRow || c == 0 || c == _iColumns-1)
+            green[c] = straight(r,c);
+          else
+            {
+              const T* p0 = _encoded.row(r-1), *p2 = _encoded.row(r+1);
+              int iGradH = qAbs(p1[c-1] - p1[c+1]), iGradV = qAbs(p0[c] - p2[c]);
+              int iSumH = p1[c-1] + p1[c+1], iSumV = p0[c] + p2[c];
+              // Hamilton-Adams: correct with the second derivative of
+              // the color channel if there is room for it.
+              if (bWideRow && c > 1 && c < _iColumns-2)
+                {
+                  int iLaplaceH = 2*p1[c] - p1[c-2] - p1[c+2];
+                  int iLaplaceV = 2*p1[c] - _encoded(r-2,c) - _encoded(r+2,c);
+                  iGradH += qAbs(iLaplaceH);
+                  iGradV += qAbs(iLaplaceV);
+                  iSumH = 2*iSumH + iLaplaceH;
+                  iSumV = 2*iSumV + iLaplaceV;
+                }
+              else
+                {
+                  iSumH *= 2;
+                  iSumV *= 2;
+                }
+              if (iGradH < iGradV)
+                green[c] = clamp(iSumH >> 2);
+              else if (iGradV < iGradH)
+                green[c] = clamp(iSumV >> 2);
+              else
+                green[c] = clamp((iSumH + iSumV) >> 3);
+            }
+        }
+    }
+
+    template <bool redRow> void edgeAwareRow(int r, const int* g0, const int* g1, const int* g2) const
+    {
+      const T* p0 = _encoded.row(r-1), *p1 = _encoded.row(r), *p2 = _encoded.row(r+1);
+      U* pTarget = resultRow(r);
+      const int iLast = _iColumns-1;
+      borderPixel(r, 0, pTarget[0]);
+      for (int c=1; c<iLast; ++c)
+        {
+          const int g = g1[c];
+          if (channel(r,c) == 1)
+            store<redRow>(pTarget[c],
+                          clamp(g + ((p1[c-1] - g1[c-1] + p1[c+1] - g1[c+1]) >> 1)),
+                          g,
+                          clamp(g + ((p0[c] - g0[c] + p2[c] - g2[c]) >> 1)));
+          else
+            store<redRow>(pTarget[c],
+                          p1[c],
+                          g,
+                          clamp(g + ((p0[c-1] - g0[c-1] + p0[c+1] - g0[c+1] +
+                                      p2[c-1] - g2[c-1] + p2[c+1] - g2[c+1]) >> 2)));
+        }
+      borderPixel(r, iLast, pTarget[iLast]);
+    }
+
+    void edgeAwareBand(int begin, int end) const
+    {
+      // A rolling buffer of three rows of interpolated green.
+      PiiMatrix<int> matGreen(PiiMatrix<int>::uninitialized(3, _iColumns));
+      int iNextGreen = qMax(begin-1, 0);
+      for (int r=begin; r<end; ++r)
+        {
+          if (r == 0 || r == _iRows-1)
+            {
+              borderRow(r);
+              continue;
+            }
+          for (; iNextGreen <= r+1; ++iNextGreen)
+            greenRow(iNextGreen, matGreen.row(iNextGreen % 3));
+          const int* g0 = matGreen.row((r-1) % 3), *g1 = matGreen.row(r % 3), *g2 = matGreen.row((r+1) % 3);
+          if (isRedRow(r))
+            edgeAwareRow<true>(r, g0, g1, g2);
+          else
+            edgeAwareRow<false>(r, g0, g1, g2);
+        }
+    }
+
+    const PiiMatrix<T>& _encoded;
+    char* _pResult;
+    int _iStride, _iRows, _iColumns, _iRedRow, _iRedColumn, _iShift, _iMaxValue;
+    BayerInterpolation _interpolation;
+  };
+  /// @endhide
+
+  /**
+   * Decodes a Bayer-encoded image directly into the final pixel type
+   * in a single pass. Unlike [bayerToRgb()], this function handles
+   * all four Bayer layouts with one implementation, steps two pixels
+   * at a time without per-pixel parity tests, and splits the image
+   * into horizontal bands that are decoded in parallel.
+   *
+   * @param encoded a Bayer-encoded image. Typically `unsigned char` or
+   * `unsigned short`.
+   *
+   * @param result the decoded image, preallocated to the size of
+   * *encoded*. The pixel type can be a scalar (the average of the
+   * color channels is stored), PiiColor or PiiColor4.
+   *
+   * @param format the Bayer layout: `BayerRGGBFormat`,
+   * `BayerBGGRFormat`, `BayerGBRGFormat` or `BayerGRBGFormat`.
+   *
+   * @param interpolation the interpolation method.
+   *
+   * @param shift the number of bits each output channel is shifted to
+   * the right. Use 8 to decode a 16-bit image into 8-bit colors.
+   *
+   * @param threads the maximum number of threads. Zero means the
+   * number of processor cores.
+   *
+   * If the input matrix is smaller than 2x2, no conversion will be
+   * done.
+   */
+  template <class T, class U>
+  void demosaic(const PiiMatrix<T>& encoded,
+                PiiMatrix<U>& result,
+                ImageFormat format,
+                BayerInterpolation interpolation = BilinearInterpolation,
+                int shift = 0,
+                int threads = 0)
+  {
+    if (encoded.rows() < 2 || encoded.columns() < 2)
+      return;
+    BayerDemosaicer<T,U> demosaicer(encoded, result, format, interpolation, shift);
+    Pii::parallelFor(encoded.rows(), demosaicer, threads, qMax(2, 32768 / encoded.columns()));
+  }
+
+  /**
+   * Returns a newly allocated image decoded with [demosaic()].
+   *
+   * ~~~(c++)
+   * PiiMatrix<unsigned short> encoded;
+   * // 16-bit BGGR to 8-bit RGB, edge-aware
+   * PiiMatrix<PiiColor4<> > rgb =
+   *   PiiCamera::demosaic<PiiColor4<> >(encoded,
+   *                                     PiiCamera::BayerBGGRFormat,
+   *                                     PiiCamera::EdgeAwareInterpolation,
+   *                                     8);
+   * ~~~
+   */
+  template <class U, class T>
+  PiiMatrix<U> demosaic(const PiiMatrix<T>& encoded,
+                        ImageFormat format,
+                        BayerInterpolation interpolation = BilinearInterpolation,
+                        int shift = 0,
+                        int threads = 0)
+  {
+    PiiMatrix<U> matResult(PiiMatrix<U>::uninitialized(encoded.rows(), encoded.columns()));
+    demosaic(encoded, matResult, format, interpolation, shift, threads);
+    return matResult;
+  }
+
   /**
    * A convenience function that decodes an RGGB-encoded 8-bit image
    * into a 32-bit RGB color image.
@@ -30,7 +30,10 @@ namespace PiiCamera
    *
    * - `MonoFormat` - the image is monochrome (gray-scale)
    *
-   * - `BayerRGGBFormat` - the image is Bayer-encoded in BGGR color
+   * - `BayerRGGBFormat` - the image is Bayer-encoded in RGGB color
+   * order.
+   *
+   * - `BayerBGGRFormat` - the image is Bayer-encoded in BGGR color
    * order.
    *
    * - `BayerGBRGFormat` - the image is Bayer-encoded in GBRG color
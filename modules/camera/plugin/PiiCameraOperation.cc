@@ -36,7 +36,9 @@ PiiCameraOperation::Data::Data() :
   iFrameCount(-1),
   bWaitPause(false),
   bMissedFrames(false),
-  iMaxMissedIndex(0)
+  iMaxMissedIndex(0),
+  bayerInterpolation(BilinearInterpolation),
+  iBayerThreadCount(0)
 {
 }
 
@@ -263,13 +265,13 @@ template <class T> void PiiCameraOperation::convert(void *frameBuffer,
 
             break;
           }
+        case PiiCamera::BayerRGGBFormat:
         case PiiCamera::BayerBGGRFormat:
-          {
-            PiiMatrix<T> image(d->iImageHeight, d->iImageWidth, frameBuffer, ownership);
-            emitImage(bayerToRgb(image, PiiCamera::BggrDecoder<T>(), PiiCamera::Rgb4Pixel<>()),
-                      Pii::ReleaseOwnership, frameIndex, elapsedTime);
-            break;
-          }
+        case PiiCamera::BayerGBRGFormat:
+        case PiiCamera::BayerGRBGFormat:
+          demosaic(PiiMatrix<T>(d->iImageHeight, d->iImageWidth, frameBuffer, ownership),
+                   frameIndex, elapsedTime);
+          break;
         default:
           {
             PiiMatrix<T> image(d->iImageHeight, d->iImageWidth, frameBuffer, ownership);
@@ -279,6 +281,25 @@ template <class T> void PiiCameraOperation::convert(void *frameBuffer,
     }
 }
 
+template <class T> void PiiCameraOperation::demosaic(const PiiMatrix<T>& image,
+                                                     int frameIndex,
+                                                     qint64 elapsedTime)
+{
+  PII_D;
+  // Decode straight into the output type. 16-bit data is scaled to
+  // 8 bits on the fly.
+  const int iShift = (sizeof(T) - 1) * 8;
+  const PiiCamera::BayerInterpolation interpolation = PiiCamera::BayerInterpolation(d->bayerInterpolation);
+  if (d->imageType == GrayScale)
+    emitImage(PiiCamera::demosaic<unsigned char>(image, d->imageFormat, interpolation,
+                                                 iShift, d->iBayerThreadCount),
+              Pii::ReleaseOwnership, frameIndex, elapsedTime);
+  else
+    emitImage(PiiCamera::demosaic<PiiColor4<> >(image, d->imageFormat, interpolation,
+                                                iShift, d->iBayerThreadCount),
+              Pii::ReleaseOwnership, frameIndex, elapsedTime);
+}
+
 template <class T> void PiiCameraOperation::emitImage(const PiiMatrix<T>& image, Pii::PtrOwnership ownership, int frameIndex, qint64 elapsedTime)
 {
   PII_D;
@@ -459,3 +480,23 @@ bool PiiCameraOperation::copyImage() const
 {
   return _d()->bCopyImage;
 }
+
+void PiiCameraOperation::setBayerInterpolation(BayerInterpolation bayerInterpolation)
+{
+  _d()->bayerInterpolation = bayerInterpolation;
+}
+
+PiiCameraOperation::BayerInterpolation PiiCameraOperation::bayerInterpolation() const
+{
+  return _d()->bayerInterpolation;
+}
+
+void PiiCameraOperation::setBayerThreadCount(int bayerThreadCount)
+{
+  _d()->iBayerThreadCount = bayerThreadCount;
+}
+
+int PiiCameraOperation::bayerThreadCount() const
+{
+  return _d()->iBayerThreadCount;
+}
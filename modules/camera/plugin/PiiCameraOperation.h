@@ -20,6 +20,7 @@
 #include "PiiCameraDriver.h"
 #include <PiiWaitCondition.h>
 #include <PiiTimer.h>
+#include <PiiBayerConverter.h>
 
 /**
  * PiiCameraOperation description
@@ -61,6 +62,23 @@ class PII_CAMERA_EXPORT PiiCameraOperation : public PiiImageReaderOperation, pub
    */
   Q_PROPERTY(bool copyImage READ copyImage WRITE setCopyImage);
 
+  /**
+   * The interpolation method used when decoding Bayer-encoded frames.
+   * Bayer frames are decoded directly into gray levels if
+   * [imageType] is `GrayScale` and into 32-bit RGBA colors otherwise.
+   * 16-bit frames are scaled down to 8 bits. The default is
+   * `BilinearInterpolation`.
+   */
+  Q_PROPERTY(BayerInterpolation bayerInterpolation READ bayerInterpolation WRITE setBayerInterpolation);
+  Q_ENUMS(BayerInterpolation);
+
+  /**
+   * The maximum number of threads used for decoding a Bayer-encoded
+   * frame. Each thread decodes a horizontal band of the frame. Zero
+   * means the number of processor cores. The default is zero.
+   */
+  Q_PROPERTY(int bayerThreadCount READ bayerThreadCount WRITE setBayerThreadCount);
+
   friend struct PiiSerialization::Accessor;
   PII_DECLARE_VIRTUAL_METAOBJECT_FUNCTION;
   template <class Archive> void serialize(Archive& archive, const unsigned int)
@@ -76,6 +94,22 @@ class PII_CAMERA_EXPORT PiiCameraOperation : public PiiImageReaderOperation, pub
       }
   }
 public:
+  /**
+   * Bayer interpolation methods.
+   *
+   * - `BilinearInterpolation` - missing color channels are averaged
+   * from the nearest neighbors.
+   *
+   * - `EdgeAwareInterpolation` - color channels are interpolated
+   * along edges, which reduces color fringes. See
+   * PiiCamera::BayerInterpolation.
+   */
+  enum BayerInterpolation
+    {
+      BilinearInterpolation = PiiCamera::BilinearInterpolation,
+      EdgeAwareInterpolation = PiiCamera::EdgeAwareInterpolation
+    };
+
   PiiCameraOperation();
   ~PiiCameraOperation();
 
@@ -128,6 +162,12 @@ protected:
   void setCopyImage(bool copy);
   bool copyImage() const;
 
+  void setBayerInterpolation(BayerInterpolation bayerInterpolation);
+  BayerInterpolation bayerInterpolation() const;
+
+  void setBayerThreadCount(int bayerThreadCount);
+  int bayerThreadCount() const;
+
   /**
    * Processes an image before delivery. The default implementation
    * returns *image*. Subclasses may add custom functionality by
@@ -139,6 +179,7 @@ protected:
 
 private:
   template <class T> void convert(void *frameBuffer, Pii::PtrOwnership ownership, int frameIndex, qint64 elapsedTime);
+  template <class T> void demosaic(const PiiMatrix<T>& image, int frameIndex, qint64 elapsedTime);
   template <class T> void emitImage(const PiiMatrix<T>& image, Pii::PtrOwnership ownership, int frameIndex, qint64 elapsedTime);
 
   void init();
@@ -163,6 +204,8 @@ protected:
     PiiWaitCondition pauseWaitCondition;
     int iMaxMissedIndex;
     QMutex pauseMutex;
+    BayerInterpolation bayerInterpolation;
+    int iBayerThreadCount;
 
   };
   PII_D_FUNC;
@@ -330,8 +330,8 @@ namespace PiiColors
 #undef PII_LAB_F
 
     return Clr(116*yPerYn - 16,
-               500*xPerXn - yPerYn,
-               200*yPerYn - zPerZn);
+               500*(xPerXn - yPerYn),
+               200*(yPerYn - zPerZn));
   }
 
   template <class Clr> Clr labToXyz(const Clr& labColor,
@@ -14,6 +14,161 @@
  */
 
 #include "PiiColors.h"
+#include "PiiFastColors.h"
+
+#include <PiiParallel.h>
+#include <QVector>
+
+namespace
+{
+  // Counts the pixels whose color equals that of (r,c) on the square
+  // ring of radius distance around it. The ring is clipped to the
+  // image, and the number of ring pixels inside the image is stored
+  // to count.
+  int ringMatches(const PiiMatrix<int>& image, int r, int c, int distance, int* count)
+  {
+    const int iRows = image.rows(), iCols = image.columns();
+    const int iCenter = image(r,c);
+    const int iLeft = qMax(c-distance, 0), iRight = qMin(c+distance, iCols-1);
+    int iSum = 0, iCnt = 0;
+    if (r-distance >= 0)
+      {
+        const int* pRow = image[r-distance];
+        for (int h=iLeft; h<=iRight; ++h)
+          iSum += pRow[h] == iCenter;
+        iCnt += iRight - iLeft + 1;
+      }
+    if (r+distance < iRows)
+      {
+        const int* pRow = image[r+distance];
+        for (int h=iLeft; h<=iRight; ++h)
+          iSum += pRow[h] == iCenter;
+        iCnt += iRight - iLeft + 1;
+      }
+    const int iTop = qMax(r-distance+1, 0), iBottom = qMin(r+distance-1, iRows-1);
+    if (c-distance >= 0)
+      {
+        for (int v=iTop; v<=iBottom; ++v)
+          iSum += image(v, c-distance) == iCenter;
+        iCnt += iBottom - iTop + 1;
+      }
+    if (c+distance < iCols)
+      {
+        for (int v=iTop; v<=iBottom; ++v)
+          iSum += image(v, c+distance) == iCenter;
+        iCnt += iBottom - iTop + 1;
+      }
+    *count = iCnt;
+    return iSum;
+  }
+
+  // The number of pixels compared at a time. The sums of a chunk are
+  // kept in a local array, which lets the compiler vectorize the
+  // comparisons.
+  const int iCorrelogramChunk = 64;
+
+  // Adds one to sums wherever center equals either of the other rows.
+  inline void addMatches(const int* center, const int* other1, const int* other2, int* sums, int count)
+  {
+    for (int i=0; i<count; ++i)
+      sums[i] += int(center[i] == other1[i]) + int(center[i] == other2[i]);
+  }
+
+  // Accumulates correlogram matches over a band of rows. Pixels whose
+  // ring is fully inside the image all have 8d ring pixels. Their
+  // matches are counted as integers, one counter for each distance d
+  // and color, by comparing the center row to shifted copies of the
+  // rows at the ring. This makes the inner loops contiguous and
+  // branch-free. Only the pixels close to image borders need to be
+  // handled one by one. Their fractions of matching ring pixels are
+  // summed directly.
+  struct CorrelogramBand
+  {
+    CorrelogramBand(const PiiMatrix<int>& image, const QList<int>& distances, int levels,
+                    long long* innerMatches, double* borderFractions) :
+      image(image), distances(distances), iLevels(levels),
+      pInnerMatches(innerMatches), pBorderFractions(borderFractions)
+    {}
+
+    void operator() (int firstRow, int lastRow, int band) const
+    {
+      const int iRows = image.rows(), iCols = image.columns();
+      const int iCounters = distances.size() * iLevels;
+      long long* pBandMatches = pInnerMatches + band * iCounters;
+      double* pBandFractions = pBorderFractions + band * iCounters;
+
+      for (int r=firstRow; r<lastRow; ++r)
+        for (int d=0; d<distances.size(); ++d)
+          {
+            const int iDist = distances[d];
+            if (iDist <= 0)
+              continue;
+            long long* pDistMatches = pBandMatches + d * iLevels;
+            double* pDistFractions = pBandFractions + d * iLevels;
+            int iInnerStart = 0, iInnerEnd = 0;
+            if (r >= iDist && r+iDist < iRows && iCols > 2*iDist)
+              {
+                iInnerStart = iDist;
+                iInnerEnd = iCols - iDist;
+                const int* pCenter = image[r];
+                int aSums[iCorrelogramChunk];
+                for (int c=iInnerStart; c<iInnerEnd; c+=iCorrelogramChunk)
+                  {
+                    const int iCount = qMin(iCorrelogramChunk, iInnerEnd - c);
+                    // Full chunks are counted with a constant length.
+                    if (iCount == iCorrelogramChunk)
+                      countInner(r, c, iDist, aSums, iCorrelogramChunk);
+                    else
+                      countInner(r, c, iDist, aSums, iCount);
+                    for (int i=0; i<iCount; ++i)
+                      if (unsigned(pCenter[c+i]) < unsigned(iLevels))
+                        pDistMatches[pCenter[c+i]] += aSums[i];
+                  }
+              }
+            for (int c=0; c<iInnerStart; ++c)
+              countBorder(r, c, iDist, pDistFractions);
+            for (int c=qMax(iInnerEnd, iInnerStart); c<iCols; ++c)
+              countBorder(r, c, iDist, pDistFractions);
+          }
+    }
+
+    // Counts the matches on the rings of count pixels starting at
+    // (r,c).
+    void countInner(int r, int c, int distance, int* sums, int count) const
+    {
+      for (int i=0; i<count; ++i)
+        sums[i] = 0;
+      const int* pCenter = image[r] + c;
+      const int* pTop = image[r-distance] + c, *pBottom = image[r+distance] + c;
+      // Top and bottom rows of the ring
+      for (int dx=-distance; dx<=distance; ++dx)
+        addMatches(pCenter, pTop + dx, pBottom + dx, sums, count);
+      // Left and right columns
+      for (int dy=-distance+1; dy<distance; ++dy)
+        {
+          const int* pRow = image[r+dy] + c;
+          addMatches(pCenter, pRow - distance, pRow + distance, sums, count);
+        }
+    }
+
+    void countBorder(int r, int c, int distance, double* fractions) const
+    {
+      const int iCenter = image(r,c);
+      if (unsigned(iCenter) >= unsigned(iLevels))
+        return;
+      int iCnt;
+      const int iSum = ringMatches(image, r, c, distance, &iCnt);
+      if (iCnt > 0)
+        fractions[iCenter] += double(iSum) / iCnt;
+    }
+
+    const PiiMatrix<int>& image;
+    const QList<int>& distances;
+    const int iLevels;
+    long long* pInnerMatches;
+    double* pBorderFractions;
+  };
+}
 
 namespace PiiColors
 {
@@ -27,211 +182,126 @@ namespace PiiColors
                                      0.212671, 0.715160, 0.072169,
                                      0.019334, 0.119193, 0.950227);
 
+  const int hsvHueScale[256] =
+    {
+      0, 2796203, 1398101, 932068, 699051, 559241, 466034, 399458,
+      349525, 310689, 279620, 254200, 233017, 215093, 199729, 186414,
+      174763, 164483, 155345, 147169, 139810, 133153, 127100, 121574,
+      116508, 111848, 107546, 103563, 99864, 96421, 93207, 90200,
+      87381, 84733, 82241, 79892, 77672, 75573, 73584, 71698,
+      69905, 68200, 66576, 65028, 63550, 62138, 60787, 59494,
+      58254, 57065, 55924, 54828, 53773, 52759, 51782, 50840,
+      49932, 49056, 48210, 47393, 46603, 45839, 45100, 44384,
+      43691, 43019, 42367, 41734, 41121, 40525, 39946, 39383,
+      38836, 38304, 37787, 37283, 36792, 36314, 35849, 35395,
+      34953, 34521, 34100, 33689, 33288, 32897, 32514, 32140,
+      31775, 31418, 31069, 30728, 30394, 30067, 29747, 29434,
+      29127, 28827, 28533, 28244, 27962, 27685, 27414, 27148,
+      26887, 26631, 26379, 26133, 25891, 25653, 25420, 25191,
+      24966, 24745, 24528, 24315, 24105, 23899, 23697, 23498,
+      23302, 23109, 22920, 22733, 22550, 22370, 22192, 22017,
+      21845, 21676, 21509, 21345, 21183, 21024, 20867, 20713,
+      20560, 20410, 20262, 20117, 19973, 19831, 19692, 19554,
+      19418, 19284, 19152, 19022, 18893, 18766, 18641, 18518,
+      18396, 18276, 18157, 18040, 17924, 17810, 17697, 17586,
+      17476, 17368, 17261, 17155, 17050, 16947, 16845, 16744,
+      16644, 16546, 16448, 16352, 16257, 16163, 16070, 15978,
+      15888, 15798, 15709, 15621, 15534, 15449, 15364, 15280,
+      15197, 15115, 15033, 14953, 14873, 14795, 14717, 14640,
+      14564, 14488, 14413, 14340, 14266, 14194, 14122, 14051,
+      13981, 13911, 13843, 13774, 13707, 13640, 13574, 13508,
+      13443, 13379, 13315, 13252, 13190, 13128, 13066, 13006,
+      12945, 12886, 12827, 12768, 12710, 12653, 12596, 12539,
+      12483, 12428, 12373, 12318, 12264, 12210, 12157, 12105,
+      12053, 12001, 11950, 11899, 11848, 11798, 11749, 11700,
+      11651, 11603, 11555, 11507, 11460, 11413, 11367, 11321,
+      11275, 11230, 11185, 11140, 11096, 11052, 11009, 10966
+    };
+
+  const int hsvSaturationScale[256] =
+    {
+      0, 16711680, 8355840, 5570560, 4177920, 3342336, 2785280, 2387383,
+      2088960, 1856853, 1671168, 1519244, 1392640, 1285514, 1193691, 1114112,
+      1044480, 983040, 928427, 879562, 835584, 795794, 759622, 726595,
+      696320, 668467, 642757, 618951, 596846, 576265, 557056, 539086,
+      522240, 506415, 491520, 477477, 464213, 451667, 439781, 428505,
+      417792, 407602, 397897, 388644, 379811, 371371, 363297, 355568,
+      348160, 341055, 334234, 327680, 321378, 315315, 309476, 303849,
+      298423, 293187, 288132, 283249, 278528, 273962, 269543, 265265,
+      261120, 257103, 253207, 249428, 245760, 242198, 238738, 235376,
+      232107, 228927, 225834, 222822, 219891, 217035, 214252, 211540,
+      208896, 206317, 203801, 201346, 198949, 196608, 194322, 192088,
+      189905, 187772, 185685, 183645, 181649, 179695, 177784, 175912,
+      174080, 172285, 170527, 168805, 167117, 165462, 163840, 162249,
+      160689, 159159, 157657, 156184, 154738, 153318, 151924, 150556,
+      149211, 147891, 146594, 145319, 144066, 142835, 141624, 140434,
+      139264, 138113, 136981, 135867, 134772, 133693, 132632, 131588,
+      130560, 129548, 128551, 127570, 126604, 125652, 124714, 123790,
+      122880, 121983, 121099, 120228, 119369, 118523, 117688, 116865,
+      116053, 115253, 114464, 113685, 112917, 112159, 111411, 110673,
+      109945, 109227, 108517, 107817, 107126, 106444, 105770, 105105,
+      104448, 103799, 103159, 102526, 101900, 101283, 100673, 100070,
+      99474, 98886, 98304, 97729, 97161, 96599, 96044, 95495,
+      94953, 94416, 93886, 93361, 92843, 92330, 91822, 91321,
+      90824, 90333, 89848, 89367, 88892, 88422, 87956, 87496,
+      87040, 86589, 86143, 85701, 85264, 84831, 84402, 83978,
+      83558, 83143, 82731, 82324, 81920, 81520, 81125, 80733,
+      80345, 79960, 79579, 79202, 78829, 78459, 78092, 77729,
+      77369, 77012, 76659, 76309, 75962, 75618, 75278, 74940,
+      74606, 74274, 73945, 73620, 73297, 72977, 72659, 72345,
+      72033, 71724, 71417, 71114, 70812, 70513, 70217, 69923,
+      69632, 69343, 69057, 68772, 68490, 68211, 67934, 67659,
+      67386, 67115, 66847, 66580, 66316, 66054, 65794, 65536
+    };
+
 
   PiiMatrix<float> autocorrelogram(const PiiMatrix<int>& image,
                                    int maxDistance,
-                                   int levels)
+                                   int levels,
+                                   int threads)
   {
     QList<int> lstDistances;
     for (int i=1; i<=maxDistance; ++i)
       lstDistances << i;
-    return autocorrelogram(image, lstDistances, levels);
+    return autocorrelogram(image, lstDistances, levels, threads);
   }
 
   PiiMatrix<float> autocorrelogram(const PiiMatrix<int>& image,
                                    const QList<int>& distances,
-                                   int levels)
+                                   int levels,
+                                   int threads)
   {
     if (levels <= 0)
       levels = Pii::max(image) + 1;
     PiiMatrix<float> matCorrelogram(1, levels * distances.size());
-    float* pCorrelogram = matCorrelogram[0];
 
-    const int iRows = image.rows(), iCols = image.columns();
-    for (int d=0; d<distances.size(); ++d)
+    const int iRows = image.rows(), iMinBandRows = Pii::reductionMinBandRows(image.columns());
+    const int iBands = Pii::parallelBandCount(iRows, threads, iMinBandRows);
+    const int iCounters = distances.size() * levels;
+    QVector<long long> vecInnerMatches(iBands * iCounters);
+    QVector<double> vecBorderFractions(iBands * iCounters);
+    CorrelogramBand band(image, distances, levels, vecInnerMatches.data(), vecBorderFractions.data());
+    Pii::parallelFor(iRows, band, threads, iMinBandRows);
+
+    // Each pixel adds the fraction of matching pixels on its ring. The
+    // rings of inner pixels all have 8d pixels.
+    float* pCorrelogram = matCorrelogram[0];
+    for (int d=0; d<distances.size(); ++d, pCorrelogram += levels)
       {
-        const int iDist = distances[d];
-        const int iWindowSize = iDist * 8;
-        if (iRows <= iDist && iCols <= iDist)
+        if (distances[d] <= 0)
           continue;
-
-        const int iLastRow = iRows - iDist, iLastCol = iCols - iDist;
-
-        int r = 0;
-        // Top boundary
-        for (; r<qMin(iDist,iRows); ++r)
+        const double dRingSize = 8 * distances[d];
+        for (int c=0; c<levels; ++c)
           {
-            int iWindowVEnd = r+iDist;
-            const int* pRow = image[r], *pRow1 = 0;
-            if (iWindowVEnd < iRows)
-              pRow1 = image[iWindowVEnd];
-            else
-              iWindowVEnd = iRows-1;
-
-            for (int c=0; c<iCols; ++c)
+            long long iMatches = 0;
+            double dFractions = 0;
+            for (int b=0; b<iBands; ++b)
               {
-                int iSum = 0, iCnt = 0;
-                const int iCenter = pRow[c];
-                if (iCenter >= levels)
-                  continue;
-
-                int iWindowHStart = c-iDist, iWindowHEnd = c+iDist;
-
-                // Verticals
-                if (iWindowHStart >= 0)
-                  {
-                    for (int v=0; v<=iWindowVEnd; ++v)
-                      if (image(v, iWindowHStart) == iCenter)
-                        ++iSum;
-                    iCnt += iWindowVEnd + 1;
-                  }
-                else
-                  iWindowHStart = -1;
-
-                if (iWindowHEnd < iCols)
-                  {
-                    for (int v=0; v<=iWindowVEnd; ++v)
-                      if (image(v, iWindowHEnd) == iCenter)
-                        ++iSum;
-                    iCnt += iWindowVEnd + 1;
-                  }
-                else
-                  iWindowHEnd = iCols;
-
-                // Horizontal
-                if (pRow1 != 0)
-                  {
-                    for (int h=iWindowHStart+1; h<iWindowHEnd; ++h)
-                      if (pRow1[h] == iCenter)
-                        ++iSum;
-                    iCnt += iWindowHEnd - iWindowHStart - 1;
-                  }
-                if (iCnt > 0)
-                  pCorrelogram[iCenter] += float(iSum) / iCnt;
+                iMatches += vecInnerMatches[b * iCounters + d * levels + c];
+                dFractions += vecBorderFractions[b * iCounters + d * levels + c];
               }
+            pCorrelogram[c] = float(double(iMatches) / dRingSize + dFractions);
           }
-
-        // Center
-        for (; r<iLastRow; ++r)
-          {
-            const int iWindowVStart = r-iDist, iWindowVEnd = r+iDist;
-            const int* pRow1 = image[iWindowVStart], *pRow = image[r], *pRow2 = image[iWindowVEnd];
-            int c = 0, iSum = 0, iCnt = 0;
-            // Left center
-            for (; c<qMin(iCols, iDist); ++c)
-              {
-                iSum = 0;
-                const int iCenter = pRow[c], iWindowHEnd = qMin(iCols-1, c+iDist);
-                if (iCenter >= levels)
-                  continue;
-                for (int h=0; h<=iWindowHEnd; ++h)
-                  {
-                    if (pRow1[h] == iCenter)
-                      ++iSum;
-                    if (pRow2[h] == iCenter)
-                      ++iSum;
-                  }
-                iCnt = (iWindowHEnd+1)*2;
-                if (c+iDist < iCols)
-                  {
-                    for (int v=iWindowVStart+1; v<iWindowVEnd; ++v)
-                      if (image(v, iWindowHEnd) == iCenter)
-                        ++iSum;
-                    iCnt += iWindowVEnd - iWindowVStart - 1;
-                  }
-                pCorrelogram[iCenter] += float(iSum) / iCnt;
-              }
-            // Image center
-            for (; c<iLastCol; ++c)
-              {
-                iSum = 0;
-                const int iCenter = pRow[c], iWindowHStart = c-iDist, iWindowHEnd = c+iDist;
-                if (iCenter >= levels)
-                  continue;
-                for (int h=iWindowHStart; h<=iWindowHEnd; ++h)
-                  {
-                    if (pRow1[h] == iCenter)
-                      ++iSum;
-                    if (pRow2[h] == iCenter)
-                      ++iSum;
-                  }
-                for (int v=iWindowVStart+1; v<iWindowVEnd; ++v)
-                  {
-                    if (image(v, iWindowHStart) == iCenter)
-                      ++iSum;
-                    if (image(v, iWindowHEnd) == iCenter)
-                      ++iSum;
-                  }
-                pCorrelogram[iCenter] += float(iSum) / iWindowSize;
-              }
-            // Right center
-            for (; c<iCols; ++c)
-              {
-                iSum = 0, iCnt = 0;
-                const int iCenter = pRow[c], iWindowHStart = qMax(0, c-iDist), iWindowHEnd = iCols-1;
-                if (iCenter >= levels)
-                  continue;
-                for (int h=iWindowHStart; h<=iWindowHEnd; ++h, iCnt += 2)
-                  {
-                    if (pRow1[h] == iCenter)
-                      ++iSum;
-                    if (pRow2[h] == iCenter)
-                      ++iSum;
-                  }
-                if (c-iDist >= 0)
-                  for (int v=iWindowVStart+1; v<iWindowVEnd; ++v, ++iCnt)
-                    if (image(v, iWindowHStart) == iCenter)
-                      ++iSum;
-                pCorrelogram[iCenter] += float(iSum) / iCnt;
-              }
-          }
-
-        // Bottom boundary
-        for (; r<iRows; ++r)
-          {
-            const int iWindowVEnd = iRows-1, iWindowVStart = r-iDist;
-            const int* pRow = image[r], *pRow1 = image[iWindowVStart];
-
-            for (int c=0; c<iCols; ++c)
-              {
-                int iSum = 0, iCnt = 0;
-                const int iCenter = pRow[c];
-                if (iCenter >= levels)
-                  continue;
-
-                int iWindowHStart = c-iDist, iWindowHEnd = c+iDist;
-
-                // Verticals
-                if (iWindowHStart >= 0)
-                  {
-                    for (int v=iWindowVStart; v<=iWindowVEnd; ++v)
-                      if (image(v, iWindowHStart) == iCenter)
-                        ++iSum;
-                    iCnt += iWindowVEnd - iWindowVStart + 1;
-                  }
-                else
-                  iWindowHStart = -1;
-
-                if (iWindowHEnd < iCols)
-                  {
-                    for (int v=iWindowVStart; v<=iWindowVEnd; ++v)
-                      if (image(v, iWindowHEnd) == iCenter)
-                        ++iSum;
-                    iCnt += iWindowVEnd - iWindowVStart + 1;
-                  }
-                else
-                  iWindowHEnd = iCols;
-
-                // Horizontal
-                for (int h=iWindowHStart+1; h<iWindowHEnd; ++h)
-                  if (pRow1[h] == iCenter)
-                    ++iSum;
-                iCnt += iWindowHEnd - iWindowHStart - 1;
-                pCorrelogram[iCenter] += float(iSum) / iCnt;
-              }
-          }
-
-        pCorrelogram += levels;
       }
     return matCorrelogram;
   }
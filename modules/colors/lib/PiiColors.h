@@ -245,14 +245,28 @@ namespace PiiColors
    * @param levels the number of indexed colors in `image`. A
    * non-positive number means auto-detect.
    *
+   * @param threads the number of threads. Zero means the number of
+   * processor cores. Apart from floating-point rounding, the result
+   * does not depend on the number of threads.
+   *
    * @return a 1 by `levels` * `maxDistance` matrix representing the
    * autocorrelogram (folded into a row matrix). Note that if the
    * number of quantization levels is auto-detected, the size of the
    * output may change in successive calls.
+   *
+   * Rows are processed in one pass over all distances. Pixels whose
+   * ring is fully inside the image are compared to shifted copies of
+   * the rows at the ring, one whole row at a time. Their matches are
+   * counted as integers, one counter for each distance and color, and
+   * divided by the ring size 8d at the end. Pixels close to image
+   * borders add their fractions of matching ring pixels directly.
+   * The memory needed is thus proportional to `levels` times the
+   * number of distances.
    */
   PII_COLORS_EXPORT PiiMatrix<float> autocorrelogram(const PiiMatrix<int>& image,
                                                      int maxDistance = 5,
-                                                     int levels = 0);
+                                                     int levels = 0,
+                                                     int threads = 1);
 
   /**
    * Calculate the autocorrelogram of an indexed olor image. This
@@ -267,14 +281,19 @@ namespace PiiColors
    * @param levels the number of indexed colors in `image`. A
    * non-positive number means auto-detect.
    *
-   * @return a 1 by `levels` * `maxDistance` matrix representing the
-   * autocorrelogram (folded into a row matrix). Note that if the
+   * @param threads the number of threads. Zero means the number of
+   * processor cores.
+   *
+   * @return a 1 by `levels` * `distances.size()` matrix representing
+   * the autocorrelogram (folded into a row matrix). Note that if the
    * number of quantization levels is auto-detected, the size of the
-   * output may change in successive calls.
+   * output may change in successive calls. Entries for non-positive
+   * distances are zero.
    */
   PII_COLORS_EXPORT PiiMatrix<float> autocorrelogram(const PiiMatrix<int>& image,
                                                      const QList<int>& distances,
-                                                     int levels = 0);
+                                                     int levels = 0,
+                                                     int threads = 1);
 
   /**
    * Apply gamma correction to a color channel. Gamma correction is
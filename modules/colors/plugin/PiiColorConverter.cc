@@ -16,13 +16,16 @@
 #include "PiiColorConverter.h"
 
 #include "PiiColors.h"
+#include "PiiFastColors.h"
 
 #include <PiiYdinTypes.h>
 #include <PiiMath.h>
 
 PiiColorConverter::Data::Data() :
   colorConversion(GenericConversion),
-  dGamma(1.0/2.2)
+  dGamma(1.0/2.2),
+  bFastConversion(false),
+  iConversionThreadCount(0)
 {
 }
 
@@ -87,8 +90,13 @@ void PiiColorConverter::process()
 
 template <class T> void PiiColorConverter::correctGamma(const PiiVariant& obj)
 {
-  emitObject(PiiColors::correctGamma(obj.valueAs<PiiMatrix<T> >(), _d()->dGamma,
-                                     PiiImage::Traits<T>::max()));
+  PII_D;
+  if (d->bFastConversion)
+    emitObject(PiiColors::fastCorrectGamma(obj.valueAs<PiiMatrix<T> >(), d->dGamma,
+                                           PiiImage::Traits<T>::max(), d->iConversionThreadCount));
+  else
+    emitObject(PiiColors::correctGamma(obj.valueAs<PiiMatrix<T> >(), d->dGamma,
+                                       PiiImage::Traits<T>::max()));
 }
 
 template <class Clr> void PiiColorConverter::convertImage(const PiiVariant& obj)
@@ -97,6 +105,12 @@ template <class Clr> void PiiColorConverter::convertImage(const PiiVariant& obj)
   const PiiMatrix<Clr> image = obj.valueAs<PiiMatrix<Clr> >();
   typedef typename SumTraits<typename Clr::Type>::Type SumType;
 
+  if (d->bFastConversion)
+    {
+      convertImageFast(image);
+      return;
+    }
+
   switch (d->colorConversion)
     {
     case GenericConversion:
@@ -153,24 +167,93 @@ template <class Clr> void PiiColorConverter::convertImage(const PiiVariant& obj)
     }
 }
 
-template <class T, class UnaryFunction>
-void PiiColorConverter::sumColors(const PiiMatrix<T>& image, UnaryFunction func)
-
+template <class Clr> void PiiColorConverter::convertImageFast(const PiiMatrix<Clr>& image)
 {
-  typedef typename UnaryFunction::result_type U;
-  PiiMatrix<U> matResult(PiiMatrix<U>::uninitialized(image.rows(), image.columns()));
+  PII_D;
+  typedef typename SumTraits<typename Clr::Type>::Type SumType;
+  const int iThreads = d->iConversionThreadCount;
 
-  const int iCols = image.columns(), iRows = image.rows();
-  for (int r=0; r<iRows; ++r)
+  switch (d->colorConversion)
     {
-      const T* pInputRow = image[r];
-      U* pOutputRow = matResult[r];
-      for (int c=0; c<iCols; ++c)
-        pOutputRow[c] = func(U(pInputRow[c].channels[0]) +
-                             U(pInputRow[c].channels[1]) +
-                             U(pInputRow[c].channels[2]));
+    case GenericConversion:
+      emitObject(PiiColors::fastGenericConversion(image, d->matGenericConversion, iThreads));
+      break;
+    case RgbToGrayMean:
+      sumColors(image, std::bind2nd(std::divides<SumType>(), 3));
+      break;
+    case RgbToGrayMeanFloat:
+      sumColors(image, std::bind2nd(std::divides<float>(), 3.0f));
+      break;
+    case RgbToGraySum:
+      sumColors(image, Pii::Identity<SumType>());
+      break;
+    case RgbToHsv:
+      emitObject(PiiColors::fastRgbToHsv(image, iThreads));
+      break;
+    case HsvToRgb:
+      emitObject(PiiColors::fastHsvToRgb(image, iThreads));
+      break;
+    case BgrToRgb:
+      emitObject(PiiColors::fastReverseColors(image, iThreads));
+      break;
+    case XyzToLab:
+      emitObject(PiiColors::fastXyzToLab(PiiMatrix<PiiColor<float> >(image), d->clrWhitePoint, iThreads));
+      break;
+    case LabToXyz:
+      emitObject(PiiColors::fastLabToXyz(PiiMatrix<PiiColor<float> >(image), d->clrWhitePoint, iThreads));
+      break;
+    case RgbToLab:
+      emitObject(PiiColors::fastRgbToLab(image, d->matGenericConversion, d->clrWhitePoint, iThreads));
+      break;
+    case RgbToOhtaKanade:
+      emitObject(PiiColors::fastGenericConversion(image, PiiColors::ohtaKanadeMatrix, iThreads));
+      break;
+    case RgbToY719:
+      emitObject(PiiColors::fastRgbToY709(image, iThreads));
+      break;
+    case RgbToYpbpr:
+      emitObject(PiiColors::fastRgbToYpbpr(image, iThreads));
+      break;
+    case YpbprToRgb:
+      emitObject(PiiColors::fastYpbprToRgb(image, iThreads));
+      break;
+    case RgbToYcbcr:
+      emitObject(PiiColors::fastRgbToYcbcr(image, PiiImage::Traits<Clr>::max(), iThreads));
+      break;
+    case YcbcrToRgb:
+      emitObject(PiiColors::fastYcbcrToRgb(image, PiiImage::Traits<Clr>::max(), iThreads));
+      break;
+    case GammaCorrection:
+      emitObject(PiiColors::fastCorrectGamma(image, d->dGamma, PiiImage::Traits<typename Clr::Type>::max(), iThreads));
     }
-  emitObject(matResult);
+}
+
+template <class T, class UnaryFunction> struct PiiColorConverter::SumRows
+{
+  typedef typename UnaryFunction::result_type U;
+
+  SumRows(UnaryFunction func) : func(func) {}
+
+  void operator() (const T* source, U* target, int columns) const
+  {
+    for (int c=0; c<columns; ++c)
+      target[c] = func(U(source[c].channels[0]) +
+                       U(source[c].channels[1]) +
+                       U(source[c].channels[2]));
+  }
+
+  UnaryFunction func;
+};
+
+template <class T, class UnaryFunction>
+void PiiColorConverter::sumColors(const PiiMatrix<T>& image, UnaryFunction func)
+{
+  PII_D;
+  typedef typename UnaryFunction::result_type U;
+  // Without fastConversion, this is the same as a single-threaded
+  // conversion.
+  emitObject(PiiColors::convertRows<U>(image, SumRows<T,UnaryFunction>(func),
+                                       d->bFastConversion ? d->iConversionThreadCount : 1));
 }
 
 void PiiColorConverter::setColorConversion(ColorConversion colorConversion) { _d()->colorConversion = colorConversion; }
@@ -181,3 +264,7 @@ void PiiColorConverter::setWhitePoint(const PiiVariant& whitePoint) { _d()->pWhi
 PiiVariant PiiColorConverter::whitePoint() const { return _d()->pWhitePoint; }
 void PiiColorConverter::setGamma(double gamma) { _d()->dGamma = gamma; }
 double PiiColorConverter::gamma() const { return _d()->dGamma; }
+void PiiColorConverter::setFastConversion(bool fastConversion) { _d()->bFastConversion = fastConversion; }
+bool PiiColorConverter::fastConversion() const { return _d()->bFastConversion; }
+void PiiColorConverter::setConversionThreadCount(int conversionThreadCount) { _d()->iConversionThreadCount = conversionThreadCount; }
+int PiiColorConverter::conversionThreadCount() const { return _d()->iConversionThreadCount; }
@@ -76,6 +76,25 @@ class PiiColorConverter : public PiiDefaultOperation
    */
   Q_PROPERTY(double gamma READ gamma WRITE setGamma);
 
+  /**
+   * Use the fast, multithreaded conversion functions in
+   * PiiFastColors.h instead of the reference implementations. With
+   * 8-bit color channels, `RgbToHsv`, `RgbToYcbcr` and `YcbcrToRgb`
+   * use fixed-point arithmetic and may differ from the reference by
+   * one level. `XyzToLab` and `RgbToLab` use an approximate cube
+   * root, with an absolute error below 1e-3. All other conversions
+   * produce identical results. The default is `false`.
+   */
+  Q_PROPERTY(bool fastConversion READ fastConversion WRITE setFastConversion);
+
+  /**
+   * The maximum number of threads used for converting a single image
+   * if [fastConversion] is enabled. Zero means the number of
+   * processor cores. Small images are always converted in a single
+   * thread. The default is zero.
+   */
+  Q_PROPERTY(int conversionThreadCount READ conversionThreadCount WRITE setConversionThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   /**
@@ -190,6 +209,12 @@ public:
   void setGamma(double gamma);
   double gamma() const;
 
+  void setFastConversion(bool fastConversion);
+  bool fastConversion() const;
+
+  void setConversionThreadCount(int conversionThreadCount);
+  int conversionThreadCount() const;
+
 protected:
   void process();
 
@@ -198,8 +223,10 @@ private:
 
   template <class T> void correctGamma(const PiiVariant& obj);
   template <class Clr> void convertImage(const PiiVariant& obj);
+  template <class Clr> void convertImageFast(const PiiMatrix<Clr>& image);
   template <class T, class UnaryFunction>
   void sumColors(const PiiMatrix<T>& image, UnaryFunction func);
+  template <class T, class UnaryFunction> struct SumRows;
 
   /// @internal
   class Data : public PiiDefaultOperation::Data
@@ -212,6 +239,8 @@ private:
     PiiVariant pWhitePoint;
     PiiColor<float> clrWhitePoint;
     double dGamma;
+    bool bFastConversion;
+    int iConversionThreadCount;
   };
   PII_D_FUNC;
 };
@@ -21,7 +21,8 @@
 
 PiiColorCorrelogramOperation::Data::Data() :
   iLevels(4),
-  bQuantize(true)
+  bQuantize(true),
+  iCorrelogramThreadCount(1)
 {
   lstDistances << 1 << 3 << 5 << 7;
 }
@@ -56,6 +57,8 @@ void PiiColorCorrelogramOperation::setDistances(const QVariantList& distances) {
 QVariantList PiiColorCorrelogramOperation::distances() const { return Pii::listToVariants(_d()->lstDistances); }
 void PiiColorCorrelogramOperation::setQuantize(bool quantize) { _d()->bQuantize = quantize; }
 bool PiiColorCorrelogramOperation::quantize() const { return _d()->bQuantize; }
+void PiiColorCorrelogramOperation::setCorrelogramThreadCount(int correlogramThreadCount) { _d()->iCorrelogramThreadCount = qMax(0, correlogramThreadCount); }
+int PiiColorCorrelogramOperation::correlogramThreadCount() const { return _d()->iCorrelogramThreadCount; }
 
 
 void PiiColorCorrelogramOperation::process()
@@ -82,7 +85,8 @@ template <class Clr> void PiiColorCorrelogramOperation::processColor(const PiiVa
     {
       d->pOutput->emitObject(PiiColors::autocorrelogram(PiiColors::toIndexed(img, d->iLevels),
                                                         d->lstDistances,
-                                                        d->iLevels*d->iLevels*d->iLevels));
+                                                        d->iLevels*d->iLevels*d->iLevels,
+                                                        d->iCorrelogramThreadCount));
     }
   else
     {
@@ -98,9 +102,10 @@ template <class Clr> void PiiColorCorrelogramOperation::processColor(const PiiVa
               d->iLevels * pSource[c].rgbG +
               pSource[c].rgbB;
         }
-      d->pOutput->emitObject(PiiColors::autocorrelogram(img,
+      d->pOutput->emitObject(PiiColors::autocorrelogram(matIndexed,
                                                         d->lstDistances,
-                                                        d->iLevels*d->iLevels*d->iLevels));
+                                                        d->iLevels*d->iLevels*d->iLevels,
+                                                        d->iCorrelogramThreadCount));
     }
 }
 
@@ -115,12 +120,14 @@ template <class T> void PiiColorCorrelogramOperation::processGray(const PiiVaria
       d->pOutput->emitObject(PiiColors::autocorrelogram(Pii::matrix(img.mapped(Pii::unaryCompose(Pii::Round<T>(),
                                                                                                  std::bind2nd(std::multiplies<double>(), dScale)))),
                                                         d->lstDistances,
-                                                        d->iLevels));
+                                                        d->iLevels,
+                                                        d->iCorrelogramThreadCount));
     }
   else
     {
       d->pOutput->emitObject(PiiColors::autocorrelogram(img,
                                                         d->lstDistances,
-                                                        d->iLevels));
+                                                        d->iLevels,
+                                                        d->iCorrelogramThreadCount));
     }
 }
@@ -64,6 +64,14 @@ class PiiColorCorrelogramOperation : public PiiDefaultOperation
    */
   Q_PROPERTY(QVariantList distances READ distances WRITE setDistances);
 
+  /**
+   * The number of threads used in calculating the correlogram. Zero
+   * means the number of processor cores. Apart from floating-point
+   * rounding, the result does not depend on the number of threads.
+   * The default is one.
+   */
+  Q_PROPERTY(int correlogramThreadCount READ correlogramThreadCount WRITE setCorrelogramThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   PiiColorCorrelogramOperation();
@@ -75,6 +83,8 @@ public:
   QVariantList distances() const;
   void setQuantize(bool quantize);
   bool quantize() const;
+  void setCorrelogramThreadCount(int correlogramThreadCount);
+  int correlogramThreadCount() const;
 
   void check(bool reset);
 
@@ -92,6 +102,7 @@ private:
     int iLevels;
     QList<int> lstDistances;
     bool bQuantize;
+    int iCorrelogramThreadCount;
   };
   PII_D_FUNC;
 
@@ -15,18 +15,43 @@
 
 #include "PiiDatabaseWriter.h"
 
+#include <PiiDelay.h>
+
 #include <QSqlDriver>
+#include <QSqlError>
 #include <QMetaType>
 #include <QSqlQuery>
 #include <QFile>
+#include <QMutexLocker>
+#include <QThread>
 
 using namespace PiiYdin;
 
+class PiiDatabaseWriter::Writer : public QThread
+{
+public:
+  Writer(PiiDatabaseWriter* writer) : _pWriter(writer) {}
+
+protected:
+  void run() { _pWriter->writeQueue(); }
+
+private:
+  PiiDatabaseWriter* _pWriter;
+};
+
 PiiDatabaseWriter::Data::Data() :
   bWriteEnabled(true),
   iDecimalsShown(0),
   pQuery(0),
-  pFile(0)
+  pFile(0),
+  iBatchSize(1),
+  iFlushInterval(0),
+  iQueueSize(0),
+  iActiveQueueSize(0),
+  pWriter(0),
+  bWriterRunning(false),
+  bFlushRequested(false),
+  bWriting(false)
 {
 }
 
@@ -41,16 +66,40 @@ PiiDatabaseWriter::PiiDatabaseWriter() :
 {
   setProtectionLevel("columnNames", WriteWhenStoppedOrPaused);
   setProtectionLevel("defaultValues", WriteWhenStoppedOrPaused);
+  // The connection is owned by either the processing thread or the
+  // writer thread, and must not change hands while open.
+  setProtectionLevel("queueSize", WriteWhenStopped);
 }
 
 PiiDatabaseWriter::~PiiDatabaseWriter()
 {
+  stopWriter();
   closeConnection();
 }
 
 void PiiDatabaseWriter::aboutToChangeState(State state)
 {
   PII_D;
+  if (state == Stopped || state == Paused)
+    {
+      // Write pending rows before the connection is closed.
+      try
+        {
+          if (d->pWriter != 0)
+            {
+              if (state == Stopped)
+                stopWriter();
+              else
+                flushQueue();
+            }
+          else
+            flushRows();
+        }
+      catch (PiiException& ex)
+        {
+          piiWarning(ex.message());
+        }
+    }
   if (state == Stopped)
     {
       delete d->pFile, d->pFile = 0;
@@ -61,12 +110,34 @@ void PiiDatabaseWriter::aboutToChangeState(State state)
 
 void PiiDatabaseWriter::check(bool reset)
 {
+  PII_D;
   PiiDefaultOperation::check(reset);
 
-  for (int i=0; i<inputCount(); i++)
-    if (inputAt(i)->isConnected())
-      return;
-  PII_THROW(PiiExecutionException, tr("At least one input must be connected."));
+  bool bConnected = false;
+  for (int i=0; i<inputCount() && !bConnected; i++)
+    bConnected = inputAt(i)->isConnected();
+  if (!bConnected)
+    PII_THROW(PiiExecutionException, tr("At least one input must be connected."));
+
+  // The processing thread only runs when rows arrive. A partial batch
+  // must be flushed by the writer thread, which has its own timer.
+  const int iActiveQueueSize = d->iQueueSize > 0 ? d->iQueueSize :
+    d->iBatchSize > 1 && d->iFlushInterval > 0 ? d->iBatchSize : 0;
+  // batchSize and flushInterval may have been changed while paused.
+  // Pending rows have already been written, but the connection must
+  // be closed before it changes threads.
+  if (!reset && (iActiveQueueSize > 0) != (d->iActiveQueueSize > 0))
+    {
+      if (d->pWriter != 0)
+        stopWriter();
+      else
+        {
+          delete d->pQuery, d->pQuery = 0;
+          delete d->pFile, d->pFile = 0;
+          closeConnection();
+        }
+    }
+  d->iActiveQueueSize = iActiveQueueSize;
 }
 
 void PiiDatabaseWriter::createQuery()
@@ -114,20 +185,29 @@ QSqlDatabase* PiiDatabaseWriter::createDatabase(const QString& driver,
 }
 
 
-void PiiDatabaseWriter::process()
+bool PiiDatabaseWriter::prepareConnection()
 {
   PII_D;
-  if (!d->bWriteEnabled)
-    return;
-
   if (!isConnected() && d->pFile == 0)
     {
       delete d->pQuery, d->pQuery = 0;
       if (openConnection())
         createQuery();
     }
+  return d->pQuery != 0 || d->pFile != 0;
+}
+
+void PiiDatabaseWriter::process()
+{
+  PII_D;
+  if (!d->bWriteEnabled)
+    return;
+
+  // In threaded mode, the writer thread owns the connection.
+  if (d->iActiveQueueSize <= 0)
+    prepareConnection();
 
-  QStringList row;
+  QVariantList row;
   for (int i=0; i<inputCount() && i<d->lstColumnNames.size(); i++)
     {
       QVariant value;
@@ -150,36 +230,293 @@ void PiiDatabaseWriter::process()
       else
         value = d->vecDefaultValues[i];
 
-      // Decimal numbers may need rounding
-      if (d->iDecimalsShown > 0 && value.type() == QVariant::Double)
-        row << QString().setNum(value.toDouble(), 'f', d->iDecimalsShown);
-      else
-        row << value.toString();
+      row << value;
+    }
+
+  if (d->iActiveQueueSize > 0)
+    enqueue(row);
+  else if (d->iBatchSize > 1)
+    {
+      d->lstRows << row;
+      if (d->lstRows.size() >= d->iBatchSize)
+        flushRows();
+    }
+  else
+    writeRows(QList<QVariantList>() << row);
+}
+
+void PiiDatabaseWriter::flushRows()
+{
+  PII_D;
+  QList<QVariantList> lstRows;
+  qSwap(lstRows, d->lstRows);
+  writeRows(lstRows);
+}
+
+void PiiDatabaseWriter::writeRows(const QList<QVariantList>& rows)
+{
+  PII_D;
+  if (rows.isEmpty())
+    return;
+
+  if (d->pQuery != 0)
+    writeQuery(rows);
+  else if (d->pFile != 0)
+    writeFile(rows);
+}
 
+void PiiDatabaseWriter::bindRows(const QList<QVariantList>& rows)
+{
+  PII_D;
+  if (rows.size() == 1)
+    {
+      // Bind the values to a prepared query
+      const QVariantList& row = rows[0];
+      for (int i=0; i<row.size(); ++i)
+        d->pQuery->bindValue(i, row[i].toString());
+      return;
+    }
+
+  // Each placeholder is bound to a list of values, one per row.
+  const int iColumns = rows[0].size();
+  for (int c=0; c<iColumns; ++c)
+    {
+      QVariantList lstValues;
+      for (int r=0; r<rows.size(); ++r)
+        lstValues << rows[r][c].toString();
+      d->pQuery->bindValue(c, lstValues);
+    }
+}
+
+bool PiiDatabaseWriter::writeQuery(const QList<QVariantList>& rows)
+{
+  PII_D;
+  int iRetries = d->iRetryCount;
+  forever
+    {
       if (d->pQuery != 0)
-        // Bind the value to a prepared query
-        d->pQuery->bindValue(i, value.toString());
+        {
+          bindRows(rows);
+          if (rows.size() == 1)
+            {
+              if (d->pQuery->exec())
+                return true;
+            }
+          else
+            {
+              // Without transaction support, execBatch() still saves
+              // the overhead of binding, but each row will be
+              // committed separately.
+              const bool bTransaction = driver()->hasFeature(QSqlDriver::Transactions) &&
+                db()->transaction();
+              // If the driver doesn't support batch operations, Qt
+              // emulates them by executing the query once for each
+              // row.
+              if (d->pQuery->execBatch())
+                {
+                  if (!bTransaction || db()->commit())
+                    return true;
+                  error(tr("Cannot commit a batch of %1 rows: %2").arg(rows.size()).arg(db()->lastError().text()));
+                  return false;
+                }
+              // Discard partially written batches so that retrying
+              // doesn't create duplicate rows.
+              if (bTransaction)
+                db()->rollback();
+            }
+          if (d->pQuery->lastError().type() != QSqlError::ConnectionError)
+            break;
+        }
+      // Pending rows are also written while stopping or pausing.
+      const State currentState = state();
+      if (iRetries-- <= 0 ||
+          (currentState != Running && currentState != Stopping && currentState != Pausing))
+        break;
+      PiiDelay::msleep(d->iRetryDelay);
+      reconnect();
     }
 
   if (d->pQuery != 0)
+    return checkQuery(*d->pQuery);
+  error(tr("Cannot write %1 rows because the database connection was lost.").arg(rows.size()));
+  return false;
+}
+
+void PiiDatabaseWriter::reconnect()
+{
+  PII_D;
+  delete d->pQuery, d->pQuery = 0;
+  closeConnection();
+  try
     {
-      // Try to execute the query
-      exec(*d->pQuery);
+      prepareConnection();
     }
-  else if (d->pFile != 0)
+  catch (PiiExecutionException&)
+    {
+      // Failed attempts count as retries.
+    }
+}
+
+void PiiDatabaseWriter::writeFile(const QList<QVariantList>& rows)
+{
+  PII_D;
+  for (int r=0; r<rows.size(); ++r)
     {
+      const QVariantList& row = rows[r];
       for (int i=0; i<row.size(); i++)
         {
           if (i)
             d->pFile->putChar(',');
-          QString value = row[i].replace('"', "\"\"");
+          QString value;
+          // Decimal numbers may need rounding
+          if (d->iDecimalsShown > 0 && row[i].type() == QVariant::Double)
+            value.setNum(row[i].toDouble(), 'f', d->iDecimalsShown);
+          else
+            value = row[i].toString();
+          value.replace('"', "\"\"");
           d->pFile->putChar('"');
           d->pFile->write(value.toUtf8());
           d->pFile->putChar('"');
         }
       d->pFile->putChar('\n');
-      d->pFile->flush();
     }
+  d->pFile->flush();
+}
+
+void PiiDatabaseWriter::enqueue(const QVariantList& row)
+{
+  PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  if (d->pWriter == 0)
+    {
+      d->bWriterRunning = true;
+      d->strWriterError.clear();
+      d->pWriter = new Writer(this);
+      d->pWriter->start();
+    }
+
+  while (d->lstRows.size() >= d->iActiveQueueSize && d->strWriterError.isEmpty())
+    d->rowsWritten.wait(&d->queueMutex);
+
+  if (!d->strWriterError.isEmpty())
+    {
+      QString strError(d->strWriterError);
+      lock.unlock();
+      PII_THROW(PiiExecutionException, strError);
+    }
+
+  if (d->lstRows.isEmpty())
+    d->flushTimer.start();
+  d->lstRows << row;
+  d->rowAdded.wakeOne();
+}
+
+void PiiDatabaseWriter::writeQueue()
+{
+  PII_D;
+  try
+    {
+      QMutexLocker lock(&d->queueMutex);
+      forever
+        {
+          // The batch size may change while paused.
+          const int iBatchSize = d->iBatchSize;
+          // Wait until there is a full batch, the oldest row has
+          // waited long enough, or a flush has been requested.
+          while (d->bWriterRunning && !d->bFlushRequested && d->lstRows.size() < iBatchSize)
+            {
+              if (d->lstRows.isEmpty() || d->iFlushInterval <= 0)
+                d->rowAdded.wait(&d->queueMutex);
+              else
+                {
+                  int iRemaining = d->iFlushInterval - d->flushTimer.elapsed();
+                  if (iRemaining <= 0)
+                    break;
+                  d->rowAdded.wait(&d->queueMutex, iRemaining);
+                }
+            }
+
+          if (d->lstRows.isEmpty())
+            {
+              d->bFlushRequested = false;
+              d->rowsWritten.wakeAll();
+              // Pending rows are written even after a stop request.
+              if (!d->bWriterRunning)
+                break;
+              continue;
+            }
+
+          QList<QVariantList> lstBatch;
+          if (d->lstRows.size() <= iBatchSize)
+            qSwap(lstBatch, d->lstRows);
+          else
+            {
+              lstBatch = d->lstRows.mid(0, iBatchSize);
+              d->lstRows.erase(d->lstRows.begin(), d->lstRows.begin() + iBatchSize);
+              d->flushTimer.start();
+            }
+          d->bWriting = true;
+          // Make room for new rows while this batch is being written.
+          d->rowsWritten.wakeAll();
+          lock.unlock();
+
+          if (prepareConnection())
+            writeRows(lstBatch);
+
+          lock.relock();
+          d->bWriting = false;
+          d->rowsWritten.wakeAll();
+        }
+    }
+  catch (PiiException& ex)
+    {
+      // The error will be reported to the processing thread. Rows
+      // that cannot be written anymore are discarded.
+      synchronized (d->queueMutex)
+        {
+          d->strWriterError = ex.message();
+          d->lstRows.clear();
+          d->bWriting = false;
+          d->bFlushRequested = false;
+          d->rowsWritten.wakeAll();
+        }
+    }
+
+  // The connection must be closed in the thread that opened it.
+  delete d->pQuery, d->pQuery = 0;
+  delete d->pFile, d->pFile = 0;
+  closeConnection();
+}
+
+void PiiDatabaseWriter::flushQueue()
+{
+  PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  if (d->pWriter == 0)
+    return;
+  d->bFlushRequested = true;
+  d->rowAdded.wakeOne();
+  while ((!d->lstRows.isEmpty() || d->bWriting) && d->strWriterError.isEmpty())
+    d->rowsWritten.wait(&d->queueMutex);
+}
+
+void PiiDatabaseWriter::stopWriter()
+{
+  PII_D;
+  if (d->pWriter == 0)
+    return;
+
+  synchronized (d->queueMutex)
+    {
+      d->bWriterRunning = false;
+      d->rowAdded.wakeOne();
+    }
+  // The writer exits once the queue is empty.
+  d->pWriter->wait();
+  delete d->pWriter;
+  d->pWriter = 0;
+  if (!d->strWriterError.isEmpty())
+    piiWarning(d->strWriterError);
 }
 
 PiiInputSocket* PiiDatabaseWriter::input(const QString& name) const
@@ -231,3 +568,12 @@ QString PiiDatabaseWriter::tableName() const { return _d()->strTableName; }
 
 QStringList PiiDatabaseWriter::columnNames() const { return _d()->lstColumnNames; }
 QVariantMap PiiDatabaseWriter::defaultValues() const { return _d()->mapDefaultValues; }
+
+void PiiDatabaseWriter::setBatchSize(int batchSize) { _d()->iBatchSize = qMax(1, batchSize); }
+int PiiDatabaseWriter::batchSize() const { return _d()->iBatchSize; }
+
+void PiiDatabaseWriter::setFlushInterval(int flushInterval) { _d()->iFlushInterval = qMax(0, flushInterval); }
+int PiiDatabaseWriter::flushInterval() const { return _d()->iFlushInterval; }
+
+void PiiDatabaseWriter::setQueueSize(int queueSize) { _d()->iQueueSize = qMax(0, queueSize); }
+int PiiDatabaseWriter::queueSize() const { return _d()->iQueueSize; }
@@ -18,6 +18,10 @@
 
 #include "PiiDatabaseOperation.h"
 #include <QSqlDatabase>
+#include <QList>
+#include <QMutex>
+#include <QTime>
+#include <QWaitCondition>
 
 class QFile;
 class QSqlQuery;
@@ -33,6 +37,23 @@ class QSqlQuery;
  * This operation adds "csv" as a supported connection scheme. See
  * PiiDatabaseOperation::databaseName for examples.
  *
+ * By default, each incoming row is written to the database as soon
+ * as it arrives. With most SQL back-ends, this means one implicit
+ * transaction per row, which limits the achievable write rate. Setting
+ * [batchSize] to a value larger than one makes the operation collect
+ * rows and write them to the database in a single transaction. If
+ * [queueSize] is non-zero, the writes are performed in a background
+ * thread so that slow database connections don't block the
+ * processing pipeline.
+ *
+ * ~~~(c++)
+ * // Write in batches of at most 500 rows, at least once a second,
+ * // in a background thread.
+ * writer->setProperty("batchSize", 500);
+ * writer->setProperty("flushInterval", 1000);
+ * writer->setProperty("queueSize", 5000);
+ * ~~~
+ *
  * Inputs
  * ------
  *
@@ -90,6 +111,40 @@ class PiiDatabaseWriter : public PiiDatabaseOperation
    */
   Q_PROPERTY(int decimalsShown READ decimalsShown WRITE setDecimalsShown);
 
+  /**
+   * The maximum number of rows written to the database at once. If
+   * this value is larger than one, incoming rows will be collected
+   * and written in a single transaction using a batch query once
+   * *batchSize* rows have been received, [flushInterval] has elapsed,
+   * or the operation is paused or stopped. Drivers that don't support
+   * transactions or batch operations fall back to executing the rows
+   * one by one. If the connection is lost, it will be reopened, and
+   * the rows will be written again as specified by [retryCount] and
+   * [retryDelay], also when flushing pending rows on pause or stop.
+   * The default is 1, which writes each row immediately.
+   */
+  Q_PROPERTY(int batchSize READ batchSize WRITE setBatchSize);
+
+  /**
+   * The maximum time, in milliseconds, a row may wait for the batch
+   * to fill up before it will be written. Zero disables time-based
+   * flushing. If [queueSize] is zero, a background writer with room
+   * for one batch will be started so that rows are flushed in time
+   * even if no new rows arrive. The default is zero.
+   */
+  Q_PROPERTY(int flushInterval READ flushInterval WRITE setFlushInterval);
+
+  /**
+   * The maximum number of rows waiting to be written by a background
+   * writer thread. If this value is non-zero, the database connection
+   * will be opened and all rows written in a separate thread, and
+   * process() only adds rows to a queue. If the queue is full, the
+   * operation waits for the writer to catch up. Errors in the
+   * background thread will be reported when the next row arrives.
+   * The default is zero, which writes rows in the processing thread.
+   */
+  Q_PROPERTY(int queueSize READ queueSize WRITE setQueueSize);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 
 public:
@@ -126,7 +181,19 @@ protected:
   QString tableName() const;
   void setTableName(const QString& tableName);
 
+  void setBatchSize(int batchSize);
+  int batchSize() const;
+
+  void setFlushInterval(int flushInterval);
+  int flushInterval() const;
+
+  void setQueueSize(int queueSize);
+  int queueSize() const;
+
 private:
+  class Writer;
+  friend class Writer;
+
   void initializeDefaults();
 
   /// @internal
@@ -144,10 +211,33 @@ private:
     int iDecimalsShown;
     QSqlQuery* pQuery;
     QFile *pFile;
+    int iBatchSize;
+    int iFlushInterval;
+    int iQueueSize;
+    int iActiveQueueSize;
+
+    QList<QVariantList> lstRows;
+    QTime flushTimer;
+    QMutex queueMutex;
+    QWaitCondition rowAdded, rowsWritten;
+    Writer* pWriter;
+    bool bWriterRunning, bFlushRequested, bWriting;
+    QString strWriterError;
   };
   PII_D_FUNC;
 
   void createQuery();
+  bool prepareConnection();
+  void writeRows(const QList<QVariantList>& rows);
+  void bindRows(const QList<QVariantList>& rows);
+  bool writeQuery(const QList<QVariantList>& rows);
+  void reconnect();
+  void writeFile(const QList<QVariantList>& rows);
+  void flushRows();
+  void enqueue(const QVariantList& row);
+  void writeQueue();
+  void flushQueue();
+  void stopWriter();
 };
 
 
@@ -25,6 +25,12 @@ namespace PiiDsp
                                               WaveletFamily type,
                                               int index)
   {
+    if (type == Biorthogonal)
+      {
+        PiiMatrix<T> matBuffer(mat);
+        liftingDwt(matBuffer, type, hasLiftingScheme(type, index) ? index : 2);
+        return dwtSubbands(matBuffer);
+      }
     QList<PiiMatrix<double> > filters(createScalingWavelets(scalingFilter(type, index)));
     return dwt(mat, PiiMatrix<T>(filters[0]), PiiMatrix<T>(filters[1]));
   }
@@ -112,4 +118,245 @@ namespace PiiDsp
     return result;
   }
 
+  /// @hide
+  // A line of samples in a contiguous array.
+  template <class T> struct LiftingSamples
+  {
+    LiftingSamples(T* data) : pData(data) {}
+
+    // this[n] += first * other[n + firstOffset] + second * other[n + secondOffset]
+    void lift(int begin, int end, const LiftingSamples& other,
+              int firstOffset, T first, int secondOffset, T second) const
+    {
+      T* pTarget = pData;
+      const T* pFirst = other.pData + firstOffset;
+      const T* pSecond = other.pData + secondOffset;
+      for (int n=begin; n<end; ++n)
+        pTarget[n] += first * pFirst[n] + second * pSecond[n];
+    }
+
+    void scale(int count, T factor) const
+    {
+      for (int n=0; n<count; ++n)
+        pData[n] *= factor;
+    }
+
+    T* pData;
+  };
+
+  // A line of rows. Each step processes whole rows, which keeps the
+  // accesses sequential in the vertical direction.
+  template <class T> struct LiftingRows
+  {
+    LiftingRows(T* const * rows, int firstColumn, int lastColumn) :
+      ppRows(rows), iFirstColumn(firstColumn), iLastColumn(lastColumn)
+    {}
+
+    void lift(int begin, int end, const LiftingRows& other,
+              int firstOffset, T first, int secondOffset, T second) const
+    {
+      for (int n=begin; n<end; ++n)
+        {
+          T* pTarget = ppRows[n];
+          const T* pFirst = other.ppRows[n + firstOffset];
+          const T* pSecond = other.ppRows[n + secondOffset];
+          for (int c=iFirstColumn; c<iLastColumn; ++c)
+            pTarget[c] += first * pFirst[c] + second * pSecond[c];
+        }
+    }
+
+    void scale(int count, T factor) const
+    {
+      for (int n=0; n<count; ++n)
+        {
+          T* pRow = ppRows[n];
+          for (int c=iFirstColumn; c<iLastColumn; ++c)
+            pRow[c] *= factor;
+        }
+    }
+
+    T* const * ppRows;
+    int iFirstColumn, iLastColumn;
+  };
+
+  /* Applies the lifting steps to a line whose even samples have been
+   * moved to *even* and odd samples to *odd*. The missing neighbors
+   * at the ends are taken from a symmetric extension, which amounts
+   * to clamping the neighbor index.
+   */
+  template <class T, class Line> void liftLine(const Line& even, int evenCount,
+                                               const Line& odd, int oddCount,
+                                               const LiftingScheme& scheme)
+  {
+    if (oddCount == 0)
+      return;
+    for (int i=0; i<scheme.iStepCount; ++i)
+      {
+        const T first = T(scheme.adFirst[i]), second = T(scheme.adSecond[i]);
+        if ((i & 1) == 0)
+          {
+            // odd[n] += first * even[n] + second * even[n+1]
+            const int iInner = qMin(oddCount, evenCount - 1);
+            odd.lift(0, iInner, even, 0, first, 1, second);
+            if (iInner < oddCount)
+              odd.lift(iInner, oddCount, even, 0, first, 0, second);
+          }
+        else
+          {
+            // even[n] += first * odd[n-1] + second * odd[n]
+            even.lift(0, 1, odd, 0, first, 0, second);
+            const int iInner = qMin(evenCount, oddCount);
+            even.lift(1, iInner, odd, -1, first, 0, second);
+            if (iInner < evenCount)
+              even.lift(iInner, evenCount, odd, -1, first, -1, second);
+          }
+      }
+    even.scale(evenCount, T(scheme.dLowScale));
+    odd.scale(oddCount, T(scheme.dHighScale));
+  }
+
+  // Transforms rows of the approximation and stores them to the work
+  // buffer so that even rows go to the top half and odd rows to the
+  // bottom half.
+  template <class T> struct LiftingRowPass
+  {
+    LiftingRowPass(const QVector<T*>& sourceRows, const QVector<T*>& targetRows,
+                   int columns, const LiftingScheme& scheme) :
+      sourceRows(sourceRows), targetRows(targetRows), iColumns(columns), scheme(scheme)
+    {}
+
+    void operator() (int firstRow, int lastRow, int) const
+    {
+      const int iEvenCount = (iColumns + 1) / 2, iOddCount = iColumns / 2;
+      const int iEvenRows = (sourceRows.size() + 1) / 2;
+      for (int r=firstRow; r<lastRow; ++r)
+        {
+          const T* pSource = sourceRows[r];
+          T* pTarget = targetRows[(r & 1) ? iEvenRows + r/2 : r/2];
+          T* pOdd = pTarget + iEvenCount;
+          for (int c=0; c<iOddCount; ++c)
+            {
+              pTarget[c] = pSource[2*c];
+              pOdd[c] = pSource[2*c+1];
+            }
+          if (iEvenCount > iOddCount)
+            pTarget[iOddCount] = pSource[iColumns-1];
+          if (iColumns > 1)
+            liftLine<T>(LiftingSamples<T>(pTarget), iEvenCount,
+                        LiftingSamples<T>(pOdd), iOddCount, scheme);
+        }
+    }
+
+    const QVector<T*>& sourceRows;
+    const QVector<T*>& targetRows;
+    int iColumns;
+    const LiftingScheme& scheme;
+  };
+
+  // Transforms the work buffer vertically in bands of columns and
+  // copies the result back to the decomposition.
+  template <class T> struct LiftingColumnPass
+  {
+    LiftingColumnPass(const QVector<T*>& workRows, const QVector<T*>& targetRows,
+                      const LiftingScheme& scheme) :
+      workRows(workRows), targetRows(targetRows), scheme(scheme)
+    {}
+
+    void operator() (int firstColumn, int lastColumn, int) const
+    {
+      const int iRows = workRows.size();
+      const int iEvenCount = (iRows + 1) / 2, iOddCount = iRows / 2;
+      if (iRows > 1)
+        liftLine<T>(LiftingRows<T>(workRows.constData(), firstColumn, lastColumn), iEvenCount,
+                    LiftingRows<T>(workRows.constData() + iEvenCount, firstColumn, lastColumn), iOddCount,
+                    scheme);
+      for (int r=0; r<iRows; ++r)
+        {
+          const T* pSource = workRows[r];
+          T* pTarget = targetRows[r];
+          for (int c=firstColumn; c<lastColumn; ++c)
+            pTarget[c] = pSource[c];
+        }
+    }
+
+    const QVector<T*>& workRows;
+    const QVector<T*>& targetRows;
+    const LiftingScheme& scheme;
+  };
+  // One-pixel-wide inputs have empty high-pass subbands.
+  template <class T> PiiMatrix<T> subband(const PiiMatrix<T>& decomposition,
+                                          int r, int c, int rows, int columns)
+  {
+    if (rows == 0 || columns == 0)
+      return PiiMatrix<T>(rows, columns);
+    return decomposition(r, c, rows, columns);
+  }
+  /// @endhide
+
+  template <class T> bool liftingDwt(PiiMatrix<T>& buffer,
+                                     WaveletFamily wavelet,
+                                     int familyMember,
+                                     int levels,
+                                     int threads,
+                                     int firstLevel)
+  {
+    const LiftingScheme* pScheme = liftingScheme(wavelet, familyMember);
+    if (pScheme == 0)
+      return false;
+
+    int iRows = buffer.rows(), iColumns = buffer.columns();
+    for (int i=1; i<firstLevel; ++i)
+      {
+        iRows = (iRows + 1) / 2;
+        iColumns = (iColumns + 1) / 2;
+      }
+    if (firstLevel > levels || iRows == 0 || iColumns == 0)
+      return true;
+
+    // The work buffer is allocated once for the largest level.
+    PiiMatrix<T> matWork(PiiMatrix<T>::uninitialized(iRows, iColumns));
+    QVector<T*> vecBufferRows(iRows), vecWorkRows(iRows);
+    for (int r=0; r<iRows; ++r)
+      {
+        vecBufferRows[r] = buffer.row(r);
+        vecWorkRows[r] = matWork.row(r);
+      }
+
+    for (int iLevel=firstLevel; iLevel<=levels && (iRows > 1 || iColumns > 1); ++iLevel)
+      {
+        vecBufferRows.resize(iRows);
+        vecWorkRows.resize(iRows);
+        LiftingRowPass<T> rowPass(vecBufferRows, vecWorkRows, iColumns, *pScheme);
+        Pii::parallelFor(iRows, rowPass, threads, Pii::reductionMinBandRows(iColumns));
+
+        // Narrow column bands would share cache lines.
+        LiftingColumnPass<T> columnPass(vecWorkRows, vecBufferRows, *pScheme);
+        Pii::parallelFor(iColumns, columnPass, threads, qMax(16, Pii::reductionMinBandRows(iRows)));
+
+        iRows = (iRows + 1) / 2;
+        iColumns = (iColumns + 1) / 2;
+      }
+    return true;
+  }
+
+  template <class T> QList<PiiMatrix<T> > dwtSubbands(const PiiMatrix<T>& decomposition,
+                                                      int level)
+  {
+    int iRows = decomposition.rows(), iColumns = decomposition.columns();
+    int iLowRows = iRows, iLowColumns = iColumns;
+    for (int i=0; i<level; ++i)
+      {
+        iRows = iLowRows;
+        iColumns = iLowColumns;
+        iLowRows = (iRows + 1) / 2;
+        iLowColumns = (iColumns + 1) / 2;
+      }
+    const int iHighRows = iRows - iLowRows, iHighColumns = iColumns - iLowColumns;
+    return QList<PiiMatrix<T> >()
+      << subband(decomposition, 0, 0, iLowRows, iLowColumns)
+      << subband(decomposition, 0, iLowColumns, iLowRows, iHighColumns)
+      << subband(decomposition, iLowRows, 0, iHighRows, iLowColumns)
+      << subband(decomposition, iLowRows, iLowColumns, iHighRows, iHighColumns);
+  }
 }
+
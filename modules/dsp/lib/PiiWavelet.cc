@@ -97,4 +97,48 @@ namespace PiiDsp
         return daubechiesScalingFilter(1);
       }
   }
+
+  const LiftingScheme* liftingScheme(WaveletFamily family, int index)
+  {
+    // Daubechies & Sweldens: Factoring wavelet transforms into lifting
+    // steps. The signs and scales of Haar match those of dwt().
+    static const LiftingScheme haar =
+      { 2, { -1, 0 }, { 0, 0.5 }, 1.41421356237309504880, -0.70710678118654752440 };
+    static const LiftingScheme daubechies2 =
+      { 3,
+        { -1.73205080756887729353, -0.06698729810778067662, 0 },
+        { 0, 0.43301270189221932338, 1 },
+        1.93185165257813657349, 0.51763809020504152470 };
+    static const LiftingScheme cdf53 =
+      { 2, { -0.5, 0.25 }, { -0.5, 0.25 }, 1.41421356237309504880, 0.70710678118654752440 };
+    static const LiftingScheme cdf97 =
+      { 4,
+        { -1.58613434205992355842, -0.05298011857296141462, 0.88291107553093294042, 0.44350685204397115004 },
+        { -1.58613434205992355842, -0.05298011857296141462, 0.88291107553093294042, 0.44350685204397115004 },
+        1.14960439886024115979, 1.0 / 1.14960439886024115979 };
+
+    switch (family)
+      {
+      case Haar:
+        return &haar;
+      case Daubechies:
+        if (index == 1)
+          return &haar;
+        else if (index == 2)
+          return &daubechies2;
+        break;
+      case Biorthogonal:
+        if (index == 1)
+          return &cdf53;
+        else if (index == 2)
+          return &cdf97;
+        break;
+      }
+    return 0;
+  }
+
+  bool hasLiftingScheme(WaveletFamily family, int index)
+  {
+    return liftingScheme(family, index) != 0;
+  }
 }
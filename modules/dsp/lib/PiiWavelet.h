@@ -17,7 +17,9 @@
 #define _PIIWAVELET_H
 
 #include <PiiMath.h>
+#include <PiiParallel.h>
 #include <QList>
+#include <QVector>
 #include "PiiDspGlobal.h"
 
 namespace PiiDsp
@@ -41,8 +43,13 @@ namespace PiiDsp
    * the first Daubechies wavelet.
    *
    * - Daubechies - Daubechies wavelet family
+   *
+   * - Biorthogonal - biorthogonal Cohen-Daubechies-Feauveau
+   * wavelets. Member 1 is the 5/3 (LeGall) wavelet and member 2 the
+   * 9/7 wavelet used in JPEG 2000. These wavelets are only available
+   * through the lifting scheme (see [liftingDwt()]).
    */
-  enum WaveletFamily { Haar, Daubechies };
+  enum WaveletFamily { Haar, Daubechies, Biorthogonal };
 
   /**
    * Compute a quadrature mirror filter for a filter. The qmf is a
@@ -104,11 +111,106 @@ namespace PiiDsp
    * @return four matrices, the first one containing approximation
    * coefficients and the last three containing horizontal, vertical
    * and diagonal details in this order.
+   *
+   * ! The `Biorthogonal` family is transformed with [liftingDwt()].
+   * Its results therefore have the sizes described there.
    */
   template <class T> QList<PiiMatrix<T> > dwt(const PiiMatrix<T>& mat,
                                               WaveletFamily wavelet = Haar,
                                               int familyMember = 1);
 
+  /**
+   * Returns `true` if the given wavelet can be calculated with
+   * [liftingDwt()]. Lifting factorizations are available for `Haar`,
+   * `Daubechies` members 1 and 2 and `Biorthogonal` members 1 and 2.
+   */
+  PII_DSP_EXPORT bool hasLiftingScheme(WaveletFamily wavelet, int familyMember = 1);
+
+  /**
+   * Performs a multi-level two-dimensional discrete wavelet transform
+   * in place using the lifting scheme. Each level first transforms
+   * the rows and then the columns of the current approximation
+   * without convolution, which needs about half of the arithmetic of
+   * [dwt()] and no temporary matrices other than a single work buffer
+   * that is shared by all levels.
+   *
+   * The coefficients are stored in the Mallat layout: after the first
+   * level, the approximation occupies the top left quarter of
+   * *buffer*, horizontal details the top right, vertical details the
+   * bottom left and diagonal details the bottom right quarter. The
+   * next level transforms the approximation quarter, and so on. If a
+   * side has an odd length, the low-pass half gets the extra row or
+   * column. Use [dwtSubbands()] to access the results.
+   *
+   * Borders are handled by symmetric extension. Thus, the results
+   * differ from those of [dwt()] near the borders. With an r-by-c
+   * input, the approximation has ceil(r/2)-by-ceil(c/2)
+   * coefficients, horizontal details ceil(r/2)-by-floor(c/2),
+   * vertical details floor(r/2)-by-ceil(c/2) and diagonal details
+   * floor(r/2)-by-floor(c/2). For `Haar` and matrices
+   * with even dimensions, the results of the first level equal those
+   * of [dwt()].
+   *
+   * ~~~(c++)
+   * PiiMatrix<float> matBuffer(matImage);
+   * PiiDsp::liftingDwt(matBuffer, PiiDsp::Biorthogonal, 2, 3);
+   * // Diagonal details on the third level
+   * PiiMatrix<float> matDiagonal(PiiDsp::dwtSubbands(matBuffer, 3)[3]);
+   * ~~~
+   *
+   * @param buffer the input matrix, which will be replaced with the
+   * transform. Must be a floating-point matrix.
+   *
+   * @param wavelet the wavelet family
+   *
+   * @param familyMember the index of the wavelet within its family
+   *
+   * @param levels the number of decomposition levels
+   *
+   * @param threads the number of threads to use. Zero means the
+   * number of processor cores.
+   *
+   * @param firstLevel the first level to transform. If *buffer*
+   * already contains *firstLevel* - 1 levels of decomposition, only
+   * levels *firstLevel* ... *levels* will be calculated.
+   *
+   * @return `true` if the transform was calculated, `false` if there
+   * is no lifting factorization for *wavelet* (see
+   * [hasLiftingScheme()]).
+   */
+  template <class T> bool liftingDwt(PiiMatrix<T>& buffer,
+                                     WaveletFamily wavelet,
+                                     int familyMember,
+                                     int levels = 1,
+                                     int threads = 1,
+                                     int firstLevel = 1);
+
+  /**
+   * Returns the subbands of the given *level* in a Mallat-layout
+   * decomposition created by [liftingDwt()]. The returned matrices
+   * refer to the data in *decomposition*.
+   *
+   * @return four matrices in the same order as in [dwt()]:
+   * approximation, horizontal, vertical and diagonal details. The
+   * approximation is valid only on the last decomposition level.
+   */
+  template <class T> QList<PiiMatrix<T> > dwtSubbands(const PiiMatrix<T>& decomposition,
+                                                      int level = 1);
+
+  /// @hide
+  struct LiftingScheme
+  {
+    // Predict and update steps alternate, starting with a prediction.
+    // Prediction: odd[n] += first * even[n] + second * even[n+1]
+    // Update: even[n] += first * odd[n-1] + second * odd[n]
+    int iStepCount;
+    double adFirst[4], adSecond[4];
+    double dLowScale, dHighScale;
+  };
+
+  PII_DSP_EXPORT const LiftingScheme* liftingScheme(WaveletFamily wavelet, int familyMember);
+  /// @endhide
+
   /**
    * Get the wavelet scaling filter for a certain mother wavelet.
    *
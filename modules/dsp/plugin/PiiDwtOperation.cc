@@ -18,7 +18,8 @@
 #include <PiiYdinTypes.h>
 
 PiiDwtOperation::Data::Data() :
-  waveletFamily(Haar), iFamilyMember(1)
+  waveletFamily(Haar), iFamilyMember(1),
+  bLiftingScheme(false), iTransformThreadCount(1)
 {
 }
 
@@ -60,7 +61,16 @@ template <class T> void PiiDwtOperation::integerTransform(const PiiVariant& obj)
 template <class T> void PiiDwtOperation::transform(const PiiMatrix<T>& mat)
 {
   PII_D;
-  QList<PiiMatrix<T> > lstTransforms(PiiDsp::dwt(mat, (PiiDsp::WaveletFamily)d->waveletFamily, d->iFamilyMember));
+  PiiDsp::WaveletFamily family = (PiiDsp::WaveletFamily)d->waveletFamily;
+  QList<PiiMatrix<T> > lstTransforms;
+  if (d->bLiftingScheme && PiiDsp::hasLiftingScheme(family, d->iFamilyMember))
+    {
+      PiiMatrix<T> matBuffer(mat);
+      PiiDsp::liftingDwt(matBuffer, family, d->iFamilyMember, 1, d->iTransformThreadCount);
+      lstTransforms = PiiDsp::dwtSubbands(matBuffer);
+    }
+  else
+    lstTransforms = PiiDsp::dwt(mat, family, d->iFamilyMember);
   for (int i=0; i<4; ++i)
     emitObject(lstTransforms[i], i);
 }
@@ -69,3 +79,7 @@ void PiiDwtOperation::setWaveletFamily(const WaveletFamily& waveletFamily) { _d(
 PiiDwtOperation::WaveletFamily PiiDwtOperation::waveletFamily() const { return _d()->waveletFamily; }
 void PiiDwtOperation::setFamilyMember(int familyMember) { _d()->iFamilyMember = familyMember; }
 int PiiDwtOperation::familyMember() const { return _d()->iFamilyMember; }
+void PiiDwtOperation::setLiftingScheme(bool liftingScheme) { _d()->bLiftingScheme = liftingScheme; }
+bool PiiDwtOperation::liftingScheme() const { return _d()->bLiftingScheme; }
+void PiiDwtOperation::setTransformThreadCount(int transformThreadCount) { _d()->iTransformThreadCount = transformThreadCount; }
+int PiiDwtOperation::transformThreadCount() const { return _d()->iTransformThreadCount; }
@@ -55,11 +55,31 @@ class PiiDwtOperation : public PiiDefaultOperation
   /**
    * The index of the wavelet within the chosen family. This value is
    * ignored for the `Haar` "family". The operation supports members
-   * 1-10 of the `Daubechies` family. Note that `Daubechies` 1 is
-   * equal to `Haar`. The default value is 1.
+   * 1-10 of the `Daubechies` family and members 1 (CDF 5/3) and 2
+   * (CDF 9/7) of the `Biorthogonal` family. Note that `Daubechies` 1
+   * is equal to `Haar`. The default value is 1.
    */
   Q_PROPERTY(int familyMember READ familyMember WRITE setFamilyMember);
 
+  /**
+   * Use the lifting scheme instead of convolution if the selected
+   * wavelet has a lifting factorization (`Haar`, `Daubechies` 1-2
+   * and `Biorthogonal`). Lifting is considerably faster, but borders
+   * are handled by symmetric extension, and each output is half of
+   * the input in both dimensions. If a side has an odd length, the
+   * low-pass half gets the extra row or column. For example, with an
+   * r-by-c input, `approximation` is ceil(r/2)-by-ceil(c/2) and
+   * `diagonal` floor(r/2)-by-floor(c/2). The `Biorthogonal` family
+   * is always calculated with lifting. The default is `false`.
+   */
+  Q_PROPERTY(bool liftingScheme READ liftingScheme WRITE setLiftingScheme);
+
+  /**
+   * The number of threads used in calculating the lifting transform.
+   * Zero means the number of processor cores. The default is 1.
+   */
+  Q_PROPERTY(int transformThreadCount READ transformThreadCount WRITE setTransformThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   /**
@@ -69,14 +89,20 @@ public:
    * the first Daubechies wavelet.
    *
    * - Daubechies - Daubechies wavelet family
+   *
+   * - Biorthogonal - biorthogonal Cohen-Daubechies-Feauveau wavelets
    */
-  enum WaveletFamily { Haar, Daubechies };
+  enum WaveletFamily { Haar, Daubechies, Biorthogonal };
   PiiDwtOperation();
 
   void setWaveletFamily(const WaveletFamily& waveletFamily);
   WaveletFamily waveletFamily() const;
   void setFamilyMember(int familyMember);
   int familyMember() const;
+  void setLiftingScheme(bool liftingScheme);
+  bool liftingScheme() const;
+  void setTransformThreadCount(int transformThreadCount);
+  int transformThreadCount() const;
 
 protected:
   void process();
@@ -94,6 +120,8 @@ private:
 
     WaveletFamily waveletFamily;
     int iFamilyMember;
+    bool bLiftingScheme;
+    int iTransformThreadCount;
   };
   PII_D_FUNC;
 };
@@ -1,2 +1 @@
 DEPENDENCIES = Dsp
-EXTENSIONS = fast
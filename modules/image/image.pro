@@ -1,10 +1,5 @@
 MODULE = Image
 include(../module.pri)
-enabled(fast) {
-  defined(HEADER_INSTALL_PATH, var) {
-    headers.files += $$INTODIR/3rdparty/fast/*.h
-  }
-}
 qt {
   SOURCES += rawimage/*.cc
   HEADERS += rawimage/*.h
@@ -0,0 +1,84 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "PiiCompactCoordinateMap.h"
+
+const int PiiCompactCoordinateMap::FractionBits;
+const int PiiCompactCoordinateMap::FractionScale;
+
+PiiCompactCoordinateMap::PiiCompactCoordinateMap() :
+  _iSourceRows(0), _iSourceColumns(0), _iTileSize(0)
+{}
+
+PiiCompactCoordinateMap::PiiCompactCoordinateMap(int rows, int columns,
+                                                 int sourceRows, int sourceColumns,
+                                                 int tileSize) :
+  _matCoordinates(PiiMatrix<short>::uninitialized(rows, 2*columns)),
+  _matFractions(rows, columns),
+  _iSourceRows(sourceRows), _iSourceColumns(sourceColumns), _iTileSize(tileSize)
+{
+  for (int r=0; r<rows; ++r)
+    {
+      short* pCoordinates = _matCoordinates[r];
+      for (int c=0; c<2*columns; ++c)
+        pCoordinates[c] = -1;
+    }
+}
+
+PiiCompactCoordinateMap::PiiCompactCoordinateMap(const PiiMatrix<PiiPoint<double> >& map,
+                                                 int sourceRows, int sourceColumns,
+                                                 int tileSize) :
+  _matCoordinates(PiiMatrix<short>::uninitialized(map.rows(), 2*map.columns())),
+  _matFractions(PiiMatrix<unsigned short>::uninitialized(map.rows(), map.columns())),
+  _iSourceRows(sourceRows), _iSourceColumns(sourceColumns), _iTileSize(tileSize)
+{
+  for (int r=0; r<map.rows(); ++r)
+    setRow(r, map[r]);
+}
+
+void PiiCompactCoordinateMap::setRow(int row, const PiiPoint<double>* points)
+{
+  short* pCoordinates = _matCoordinates[row];
+  unsigned short* pFractions = _matFractions[row];
+  const int iColumns = columns();
+  for (int c=0; c<iColumns; ++c, pCoordinates += 2)
+    storePoint(pCoordinates, pFractions + c, points[c].x, points[c].y);
+}
+
+void PiiCompactCoordinateMap::storePoint(short* coordinates, unsigned short* fractions, double x, double y)
+{
+  // The negated comparisons also catch NaNs.
+  if (!(x >= 0 && x < _iSourceColumns && y >= 0 && y < _iSourceRows) ||
+      _iSourceColumns > 32767 || _iSourceRows > 32767)
+    {
+      coordinates[0] = coordinates[1] = -1;
+      *fractions = 0;
+      return;
+    }
+  int iX = int(x), iY = int(y);
+  int iFractionX = int((x - iX) * FractionScale + 0.5);
+  int iFractionY = int((y - iY) * FractionScale + 0.5);
+  // Rounding may carry to the next pixel.
+  if (iFractionX == FractionScale) { ++iX; iFractionX = 0; }
+  if (iFractionY == FractionScale) { ++iY; iFractionY = 0; }
+  // Past the center of the last column or row there is no neighbor
+  // to interpolate with. A zero fraction never reads the next pixel,
+  // which replicates the edge pixel.
+  if (iX >= _iSourceColumns-1) { iX = _iSourceColumns-1; iFractionX = 0; }
+  if (iY >= _iSourceRows-1) { iY = _iSourceRows-1; iFractionY = 0; }
+  coordinates[0] = short(iX);
+  coordinates[1] = short(iY);
+  *fractions = (unsigned short)(iFractionX | (iFractionY << 8));
+}
@@ -0,0 +1,146 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIICOMPACTCOORDINATEMAP_H
+#define _PIICOMPACTCOORDINATEMAP_H
+
+#include "PiiImageGlobal.h"
+#include <PiiMatrix.h>
+#include <PiiPoint.h>
+
+/**
+ * A fixed-point coordinate map for bilinear remapping. A map stored
+ * as a `PiiMatrix<PiiPoint<double> >` takes 16 bytes per pixel,
+ * which makes remapping large images memory bound. PiiCompactCoordinateMap
+ * stores the integer part of each source coordinate as a 16-bit
+ * integer and the fractional parts as two 7-bit bilinear weights
+ * packed into another 16-bit integer, six bytes per pixel in total.
+ *
+ * The map is created for a source image of a fixed size. Valid
+ * source coordinates are in [0, sourceColumns) horizontally and [0,
+ * sourceRows) vertically. Between the center of the last pixel and
+ * the edge of the image, the last column or row is used as such.
+ * Source coordinates outside of the image are marked invalid, and
+ * PiiImage::remap() sets the corresponding output pixels to zero.
+ * Source images larger than 32767 pixels in either direction cannot
+ * be addressed.
+ *
+ * ~~~(c++)
+ * PiiImage::DoubleCoordinateMap map(PiiCalibration::undistortMap(rows, columns, intrinsic));
+ * PiiCompactCoordinateMap compactMap(map, rows, columns);
+ * PiiMatrix<unsigned char> matUndistorted(PiiImage::remap(matImage, compactMap));
+ * ~~~
+ */
+class PII_IMAGE_EXPORT PiiCompactCoordinateMap
+{
+public:
+  /**
+   * The number of bits in the fractional part of a source
+   * coordinate.
+   */
+  static const int FractionBits = 7;
+  /**
+   * The fixed-point representation of one pixel.
+   */
+  static const int FractionScale = 1 << FractionBits;
+
+  /**
+   * Creates an empty map.
+   */
+  PiiCompactCoordinateMap();
+
+  /**
+   * Creates a *rows* -by- *columns* map into a *sourceRows* -by-
+   * *sourceColumns* image. All points are initially invalid.
+   *
+   * @param tileSize the width and height of the tiles in which
+   * PiiImage::remap() processes the output image. If the map rotates
+   * or strongly bends the image, processing it in small tiles keeps
+   * the accessed source pixels in cache. Zero means that the image
+   * will be processed row by row.
+   */
+  PiiCompactCoordinateMap(int rows, int columns, int sourceRows, int sourceColumns, int tileSize = 0);
+
+  /**
+   * Converts *map* to the compact format. Each point in *map*
+   * contains the (x, y) coordinates of the source pixel.
+   */
+  PiiCompactCoordinateMap(const PiiMatrix<PiiPoint<double> >& map, int sourceRows, int sourceColumns,
+                          int tileSize = 0);
+
+  /**
+   * Returns the number of rows in the map (and in the remapped
+   * image).
+   */
+  int rows() const { return _matFractions.rows(); }
+  /**
+   * Returns the number of columns in the map (and in the remapped
+   * image).
+   */
+  int columns() const { return _matFractions.columns(); }
+  /**
+   * Returns the number of rows in the source image.
+   */
+  int sourceRows() const { return _iSourceRows; }
+  /**
+   * Returns the number of columns in the source image.
+   */
+  int sourceColumns() const { return _iSourceColumns; }
+  /**
+   * Returns the tile size.
+   */
+  int tileSize() const { return _iTileSize; }
+  /**
+   * Sets the tile size.
+   */
+  void setTileSize(int tileSize) { _iTileSize = tileSize; }
+  /**
+   * Returns `true` if the map has no points.
+   */
+  bool isEmpty() const { return _matFractions.isEmpty(); }
+
+  /**
+   * Sets the source coordinates of the point at (*row*, *column*).
+   * If (*x*, *y*) is not within the source image, the point will be
+   * marked invalid.
+   */
+  void setPoint(int row, int column, double x, double y)
+  {
+    storePoint(_matCoordinates[row] + 2*column, _matFractions[row] + column, x, y);
+  }
+
+  /**
+   * Sets a whole row of source coordinates at once. *points* must
+   * hold [columns()] points.
+   */
+  void setRow(int row, const PiiPoint<double>* points);
+
+  /// @hide
+  // Interleaved (x, y) integer coordinates. Invalid points have x = -1.
+  const short* coordinateRow(int row) const { return _matCoordinates[row]; }
+  // Packed fractions: x in the low byte, y in the high byte.
+  const unsigned short* fractionRow(int row) const { return _matFractions[row]; }
+  /// @endhide
+
+private:
+  void storePoint(short* coordinates, unsigned short* fractions, double x, double y);
+
+  PiiMatrix<short> _matCoordinates;
+  PiiMatrix<unsigned short> _matFractions;
+  int _iSourceRows, _iSourceColumns;
+  int _iTileSize;
+};
+
+#endif //_PIICOMPACTCOORDINATEMAP_H
@@ -0,0 +1,272 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIIFASTCORNERDETECTOR_H
+# error "Never use <PiiFastCornerDetector-templates.h> directly; include <PiiFastCornerDetector.h> instead."
+#endif
+
+/// @hide
+namespace PiiImage
+{
+  // The circle of 16 pixels around the center, clockwise from the
+  // bottom. Rows are relative to the center row.
+  static const int aFastCircleX[16] = { 0, 1, 2, 3, 3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1 };
+  static const int aFastCircleY[16] = { 3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1, 0, 1, 2, 3 };
+  // Opposite pairs (i, i+8) in the order they are tested.
+  static const int aFastPairs[8] = { 0, 4, 2, 6, 1, 3, 5, 7 };
+
+  // Returns true if the 16-bit circular mask has at least nine
+  // contiguous bits set.
+  inline bool hasFastArc(unsigned mask)
+  {
+    mask |= mask << 16;
+    unsigned uiRun = mask & (mask >> 1); // 2 contiguous bits
+    uiRun &= uiRun >> 2; // 4
+    uiRun &= uiRun >> 4; // 8
+    uiRun &= mask >> 8; // 9
+    return (uiRun & 0xffff) != 0;
+  }
+
+  // Returns the largest value v for which nine contiguous elements in
+  // the circular array differences are all at least v.
+  template <class T> inline T bestFastArc(const T* differences)
+  {
+    T aMin2[24], aMin4[24], aMin8[16];
+    for (int i=0; i<24; ++i)
+      aMin2[i] = qMin(differences[i & 15], differences[(i+1) & 15]);
+    for (int i=0; i<22; ++i)
+      aMin4[i] = qMin(aMin2[i], aMin2[i+2]);
+    for (int i=0; i<16; ++i)
+      aMin8[i] = qMin(aMin4[i], aMin4[i+4]);
+    T best = qMin(aMin8[0], differences[8]);
+    for (int i=1; i<16; ++i)
+      best = qMax(best, qMin(aMin8[i], differences[(i+8) & 15]));
+    return best;
+  }
+
+  template <class T> struct FastCornerBand
+  {
+    typedef typename Pii::Combine<T,int>::Type CalcType;
+
+    FastCornerBand(const PiiMatrix<T>& image, CalcType threshold, bool suppress,
+                   QVector<int>* coordinates, QVector<double>* scores) :
+      image(image), threshold(threshold), bSuppress(suppress),
+      pCoordinates(coordinates), pScores(scores)
+    {}
+
+    void operator() (int firstRow, int lastRow, int band) const
+    {
+      const int iRows = image.rows(), iColumns = image.columns();
+      // Non-maximum suppression needs the scores of the rows above
+      // and below. Three rows are kept in a ring of dense buffers.
+      // Non-corners have a negative score.
+      PiiMatrix<CalcType> matScores(PiiMatrix<CalcType>::uninitialized(3, iColumns));
+      matScores = CalcType(-1);
+      QVector<int> lstCorners[3];
+
+      firstRow = qMax(firstRow, 3);
+      lastRow = qMin(lastRow, iRows-3);
+      if (firstRow >= lastRow)
+        return;
+      if (firstRow > 3)
+        scoreRow(firstRow-1, matScores[(firstRow-1) % 3], lstCorners[(firstRow-1) % 3]);
+      scoreRow(firstRow, matScores[firstRow % 3], lstCorners[firstRow % 3]);
+
+      QVector<int>& vecCoordinates = pCoordinates[band];
+      QVector<double>& vecScores = pScores[band];
+      for (int r=firstRow; r<lastRow; ++r)
+        {
+          // Replace the row two rows above with the one below.
+          const int iNext = (r+1) % 3;
+          CalcType* pNext = matScores[iNext];
+          for (int i=0; i<lstCorners[iNext].size(); ++i)
+            pNext[lstCorners[iNext][i]] = CalcType(-1);
+          lstCorners[iNext].clear();
+          if (r+1 < iRows-3)
+            scoreRow(r+1, pNext, lstCorners[iNext]);
+
+          const CalcType* pAbove = matScores[(r+2) % 3], *pRow = matScores[r % 3], *pBelow = pNext;
+          const QVector<int>& lstRowCorners = lstCorners[r % 3];
+          for (int i=0; i<lstRowCorners.size(); ++i)
+            {
+              const int c = lstRowCorners[i];
+              const CalcType score = pRow[c];
+              // Suppress if any neighbor scores at least as high.
+              if (bSuppress &&
+                  (pRow[c-1] >= score || pRow[c+1] >= score ||
+                   pAbove[c-1] >= score || pAbove[c] >= score || pAbove[c+1] >= score ||
+                   pBelow[c-1] >= score || pBelow[c] >= score || pBelow[c+1] >= score))
+                continue;
+              vecCoordinates << c << r;
+              vecScores << double(score);
+            }
+        }
+    }
+
+    // Finds the corners on row r, stores their scores to scores and
+    // their column indices to corners.
+    void scoreRow(int r, CalcType* scores, QVector<int>& corners) const
+    {
+      const int iColumns = image.columns();
+      const CalcType t = threshold;
+      const char* pCenter = reinterpret_cast<const char*>(image[r]);
+      // Byte offsets of the circle pixels relative to the center.
+      const int iStride = int(image.stride());
+      int aOffsets[16];
+      for (int i=0; i<16; ++i)
+        aOffsets[i] = aFastCircleY[i] * iStride + aFastCircleX[i] * int(sizeof(T));
+
+      for (int c=3; c<iColumns-3; ++c)
+        {
+          const char* p = pCenter + c * int(sizeof(T));
+          const CalcType center = *reinterpret_cast<const T*>(p);
+          const CalcType high = center + t, low = center - t;
+          // A nine-pixel arc covers at least one pixel of each
+          // opposite pair on the circle. Most pixels are rejected
+          // after the first one or two pairs.
+          CalcType aValues[16];
+          aValues[0] = *reinterpret_cast<const T*>(p + aOffsets[0]);
+          aValues[8] = *reinterpret_cast<const T*>(p + aOffsets[8]);
+          int iBright = (aValues[0] > high) | (aValues[8] > high);
+          int iDark = (aValues[0] < low) | (aValues[8] < low);
+          for (int i=1; i<8 && (iBright | iDark) != 0; ++i)
+            {
+              const int j = aFastPairs[i];
+              const CalcType a = aValues[j] = *reinterpret_cast<const T*>(p + aOffsets[j]);
+              const CalcType b = aValues[j+8] = *reinterpret_cast<const T*>(p + aOffsets[j+8]);
+              iBright &= (a > high) | (b > high);
+              iDark &= (a < low) | (b < low);
+            }
+          if ((iBright | iDark) == 0)
+            continue;
+
+          unsigned uiMask = 0;
+          if (iBright)
+            for (int i=0; i<16; ++i)
+              uiMask |= unsigned(aValues[i] > high) << i;
+          else
+            for (int i=0; i<16; ++i)
+              uiMask |= unsigned(aValues[i] < low) << i;
+          if (!hasFastArc(uiMask))
+            continue;
+
+          // Differences in the direction of the arc. Both polarities
+          // cannot have a nine-pixel arc.
+          const CalcType sign = iBright ? 1 : -1;
+          for (int i=0; i<16; ++i)
+            aValues[i] = sign * (aValues[i] - center);
+          scores[c] = score(bestFastArc(aValues));
+          corners << c;
+        }
+    }
+
+    // The largest threshold at which the point is still a corner.
+    // Integers must exceed the threshold by one.
+    CalcType score(CalcType best) const
+    {
+      const CalcType maxScore = Traits<T>::max() - (Pii::IsInteger<T>::boolValue ? 1 : 0);
+      return qMax(threshold, qMin(best - (Pii::IsInteger<T>::boolValue ? 1 : 0), maxScore));
+    }
+
+    const PiiMatrix<T>& image;
+    const CalcType threshold;
+    bool bSuppress;
+    QVector<int>* pCoordinates;
+    QVector<double>* pScores;
+  };
+
+  // Halves the size of image by averaging 2-by-2 blocks.
+  template <class T> PiiMatrix<T> fastPyramidLevel(const PiiMatrix<T>& image)
+  {
+    typedef typename Pii::Combine<T,int>::Type CalcType;
+    const int iRows = image.rows() / 2, iColumns = image.columns() / 2;
+    PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(iRows, iColumns));
+    for (int r=0; r<iRows; ++r)
+      {
+        const T* pRow0 = image[2*r], *pRow1 = image[2*r+1];
+        T* pResult = matResult[r];
+        for (int c=0; c<iColumns; ++c)
+          pResult[c] = T((CalcType(pRow0[2*c]) + pRow0[2*c+1] + pRow1[2*c] + pRow1[2*c+1]) / 4);
+      }
+    return matResult;
+  }
+}
+/// @endhide
+
+template <class T> void PiiFastCornerDetector::detectLevel(const PiiMatrix<T>& image, int level,
+                                                           QVector<int>& coordinates,
+                                                           QVector<double>& scores,
+                                                           QVector<int>& levels) const
+{
+  typedef typename Pii::Combine<T,int>::Type CalcType;
+  const int iRows = image.rows(), iColumns = image.columns();
+  if (iRows < 7 || iColumns < 7)
+    return;
+
+  const int iMinBandRows = Pii::reductionMinBandRows(iColumns);
+  const int iBands = Pii::parallelBandCount(iRows, _iThreadCount, iMinBandRows);
+  QVector<QVector<int> > lstCoordinates(iBands);
+  QVector<QVector<double> > lstScores(iBands);
+  PiiImage::FastCornerBand<T> band(image, CalcType(_dThreshold), _bNonMaximumSuppression,
+                                   lstCoordinates.data(), lstScores.data());
+  Pii::parallelFor(iRows, band, _iThreadCount, iMinBandRows);
+
+  // Bands are in raster-scan order.
+  const int iOffset = ((1 << level) - 1) / 2;
+  for (int i=0; i<iBands; ++i)
+    {
+      const QVector<int>& vecCoordinates = lstCoordinates[i];
+      for (int j=0; j<vecCoordinates.size(); ++j)
+        coordinates << (vecCoordinates[j] << level) + iOffset;
+      scores += lstScores[i];
+      levels += QVector<int>(lstScores[i].size(), level);
+    }
+}
+
+template <class T> PiiMatrix<int> PiiFastCornerDetector::detect(const PiiMatrix<T>& image,
+                                                                QVector<double>* scores,
+                                                                QVector<int>* levels) const
+{
+  QVector<int> vecCoordinates;
+  QVector<double> vecScores;
+  QVector<int> vecLevels;
+
+  detectLevel(image, 0, vecCoordinates, vecScores, vecLevels);
+  PiiMatrix<T> matLevel(image);
+  for (int i=1; i<_iLevels && matLevel.rows() >= 14 && matLevel.columns() >= 14; ++i)
+    {
+      matLevel = PiiImage::fastPyramidLevel(matLevel);
+      detectLevel(matLevel, i, vecCoordinates, vecScores, vecLevels);
+    }
+
+  QVector<int> vecSelected(selectCorners(vecCoordinates, vecScores, image.columns()));
+  const int iCorners = vecSelected.size();
+  PiiMatrix<int> matCorners(PiiMatrix<int>::uninitialized(iCorners, 2));
+  if (scores != 0)
+    scores->resize(iCorners);
+  if (levels != 0)
+    levels->resize(iCorners);
+  for (int i=0; i<iCorners; ++i)
+    {
+      const int iIndex = vecSelected[i];
+      matCorners(i,0) = vecCoordinates[2*iIndex];
+      matCorners(i,1) = vecCoordinates[2*iIndex+1];
+      if (scores != 0)
+        (*scores)[i] = vecScores[iIndex];
+      if (levels != 0)
+        (*levels)[i] = vecLevels[iIndex];
+    }
+  return matCorners;
+}
@@ -0,0 +1,114 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "PiiFastCornerDetector.h"
+
+#include <algorithm>
+
+namespace
+{
+  // Orders corner indices by descending score. Ties retain the
+  // detection order with a stable sort.
+  struct ScoreOrder
+  {
+    ScoreOrder(const QVector<double>& scores) : scores(scores) {}
+    bool operator() (int a, int b) const { return scores[a] > scores[b]; }
+    const QVector<double>& scores;
+  };
+
+  struct CellOrder
+  {
+    CellOrder(const QVector<int>& cells, const QVector<double>& scores) : cells(cells), scores(scores) {}
+    bool operator() (int a, int b) const
+    {
+      return cells[a] < cells[b] || (cells[a] == cells[b] && scores[a] > scores[b]);
+    }
+    const QVector<int>& cells;
+    const QVector<double>& scores;
+  };
+}
+
+PiiFastCornerDetector::PiiFastCornerDetector(double threshold) :
+  _dThreshold(qMax(0.0, threshold)),
+  _bNonMaximumSuppression(true),
+  _iGridSize(0),
+  _iCornersPerCell(0),
+  _iMaxCorners(0),
+  _iLevels(1),
+  _iThreadCount(1)
+{}
+
+QVector<int> PiiFastCornerDetector::selectCorners(const QVector<int>& coordinates,
+                                                  const QVector<double>& scores,
+                                                  int columns) const
+{
+  const int iCorners = scores.size();
+  QVector<int> vecIndices(iCorners);
+  for (int i=0; i<iCorners; ++i)
+    vecIndices[i] = i;
+
+  QVector<bool> vecSelected(iCorners, true);
+  int iSelected = iCorners;
+  if (_iGridSize > 0 && _iCornersPerCell > 0)
+    {
+      const int iGridColumns = (columns + _iGridSize - 1) / _iGridSize;
+      QVector<int> vecCells(iCorners);
+      for (int i=0; i<iCorners; ++i)
+        vecCells[i] = coordinates[2*i+1] / _iGridSize * iGridColumns + coordinates[2*i] / _iGridSize;
+      std::stable_sort(vecIndices.begin(), vecIndices.end(), CellOrder(vecCells, scores));
+      for (int i=0, iInCell=0; i<iCorners; ++i)
+        {
+          if (i > 0 && vecCells[vecIndices[i]] != vecCells[vecIndices[i-1]])
+            iInCell = 0;
+          if (++iInCell > _iCornersPerCell)
+            {
+              vecSelected[vecIndices[i]] = false;
+              --iSelected;
+            }
+        }
+    }
+
+  if (_iMaxCorners > 0 && iSelected > _iMaxCorners)
+    {
+      vecIndices.clear();
+      for (int i=0; i<iCorners; ++i)
+        if (vecSelected[i])
+          vecIndices << i;
+      std::stable_sort(vecIndices.begin(), vecIndices.end(), ScoreOrder(scores));
+      for (int i=_iMaxCorners; i<vecIndices.size(); ++i)
+        vecSelected[vecIndices[i]] = false;
+    }
+
+  vecIndices.clear();
+  for (int i=0; i<iCorners; ++i)
+    if (vecSelected[i])
+      vecIndices << i;
+  return vecIndices;
+}
+
+void PiiFastCornerDetector::setThreshold(double threshold) { _dThreshold = qMax(0.0, threshold); }
+double PiiFastCornerDetector::threshold() const { return _dThreshold; }
+void PiiFastCornerDetector::setNonMaximumSuppression(bool nonMaximumSuppression) { _bNonMaximumSuppression = nonMaximumSuppression; }
+bool PiiFastCornerDetector::nonMaximumSuppression() const { return _bNonMaximumSuppression; }
+void PiiFastCornerDetector::setGridSize(int gridSize) { _iGridSize = qMax(0, gridSize); }
+int PiiFastCornerDetector::gridSize() const { return _iGridSize; }
+void PiiFastCornerDetector::setCornersPerCell(int cornersPerCell) { _iCornersPerCell = qMax(0, cornersPerCell); }
+int PiiFastCornerDetector::cornersPerCell() const { return _iCornersPerCell; }
+void PiiFastCornerDetector::setMaxCorners(int maxCorners) { _iMaxCorners = qMax(0, maxCorners); }
+int PiiFastCornerDetector::maxCorners() const { return _iMaxCorners; }
+void PiiFastCornerDetector::setLevels(int levels) { _iLevels = qMax(1, levels); }
+int PiiFastCornerDetector::levels() const { return _iLevels; }
+void PiiFastCornerDetector::setThreadCount(int threadCount) { _iThreadCount = qMax(0, threadCount); }
+int PiiFastCornerDetector::threadCount() const { return _iThreadCount; }
@@ -0,0 +1,183 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIIFASTCORNERDETECTOR_H
+#define _PIIFASTCORNERDETECTOR_H
+
+#include "PiiImageGlobal.h"
+#include <PiiColor.h>
+#include "PiiImageTraits.h"
+#include <PiiMath.h>
+#include <PiiParallel.h>
+#include <QVector>
+
+/**
+ * The FAST (Features from Accelerated Segment Test) corner detector.
+ * A pixel is a corner if at least nine contiguous pixels on a circle
+ * of 16 pixels around it are all brighter than the center pixel plus
+ * a threshold or all darker than the center minus the threshold.
+ *
+ * A nine-pixel arc always covers at least one pixel of each opposite
+ * pair on the circle, which rejects most pixels after testing one or
+ * two pairs. The full segment test packs the 16 comparisons into a
+ * bit mask and finds nine-pixel arcs with shifts. Each corner is
+ * given a score that is the largest threshold at which it would
+ * still be detected. With integer images, the corners and scores are
+ * equal to those of the original FAST-9 implementation. Corners whose
+ * score is not higher than that of all of their eight neighbors are
+ * suppressed. The image is processed in bands of rows, optionally in
+ * parallel.
+ *
+ * Optionally, the strongest corners can be selected on a grid, which
+ * spreads the corners evenly over the image, and corners can be
+ * detected on an image pyramid. The returned coordinates can be used
+ * as the `points` input of PiiFeaturePointMatcher and
+ * PiiRansacPointMatcher.
+ *
+ * ~~~(c++)
+ * PiiFastCornerDetector detector(20);
+ * // At most 4 corners in each 32-by-32 cell, 500 in total
+ * detector.setGridSize(32);
+ * detector.setCornersPerCell(4);
+ * detector.setMaxCorners(500);
+ * detector.setLevels(3);
+ * detector.setThreadCount(0);
+ * QVector<double> vecScores;
+ * PiiMatrix<int> matCorners(detector.detect(matImage, &vecScores));
+ * ~~~
+ */
+class PII_IMAGE_EXPORT PiiFastCornerDetector
+{
+public:
+  /**
+   * Creates a new corner detector with the given detection
+   * threshold.
+   */
+  PiiFastCornerDetector(double threshold = 25);
+
+  /**
+   * Sets the detection threshold. A high value accepts only strong
+   * corners. The lower the value, the more corners are detected,
+   * which also means lower processing speed. Negative values are
+   * treated as zero. The default is 25.
+   */
+  void setThreshold(double threshold);
+  /**
+   * Returns the detection threshold.
+   */
+  double threshold() const;
+
+  /**
+   * Enables or disables non-maximum suppression. If suppression is
+   * enabled (the default), a corner is accepted only if its score is
+   * higher than that of any other corner in its 3-by-3
+   * neighborhood.
+   */
+  void setNonMaximumSuppression(bool nonMaximumSuppression);
+  /**
+   * Returns `true` if non-maximum suppression is enabled.
+   */
+  bool nonMaximumSuppression() const;
+
+  /**
+   * Sets the size of the cells in grid selection. If *gridSize* is
+   * positive and [cornersPerCell()] is positive, the image is divided
+   * into *gridSize* -by- *gridSize* cells, and only the
+   * [cornersPerCell()] strongest corners in each cell are retained.
+   * The default is zero.
+   */
+  void setGridSize(int gridSize);
+  /**
+   * Returns the grid cell size.
+   */
+  int gridSize() const;
+
+  /**
+   * Sets the maximum number of corners retained in each grid cell.
+   * Zero disables grid selection. The default is zero.
+   */
+  void setCornersPerCell(int cornersPerCell);
+  /**
+   * Returns the maximum number of corners in a grid cell.
+   */
+  int cornersPerCell() const;
+
+  /**
+   * Sets the maximum number of returned corners. If there are more
+   * corners, the strongest ones are retained. Zero means no limit.
+   * The default is zero.
+   */
+  void setMaxCorners(int maxCorners);
+  /**
+   * Returns the maximum number of corners.
+   */
+  int maxCorners() const;
+
+  /**
+   * Sets the number of pyramid levels. If *levels* is greater than
+   * one, the image will be repeatedly halved in size by averaging 2-by-2
+   * blocks, and corners will be detected on each level. The
+   * coordinates of the corners found on the higher levels are mapped
+   * back to the original image. The default is one.
+   */
+  void setLevels(int levels);
+  /**
+   * Returns the number of pyramid levels.
+   */
+  int levels() const;
+
+  /**
+   * Sets the number of threads used in detection. Zero means the
+   * number of processor cores. The result does not depend on the
+   * number of threads. The default is one.
+   */
+  void setThreadCount(int threadCount);
+  /**
+   * Returns the number of threads.
+   */
+  int threadCount() const;
+
+  /**
+   * Detects corners in *image*.
+   *
+   * @param scores an optional output-value argument that will store
+   * the score of each returned corner.
+   *
+   * @param levels an optional output-value argument that will store
+   * the pyramid level at which each corner was found.
+   *
+   * @return a N-by-2 matrix in which each row stores the (x,y)
+   * coordinates of a detected corner. On each pyramid level, the
+   * corners are in raster-scan order.
+   */
+  template <class T> PiiMatrix<int> detect(const PiiMatrix<T>& image,
+                                           QVector<double>* scores = 0,
+                                           QVector<int>* levels = 0) const;
+
+private:
+  template <class T> void detectLevel(const PiiMatrix<T>& image, int level,
+                                      QVector<int>& coordinates, QVector<double>& scores,
+                                      QVector<int>& levels) const;
+  QVector<int> selectCorners(const QVector<int>& coordinates, const QVector<double>& scores,
+                             int columns) const;
+
+  double _dThreshold;
+  bool _bNonMaximumSuppression;
+  int _iGridSize, _iCornersPerCell, _iMaxCorners, _iLevels, _iThreadCount;
+};
+
+#include "PiiFastCornerDetector-templates.h"
+
+#endif //_PIIFASTCORNERDETECTOR_H
@@ -19,39 +19,142 @@
 
 #include <PiiAlgorithm.h>
 #include <PiiFunctional.h>
+#include <limits>
 
+/// @hide
 namespace PiiImage
 {
-  template <class T, class U, class Roi> PiiMatrix<T> histogram(const PiiMatrix<U>& image, const Roi& roi, unsigned int levels)
+  // Maps pixel values to bins. Values outside of the histogram go to
+  // the extra bin at index levels.
+  struct HistogramLevels
   {
-    if (levels < 1)
-      levels = unsigned(Pii::max(image)) + 1;
-    PiiMatrix<T> result(1, int(levels));
-    T* vector = result.row(0);
+    HistogramLevels(unsigned int levels) : uiLevels(levels) {}
+    unsigned int levels() const { return uiLevels; }
+    template <class U> unsigned int operator() (U value) const
+    {
+      const unsigned int uiValue = unsigned(value);
+      return uiValue < uiLevels ? uiValue : uiLevels;
+    }
+    unsigned int uiLevels;
+  };
 
-    const int iRows = image.rows(), iCols = image.columns();
-    for (int r=0; r<iRows; ++r)
+  // Maps pixel values to bins if all values of the type fit into the
+  // histogram.
+  struct HistogramValues
+  {
+    HistogramValues(unsigned int levels) : uiLevels(levels) {}
+    unsigned int levels() const { return uiLevels; }
+    template <class U> unsigned int operator() (U value) const { return unsigned(value); }
+    unsigned int uiLevels;
+  };
+
+  template <class U> struct HistogramQuantizer
+  {
+    HistogramQuantizer(const PiiQuantizer<U>& quantizer) : quantizer(quantizer) {}
+    unsigned int levels() const { return quantizer.levels(); }
+    unsigned int operator() (U value) const { return unsigned(quantizer.quantize(value)); }
+    const PiiQuantizer<U>& quantizer;
+  };
+
+  // Counts a band of rows into interleaved banks of bins. Each band
+  // has its own banks. Pixels outside of the ROI go to the extra bin.
+  template <class U, class Roi, class Binner> struct HistogramBand
+  {
+    HistogramBand(const PiiMatrix<U>& image, const Roi& roi, const Binner& binner,
+                  int banks, int* counts) :
+      image(image), roi(roi), binner(binner),
+      iBins(int(binner.levels()) + 1), iBanks(banks), pCounts(counts)
+    {}
+
+    void operator() (int firstRow, int lastRow, int band) const
+    {
+      const int iColumns = image.columns();
+      int* pBank0 = pCounts + band * iBanks * iBins;
+      for (int r=firstRow; r<lastRow; ++r)
+        {
+          const U* pRow = image[r];
+          int c = 0;
+          if (iBanks == 4)
+            {
+              int* pBank1 = pBank0 + iBins, *pBank2 = pBank1 + iBins, *pBank3 = pBank2 + iBins;
+              for (; c<iColumns-3; c+=4)
+                {
+                  ++pBank0[bin(pRow[c], r, c)];
+                  ++pBank1[bin(pRow[c+1], r, c+1)];
+                  ++pBank2[bin(pRow[c+2], r, c+2)];
+                  ++pBank3[bin(pRow[c+3], r, c+3)];
+                }
+            }
+          for (; c<iColumns; ++c)
+            ++pBank0[bin(pRow[c], r, c)];
+        }
+    }
+
+    unsigned int bin(U value, int r, int c) const
+    {
+      return roi(r,c) ? binner(value) : unsigned(iBins - 1);
+    }
+
+    const PiiMatrix<U>& image;
+    const Roi& roi;
+    const Binner& binner;
+    const int iBins, iBanks;
+    int* pCounts;
+  };
+
+  template <class T, class U, class Roi, class Binner>
+  PiiMatrix<T> countHistogram(const PiiMatrix<U>& image, const Roi& roi, const Binner& binner, int threads)
+  {
+    const int iLevels = int(binner.levels()), iBins = iLevels + 1;
+    // Large histograms don't fit into the cache four times.
+    const int iBanks = iLevels <= 4096 ? 4 : 1;
+    const int iMinBandRows = Pii::reductionMinBandRows(image.columns());
+    const int iBands = Pii::parallelBandCount(image.rows(), threads, iMinBandRows);
+    QVector<int> vecCounts(iBands * iBanks * iBins);
+    HistogramBand<U,Roi,Binner> band(image, roi, binner, iBanks, vecCounts.data());
+    Pii::parallelFor(image.rows(), band, threads, iMinBandRows);
+
+    PiiMatrix<T> result(PiiMatrix<T>::uninitialized(1, iLevels));
+    T* pResult = result.row(0);
+    const int* pCounts = vecCounts.constData();
+    for (int i=0; i<iLevels; ++i)
       {
-        const U* row = image.row(r);
-        for (int c=0; c<iCols; ++c)
-          if (unsigned(row[c]) < levels && roi(r,c)) ++vector[unsigned(row[c])];
+        int iSum = 0;
+        for (int j=0; j<iBands*iBanks; ++j)
+          iSum += pCounts[j*iBins + i];
+        pResult[i] = T(iSum);
       }
     return result;
   }
+}
+/// @endhide
 
-  template <class T, class U, class Roi> PiiMatrix<T> histogram(const PiiMatrix<U>& image, const Roi& roi, const PiiQuantizer<U>& quantizer)
+namespace PiiImage
+{
+  template <class T, class U, class Roi> PiiMatrix<T> histogram(const PiiMatrix<U>& image, const Roi& roi, unsigned int levels,
+                                                                int threads)
   {
-    PiiMatrix<T> result(1, quantizer.levels());
-    T* vector = result.row(0);
+    if (levels < 1)
+      levels = unsigned(Pii::max(image)) + 1;
+    // No range check is needed if the histogram covers all values of
+    // a small unsigned type.
+    if (Pii::IsUnsigned<U>::boolValue && sizeof(U) <= 2 &&
+        double(levels) > double(std::numeric_limits<U>::max()))
+      return countHistogram<T>(image, roi, HistogramValues(levels), threads);
+    return countHistogram<T>(image, roi, HistogramLevels(levels), threads);
+  }
 
-    const int iRows = image.rows(), iCols = image.columns();
-    for (int r=0; r<iRows; ++r)
-      {
-        const U* row = image.row(r);
-        for (int c=0; c<iCols; ++c)
-          if (roi(r,c)) ++vector[quantizer.quantize(row[c])];
-      }
-    return result;
+  template <class T, class U> PiiMatrix<T> histogram(const PiiMatrix<U>& image, const PiiRectangle<int>& rectangle,
+                                                     unsigned int levels, int threads)
+  {
+    const PiiMatrix<U> matArea(image(rectangle.y, rectangle.x, rectangle.height, rectangle.width));
+    return histogram<T,U,DefaultRoi>(matArea, DefaultRoi(), levels, threads);
+  }
+
+  template <class T, class U, class Roi> PiiMatrix<T> histogram(const PiiMatrix<U>& image, const Roi& roi, const PiiQuantizer<U>& quantizer,
+                                                                int threads)
+  {
+    return countHistogram<T>(image, roi, HistogramQuantizer<U>(quantizer), threads);
   }
 
   template <class T, class U> PiiMatrix<T> normalize(const PiiMatrix<U>& histogram)
@@ -61,7 +164,7 @@ namespace PiiImage
     for (int r=0; r<iRows; ++r)
       {
         const U* pRow = histogram.row(r);
-        T sum = Pii::accumulateN(pRow, iColumns, std::plus<T>(), T(0));
+        T sum = Pii::sumN<T>(pRow, iColumns);
         if (sum != 0)
           Pii::transformN(pRow, iColumns, result.row(r),
                           std::bind2nd(std::multiplies<T>(), 1.0/sum));
@@ -113,15 +216,22 @@ namespace PiiImage
 
   template <class T> PiiMatrix<T> equalize(const PiiMatrix<T>& img, unsigned int levels)
   {
-    PiiMatrix<T> result(img.rows(), img.columns());
-
     unsigned int maxValue = (unsigned int)Pii::max(img);
-    if (levels < maxValue)
+    if (levels <= maxValue)
       levels = maxValue + 1;
     if (levels == 0)
       return img;
 
-    PiiMatrix<int> dist = cumulative(histogram(img, levels));
+    return equalize(img, histogram(img, levels));
+  }
+
+  template <class T> PiiMatrix<T> equalize(const PiiMatrix<T>& img, const PiiMatrix<int>& histogram)
+  {
+    const unsigned int levels = unsigned(histogram.columns());
+    if (levels == 0)
+      return img;
+
+    PiiMatrix<int> dist = cumulative(histogram);
     int* pDist = dist.row(0);
 
     PiiMatrix<T> newDist(1, levels);
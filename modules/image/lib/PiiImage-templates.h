@@ -19,7 +19,8 @@
 
 #include <PiiGeometricObjects.h>
 #include "PiiThresholding.h"
-#include <fast.h>
+#include "PiiLocalStatistics.h"
+#include "PiiFastCornerDetector.h"
 
 #include <PiiMatrixUtil.h>
 #include <PiiMath.h>
@@ -754,92 +755,21 @@ namespace PiiImage
                   padded);
   }
 
-  template <class GreaterThan, class T, class U>
-  inline void takeExtremum(GreaterThan greater, T& a, U b) { if (greater(b, a)) a = b; }
-
-  template <class T, class GreaterThan>
-  PiiMatrix<T> extremumFilter(const PiiMatrix<T>& image,
-                              int windowRows, int windowColumns,
-                              GreaterThan greater,
-                              T initialValue)
-  {
-    const int iRows = image.rows(), iCols = image.columns();
-    PiiMatrix<T> matResult(PiiMatrix<T>::constant(iRows, iCols, initialValue));
-    if (windowColumns <= 0) windowColumns = windowRows;
-    if (windowRows > iRows) windowRows = iRows;
-    if (windowColumns > iCols) windowColumns = iCols;
-
-    const int iLeftCols = windowColumns / 2, iRightCols = windowColumns - iLeftCols;
-    for (int r=0; r<iRows; ++r)
-      {
-        typename PiiMatrix<T>::const_row_iterator pSourceRow = image[r];
-        typename PiiMatrix<T>::row_iterator pTargetRow = matResult[r];
-        // We handle both edges separately to avoid boundary checks in
-        // the middle.
-        for (int c=0; c<iLeftCols; ++c)
-          for (int c2=0; c2<c+iRightCols; ++c2)
-            takeExtremum(greater, pTargetRow[c], pSourceRow[c2]);
-        for (int c=iLeftCols; c<iCols-iRightCols; ++c)
-          for (int c2=c-iLeftCols; c2<c+iRightCols; ++c2)
-            takeExtremum(greater, pTargetRow[c], pSourceRow[c2]);
-        for (int c=iCols-iRightCols; c<iCols; ++c)
-          for (int c2=c-iLeftCols; c2<iCols; ++c2)
-            takeExtremum(greater, pTargetRow[c], pSourceRow[c2]);
-      }
-
-    const int iTopRows = windowRows / 2, iBottomRows = windowRows - iTopRows;
-    // Cyclic temporary buffer for data that cannot be written to the
-    // result matrix yet.
-    QVarLengthArray<T,8> tmpBfr(iTopRows);
-
-    for (int c=0; c<iCols; ++c)
-      {
-        typename PiiMatrix<T>::column_iterator pTargetCol = matResult.columnBegin(c);
-
-        // Initialize the buffer with values that cannot be written yet.
-        for (int r=0; r<iTopRows; ++r)
-          {
-            tmpBfr[r] = initialValue;
-            for (int r2=0; r2<r+iBottomRows; ++r2)
-              takeExtremum(greater, tmpBfr[r], pTargetCol[r2]);
-          }
-
-        for (int r=iTopRows; r<iRows-iBottomRows; ++r)
-          {
-            // Write the oldest value from the buffer and update.
-            int iBfrIndex = r % iTopRows;
-            T oldMax = tmpBfr[iBfrIndex];
-            tmpBfr[iBfrIndex] = initialValue;
-            for (int r2=r-iTopRows; r2<r+iBottomRows; ++r2)
-              takeExtremum(greater, tmpBfr[iBfrIndex], pTargetCol[r2]);
-            pTargetCol[r-iTopRows] = oldMax;
-          }
-        for (int r=iRows-iBottomRows; r<iRows; ++r)
-          {
-            int iBfrIndex = r % iTopRows;
-            T oldMax = tmpBfr[iBfrIndex];
-            tmpBfr[iBfrIndex] = initialValue;
-            for (int r2=r-iTopRows; r2<iRows; ++r2)
-              takeExtremum(greater, tmpBfr[iBfrIndex], pTargetCol[r2]);
-            pTargetCol[r-iTopRows] = oldMax;
-          }
-        // Write the remaining values from the buffer.
-        for (int r=iRows-iTopRows; r<iRows; ++r)
-          pTargetCol[r] = tmpBfr[r % iTopRows];
-      }
-
-    return matResult;
-  }
-
   template <class T> PiiMatrix<T> maxFilter(const PiiMatrix<T>& image,
                                             int windowRows, int windowColumns)
   {
-    return extremumFilter(image, windowRows, windowColumns, std::greater<T>(), Pii::Numeric<T>::minValue());
+    if (windowColumns < 1)
+      windowColumns = windowRows;
+    // Windows larger than the image are clamped to its size.
+    return localMaximum(image, qMin(windowRows, image.rows()), qMin(windowColumns, image.columns()));
   }
   template <class T> PiiMatrix<T> minFilter(const PiiMatrix<T>& image,
                                             int windowRows, int windowColumns)
   {
-    return extremumFilter(image, windowRows, windowColumns, std::less<T>(), Pii::Numeric<T>::maxValue());
+    if (windowColumns < 1)
+      windowColumns = windowRows;
+    // Windows larger than the image are clamped to its size.
+    return localMinimum(image, qMin(windowRows, image.rows()), qMin(windowColumns, image.columns()));
   }
 
   template <class T> PiiMatrix<T> makeFilter(PrebuiltFilterType type, unsigned int size)
@@ -1173,15 +1103,11 @@ namespace PiiImage
                                lowThreshold, highThreshold);
   }
 
-  template <class T> PiiMatrix<int> detectFastCorners(const PiiMatrix<T>& image, T threshold)
+  template <class T> PiiMatrix<int> detectFastCorners(const PiiMatrix<T>& image, T threshold, int threads)
   {
-    int pixel[16];
-    fast9_make_offsets<T>(pixel, image.stride());
-
-    PiiMatrix<int> matCorners(0,2);
-    fast9_detect(image, pixel, threshold, matCorners);
-    QVector<int> vecScores = fast9_score(image, matCorners, pixel, threshold);
-    return fast_suppress_nonmax(matCorners, vecScores);
+    PiiFastCornerDetector detector(threshold);
+    detector.setThreadCount(threads);
+    return detector.detect(image);
   }
 
   template <class T, class U> PiiMatrix<T> remap(const PiiMatrix<T>& image,
@@ -1204,6 +1130,117 @@ namespace PiiImage
     return matResult;
   }
 
+  /// @hide
+  template <class T> struct IsFixedPointRemappable : Pii::False {};
+  template <> struct IsFixedPointRemappable<char> : Pii::True {};
+  template <> struct IsFixedPointRemappable<unsigned char> : Pii::True {};
+  template <> struct IsFixedPointRemappable<short> : Pii::True {};
+  template <> struct IsFixedPointRemappable<unsigned short> : Pii::True {};
+
+  struct FixedPointRemap
+  {
+    // 7+7 fractional bits leave room for 16-bit pixels in an int.
+    template <class T> static inline T interpolate(const T* row0, const T* row1, int x, int fx, int fy)
+    {
+      const int iX1 = x + (fx != 0);
+      const int iFx1 = PiiCompactCoordinateMap::FractionScale - fx;
+      const int iFy1 = PiiCompactCoordinateMap::FractionScale - fy;
+      const int iTop = int(row0[x]) * iFx1 + int(row0[iX1]) * fx;
+      const int iBottom = int(row1[x]) * iFx1 + int(row1[iX1]) * fx;
+      return T((iTop * iFy1 + iBottom * fy + (1 << (2*PiiCompactCoordinateMap::FractionBits-1))) >>
+               (2*PiiCompactCoordinateMap::FractionBits));
+    }
+  };
+
+  struct FloatingPointRemap
+  {
+    template <class T> static inline T interpolate(const T* row0, const T* row1, int x, int fx, int fy)
+    {
+      typedef typename Pii::ToFloatingPoint<T>::Type Real;
+      typedef typename Pii::ToFloatingPoint<T>::PrimitiveType RealScalar;
+      const RealScalar scale = RealScalar(1) / PiiCompactCoordinateMap::FractionScale;
+      const RealScalar dx = RealScalar(fx) * scale, dy = RealScalar(fy) * scale;
+      const int iX1 = x + (fx != 0);
+      Real result = Real(row0[x]) * ((1-dx) * (1-dy));
+      result += Real(row0[iX1]) * (dx * (1-dy));
+      result += Real(row1[x]) * ((1-dx) * dy);
+      result += Real(row1[iX1]) * (dx * dy);
+      return T(result);
+    }
+  };
+
+  template <class T> struct CompactRemapBand
+  {
+    typedef typename Pii::IfClass<IsFixedPointRemappable<T>, FixedPointRemap, FloatingPointRemap>::Type Interpolator;
+
+    CompactRemapBand(const PiiMatrix<T>& image, const PiiCompactCoordinateMap& map,
+                     PiiMatrix<T>& result, int tileSize) :
+      image(image), map(map), result(result), iTileSize(tileSize)
+    {}
+
+    void operator() (int firstTile, int lastTile, int) const
+    {
+      const int iRows = map.rows(), iColumns = map.columns();
+      const int iTileWidth = map.tileSize() > 0 ? iTileSize : iColumns;
+      const char* pImage = reinterpret_cast<const char*>(image.row(0));
+      const std::size_t iStride = image.stride();
+      for (int iTile = firstTile; iTile < lastTile; ++iTile)
+        {
+          const int iFirstRow = iTile * iTileSize, iLastRow = qMin(iRows, iFirstRow + iTileSize);
+          for (int iFirstColumn = 0; iFirstColumn < iColumns; iFirstColumn += iTileWidth)
+            {
+              const int iLastColumn = qMin(iColumns, iFirstColumn + iTileWidth);
+              for (int r = iFirstRow; r < iLastRow; ++r)
+                {
+                  const short* pCoordinates = map.coordinateRow(r);
+                  const unsigned short* pFractions = map.fractionRow(r);
+                  T* pResult = result.row(r);
+                  for (int c = iFirstColumn; c < iLastColumn; ++c)
+                    {
+                      const int iX = pCoordinates[2*c], iY = pCoordinates[2*c+1];
+                      if (iX < 0)
+                        {
+                          pResult[c] = T(0);
+                          continue;
+                        }
+                      const int iFx = pFractions[c] & 0xff, iFy = pFractions[c] >> 8;
+                      const T* pRow0 = reinterpret_cast<const T*>(pImage + iY * iStride);
+                      // A zero fraction never reads the next row.
+                      const T* pRow1 = reinterpret_cast<const T*>(pImage + (iY + (iFy != 0)) * iStride);
+                      pResult[c] = Interpolator::interpolate(pRow0, pRow1, iX, iFx, iFy);
+                    }
+                }
+            }
+        }
+    }
+
+    const PiiMatrix<T>& image;
+    const PiiCompactCoordinateMap& map;
+    PiiMatrix<T>& result;
+    int iTileSize;
+  };
+  /// @endhide
+
+  template <class T> PiiMatrix<T> remap(const PiiMatrix<T>& image, const PiiCompactCoordinateMap& map,
+                                        int threads)
+  {
+    const int iRows = map.rows(), iColumns = map.columns();
+    if (image.rows() != map.sourceRows() || image.columns() != map.sourceColumns() ||
+        image.isEmpty())
+      return PiiMatrix<T>(iRows, iColumns);
+
+    PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(iRows, iColumns));
+    if (matResult.isEmpty())
+      return matResult;
+    // Without tiling, each row is a tile of its own.
+    const int iTileSize = map.tileSize() > 0 ? map.tileSize() : 1;
+    const int iTileRows = (iRows + iTileSize - 1) / iTileSize;
+    CompactRemapBand<T> band(image, map, matResult, iTileSize);
+    Pii::parallelFor(iTileRows, band, threads,
+                     qMax(1, Pii::reductionMinBandRows(iColumns) / iTileSize));
+    return matResult;
+  }
+
   /// @internal
   template <class T> inline T transformHomogeneousPoint(const T* transform, T x, T y)
   {
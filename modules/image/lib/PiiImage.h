@@ -22,6 +22,7 @@
 #include <PiiDsp.h>
 #include <PiiColor.h>
 #include <PiiPoint.h>
+#include "PiiCompactCoordinateMap.h"
 
 /**
  * Definitions and functions for image processing.
@@ -829,6 +830,10 @@ namespace PiiImage
    * @param windowColumns the size of the local window in horizontal
    * direction. If this value is less than one, `windowRows` will be
    * used instead.
+   *
+   * A window larger than the image is clamped to the size of the
+   * image. The filter takes a constant time per pixel irrespective of
+   * the window size. See [localMaximum()].
    */
   template <class T> PiiMatrix<T> maxFilter(const PiiMatrix<T>& image,
                                             int windowRows, int windowColumns = -1);
@@ -1131,10 +1136,16 @@ namespace PiiImage
    * accepts only strong corners. The lower the value, the more
    * corners are detected, which also means lower processing speed.
    *
+   * @param threads the number of threads. Zero means the number of
+   * processor cores.
+   *
    * @return a N-by-2 matrix in which each row stores the (x,y)
-   * coordinates of a detected corner.
+   * coordinates of a detected corner. Non-maximal corners have been
+   * suppressed.
+   *
+   * @see PiiFastCornerDetector
    */
-  template <class T> PiiMatrix<int> detectFastCorners(const PiiMatrix<T>& image, T threshold=25);
+  template <class T> PiiMatrix<int> detectFastCorners(const PiiMatrix<T>& image, T threshold=25, int threads=1);
 
   /**
    * Transforms *image* according to the given coordinate *map*. The
@@ -1149,6 +1160,27 @@ namespace PiiImage
    */
   template <class T, class U> PiiMatrix<T> remap(const PiiMatrix<T>& image, const PiiMatrix<PiiPoint<U> >& map);
 
+  /**
+   * Transforms *image* according to a compact fixed-point coordinate
+   * *map*. The result is the same as with the floating-point map
+   * except that the bilinear interpolation weights are quantized to
+   * 1/128 of a pixel. 8 and 16-bit integer images are interpolated
+   * in fixed point. Other types are interpolated in floating point.
+   * The output image is processed in the tiles specified by the map.
+   *
+   * @param image the source image. Its size must match the source
+   * size of *map*. If it doesn't, a black image will be returned.
+   *
+   * @param map the coordinate map. The size of the result image will
+   * be equal to the size of the map.
+   *
+   * @param threads the maximum number of threads. Zero means the
+   * number of processor cores. Small images are always processed in
+   * a single thread.
+   */
+  template <class T> PiiMatrix<T> remap(const PiiMatrix<T>& image, const PiiCompactCoordinateMap& map,
+                                        int threads = 1);
+
   template <class T, class Matrix, class UnaryFunction>
   PiiMatrix<T> collectCoordinates(const Matrix& image,
                                   UnaryFunction decisionRule)
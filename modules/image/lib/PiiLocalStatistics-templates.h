@@ -0,0 +1,305 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIILOCALSTATISTICS_H
+# error "Never use <PiiLocalStatistics-templates.h> directly; include <PiiLocalStatistics.h> instead."
+#endif
+
+#include <QVector>
+
+template <class T> void PiiLocalStatistics<T>::setImage(const PiiMatrix<T>& image, bool squares, int threads)
+{
+  const int iRows = image.rows() + 1, iColumns = image.columns() + 1;
+  if (_matSum.rows() != iRows || _matSum.columns() != iColumns)
+    {
+      _matSum = PiiMatrix<SumType>::uninitialized(iRows, iColumns);
+      Pii::fillN(_matSum.rowBegin(0), iColumns, SumType(0));
+      Pii::fillN(_matSum.columnBegin(0), iRows, SumType(0));
+    }
+  if (!squares)
+    _matSquareSum = PiiMatrix<SquareSumType>();
+  else if (_matSquareSum.rows() != iRows || _matSquareSum.columns() != iColumns)
+    {
+      _matSquareSum = PiiMatrix<SquareSumType>::uninitialized(iRows, iColumns);
+      Pii::fillN(_matSquareSum.rowBegin(0), iColumns, SquareSumType(0));
+      Pii::fillN(_matSquareSum.columnBegin(0), iRows, SquareSumType(0));
+    }
+  if (image.isEmpty())
+    return;
+
+  Pii::cumulativeSum(image, _matSum, Pii::Cast<T,SumType>(), Pii::ZeroBorderCumulativeSum, threads);
+  if (squares)
+    Pii::cumulativeSum(image, _matSquareSum, Pii::Square<SquareSumType>(), Pii::ZeroBorderCumulativeSum, threads);
+}
+
+/// @hide
+namespace PiiImage
+{
+  struct LocalMeanFunction
+  {
+    template <class Statistics> static double value(const Statistics& stats, int r1, int c1, int r2, int c2)
+    {
+      return stats.mean(r1, c1, r2, c2);
+    }
+  };
+
+  struct LocalVarianceFunction
+  {
+    template <class Statistics> static double value(const Statistics& stats, int r1, int c1, int r2, int c2)
+    {
+      return stats.variance(r1, c1, r2, c2);
+    }
+  };
+
+  template <class Statistics, class U, class Function> struct LocalStatisticsBand
+  {
+    LocalStatisticsBand(const Statistics& stats, PiiMatrix<U>& result, int windowRows, int windowColumns) :
+      stats(stats), result(result), iWindowRows(windowRows), iWindowColumns(windowColumns)
+    {}
+
+    void operator() (int firstRow, int lastRow, int) const
+    {
+      const int iRows = stats.rows(), iColumns = stats.columns();
+      const int iTop = iWindowRows / 2, iLeft = iWindowColumns / 2;
+      for (int r=firstRow; r<lastRow; ++r)
+        {
+          const int r1 = qMax(r - iTop, 0), r2 = qMin(r - iTop + iWindowRows, iRows);
+          U* pTarget = result.row(r);
+          for (int c=0; c<iColumns; ++c)
+            pTarget[c] = U(Function::value(stats, r1, qMax(c - iLeft, 0), r2, qMin(c - iLeft + iWindowColumns, iColumns)));
+        }
+    }
+
+    const Statistics& stats;
+    PiiMatrix<U>& result;
+    int iWindowRows, iWindowColumns;
+  };
+}
+/// @endhide
+
+template <class T>
+template <class U, class Function> PiiMatrix<U> PiiLocalStatistics<T>::windowImage(int windowRows,
+                                                                                  int windowColumns,
+                                                                                  int threads) const
+{
+  if (windowColumns < 1)
+    windowColumns = windowRows;
+  PiiMatrix<U> matResult(PiiMatrix<U>::uninitialized(rows(), columns()));
+  if (matResult.isEmpty())
+    return matResult;
+  PiiImage::LocalStatisticsBand<PiiLocalStatistics<T>, U, Function> band(*this, matResult, windowRows, windowColumns);
+  Pii::parallelFor(rows(), band, threads, Pii::reductionMinBandRows(columns()));
+  return matResult;
+}
+
+template <class T>
+template <class U> PiiMatrix<U> PiiLocalStatistics<T>::meanImage(int windowRows, int windowColumns, int threads) const
+{
+  return windowImage<U, PiiImage::LocalMeanFunction>(windowRows, windowColumns, threads);
+}
+
+template <class T>
+template <class U> PiiMatrix<U> PiiLocalStatistics<T>::varianceImage(int windowRows, int windowColumns, int threads) const
+{
+  return windowImage<U, PiiImage::LocalVarianceFunction>(windowRows, windowColumns, threads);
+}
+
+namespace PiiImage
+{
+  /// @hide
+  /* The van Herk/Gil-Werman algorithm splits a line into blocks as
+   * long as the window. Within each block, prefix[i] holds the
+   * extremum from the beginning of the block to i, and suffix[i] the
+   * extremum from i to the end of the block. A full window [a, a+w)
+   * always covers the end of one block and the beginning of the next,
+   * and its extremum is op(suffix[a], prefix[a+w-1]). Windows clipped
+   * at the borders are handled separately.
+   */
+  template <class T, class BinaryFunction>
+  inline T clippedExtremum(const T* prefix, const T* suffix, int a, int b, int window, BinaryFunction op)
+  {
+    if (a / window == b / window)
+      return a % window == 0 ? prefix[b] : suffix[a];
+    return op(suffix[a], prefix[b]);
+  }
+
+  template <class T, class BinaryFunction> struct HorizontalExtremumBand
+  {
+    HorizontalExtremumBand(const PiiMatrix<T>& image, PiiMatrix<T>& result, int window, BinaryFunction op) :
+      image(image), result(result), iWindow(window), op(op)
+    {}
+
+    void operator() (int firstRow, int lastRow, int) const
+    {
+      const int iColumns = image.columns(), iLeft = iWindow / 2;
+      QVector<T> vecPrefix(iColumns), vecSuffix(iColumns);
+      T* pPrefix = vecPrefix.data(), *pSuffix = vecSuffix.data();
+      // Columns whose window is not clipped.
+      const int iFirstFull = qMin(iLeft, iColumns), iLastFull = qMax(iColumns - iWindow + iLeft + 1, iFirstFull);
+      for (int r=firstRow; r<lastRow; ++r)
+        {
+          const T* pSource = image.row(r);
+          T* pTarget = result.row(r);
+          for (int c=0; c<iColumns; ++c)
+            pPrefix[c] = c % iWindow == 0 ? pSource[c] : op(pPrefix[c-1], pSource[c]);
+          for (int c=iColumns-1; c>=0; --c)
+            pSuffix[c] = (c % iWindow == iWindow-1 || c == iColumns-1) ? pSource[c] : op(pSuffix[c+1], pSource[c]);
+
+          for (int c=0; c<iFirstFull; ++c)
+            pTarget[c] = clippedExtremum(pPrefix, pSuffix, 0, qMin(c - iLeft + iWindow, iColumns) - 1, iWindow, op);
+          for (int c=iFirstFull; c<iLastFull; ++c)
+            pTarget[c] = op(pSuffix[c - iLeft], pPrefix[c - iLeft + iWindow - 1]);
+          for (int c=iLastFull; c<iColumns; ++c)
+            pTarget[c] = clippedExtremum(pPrefix, pSuffix, qMax(c - iLeft, 0), iColumns - 1, iWindow, op);
+        }
+    }
+
+    const PiiMatrix<T>& image;
+    PiiMatrix<T>& result;
+    int iWindow;
+    BinaryFunction op;
+  };
+
+  // Runs the same algorithm vertically, a whole row at a time, on a
+  // band of columns.
+  template <class T, class BinaryFunction> struct VerticalExtremumBand
+  {
+    VerticalExtremumBand(PiiMatrix<T>& image, PiiMatrix<T>& prefix, PiiMatrix<T>& suffix,
+                         int window, BinaryFunction op) :
+      image(image), prefix(prefix), suffix(suffix), iWindow(window), op(op)
+    {}
+
+    void operator() (int firstColumn, int lastColumn, int) const
+    {
+      const int iRows = image.rows(), iTop = iWindow / 2;
+      for (int r=0; r<iRows; ++r)
+        {
+          const T* pSource = image.row(r);
+          T* pPrefix = prefix.row(r);
+          if (r % iWindow == 0)
+            for (int c=firstColumn; c<lastColumn; ++c)
+              pPrefix[c] = pSource[c];
+          else
+            {
+              const T* pPrevious = prefix.row(r-1);
+              for (int c=firstColumn; c<lastColumn; ++c)
+                pPrefix[c] = op(pPrevious[c], pSource[c]);
+            }
+        }
+      for (int r=iRows-1; r>=0; --r)
+        {
+          const T* pSource = image.row(r);
+          T* pSuffix = suffix.row(r);
+          if (r % iWindow == iWindow-1 || r == iRows-1)
+            for (int c=firstColumn; c<lastColumn; ++c)
+              pSuffix[c] = pSource[c];
+          else
+            {
+              const T* pNext = suffix.row(r+1);
+              for (int c=firstColumn; c<lastColumn; ++c)
+                pSuffix[c] = op(pNext[c], pSource[c]);
+            }
+        }
+      for (int r=0; r<iRows; ++r)
+        {
+          const int a = qMax(r - iTop, 0), b = qMin(r - iTop + iWindow, iRows) - 1;
+          T* pTarget = image.row(r);
+          if (a / iWindow != b / iWindow)
+            {
+              const T* pSuffix = suffix.row(a), *pPrefix = prefix.row(b);
+              for (int c=firstColumn; c<lastColumn; ++c)
+                pTarget[c] = op(pSuffix[c], pPrefix[c]);
+            }
+          else
+            {
+              const T* pSource = a % iWindow == 0 ? prefix.row(b) : suffix.row(a);
+              for (int c=firstColumn; c<lastColumn; ++c)
+                pTarget[c] = pSource[c];
+            }
+        }
+    }
+
+    PiiMatrix<T>& image;
+    PiiMatrix<T>& prefix;
+    PiiMatrix<T>& suffix;
+    int iWindow;
+    BinaryFunction op;
+  };
+
+  template <class T, class BinaryFunction> PiiMatrix<T> localExtremum(const PiiMatrix<T>& image,
+                                                                     int windowRows, int windowColumns,
+                                                                     int threads, BinaryFunction op)
+  {
+    if (windowColumns < 1)
+      windowColumns = windowRows;
+    const int iRows = image.rows(), iColumns = image.columns();
+    if (image.isEmpty())
+      return PiiMatrix<T>(iRows, iColumns);
+
+    PiiMatrix<T> matResult;
+    if (windowColumns > 1)
+      {
+        matResult = PiiMatrix<T>::uninitialized(iRows, iColumns);
+        HorizontalExtremumBand<T,BinaryFunction> band(image, matResult, windowColumns, op);
+        Pii::parallelFor(iRows, band, threads, Pii::reductionMinBandRows(iColumns));
+      }
+    else
+      matResult = image;
+
+    if (windowRows > 1)
+      {
+        // Detach in the main thread
+        matResult.row(0);
+        PiiMatrix<T> matPrefix(PiiMatrix<T>::uninitialized(iRows, iColumns));
+        PiiMatrix<T> matSuffix(PiiMatrix<T>::uninitialized(iRows, iColumns));
+        VerticalExtremumBand<T,BinaryFunction> band(matResult, matPrefix, matSuffix, windowRows, op);
+        // Narrow column bands would share cache lines.
+        Pii::parallelFor(iColumns, band, threads, qMax(16, Pii::reductionMinBandRows(iRows)));
+      }
+    return matResult;
+  }
+  /// @endhide
+
+  template <class T> PiiMatrix<T> localMinimum(const PiiMatrix<T>& image,
+                                               int windowRows, int windowColumns,
+                                               int threads)
+  {
+    return localExtremum(image, windowRows, windowColumns, threads, Pii::Min<T>());
+  }
+
+  template <class T> PiiMatrix<T> localMaximum(const PiiMatrix<T>& image,
+                                               int windowRows, int windowColumns,
+                                               int threads)
+  {
+    return localExtremum(image, windowRows, windowColumns, threads, Pii::Max<T>());
+  }
+
+  template <class T> PiiMatrix<T> localContrast(const PiiMatrix<T>& image,
+                                                int windowRows, int windowColumns,
+                                                int threads)
+  {
+    PiiMatrix<T> matResult(localMaximum(image, windowRows, windowColumns, threads));
+    PiiMatrix<T> matMinimum(localMinimum(image, windowRows, windowColumns, threads));
+    const int iRows = image.rows(), iColumns = image.columns();
+    for (int r=0; r<iRows; ++r)
+      {
+        const T* pSource = image.row(r), *pMinimum = matMinimum.row(r);
+        T* pTarget = matResult.row(r);
+        for (int c=0; c<iColumns; ++c)
+          pTarget[c] = qMax(T(pTarget[c] - pSource[c]), T(pSource[c] - pMinimum[c]));
+      }
+    return matResult;
+  }
+}
@@ -0,0 +1,226 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _PIILOCALSTATISTICS_H
+#define _PIILOCALSTATISTICS_H
+
+#include <PiiMath.h>
+#include <PiiParallel.h>
+
+/**
+ * Windowed statistics over an image in constant time per pixel.
+ * PiiLocalStatistics builds the integral images (see
+ * Pii::cumulativeSum()) of the input and its square once, after which
+ * the sum, mean and variance of any rectangular window can be
+ * retrieved with four look-ups each.
+ *
+ * Integer images are summed with 64-bit integers, and the sums are
+ * therefore exact. The squares of 32-bit integers may not fit into 64
+ * bits; they and all floating-point types are summed as `double`.
+ *
+ * ~~~(c++)
+ * PiiLocalStatistics<unsigned char> stats(matImage);
+ * // Local variance in a 15-by-15 window around each pixel
+ * PiiMatrix<float> matVariance(stats.varianceImage<float>(15));
+ * // Mean of a single window
+ * double dMean = stats.mean(10, 10, 20, 30);
+ * ~~~
+ *
+ * Local minima and maxima cannot be derived from integral images.
+ * They are calculated by [PiiImage::localMinimum()] and
+ * [PiiImage::localMaximum()], which also take a constant time per
+ * pixel.
+ */
+template <class T> class PiiLocalStatistics
+{
+public:
+  /**
+   * The type of the integral image.
+   */
+  typedef typename Pii::IfClass<Pii::IsInteger<T>, long long, double>::Type SumType;
+  /**
+   * The type of the integral image of squares.
+   */
+  typedef typename Pii::IfClass<Pii::And<Pii::IsInteger<T>::boolValue, (sizeof(T) <= 2)>,
+                                long long, double>::Type SquareSumType;
+
+  /**
+   * Creates an empty statistics object.
+   */
+  PiiLocalStatistics() {}
+
+  /**
+   * Calculates the integral images of *image*.
+   *
+   * @param squares if `false`, the integral image of squares will not
+   * be calculated, and [variance()] cannot be used.
+   *
+   * @param threads the number of threads used in calculating the
+   * integral images. Zero means the number of processor cores.
+   */
+  PiiLocalStatistics(const PiiMatrix<T>& image, bool squares = true, int threads = 1)
+  {
+    setImage(image, squares, threads);
+  }
+
+  /**
+   * Recalculates the integral images for a new image. If the size of
+   * the image does not change, the old buffers will be reused.
+   */
+  void setImage(const PiiMatrix<T>& image, bool squares = true, int threads = 1);
+
+  /**
+   * Returns the number of rows in the image.
+   */
+  int rows() const { return qMax(_matSum.rows() - 1, 0); }
+  /**
+   * Returns the number of columns in the image.
+   */
+  int columns() const { return qMax(_matSum.columns() - 1, 0); }
+  /**
+   * Returns `true` if the integral image of squares is available.
+   */
+  bool hasSquares() const { return !_matSquareSum.isEmpty(); }
+
+  /**
+   * Returns the integral image in `Pii::ZeroBorderCumulativeSum`
+   * format.
+   */
+  const PiiMatrix<SumType>& integralImage() const { return _matSum; }
+  /**
+   * Returns the integral image of squares in
+   * `Pii::ZeroBorderCumulativeSum` format.
+   */
+  const PiiMatrix<SquareSumType>& integralImageOfSquares() const { return _matSquareSum; }
+
+  /**
+   * Returns the sum of the pixels in the window that starts at
+   * (*r1*, *c1*) and ends just before (*r2*, *c2*).
+   */
+  SumType sum(int r1, int c1, int r2, int c2) const
+  {
+    return windowSum(_matSum, r1, c1, r2, c2);
+  }
+
+  /**
+   * Returns the sum of squared pixels in a window.
+   */
+  SquareSumType sumOfSquares(int r1, int c1, int r2, int c2) const
+  {
+    return windowSum(_matSquareSum, r1, c1, r2, c2);
+  }
+
+  /**
+   * Returns the mean of the pixels in a window.
+   */
+  double mean(int r1, int c1, int r2, int c2) const
+  {
+    return double(sum(r1, c1, r2, c2)) / ((r2-r1) * (c2-c1));
+  }
+
+  /**
+   * Returns the variance of the pixels in a window.
+   *
+   * @param mean an optional output-value argument that will store the
+   * mean of the window.
+   */
+  double variance(int r1, int c1, int r2, int c2, double* mean = 0) const
+  {
+    const double dCount = double((r2-r1) * (c2-c1));
+    const double dMean = double(sum(r1, c1, r2, c2)) / dCount;
+    if (mean != 0)
+      *mean = dMean;
+    // Rounding errors may make the variance of a flat window slightly
+    // negative.
+    return qMax(double(sumOfSquares(r1, c1, r2, c2)) / dCount - dMean * dMean, 0.0);
+  }
+
+  /**
+   * Returns the mean in a *windowRows* -by- *windowColumns* window
+   * around each pixel. The window is clipped at image borders. Like
+   * in PiiImage::maxFilter(), a window of size *w* around pixel *x*
+   * starts at *x* - *w* / 2.
+   *
+   * @param windowColumns the width of the window. If this value is
+   * less than one, *windowRows* will be used.
+   *
+   * @param threads the number of threads. Zero means the number of
+   * processor cores.
+   */
+  template <class U> PiiMatrix<U> meanImage(int windowRows, int windowColumns = 0, int threads = 1) const;
+
+  /**
+   * Returns the variance in a window around each pixel. See
+   * [meanImage()] for a description of the parameters.
+   */
+  template <class U> PiiMatrix<U> varianceImage(int windowRows, int windowColumns = 0, int threads = 1) const;
+
+private:
+  template <class S> static S windowSum(const PiiMatrix<S>& integral, int r1, int c1, int r2, int c2)
+  {
+    const S* pTop = integral[r1], *pBottom = integral[r2];
+    return pBottom[c2] + pTop[c1] - pBottom[c1] - pTop[c2];
+  }
+
+  template <class U, class Function> PiiMatrix<U> windowImage(int windowRows, int windowColumns, int threads) const;
+
+  PiiMatrix<SumType> _matSum;
+  PiiMatrix<SquareSumType> _matSquareSum;
+};
+
+namespace PiiImage
+{
+  /**
+   * Returns the minimum in a *windowRows* -by- *windowColumns*
+   * window around each pixel. The result equals that of
+   * [minFilter()], but the calculation takes a constant time per
+   * pixel irrespective of the window size (van Herk/Gil-Werman
+   * algorithm).
+   *
+   * @param threads the number of threads. Zero means the number of
+   * processor cores.
+   */
+  template <class T> PiiMatrix<T> localMinimum(const PiiMatrix<T>& image,
+                                               int windowRows, int windowColumns = 0,
+                                               int threads = 1);
+
+  /**
+   * Returns the maximum in a *windowRows* -by- *windowColumns*
+   * window around each pixel.
+   *
+   * @see localMinimum()
+   */
+  template <class T> PiiMatrix<T> localMaximum(const PiiMatrix<T>& image,
+                                               int windowRows, int windowColumns = 0,
+                                               int threads = 1);
+
+  /**
+   * Returns the local contrast around each pixel, defined as the
+   * largest absolute difference between the pixel and the pixels in
+   * a *windowRows* -by- *windowColumns* window around it.
+   *
+   * ~~~(c++)
+   * // Largest difference to any pixel in a 5-by-5 neighborhood
+   * PiiMatrix<int> matContrast(PiiImage::localContrast(matImage, 5));
+   * ~~~
+   */
+  template <class T> PiiMatrix<T> localContrast(const PiiMatrix<T>& image,
+                                                int windowRows, int windowColumns = 0,
+                                                int threads = 1);
+}
+
+#include "PiiLocalStatistics-templates.h"
+
+#endif //_PIILOCALSTATISTICS_H
@@ -18,6 +18,7 @@
 
 #include <PiiMatrix.h>
 #include "PiiHistogram.h"
+#include "PiiLocalStatistics.h"
 
 namespace PiiImage
 {
@@ -73,13 +74,18 @@ namespace PiiImage
     return th;
   }
 
+  /// @hide
+  // Thresholds rows [firstRow, lastRow) of image. Used by
+  // adaptiveThresholdImpl() and by operations that split the work
+  // into row bands.
   template <class Image, class IntegralImage, class PixelCounter, class BinaryFunction>
-  void adaptiveThresholdImpl(const Image& image,
+  void adaptiveThresholdRows(const Image& image,
                              PiiMatrix<typename BinaryFunction::result_type>& matThresholded,
                              const IntegralImage& integral,
                              const PixelCounter& counter,
                              BinaryFunction func,
-                             int windowRows, int windowColumns)
+                             int windowRows, int windowColumns,
+                             int firstRow, int lastRow)
   {
     typedef typename BinaryFunction::result_type T;
     typedef typename Image::const_row_iterator ImageRow;
@@ -95,7 +101,7 @@ namespace PiiImage
 
     IntegralRow prevRow, nextRow;
     T* pTarget;
-    for (int r=0; r<iRows; ++r)
+    for (int r=firstRow; r<lastRow; ++r)
       {
         // Check image boundaries
         r1 = qMax(r-iHalfRows, 0);
@@ -116,6 +122,19 @@ namespace PiiImage
       }
   }
 
+  template <class Image, class IntegralImage, class PixelCounter, class BinaryFunction>
+  inline void adaptiveThresholdImpl(const Image& image,
+                                    PiiMatrix<typename BinaryFunction::result_type>& matThresholded,
+                                    const IntegralImage& integral,
+                                    const PixelCounter& counter,
+                                    BinaryFunction func,
+                                    int windowRows, int windowColumns)
+  {
+    adaptiveThresholdRows(image, matThresholded, integral, counter, func,
+                          windowRows, windowColumns, 0, image.rows());
+  }
+  /// @endhide
+
   template <class Image, class PixelCounter, class BinaryFunction>
   inline void adaptiveThresholdImpl(const Image& image,
                                     PiiMatrix<typename BinaryFunction::result_type>& matThresholded,
@@ -271,17 +290,11 @@ namespace PiiImage
      */
 
     typedef typename TernaryFunction::result_type T;
+    typedef typename Matrix::value_type V;
     typedef typename Matrix::const_row_iterator ImageRow;
 
-    // Use at least int accuracy for the integral image
-    typedef typename Pii::Combine<typename Matrix::value_type,int>::Type I;
-    // Use at least long long accuracy for the integral image of squares
-    typedef typename Pii::Combine<typename Matrix::value_type,long long>::Type I2;
-
-    // Calculate an integral image
-    PiiMatrix<I> matIntegral = Pii::cumulativeSum<I,Matrix>(image, Pii::ZeroBorderCumulativeSum);
-    // Integral image of squares
-    PiiMatrix<I2> matIntegral2 = Pii::cumulativeSum(image, Pii::Square<I2>(), Pii::ZeroBorderCumulativeSum);
+    // Integral images of the image and its square
+    PiiLocalStatistics<V> stats((PiiMatrix<V>(image)));
 
     if (windowColumns <= 0)
       windowColumns = windowRows;
@@ -289,19 +302,12 @@ namespace PiiImage
     const int iRows = image.rows(), iCols = image.columns();
     int c1, c2, r1, r2;
 
-    const I* pPrevRow, *pNextRow;
-    const I2* pPrevRow2, *pNextRow2;
-
     T* pTarget;
     for (int r=0; r<iRows; ++r)
       {
         // Check image boundaries
         r1 = qMax(r-iHalfRows, 0);
         r2 = qMin(r+iHalfRows+1, iRows);
-        pPrevRow = matIntegral[r1];
-        pNextRow = matIntegral[r2];
-        pPrevRow2 = matIntegral2[r1];
-        pNextRow2 = matIntegral2[r2];
         pTarget = matThresholded[r];
         ImageRow pSource = image[r];
 
@@ -309,10 +315,8 @@ namespace PiiImage
           {
             c1 = qMax(c-iHalfCols, 0);
             c2 = qMin(c+iHalfCols+1, iCols);
-            int iCount = (c2-c1) * (r2-r1);
-            double dMean = double(pNextRow[c2] + pPrevRow[c1] - pNextRow[c1] - pPrevRow[c2]) / iCount;
-            double dVar = double(pNextRow2[c2] + pPrevRow2[c1] - pNextRow2[c1] - pPrevRow2[c2]) / iCount // sum(x)/N
-              - Pii::square(dMean);
+            double dMean;
+            double dVar = stats.variance(r1, c1, r2, c2, &dMean);
 
             pTarget[c] = func(pSource[c],
                               dMean,
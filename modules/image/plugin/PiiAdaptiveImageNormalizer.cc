@@ -21,7 +21,8 @@
 
 PiiAdaptiveImageNormalizer::Data::Data() :
   windowSize(64,64),
-  dTargetMean(NAN)
+  dTargetMean(NAN),
+  iNormalizerThreadCount(0)
 {
 }
 
@@ -58,6 +59,26 @@ template <> struct PiiAdaptiveImageNormalizer::Normalizer<uchar> : Pii::BinaryFu
   float fTarget;
 };
 
+template <class T, class I> struct PiiAdaptiveImageNormalizer::NormalizerBand
+{
+  NormalizerBand(const PiiMatrix<T>& image, const PiiMatrix<I>& integral,
+                 PiiMatrix<T>& result, float target, const QSize& windowSize) :
+    image(image), integral(integral), result(result), normalizer(target), windowSize(windowSize)
+  {}
+
+  void operator() (int begin, int end, int /*band*/)
+  {
+    PiiImage::adaptiveThresholdRows(image, result, integral, PiiImage::DefaultPixelCounter(), normalizer,
+                                    windowSize.width(), windowSize.height(), begin, end);
+  }
+
+  const PiiMatrix<T>& image;
+  const PiiMatrix<I>& integral;
+  PiiMatrix<T>& result;
+  Normalizer<T> normalizer;
+  QSize windowSize;
+};
+
 template <class T> void PiiAdaptiveImageNormalizer::normalizeGray(const PiiVariant& obj)
 {
   emitObject(normalize(obj.valueAs<PiiMatrix<T> >()));
@@ -78,7 +99,15 @@ template <class T> PiiMatrix<T> PiiAdaptiveImageNormalizer::normalize(const PiiM
   double dTarget = d->dTargetMean;
   if (Pii::isNan(dTarget))
     dTarget = PiiImage::Traits<T>::max() / 2;
-  return PiiImage::adaptiveThreshold(image, Normalizer<T>(dTarget), d->windowSize.width(), d->windowSize.height());
+
+  // Same integral type as in PiiImage::adaptiveThreshold()
+  typedef typename Pii::Combine<T,int>::Type I;
+  const int iThreads = d->iNormalizerThreadCount;
+  PiiMatrix<I> matIntegral(Pii::cumulativeSum<I>(image, Pii::ZeroBorderCumulativeSum, iThreads));
+  PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(image.rows(), image.columns()));
+  NormalizerBand<T,I> band(image, matIntegral, matResult, dTarget, d->windowSize);
+  Pii::parallelFor(image.rows(), band, iThreads, Pii::reductionMinBandRows(image.columns()));
+  return matResult;
 }
 
 void PiiAdaptiveImageNormalizer::setWindowSize(const QSize& windowSize) { _d()->windowSize = windowSize; }
@@ -86,3 +115,5 @@ QSize PiiAdaptiveImageNormalizer::windowSize() const { return _d()->windowSize;
 
 void PiiAdaptiveImageNormalizer::setTargetMean(double targetMean) { _d()->dTargetMean = targetMean; }
 double PiiAdaptiveImageNormalizer::targetMean() const { return _d()->dTargetMean; }
+void PiiAdaptiveImageNormalizer::setNormalizerThreadCount(int normalizerThreadCount) { _d()->iNormalizerThreadCount = normalizerThreadCount; }
+int PiiAdaptiveImageNormalizer::normalizerThreadCount() const { return _d()->iNormalizerThreadCount; }
@@ -59,6 +59,18 @@ class PiiAdaptiveImageNormalizer : public PiiDefaultOperation
    */
   Q_PROPERTY(double targetMean READ targetMean WRITE setTargetMean);
 
+  /**
+   * The maximum number of threads used for normalizing a single
+   * image. Both the local sums and the normalized pixels are
+   * calculated in parallel row bands. Zero means the number of
+   * processor cores. Small images are always processed in a single
+   * thread. Integer images produce identical results with any number
+   * of threads. With floating-point images, the order of additions
+   * in the local sums depends on the number of threads. The default
+   * is zero.
+   */
+  Q_PROPERTY(int normalizerThreadCount READ normalizerThreadCount WRITE setNormalizerThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   PiiAdaptiveImageNormalizer();
@@ -72,11 +84,15 @@ protected:
   void setTargetMean(double targetMean);
   double targetMean() const;
 
+  void setNormalizerThreadCount(int normalizerThreadCount);
+  int normalizerThreadCount() const;
+
 private:
   template <class T> void normalizeColor(const PiiVariant& obj);
   template <class T> void normalizeGray(const PiiVariant& obj);
   template <class T> PiiMatrix<T> normalize(const PiiMatrix<T>& obj);
   template <class T> struct Normalizer;
+  template <class T, class I> struct NormalizerBand;
 
   /// @internal
   class Data : public PiiDefaultOperation::Data
@@ -85,6 +101,7 @@ private:
     Data();
     QSize windowSize;
     double dTargetMean;
+    int iNormalizerThreadCount;
   };
   PII_D_FUNC;
 };
@@ -16,13 +16,23 @@
 #include "PiiBackgroundExtractor.h"
 #include <PiiYdinTypes.h>
 #include <QString>
+#include <QVector>
 #include <PiiMath.h>
 #include <PiiImageTraits.h>
+#include <cmath>
 
 PiiBackgroundExtractor::Data::Data() :
-  bFirst(true), dThreshold(25.0),
+  dThreshold(25.0),
   dAlpha1(0.1), dAlpha2(0.01),
-  iMaxStillTime(1000), dMovementThreshold(0.0)
+  iMaxStillTime(1000), dMovementThreshold(0.0),
+  backgroundModel(RunningAverageModel),
+  bFixedPoint(false),
+  iGaussianCount(3),
+  dMixtureLearningRate(0.01),
+  dMixtureMatchThreshold(2.5),
+  dMixtureBackgroundRatio(0.7),
+  dMixtureInitialDeviation(15.0),
+  iExtractorThreadCount(0)
 {
 }
 
@@ -46,73 +56,374 @@ void PiiBackgroundExtractor::process()
     }
 }
 
+/* Updates the running average in a band of rows. This does the same
+ * as the original per-pixel loop, but without branches and in single
+ * precision.
+ */
+struct PiiBackgroundExtractor::RunningAverageBand
+{
+  RunningAverageBand(const PiiMatrix<float>& input, PiiMatrix<float>& background,
+                     PiiMatrix<int>& stillCounter, double threshold,
+                     double alpha1, double alpha2, int maxStillTime) :
+    input(input), background(background), stillCounter(stillCounter),
+    fThreshold(float(threshold)), fAlpha1(float(alpha1)), fAlpha2(float(alpha2)),
+    bInclusive(double(fThreshold) > threshold),
+    iMaxStillTime(maxStillTime), pForegroundCounts(0)
+  {}
+
+  void operator() (int begin, int end, int band)
+  {
+    const int iColumns = input.columns();
+    int iForeground = 0;
+    for (int r=begin; r<end; ++r)
+      {
+        const float* pInput = input[r];
+        float* pBackground = background.row(r);
+        int* pStillCounter = stillCounter.row(r);
+        for (int c=0; c<iColumns; ++c)
+          {
+            const float fDifference = pInput[c] - pBackground[c];
+            // If the threshold was rounded up, no float lies between
+            // it and the original one, and >= gives the same result
+            // as a comparison in double precision.
+            const float fAbsDifference = std::fabs(fDifference);
+            const int iMoving = bInclusive ? fAbsDifference >= fThreshold : fAbsDifference > fThreshold;
+            iForeground += iMoving;
+            // Count successive foreground frames. If the pixel has
+            // been foreground for too long, make it background.
+            const int iStill = (pStillCounter[c] + 1) * iMoving;
+            const bool bBurntIn = iStill > iMaxStillTime;
+            pStillCounter[c] = bBurntIn ? 0 : iStill;
+            const float fBase = bBurntIn ? pInput[c] : pBackground[c];
+            // B_t+1 = B_t + (alpha1 * (1 - M_t) + alpha2 * M_t) * D_t
+            pBackground[c] = fBase + (iMoving ? fAlpha2 : fAlpha1) * fDifference;
+          }
+      }
+    pForegroundCounts[band] = iForeground;
+  }
+
+  const PiiMatrix<float>& input;
+  PiiMatrix<float>& background;
+  PiiMatrix<int>& stillCounter;
+  float fThreshold, fAlpha1, fAlpha2;
+  bool bInclusive;
+  int iMaxStillTime;
+  int* pForegroundCounts;
+};
+
+/* Same as RunningAverageBand for 8-bit images, but with a background
+ * in 24.8 fixed point and learning weights in 1.15 fixed point.
+ */
+struct PiiBackgroundExtractor::FixedPointBand
+{
+  enum { BackgroundShift = 8, WeightShift = 15 };
+
+  FixedPointBand(const PiiMatrix<uchar>& input, PiiMatrix<int>& background,
+                 PiiMatrix<int>& stillCounter, double threshold,
+                 double alpha1, double alpha2, int maxStillTime) :
+    input(input), background(background), stillCounter(stillCounter),
+    iThreshold(int(std::floor(qMax(threshold, 0.0) * (1 << BackgroundShift)))),
+    iAlpha1(toWeight(alpha1)), iAlpha2(toWeight(alpha2)),
+    iMaxStillTime(maxStillTime), pForegroundCounts(0)
+  {}
+
+  static int toWeight(double alpha)
+  {
+    return qBound(0, int(alpha * (1 << WeightShift) + 0.5), 1 << WeightShift);
+  }
+
+  void operator() (int begin, int end, int band)
+  {
+    const int iColumns = input.columns();
+    const int iRound = 1 << (WeightShift-1);
+    int iForeground = 0;
+    for (int r=begin; r<end; ++r)
+      {
+        const uchar* pInput = input[r];
+        int* pBackground = background.row(r);
+        int* pStillCounter = stillCounter.row(r);
+        for (int c=0; c<iColumns; ++c)
+          {
+            const int iInput = int(pInput[c]) << BackgroundShift;
+            // |iDifference| < 2^16, and the weights are at most
+            // 2^15. The product fits into 31 bits.
+            const int iDifference = iInput - pBackground[c];
+            const int iMoving = (iDifference < 0 ? -iDifference : iDifference) > iThreshold;
+            iForeground += iMoving;
+            const int iStill = (pStillCounter[c] + 1) * iMoving;
+            const bool bBurntIn = iStill > iMaxStillTime;
+            pStillCounter[c] = bBurntIn ? 0 : iStill;
+            const int iBase = bBurntIn ? iInput : pBackground[c];
+            pBackground[c] = iBase + ((iDifference * (iMoving ? iAlpha2 : iAlpha1) + iRound) >> WeightShift);
+          }
+      }
+    pForegroundCounts[band] = iForeground;
+  }
+
+  const PiiMatrix<uchar>& input;
+  PiiMatrix<int>& background;
+  PiiMatrix<int>& stillCounter;
+  int iThreshold, iAlpha1, iAlpha2;
+  int iMaxStillTime;
+  int* pForegroundCounts;
+};
+
+/* Updates a mixture of Gaussians in a band of rows. The components of
+ * each pixel are kept in descending order of weight/deviation, and
+ * unused components (zero weight) are at the end.
+ */
+struct PiiBackgroundExtractor::MixtureBand
+{
+  MixtureBand(const PiiMatrix<float>& input,
+              PiiMatrix<float>& weights, PiiMatrix<float>& means, PiiMatrix<float>& variances,
+              PiiMatrix<int>& stillCounter, int components, double learningRate,
+              double matchThreshold, double backgroundRatio, double initialDeviation,
+              int maxStillTime) :
+    input(input), weights(weights), means(means), variances(variances),
+    stillCounter(stillCounter), iComponents(components),
+    fLearningRate(float(learningRate)),
+    fMatchThreshold2(float(matchThreshold * matchThreshold)),
+    fBackgroundRatio(float(backgroundRatio)),
+    fInitialVariance(float(initialDeviation * initialDeviation)),
+    fMinVariance(float(initialDeviation * initialDeviation / 100)),
+    iMaxStillTime(maxStillTime), pForegroundCounts(0)
+  {}
+
+  void operator() (int begin, int end, int band)
+  {
+    const int iColumns = input.columns();
+    const float fDecay = 1.0f - fLearningRate;
+    int iForeground = 0;
+    for (int r=begin; r<end; ++r)
+      {
+        const float* pInput = input[r];
+        float* pWeights = weights.row(r);
+        float* pMeans = means.row(r);
+        float* pVariances = variances.row(r);
+        int* pStillCounter = stillCounter.row(r);
+        for (int c=0; c<iColumns; ++c)
+          {
+            const float fValue = pInput[c];
+            // Component k of this pixel is at w[k*iColumns] etc.
+            float* w = pWeights + c, *mu = pMeans + c, *var = pVariances + c;
+            int iMatch = -1, iUsed = iComponents;
+            for (int k=0, i=0; k<iComponents; ++k, i += iColumns)
+              {
+                if (w[i] <= 0)
+                  {
+                    iUsed = k;
+                    break;
+                  }
+                const float fDiff = fValue - mu[i];
+                if (fDiff * fDiff < fMatchThreshold2 * var[i])
+                  {
+                    iMatch = k;
+                    break;
+                  }
+              }
+
+            for (int k=0, i=0; k<iComponents; ++k, i += iColumns)
+              w[i] *= fDecay;
+
+            const bool bMatched = iMatch >= 0;
+            if (bMatched)
+              {
+                const int i = iMatch * iColumns;
+                w[i] += fLearningRate;
+                const float fRho = qMin(1.0f, fLearningRate / w[i]);
+                const float fDiff = fValue - mu[i];
+                mu[i] += fRho * fDiff;
+                var[i] = qMax(fMinVariance, var[i] + fRho * (fDiff * fDiff - var[i]));
+              }
+            else
+              {
+                // Replace an unused or the least probable component.
+                iMatch = qMin(iUsed, iComponents-1);
+                const int i = iMatch * iColumns;
+                w[i] = iComponents > 1 ? fLearningRate : 1.0f;
+                mu[i] = fValue;
+                var[i] = fInitialVariance;
+              }
+
+            float fSum = 0;
+            for (int k=0, i=0; k<iComponents; ++k, i += iColumns)
+              fSum += w[i];
+            const float fScale = 1.0f / fSum;
+            for (int k=0, i=0; k<iComponents; ++k, i += iColumns)
+              w[i] *= fScale;
+            iMatch = moveUp(w, mu, var, iColumns, iMatch);
+
+            // The pixel is background if the components before the
+            // matching one don't yet cover the background ratio.
+            float fWeightBefore = 0;
+            for (int k=0, i=0; k<iMatch; ++k, i += iColumns)
+              fWeightBefore += w[i];
+            const bool bForeground = !bMatched || fWeightBefore >= fBackgroundRatio;
+            iForeground += bForeground;
+
+            int iStill = bForeground ? pStillCounter[c] + 1 : 0;
+            if (iStill > iMaxStillTime)
+              {
+                // Burnt in. Make the current component background.
+                for (int k=0, i=0; k<iComponents; ++k, i += iColumns)
+                  w[i] *= 1.0f - fBackgroundRatio;
+                w[iMatch * iColumns] += fBackgroundRatio;
+                moveUp(w, mu, var, iColumns, iMatch);
+                iStill = 0;
+              }
+            pStillCounter[c] = iStill;
+          }
+      }
+    pForegroundCounts[band] = iForeground;
+  }
+
+  // Moves component k towards the beginning until the components are
+  // in descending order of weight/deviation. Compares w^2/var to
+  // avoid square roots. Returns the new index.
+  int moveUp(float* w, float* mu, float* var, int columns, int k) const
+  {
+    for (int i = k*columns, j = i-columns; k > 0 && w[i] * w[i] * var[j] > w[j] * w[j] * var[i];
+         --k, i = j, j -= columns)
+      {
+        qSwap(w[i], w[j]);
+        qSwap(mu[i], mu[j]);
+        qSwap(var[i], var[j]);
+      }
+    return k;
+  }
+
+  const PiiMatrix<float>& input;
+  PiiMatrix<float>& weights, &means, &variances;
+  PiiMatrix<int>& stillCounter;
+  int iComponents;
+  float fLearningRate, fMatchThreshold2, fBackgroundRatio, fInitialVariance, fMinVariance;
+  int iMaxStillTime;
+  int* pForegroundCounts;
+};
+
 template <class T> void PiiBackgroundExtractor::operate(const PiiVariant& obj)
 {
   PII_D;
-  PiiMatrix<float> inputMatrix(obj.valueAs<PiiMatrix<T> >());
-  double dDifference = 0;
+  const PiiMatrix<T> image = obj.valueAs<PiiMatrix<T> >();
+  const int iRows = image.rows(), iCols = image.columns();
+
+  if (!d->matStillCounter.isEmpty() &&
+      (iRows != d->matStillCounter.rows() || iCols != d->matStillCounter.columns()))
+    PII_THROW_WRONG_SIZE(inputAt(0), image, d->matStillCounter.rows(), d->matStillCounter.columns());
+
   int iValidCounter = 0;
+  if (d->backgroundModel == MixtureOfGaussiansModel)
+    iValidCounter = updateMixture(PiiMatrix<float>(image));
+  else
+    iValidCounter = updateRunningAverage(image);
 
-  const int iRows = inputMatrix.rows(), iCols = inputMatrix.columns();
+  // Too many foreground pixels -> there is something wrong
+  emitObject(iValidCounter < (d->dMovementThreshold * iRows * iCols), 1);
+  emitObject(d->matStillCounter, 0);
+}
 
-  if (d->bFirst) // Initialize.
+void PiiBackgroundExtractor::initStillCounter(int rows, int columns)
+{
+  _d()->matStillCounter = PiiMatrix<int>(rows, columns);
+}
+
+void PiiBackgroundExtractor::clearModel()
+{
+  PII_D;
+  d->matStillCounter = PiiMatrix<int>();
+  d->matBackground = PiiMatrix<float>();
+  d->matFixedBackground = PiiMatrix<int>();
+  d->matWeights = d->matMeans = d->matVariances = PiiMatrix<float>();
+}
+
+template <class Band> int PiiBackgroundExtractor::runBands(Band& band)
+{
+  PII_D;
+  const int iRows = d->matStillCounter.rows();
+  const int iMinBandSize = Pii::reductionMinBandRows(d->matStillCounter.columns());
+  QVector<int> vecCounts(qMax(1, Pii::parallelBandCount(iRows, d->iExtractorThreadCount, iMinBandSize)));
+  band.pForegroundCounts = vecCounts.data();
+  // Detach in this thread. The bands only modify their own rows.
+  d->matStillCounter.row(0);
+  Pii::parallelFor(iRows, band, d->iExtractorThreadCount, iMinBandSize);
+  return Pii::sumN<int>(vecCounts.constData(), vecCounts.size());
+}
+
+template <class T> int PiiBackgroundExtractor::updateRunningAverage(const PiiMatrix<T>& image)
+{
+  return updateRunningAverage(PiiMatrix<float>(image));
+}
+
+int PiiBackgroundExtractor::updateRunningAverage(const PiiMatrix<uchar>& image)
+{
+  if (_d()->bFixedPoint)
+    return updateFixedPoint(image);
+  return updateRunningAverage(PiiMatrix<float>(image));
+}
+
+int PiiBackgroundExtractor::updateRunningAverage(const PiiMatrix<float>& image)
+{
+  PII_D;
+  if (d->matBackground.isEmpty()) // Initialize with input image values.
     {
-      // Init support matrices.
-      d->matStillCounter = PiiMatrix<int>(iRows, iCols);
-      d->matBackground = PiiMatrix<float>(inputMatrix); // Init with input image values.
-      d->matForeground = PiiMatrix<float>(iRows, iCols);
-      d->bFirst = false;
+      initStillCounter(image.rows(), image.columns());
+      d->matBackground = image;
+      return 0;
     }
-  else // Update model.
+  if (image.isEmpty())
+    return 0;
+
+  d->matBackground.row(0);
+  RunningAverageBand band(image, d->matBackground, d->matStillCounter,
+                          d->dThreshold, d->dAlpha1, d->dAlpha2, d->iMaxStillTime);
+  return runBands(band);
+}
+
+int PiiBackgroundExtractor::updateFixedPoint(const PiiMatrix<uchar>& image)
+{
+  PII_D;
+  if (d->matFixedBackground.isEmpty())
     {
-      if (iRows != d->matBackground.rows() || iCols != d->matBackground.columns())
-        PII_THROW_WRONG_SIZE(inputAt(0), inputMatrix, d->matBackground.rows(), d->matBackground.columns());
-
-      for (int r=0; r<iRows; ++r)
-        {
-          float* pInputRow = inputMatrix[r];
-          float* pBackgroundRow = d->matBackground[r];
-          float* pForegroundRow = d->matForeground[r];
-          int* pStillCounterRow = d->matStillCounter[r];
-          for (int c=0; c<iCols; ++c)
-            {
-              //float dInputValue = PiiImage::Traits<T>::template toFloat<float>(pInputRow[c]);
-              dDifference = pInputRow[c] - pBackgroundRow[c];
-
-              // If the difference between background model and the
-              // currente frame is big enough, mark the pixel as moved.
-              if (Pii::abs(dDifference) > d->dThreshold)
-                {
-                  // Count the number of successive frames in which
-                  // the same pixel is "foreground".
-                  ++pStillCounterRow[c];
-                  iValidCounter++;
-                  pForegroundRow[c] = 1.0f;
-                }
-              else
-                {
-                  pStillCounterRow[c] = 0;
-                  pForegroundRow[c] = 0.0f;
-                }
-
-              // Now, this pixel has been "foreground" way too long.
-              if (pStillCounterRow[c] > d->iMaxStillTime)
-                {
-                  pStillCounterRow[c] = 0;
-                  pBackgroundRow[c] = pInputRow[c];
-                }
-
-              // Update background model.
-              // B_t+1 = B_t + (alpha1 * (1 - M_t) + alpha2 * M_t) * D_t
-              pBackgroundRow[c] += float((d->dAlpha1 * (1.0 - pForegroundRow[c]) +
-                                          d->dAlpha2 * pForegroundRow[c]) * dDifference);
-            }
-        }
+      initStillCounter(image.rows(), image.columns());
+      d->matFixedBackground = PiiMatrix<int>(image);
+      d->matFixedBackground *= 1 << FixedPointBand::BackgroundShift;
+      return 0;
     }
+  if (image.isEmpty())
+    return 0;
 
-  // Too many foreground pixels -> there is something wrong
-  emitObject(iValidCounter < (d->dMovementThreshold * iRows * iCols), 1);
-  emitObject(d->matStillCounter, 0);
+  d->matFixedBackground.row(0);
+  FixedPointBand band(image, d->matFixedBackground, d->matStillCounter,
+                      d->dThreshold, d->dAlpha1, d->dAlpha2, d->iMaxStillTime);
+  return runBands(band);
+}
+
+int PiiBackgroundExtractor::updateMixture(const PiiMatrix<float>& image)
+{
+  PII_D;
+  const int iRows = image.rows(), iCols = image.columns(), iComponents = d->iGaussianCount;
+  if (d->matWeights.isEmpty())
+    {
+      initStillCounter(iRows, iCols);
+      // The first component models the first frame.
+      d->matWeights = PiiMatrix<float>(iRows, iCols * iComponents);
+      d->matWeights(0, 0, iRows, iCols) = 1.0f;
+      d->matMeans = PiiMatrix<float>(iRows, iCols * iComponents);
+      d->matMeans(0, 0, iRows, iCols) << image;
+      d->matVariances = PiiMatrix<float>(iRows, iCols * iComponents);
+      d->matVariances = float(d->dMixtureInitialDeviation * d->dMixtureInitialDeviation);
+      return 0;
+    }
+  if (image.isEmpty())
+    return 0;
+
+  d->matWeights.row(0);
+  d->matMeans.row(0);
+  d->matVariances.row(0);
+  MixtureBand band(image, d->matWeights, d->matMeans, d->matVariances, d->matStillCounter,
+                   iComponents, d->dMixtureLearningRate, d->dMixtureMatchThreshold,
+                   d->dMixtureBackgroundRatio, d->dMixtureInitialDeviation, d->iMaxStillTime);
+  return runBands(band);
 }
 
 double PiiBackgroundExtractor::threshold() const { return _d()->dThreshold; }
@@ -125,3 +436,41 @@ void PiiBackgroundExtractor::setMaxStillTime(int maxStillTime) { _d()->iMaxStill
 int PiiBackgroundExtractor::maxStillTime() const { return _d()->iMaxStillTime; }
 void PiiBackgroundExtractor::setMovementThreshold(double movementThreshold) { _d()->dMovementThreshold = movementThreshold; }
 float PiiBackgroundExtractor::movementThreshold() const { return _d()->dMovementThreshold; }
+void PiiBackgroundExtractor::setBackgroundModel(BackgroundModel backgroundModel)
+{
+  if (backgroundModel != _d()->backgroundModel)
+    {
+      _d()->backgroundModel = backgroundModel;
+      clearModel();
+    }
+}
+PiiBackgroundExtractor::BackgroundModel PiiBackgroundExtractor::backgroundModel() const { return _d()->backgroundModel; }
+void PiiBackgroundExtractor::setFixedPoint(bool fixedPoint)
+{
+  if (fixedPoint != _d()->bFixedPoint)
+    {
+      _d()->bFixedPoint = fixedPoint;
+      clearModel();
+    }
+}
+bool PiiBackgroundExtractor::fixedPoint() const { return _d()->bFixedPoint; }
+void PiiBackgroundExtractor::setGaussianCount(int gaussianCount)
+{
+  gaussianCount = qBound(1, gaussianCount, 8);
+  if (gaussianCount != _d()->iGaussianCount)
+    {
+      _d()->iGaussianCount = gaussianCount;
+      clearModel();
+    }
+}
+int PiiBackgroundExtractor::gaussianCount() const { return _d()->iGaussianCount; }
+void PiiBackgroundExtractor::setMixtureLearningRate(double mixtureLearningRate) { _d()->dMixtureLearningRate = mixtureLearningRate; }
+double PiiBackgroundExtractor::mixtureLearningRate() const { return _d()->dMixtureLearningRate; }
+void PiiBackgroundExtractor::setMixtureMatchThreshold(double mixtureMatchThreshold) { _d()->dMixtureMatchThreshold = mixtureMatchThreshold; }
+double PiiBackgroundExtractor::mixtureMatchThreshold() const { return _d()->dMixtureMatchThreshold; }
+void PiiBackgroundExtractor::setMixtureBackgroundRatio(double mixtureBackgroundRatio) { _d()->dMixtureBackgroundRatio = mixtureBackgroundRatio; }
+double PiiBackgroundExtractor::mixtureBackgroundRatio() const { return _d()->dMixtureBackgroundRatio; }
+void PiiBackgroundExtractor::setMixtureInitialDeviation(double mixtureInitialDeviation) { _d()->dMixtureInitialDeviation = mixtureInitialDeviation; }
+double PiiBackgroundExtractor::mixtureInitialDeviation() const { return _d()->dMixtureInitialDeviation; }
+void PiiBackgroundExtractor::setExtractorThreadCount(int extractorThreadCount) { _d()->iExtractorThreadCount = extractorThreadCount; }
+int PiiBackgroundExtractor::extractorThreadCount() const { return _d()->iExtractorThreadCount; }
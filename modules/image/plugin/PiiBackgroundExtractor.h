@@ -22,9 +22,12 @@
 
 /**
  * An operation that models static background of a scene with moving
- * objects. The background model is based on the mean and covariance
- * values of the image pixels. The background model is updated
- * according to the following formula:
+ * objects. Two background models are available, see
+ * [backgroundModel].
+ *
+ * The default model (`RunningAverageModel`) keeps a running average
+ * of the intensity of each pixel. It is updated according to the
+ * following formula:
  *
  * \[
  * B_{t+1} = B_t + (\alpha_1 * (1 - I_t) + \alpha_2 * I_t) * (I_t - B_t),
@@ -37,6 +40,17 @@
  * input image is normalized so that the maximum pixel intensity is
  * always one.
  *
+ * The `MixtureOfGaussiansModel` represents each pixel with a
+ * weighted set of [gaussianCount] Gaussian distributions (Stauffer &
+ * Grimson). A pixel belongs to the background if it matches one of
+ * the most probable distributions whose total weight is at least
+ * [mixtureBackgroundRatio]. The model tolerates repetitive motion
+ * (swaying trees, flickering light) better than a single average,
+ * but it is about an order of magnitude slower.
+ *
+ * Both models update the image in parallel row bands (see
+ * [extractorThreadCount]).
+ *
  * Inputs
  * ------
  *
@@ -90,8 +104,77 @@ class PiiBackgroundExtractor : public PiiDefaultOperation
    */
   Q_PROPERTY(double movementThreshold READ movementThreshold WRITE setMovementThreshold);
 
+  /**
+   * The background model. The default is `RunningAverageModel`.
+   * Changing the model resets the background.
+   */
+  Q_PROPERTY(BackgroundModel backgroundModel READ backgroundModel WRITE setBackgroundModel);
+  Q_ENUMS(BackgroundModel);
+
+  /**
+   * Use fixed-point arithmetic with 8-bit gray-scale images in
+   * `RunningAverageModel`. The background is stored with 1/256 gray
+   * level precision and the learning weights with 1/32768 precision.
+   * The results are close to, but not exactly the same as, those of
+   * the floating-point model. Other image types always use floating
+   * point. Changing the value resets the background. The default is
+   * `false`.
+   */
+  Q_PROPERTY(bool fixedPoint READ fixedPoint WRITE setFixedPoint);
+
+  /**
+   * The number of Gaussian distributions per pixel in
+   * `MixtureOfGaussiansModel`, in [1, 8]. Changing the value resets
+   * the background. The default is 3.
+   */
+  Q_PROPERTY(int gaussianCount READ gaussianCount WRITE setGaussianCount);
+
+  /**
+   * The learning rate of `MixtureOfGaussiansModel`. The default is
+   * 0.01.
+   */
+  Q_PROPERTY(double mixtureLearningRate READ mixtureLearningRate WRITE setMixtureLearningRate);
+
+  /**
+   * A pixel matches a distribution in `MixtureOfGaussiansModel` if
+   * its distance to the mean is less than this many standard
+   * deviations. The default is 2.5.
+   */
+  Q_PROPERTY(double mixtureMatchThreshold READ mixtureMatchThreshold WRITE setMixtureMatchThreshold);
+
+  /**
+   * The minimum total weight of the distributions that model the
+   * background in `MixtureOfGaussiansModel`. The default is 0.7.
+   */
+  Q_PROPERTY(double mixtureBackgroundRatio READ mixtureBackgroundRatio WRITE setMixtureBackgroundRatio);
+
+  /**
+   * The standard deviation of new distributions in
+   * `MixtureOfGaussiansModel`, in gray levels. The default is 15.
+   */
+  Q_PROPERTY(double mixtureInitialDeviation READ mixtureInitialDeviation WRITE setMixtureInitialDeviation);
+
+  /**
+   * The maximum number of threads used for updating the model. Zero
+   * means the number of processor cores. Small images are always
+   * processed in a single thread. The results do not depend on the
+   * number of threads. The default is zero.
+   */
+  Q_PROPERTY(int extractorThreadCount READ extractorThreadCount WRITE setExtractorThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
+  /**
+   * Background models.
+   *
+   * - `RunningAverageModel` - a running average with two learning
+   * weights.
+   *
+   * - `MixtureOfGaussiansModel` - an adaptive mixture of Gaussian
+   * distributions.
+   */
+  enum BackgroundModel { RunningAverageModel, MixtureOfGaussiansModel };
+
   PiiBackgroundExtractor();
 
   double threshold() const;
@@ -104,28 +187,68 @@ public:
   int maxStillTime() const;
   void setMovementThreshold(double movementThreshold);
   float movementThreshold() const;
+  void setBackgroundModel(BackgroundModel backgroundModel);
+  BackgroundModel backgroundModel() const;
+  void setFixedPoint(bool fixedPoint);
+  bool fixedPoint() const;
+  void setGaussianCount(int gaussianCount);
+  int gaussianCount() const;
+  void setMixtureLearningRate(double mixtureLearningRate);
+  double mixtureLearningRate() const;
+  void setMixtureMatchThreshold(double mixtureMatchThreshold);
+  double mixtureMatchThreshold() const;
+  void setMixtureBackgroundRatio(double mixtureBackgroundRatio);
+  double mixtureBackgroundRatio() const;
+  void setMixtureInitialDeviation(double mixtureInitialDeviation);
+  double mixtureInitialDeviation() const;
+  void setExtractorThreadCount(int extractorThreadCount);
+  int extractorThreadCount() const;
 
 protected:
   void process();
 
 private:
   template <class T> void operate(const PiiVariant& obj);
+  template <class T> int updateRunningAverage(const PiiMatrix<T>& image);
+  int updateRunningAverage(const PiiMatrix<uchar>& image);
+  int updateRunningAverage(const PiiMatrix<float>& image);
+  int updateFixedPoint(const PiiMatrix<uchar>& image);
+  int updateMixture(const PiiMatrix<float>& image);
+  void initStillCounter(int rows, int columns);
+  void clearModel();
+  template <class Band> int runBands(Band& band);
+
+  struct RunningAverageBand;
+  struct FixedPointBand;
+  struct MixtureBand;
 
   /// @internal
   class Data : public PiiDefaultOperation::Data
   {
   public:
     Data();
-    bool bFirst;
     double dThreshold;
     double dAlpha1;
     double dAlpha2;
     PiiMatrix<int> matStillCounter;
+    // Floating-point running average
     PiiMatrix<float> matBackground;
-    PiiMatrix<float> matForeground;
+    // Fixed-point running average, 8 fractional bits
+    PiiMatrix<int> matFixedBackground;
+    // Mixture of Gaussians. Each row stores the weights, means and
+    // variances of component k at columns [k*columns, (k+1)*columns).
+    PiiMatrix<float> matWeights, matMeans, matVariances;
 
     int iMaxStillTime;
     double dMovementThreshold;
+    BackgroundModel backgroundModel;
+    bool bFixedPoint;
+    int iGaussianCount;
+    double dMixtureLearningRate;
+    double dMixtureMatchThreshold;
+    double dMixtureBackgroundRatio;
+    double dMixtureInitialDeviation;
+    int iExtractorThreadCount;
   };
   PII_D_FUNC;
 };
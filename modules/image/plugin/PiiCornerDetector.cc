@@ -17,8 +17,7 @@
 #include "PiiCornerDetector.h"
 #include "PiiImage.h"
 
-PiiCornerDetector::Data::Data() :
-  dThreshold(25)
+PiiCornerDetector::Data::Data()
 {
 }
 
@@ -27,6 +26,8 @@ PiiCornerDetector::PiiCornerDetector() : PiiDefaultOperation(new Data)
   setThreadCount(1);
   addSocket(new PiiInputSocket("image"));
   addSocket(new PiiOutputSocket("corners"));
+  addSocket(new PiiOutputSocket("scores"));
+  addSocket(new PiiOutputSocket("levels"));
 }
 
 void PiiCornerDetector::process()
@@ -43,9 +44,33 @@ void PiiCornerDetector::process()
 
 template <class T> void PiiCornerDetector::detectCorners(const PiiVariant& obj)
 {
-  emitObject(PiiImage::detectFastCorners(obj.valueAs<PiiMatrix<T> >(),
-                                         T(_d()->dThreshold)));
+  QVector<double> vecScores;
+  QVector<int> vecLevels;
+  PiiMatrix<int> matCorners(_d()->detector.detect(obj.valueAs<PiiMatrix<T> >(), &vecScores, &vecLevels));
+  const int iCorners = matCorners.rows();
+  PiiMatrix<double> matScores(PiiMatrix<double>::uninitialized(iCorners, 1));
+  PiiMatrix<int> matLevels(PiiMatrix<int>::uninitialized(iCorners, 1));
+  for (int i=0; i<iCorners; ++i)
+    {
+      matScores(i,0) = vecScores[i];
+      matLevels(i,0) = vecLevels[i];
+    }
+  emitObject(matCorners);
+  emitObject(matScores, 1);
+  emitObject(matLevels, 2);
 }
 
-void PiiCornerDetector::setThreshold(double threshold) { _d()->dThreshold = threshold; }
-double PiiCornerDetector::threshold() const { return _d()->dThreshold; }
+void PiiCornerDetector::setThreshold(double threshold) { _d()->detector.setThreshold(threshold); }
+double PiiCornerDetector::threshold() const { return _d()->detector.threshold(); }
+void PiiCornerDetector::setNonMaximumSuppression(bool nonMaximumSuppression) { _d()->detector.setNonMaximumSuppression(nonMaximumSuppression); }
+bool PiiCornerDetector::nonMaximumSuppression() const { return _d()->detector.nonMaximumSuppression(); }
+void PiiCornerDetector::setGridSize(int gridSize) { _d()->detector.setGridSize(gridSize); }
+int PiiCornerDetector::gridSize() const { return _d()->detector.gridSize(); }
+void PiiCornerDetector::setCornersPerCell(int cornersPerCell) { _d()->detector.setCornersPerCell(cornersPerCell); }
+int PiiCornerDetector::cornersPerCell() const { return _d()->detector.cornersPerCell(); }
+void PiiCornerDetector::setMaxCorners(int maxCorners) { _d()->detector.setMaxCorners(maxCorners); }
+int PiiCornerDetector::maxCorners() const { return _d()->detector.maxCorners(); }
+void PiiCornerDetector::setLevels(int levels) { _d()->detector.setLevels(levels); }
+int PiiCornerDetector::levels() const { return _d()->detector.levels(); }
+void PiiCornerDetector::setDetectionThreadCount(int detectionThreadCount) { _d()->detector.setThreadCount(detectionThreadCount); }
+int PiiCornerDetector::detectionThreadCount() const { return _d()->detector.threadCount(); }
@@ -17,6 +17,7 @@
 #define _PIICORNERDETECTOR_H
 
 #include <PiiDefaultOperation.h>
+#include <PiiFastCornerDetector.h>
 
 /**
  * Detects corners in gray-level images using the FAST corner
@@ -31,7 +32,17 @@
  * -------
  *
  * @out corners - corner coordinates, a N-by-2 PiiMatrix<int> in which
- * each row stores the (x,y) coordinates of a detected corner.
+ * each row stores the (x,y) coordinates of a detected corner. The
+ * coordinates can be fed to the `points` input of
+ * PiiRansacPointMatcher and other PiiPointMatchingOperation
+ * derivatives.
+ *
+ * @out scores - the score of each corner, a N-by-1 PiiMatrix<double>.
+ * See PiiFastCornerDetector.
+ *
+ * @out levels - the pyramid level at which each corner was found, a
+ * N-by-1 PiiMatrix<int>. All zeros unless [levels] is greater than
+ * one.
  *
  */
 class PiiCornerDetector : public PiiDefaultOperation
@@ -44,12 +55,64 @@ class PiiCornerDetector : public PiiDefaultOperation
    */
   Q_PROPERTY(double threshold READ threshold WRITE setThreshold);
 
+  /**
+   * Enables non-maximum suppression of detected corners. The default
+   * value is `true`.
+   */
+  Q_PROPERTY(bool nonMaximumSuppression READ nonMaximumSuppression WRITE setNonMaximumSuppression);
+
+  /**
+   * The size of the cells in grid selection. If both this value and
+   * [cornersPerCell] are positive, at most [cornersPerCell] strongest
+   * corners will be retained in each *gridSize* -by- *gridSize* cell.
+   * The default value is zero.
+   */
+  Q_PROPERTY(int gridSize READ gridSize WRITE setGridSize);
+
+  /**
+   * The maximum number of corners in a grid cell. Zero disables grid
+   * selection. The default value is zero.
+   */
+  Q_PROPERTY(int cornersPerCell READ cornersPerCell WRITE setCornersPerCell);
+
+  /**
+   * The maximum number of corners emitted. If more corners are found,
+   * the strongest ones will be retained. Zero means no limit. The
+   * default value is zero.
+   */
+  Q_PROPERTY(int maxCorners READ maxCorners WRITE setMaxCorners);
+
+  /**
+   * The number of image pyramid levels corners are detected on. The
+   * default value is one.
+   */
+  Q_PROPERTY(int levels READ levels WRITE setLevels);
+
+  /**
+   * The number of threads used in detecting corners in a single
+   * image. Zero means the number of processor cores. The default
+   * value is one.
+   */
+  Q_PROPERTY(int detectionThreadCount READ detectionThreadCount WRITE setDetectionThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   PiiCornerDetector();
 
   void setThreshold(double threshold);
   double threshold() const;
+  void setNonMaximumSuppression(bool nonMaximumSuppression);
+  bool nonMaximumSuppression() const;
+  void setGridSize(int gridSize);
+  int gridSize() const;
+  void setCornersPerCell(int cornersPerCell);
+  int cornersPerCell() const;
+  void setMaxCorners(int maxCorners);
+  int maxCorners() const;
+  void setLevels(int levels);
+  int levels() const;
+  void setDetectionThreadCount(int detectionThreadCount);
+  int detectionThreadCount() const;
 
 protected:
   void process();
@@ -60,7 +123,7 @@ private:
   {
   public:
     Data();
-    double dThreshold;
+    PiiFastCornerDetector detector;
   };
   PII_D_FUNC;
 
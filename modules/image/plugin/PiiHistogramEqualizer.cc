@@ -18,7 +18,8 @@
 #include "PiiHistogram.h"
 
 PiiHistogramEqualizer::Data::Data() :
-  iLevels(256)
+  iLevels(256),
+  bHistogramConnected(false)
 {
 }
 
@@ -27,9 +28,17 @@ PiiHistogramEqualizer::PiiHistogramEqualizer() :
 {
   setThreadCount(1);
   addSocket(new PiiInputSocket("image"));
+  addSocket(new PiiInputSocket("histogram"));
+  inputAt(1)->setOptional(true);
   addSocket(new PiiOutputSocket("image"));
 }
 
+void PiiHistogramEqualizer::check(bool reset)
+{
+  PiiDefaultOperation::check(reset);
+  _d()->bHistogramConnected = inputAt(1)->isConnected();
+}
+
 void PiiHistogramEqualizer::setLevels(int levels)
 {
   if (levels >= 0 && levels < 65536)
@@ -51,7 +60,20 @@ void PiiHistogramEqualizer::process()
 template <class T> void PiiHistogramEqualizer::equalize(const PiiVariant& obj)
 {
   const PiiMatrix<T> img = obj.valueAs<PiiMatrix<T> >();
-  emitObject(PiiImage::equalize(img, (unsigned)_d()->iLevels));
+  if (_d()->bHistogramConnected)
+    {
+      // Normalized histograms would be truncated to zeros.
+      const unsigned int uiHistogramType = inputAt(1)->firstObject().type();
+      if (uiHistogramType == PiiYdin::FloatMatrixType ||
+          uiHistogramType == PiiYdin::DoubleMatrixType)
+        PII_THROW(PiiExecutionException, tr("The histogram must contain integer frequencies."));
+      PiiMatrix<int> matHistogram(PiiYdin::convertMatrixTo<int>(inputAt(1)));
+      if (matHistogram.rows() != 1 || matHistogram.columns() <= int(Pii::max(img)))
+        PII_THROW(PiiExecutionException, tr("The histogram does not cover all gray levels of the image."));
+      emitObject(PiiImage::equalize(img, matHistogram));
+    }
+  else
+    emitObject(PiiImage::equalize(img, (unsigned)_d()->iLevels));
 }
 
 int PiiHistogramEqualizer::levels() const
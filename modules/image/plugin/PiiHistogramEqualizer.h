@@ -27,6 +27,13 @@
  *
  * @in image - The input image. Any integer-valued gray-level image.
  *
+ * @in histogram - An optional histogram of the input image. If this
+ * input is connected, the received histogram will be used instead of
+ * calculating a new one, and [levels] will be ignored. The histogram
+ * must be an integer matrix (not normalized), and it must have more
+ * columns than the maximum gray level in the image. The `red` output of
+ * PiiHistogramOperation can be connected here.
+ *
  * Outputs
  * -------
  *
@@ -53,6 +60,7 @@ public:
 
 protected:
   void process();
+  void check(bool reset);
 
 private:
   template <class T> void equalize(const PiiVariant& obj);
@@ -62,7 +70,8 @@ private:
   {
   public:
     Data();
-    int iLevels;};
+    int iLevels;
+    bool bHistogramConnected;};
   PII_D_FUNC;
 
 };
@@ -26,7 +26,8 @@ struct PiiHistogramHandler
   PiiHistogramHandler() :
     iPixelCount(0),
     iLevels(256),
-    bNormalized(false)
+    bNormalized(false),
+    iThreadCount(1)
   {}
 
   virtual ~PiiHistogramHandler() {}
@@ -41,21 +42,23 @@ struct PiiHistogramHandler
       variant.valueAs<PiiMatrix<int> >() += histogram;
   }
 
-  void initialize(int levels, bool normalized)
+  void initialize(int levels, bool normalized, int threads = 1)
   {
     iPixelCount = 0;
     iLevels = levels;
     bNormalized = normalized;
+    iThreadCount = threads;
   }
 
   int iPixelCount;
   int iLevels;
   int bNormalized;
+  int iThreadCount;
 };
 
 template <class T> struct PiiGrayHistogramHandler : PiiHistogramHandler
 {
-  void initialize(int levels, bool normalized);
+  void initialize(int levels, bool normalized, int threads = 1);
   void operator() (const PiiMatrix<T>& image);
   template <class Roi> void operator() (const PiiMatrix<T>& image, const Roi& roi);
   void normalize();
@@ -70,7 +73,7 @@ template <class Clr> struct PiiColorHistogramHandler : PiiHistogramHandler
     baCalculate[0] = baCalculate[1] = baCalculate[2] = true;
   }
 
-  void initialize(int levels, bool normalized);
+  void initialize(int levels, bool normalized, int threads = 1);
   void operator() (const PiiMatrix<Clr>& image);
   template <class Roi> void operator() (const PiiMatrix<Clr>& image, const Roi& roi);
   void normalize();
@@ -83,13 +86,13 @@ template <class Clr> struct PiiColorHistogramHandler : PiiHistogramHandler
 template <class T> void PiiGrayHistogramHandler<T>::operator() (const PiiMatrix<T>& image)
 {
   iPixelCount += image.rows() * image.columns();
-  addToVariant(varHistogram, PiiImage::histogram(image, iLevels));
+  addToVariant(varHistogram, PiiImage::histogram(image, PiiImage::DefaultRoi(), iLevels, iThreadCount));
 }
 
 template <class T> template <class Roi>
 void PiiGrayHistogramHandler<T>::operator() (const PiiMatrix<T>& image, const Roi& roi)
 {
-  PiiMatrix<int> matHistogram(PiiImage::histogram(image, roi, iLevels));
+  PiiMatrix<int> matHistogram(PiiImage::histogram(image, roi, iLevels, iThreadCount));
   if (bNormalized)
     iPixelCount += Pii::sum<int>(matHistogram);
   addToVariant(varHistogram, matHistogram);
@@ -102,9 +105,9 @@ template <class T> void PiiGrayHistogramHandler<T>::normalize()
                                           .mapped(std::multiplies<float>(), 1.0 / iPixelCount)));
 }
 
-template <class T> void PiiGrayHistogramHandler<T>::initialize(int levels, bool normalized)
+template <class T> void PiiGrayHistogramHandler<T>::initialize(int levels, bool normalized, int threads)
 {
-  PiiHistogramHandler::initialize(levels, normalized);
+  PiiHistogramHandler::initialize(levels, normalized, threads);
   varHistogram = PiiVariant();
 }
 
@@ -114,7 +117,8 @@ template <class Clr> void PiiColorHistogramHandler<Clr>::operator() (const PiiMa
   iPixelCount += image.rows() * image.columns();
   for (int i=0; i<3; ++i)
     if (baCalculate[i])
-      addToVariant(varHistograms[i], PiiImage::histogram(channelImages[i], iLevels));
+      addToVariant(varHistograms[i], PiiImage::histogram(channelImages[i], PiiImage::DefaultRoi(),
+                                                              iLevels, iThreadCount));
 }
 
 template <class Clr> template <class Roi>
@@ -126,7 +130,7 @@ void PiiColorHistogramHandler<Clr>::operator() (const PiiMatrix<Clr>& image, con
     {
       if (baCalculate[i])
         {
-          PiiMatrix<int> matHistogram(PiiImage::histogram(channelImages[i], roi, iLevels));
+          PiiMatrix<int> matHistogram(PiiImage::histogram(channelImages[i], roi, iLevels, iThreadCount));
           if (bMustCount)
             {
               iPixelCount += Pii::sum<int>(matHistogram);
@@ -146,9 +150,9 @@ template <class Clr> void PiiColorHistogramHandler<Clr>::normalize()
                                                   .mapped(std::multiplies<float>(), 1.0 / iPixelCount)));
 }
 
-template <class Clr> void PiiColorHistogramHandler<Clr>::initialize(int levels, bool normalized)
+template <class Clr> void PiiColorHistogramHandler<Clr>::initialize(int levels, bool normalized, int threads)
 {
-  PiiHistogramHandler::initialize(levels, normalized);
+  PiiHistogramHandler::initialize(levels, normalized, threads);
   for (int i=0; i<3; ++i)
     varHistograms[i] = PiiVariant();
 }
@@ -68,7 +68,8 @@ PiiHistogramOperation::Data::Data() :
   bNormalized(false),
   roiType(PiiImage::AutoRoi),
   pHistogram(0),
-  uiPreviousType(PiiVariant::InvalidType)
+  uiPreviousType(PiiVariant::InvalidType),
+  iHistogramThreadCount(1)
 {
 }
 
@@ -100,6 +101,9 @@ bool PiiHistogramOperation::normalized() const { return _d()->bNormalized; }
 void PiiHistogramOperation::setRoiType(PiiImage::RoiType roiType) { _d()->roiType = roiType; }
 PiiImage::RoiType PiiHistogramOperation::roiType() const { return _d()->roiType; }
 
+void PiiHistogramOperation::setHistogramThreadCount(int histogramThreadCount) { _d()->iHistogramThreadCount = qMax(0, histogramThreadCount); }
+int PiiHistogramOperation::histogramThreadCount() const { return _d()->iHistogramThreadCount; }
+
 void PiiHistogramOperation::aboutToChangeState(State state)
 {
   PII_D;
@@ -139,7 +143,7 @@ template <class T> void PiiHistogramOperation::histogram(const PiiVariant& obj)
     }
 
   Histogram<T>& hist = *static_cast<Histogram<T>*>(d->pHistogram);
-  hist.initialize(d->iLevels, d->bNormalized);
+  hist.initialize(d->iLevels, d->bNormalized, d->iHistogramThreadCount);
 
   PiiImage::handleRoiInput(d->pRoiInput, d->roiType, image, hist);
 
@@ -46,6 +46,11 @@
  * If a gray-scale image is read, the histogram will be sent to all
  * three outputs.
  *
+ * The histogram of a gray-scale image can be shared with other
+ * operations in the same stage. Connect `red` to the `histogram`
+ * input of PiiThresholdingOperation and PiiHistogramEqualizer to
+ * calculate the histogram only once.
+ *
  */
 class PiiHistogramOperation : public PiiDefaultOperation
 {
@@ -74,6 +79,13 @@ class PiiHistogramOperation : public PiiDefaultOperation
    */
   Q_PROPERTY(PiiImage::RoiType roiType READ roiType WRITE setRoiType);
 
+  /**
+   * The number of threads used in counting. Zero means the number of
+   * processor cores. The result does not depend on the number of
+   * threads. The default is one.
+   */
+  Q_PROPERTY(int histogramThreadCount READ histogramThreadCount WRITE setHistogramThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION;
 public:
   PiiHistogramOperation();
@@ -92,6 +104,9 @@ protected:
   int levels() const;
   void setLevels(int levels);
 
+  void setHistogramThreadCount(int histogramThreadCount);
+  int histogramThreadCount() const;
+
 private:
   template <class T> struct GrayHistogram;
   template <class T> struct ColorHistogram;
@@ -113,6 +128,7 @@ private:
     PiiImage::RoiType roiType;
     PiiHistogramHandler* pHistogram;
     unsigned int uiPreviousType;
+    int iHistogramThreadCount;
   };
   PII_D_FUNC;
 };
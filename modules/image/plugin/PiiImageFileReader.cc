@@ -16,8 +16,11 @@
 #include "PiiImageFileReader.h"
 #include <PiiYdinTypes.h>
 #include <PiiRandom.h>
+#include <PiiParallel.h>
 #include <QDir>
 #include <QFileInfo>
+#include <QMutexLocker>
+#include <QThread>
 #include <QtGui>
 
 #ifndef Q_OS_WIN
@@ -25,14 +28,89 @@
 #  include <QFile>
 #endif
 
+#ifdef Q_OS_LINUX
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
 using namespace PiiYdin;
 using namespace Pii;
 
+namespace
+{
+  // Asks the kernel to start reading fileName into the page cache.
+  void adviseWillNeed(const QString& fileName)
+  {
+#ifdef Q_OS_LINUX
+    int fd = ::open(QFile::encodeName(fileName).constData(), O_RDONLY);
+    if (fd != -1)
+      {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+      }
+#else
+    Q_UNUSED(fileName);
+#endif
+  }
+
+  // Converts a decoded image the same way emit(Gray|Color)Image()
+  // would, but retains meta-data.
+  void convertImage(QImage& img, PiiImageReaderOperation::ImageType type)
+  {
+    QStringList lstKeys = img.textKeys();
+    QStringList lstValues;
+    for (int i=0; i<lstKeys.size(); ++i)
+      lstValues << img.text(lstKeys[i]);
+
+    if (type == PiiImageReaderOperation::Color ||
+        (type == PiiImageReaderOperation::Original && img.depth() == 32))
+      Pii::convertToRgba(img);
+    else
+      Pii::convertToGray(img);
+
+    for (int i=0; i<lstKeys.size(); ++i)
+      img.setText(lstKeys[i], lstValues[i]);
+  }
+}
+
+struct PiiImageFileReader::Job
+{
+  Job(const QString& fileName, ImageType type) :
+    strFileName(fileName), imageType(type), bDone(false)
+  {}
+
+  QString strFileName;
+  ImageType imageType;
+  // Non-empty if this job starts a new, reshuffled iteration.
+  QVector<int> vecIndices;
+  QImage image;
+  QString strError;
+  bool bDone;
+};
+
+class PiiImageFileReader::Decoder : public QThread
+{
+public:
+  Decoder(PiiImageFileReader* reader) : _pReader(reader) {}
+
+protected:
+  void run() { _pReader->decodeJobs(); }
+
+private:
+  PiiImageFileReader* _pReader;
+};
+
 PiiImageFileReader::Data::Data() :
   iRepeatCount(1), bFirst(false), bLockFiles(false),
   bTriggered(false), bNameConnected(false),
   randMode(NoRandomization),
-  bSendKeys(false)
+  bSendKeys(false),
+  iPrefetchCount(0), iDecoderThreadCount(0),
+  bReadAhead(false),
+  bPrefetching(false),
+  iScheduleIndex(0),
+  iNextJob(0),
+  bDecodersRunning(false)
 {
 }
 
@@ -53,11 +131,19 @@ PiiImageFileReader::PiiImageFileReader(const QString& pattern) :
   d->iStaticOutputCount = outputCount();
 
   setProtectionLevel("metaFields", WriteWhenStoppedOrPaused);
+  setProtectionLevel("prefetchCount", WriteWhenStoppedOrPaused);
+  setProtectionLevel("decoderThreadCount", WriteWhenStoppedOrPaused);
+}
+
+PiiImageFileReader::~PiiImageFileReader()
+{
+  stopPrefetch();
 }
 
 void PiiImageFileReader::check(bool reset)
 {
   PII_D;
+  stopPrefetch();
   PiiImageReaderOperation::check(reset);
   if (reset)
     {
@@ -86,49 +172,89 @@ void PiiImageFileReader::check(bool reset)
 void PiiImageFileReader::process()
 {
   PII_D;
-  if (!d->bNameConnected &&
-      d->randMode == RandomizeOnEachIteration &&
-      d->iCurrentIndex % d->lstFileNames.size() == 0)
-    Pii::shuffle(d->vecIndices);
-
   QString fileName;
-  //We only track the counts if neither trigger input isn't connected
-  if (!d->bTriggered)
+  QImage img;
+
+  if (!d->bTriggered && d->iPrefetchCount > 0)
     {
       int loopIndex = d->iCurrentIndex / d->lstFileNames.size();
       if ((d->iMaxImages > 0 && d->iCurrentIndex >= d->iMaxImages) ||
           (d->iRepeatCount > 0 && loopIndex >= d->iRepeatCount))
         operationStopped(); //stop here
-      fileName = d->lstFileNames[d->vecIndices[d->iCurrentIndex % d->lstFileNames.size()]];
-    }
-  else if (d->bNameConnected) // name input is connected -> we don't care about trigger
-    {
-      fileName = PiiYdin::convertToQString(d->pNameInput);
+      // Shuffling is done by the scheduler.
+      takePrefetchedImage(&fileName, &img);
     }
-  else // only trigger is connected
+  else
     {
-      // If a trigger object is received and it is an integer, it is
-      // added to the current image index.
-      PiiVariant obj = d->pTriggerInput->firstObject();
+      if (!d->bNameConnected &&
+          d->randMode == RandomizeOnEachIteration &&
+          d->iCurrentIndex % d->lstFileNames.size() == 0)
+        Pii::shuffle(d->vecIndices);
 
-      int step = obj.type() == PiiVariant::IntType ? obj.valueAs<int>() : 1;
-      if (d->bFirst)
+      //We only track the counts if neither trigger input isn't connected
+      if (!d->bTriggered)
         {
-          d->bFirst = false;
-          if (step > 0) step--;
+          int loopIndex = d->iCurrentIndex / d->lstFileNames.size();
+          if ((d->iMaxImages > 0 && d->iCurrentIndex >= d->iMaxImages) ||
+              (d->iRepeatCount > 0 && loopIndex >= d->iRepeatCount))
+            operationStopped(); //stop here
+          fileName = d->lstFileNames[d->vecIndices[d->iCurrentIndex % d->lstFileNames.size()]];
         }
-      d->iCurrentIndex += step;
-      while (d->iCurrentIndex < 0)
-        d->iCurrentIndex += d->lstFileNames.size();
-      fileName = d->lstFileNames[d->vecIndices[d->iCurrentIndex % d->lstFileNames.size()]];
+      else if (d->bNameConnected) // name input is connected -> we don't care about trigger
+        {
+          fileName = PiiYdin::convertToQString(d->pNameInput);
+        }
+      else // only trigger is connected
+        {
+          // If a trigger object is received and it is an integer, it is
+          // added to the current image index.
+          PiiVariant obj = d->pTriggerInput->firstObject();
+
+          int step = obj.type() == PiiVariant::IntType ? obj.valueAs<int>() : 1;
+          if (d->bFirst)
+            {
+              d->bFirst = false;
+              if (step > 0) step--;
+            }
+          d->iCurrentIndex += step;
+          while (d->iCurrentIndex < 0)
+            d->iCurrentIndex += d->lstFileNames.size();
+          fileName = d->lstFileNames[d->vecIndices[d->iCurrentIndex % d->lstFileNames.size()]];
+        }
+
+      //qDebug("PiiImageFileReader: Emitting image %d/%d", d->iCurrentIndex+1, d->lstFileNames.size());
+
+      QString strError;
+      if (!loadImage(fileName, d->bLockFiles, &img, &strError))
+        PII_THROW(PiiExecutionException, strError);
     }
 
-  //qDebug("PiiImageFileReader: Emitting image %d/%d", d->iCurrentIndex+1, d->lstFileNames.size());
+  if (d->bSendKeys)
+    sendKeys(img);
 
-  QImage img;
+  if (d->imageType == GrayScale)
+    emitGrayImage(img);
+  else if (d->imageType == Color)
+    emitColorImage(img);
+  else
+    emitImage(img);
+
+  d->pNameOutput->emitObject(fileName);
+
+  // Auto-advance if no trigger
+  if (!d->bTriggered)
+    d->iCurrentIndex++;
+}
+
+bool PiiImageFileReader::loadImage(const QString& fileName, bool lockFile, QImage* image, QString* error)
+{
 #ifdef Q_OS_WIN // no locking on windows
-  if (!img.load(fileName))
-    PII_THROW(PiiExecutionException, tr("Cannot read image \"%1\".").arg(fileName));
+  Q_UNUSED(lockFile);
+  if (!image->load(fileName))
+    {
+      *error = tr("Cannot read image \"%1\".").arg(fileName);
+      return false;
+    }
 #else
   // Must manually open the file to obtain its handle
   // See PiiImageFileReader.h for a detailed description.
@@ -136,36 +262,171 @@ void PiiImageFileReader::process()
   if (!f.open(QIODevice::ReadOnly))
     {
       f.close();
-      PII_THROW(PiiExecutionException, tr("Cannot open %1.").arg(fileName));
+      *error = tr("Cannot open %1.").arg(fileName);
+      return false;
     }
-  if (d->bLockFiles && flock(f.handle(), LOCK_SH) == -1)
+  if (lockFile && flock(f.handle(), LOCK_SH) == -1)
     {
       f.close();
-      PII_THROW(PiiExecutionException, tr("Cannot lock %1.").arg(fileName));
+      *error = tr("Cannot lock %1.").arg(fileName);
+      return false;
     }
-  if (!img.load(&f, qPrintable(QFileInfo(fileName).suffix())))
+  if (!image->load(&f, qPrintable(QFileInfo(fileName).suffix())))
     {
       f.close();
-      PII_THROW(PiiExecutionException, tr("Cannot decode %1.").arg(fileName));
+      *error = tr("Cannot decode %1.").arg(fileName);
+      return false;
     }
   f.close();
 #endif
+  return true;
+}
 
-  if (d->bSendKeys)
-    sendKeys(img);
+void PiiImageFileReader::takePrefetchedImage(QString* fileName, QImage* image)
+{
+  PII_D;
+  if (!d->bPrefetching)
+    {
+      // Continue from where the previous run stopped.
+      d->bPrefetching = true;
+      d->iScheduleIndex = d->iCurrentIndex;
+      d->vecScheduleIndices = d->vecIndices;
+      d->bDecodersRunning = true;
+      int iThreads = qMin(Pii::threadCount(d->iDecoderThreadCount), d->iPrefetchCount);
+      for (int i=0; i<iThreads; ++i)
+        {
+          d->lstDecoders << new Decoder(this);
+          d->lstDecoders.last()->start();
+        }
+    }
 
-  if (d->imageType == GrayScale)
-    emitGrayImage(img);
-  else if (d->imageType == Color)
-    emitColorImage(img);
-  else
-    emitImage(img);
+  schedulePrefetch();
 
-  d->pNameOutput->emitObject(fileName);
+  QString strError;
+  synchronized (d->jobMutex)
+    {
+      // Cannot happen unless fileNames was changed while running.
+      if (d->lstJobs.isEmpty())
+        PII_THROW(PiiExecutionException, tr("The prefetch queue is empty."));
+      Job* pJob = d->lstJobs[0];
+      while (!pJob->bDone)
+        d->jobDone.wait(&d->jobMutex);
+      d->lstJobs.removeFirst();
+      --d->iNextJob;
+
+      if (!pJob->vecIndices.isEmpty())
+        d->vecIndices = pJob->vecIndices;
+      *fileName = pJob->strFileName;
+      *image = pJob->image;
+      strError = pJob->strError;
+      delete pJob;
+    }
 
-  // Auto-advance if no trigger
-  if (!d->bTriggered)
-    d->iCurrentIndex++;
+  // Keep the decoders busy while the image is being processed.
+  schedulePrefetch();
+
+  if (!strError.isEmpty())
+    PII_THROW(PiiExecutionException, strError);
+}
+
+void PiiImageFileReader::schedulePrefetch()
+{
+  PII_D;
+  int iQueued;
+  synchronized (d->jobMutex) iQueued = d->lstJobs.size();
+
+  const int iTotal = totalImageCount(), iFileCount = d->lstFileNames.size();
+  QList<Job*> lstNewJobs;
+  while (iQueued + lstNewJobs.size() < d->iPrefetchCount &&
+         (iTotal < 0 || d->iScheduleIndex < iTotal))
+    {
+      const int iIndex = d->iScheduleIndex % iFileCount;
+      // Shuffle in advance, but let process() replace vecIndices
+      // only when the iteration actually starts.
+      QVector<int> vecIndices;
+      if (d->randMode == RandomizeOnEachIteration && iIndex == 0)
+        {
+          Pii::shuffle(d->vecScheduleIndices);
+          vecIndices = d->vecScheduleIndices;
+        }
+      Job* pJob = new Job(d->lstFileNames[d->vecScheduleIndices[iIndex]], d->imageType);
+      pJob->vecIndices = vecIndices;
+      lstNewJobs << pJob;
+      ++d->iScheduleIndex;
+    }
+
+  if (lstNewJobs.isEmpty())
+    return;
+
+  if (d->bReadAhead)
+    for (int i=0; i<lstNewJobs.size(); ++i)
+      adviseWillNeed(lstNewJobs[i]->strFileName);
+
+  synchronized (d->jobMutex)
+    {
+      d->lstJobs << lstNewJobs;
+      d->jobAdded.wakeAll();
+    }
+}
+
+void PiiImageFileReader::decodeJobs()
+{
+  PII_D;
+  QMutexLocker lock(&d->jobMutex);
+  forever
+    {
+      while (d->bDecodersRunning && d->iNextJob >= d->lstJobs.size())
+        d->jobAdded.wait(&d->jobMutex);
+      if (!d->bDecodersRunning)
+        return;
+
+      Job* pJob = d->lstJobs[d->iNextJob++];
+      bool bLockFiles = d->bLockFiles;
+      lock.unlock();
+
+      QImage image;
+      QString strError;
+      if (loadImage(pJob->strFileName, bLockFiles, &image, &strError))
+        convertImage(image, pJob->imageType);
+
+      lock.relock();
+      pJob->image = image;
+      pJob->strError = strError;
+      pJob->bDone = true;
+      d->jobDone.wakeAll();
+    }
+}
+
+void PiiImageFileReader::stopPrefetch()
+{
+  PII_D;
+  if (!d->bPrefetching)
+    return;
+
+  synchronized (d->jobMutex)
+    {
+      d->bDecodersRunning = false;
+      d->jobAdded.wakeAll();
+    }
+  for (int i=0; i<d->lstDecoders.size(); ++i)
+    {
+      d->lstDecoders[i]->wait();
+      delete d->lstDecoders[i];
+    }
+  d->lstDecoders.clear();
+  qDeleteAll(d->lstJobs);
+  d->lstJobs.clear();
+  d->iNextJob = 0;
+  d->bPrefetching = false;
+}
+
+void PiiImageFileReader::aboutToChangeState(State state)
+{
+  // Queued images will be discarded. The next run continues from
+  // currentImageIndex.
+  if (state == Stopped)
+    stopPrefetch();
+  PiiImageReaderOperation::aboutToChangeState(state);
 }
 
 void PiiImageFileReader::sendKeys(const QImage& img)
@@ -314,6 +575,13 @@ void PiiImageFileReader::setMetaFields(const QVariantList& metaFields)
   setNumberedOutputs(d->lstMetaFields.size(), d->iStaticOutputCount, "meta");
 }
 
+void PiiImageFileReader::setPrefetchCount(int prefetchCount) { _d()->iPrefetchCount = qMax(0, prefetchCount); }
+int PiiImageFileReader::prefetchCount() const { return _d()->iPrefetchCount; }
+void PiiImageFileReader::setDecoderThreadCount(int decoderThreadCount) { _d()->iDecoderThreadCount = qMax(0, decoderThreadCount); }
+int PiiImageFileReader::decoderThreadCount() const { return _d()->iDecoderThreadCount; }
+void PiiImageFileReader::setReadAhead(bool readAhead) { _d()->bReadAhead = readAhead; }
+bool PiiImageFileReader::readAhead() const { return _d()->bReadAhead; }
+
 QVariantList PiiImageFileReader::metaFields() const
 {
   const PII_D;
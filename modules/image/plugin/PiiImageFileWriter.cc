@@ -17,8 +17,66 @@
 #include <PiiYdinTypes.h>
 #include <PiiColor.h>
 #include "PiiImage.h"
+#include <PiiParallel.h>
 #include <QFileInfo>
+#include <QFile>
 #include <QDir>
+#include <QMutexLocker>
+#include <QThread>
+
+#ifndef Q_OS_WIN
+#  include <sys/file.h>
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace
+{
+  // Flushes the contents of the given files to disk.
+  void syncFiles(const QStringList& fileNames)
+  {
+#ifndef Q_OS_WIN
+    for (int i=0; i<fileNames.size(); ++i)
+      {
+        int fd = ::open(QFile::encodeName(fileNames[i]).constData(), O_RDONLY);
+        if (fd != -1)
+          {
+            ::fsync(fd);
+            ::close(fd);
+          }
+      }
+#else
+    Q_UNUSED(fileNames);
+#endif
+  }
+}
+
+struct PiiImageFileWriter::Job
+{
+  Job(QImage* image, const QString& fileName, const QString& format,
+      int compression, bool lock, bool overwrite) :
+    pImage(image), strFileName(fileName), strFormat(format),
+    iCompression(compression), bLock(lock), bOverwrite(overwrite)
+  {}
+  ~Job() { delete pImage; }
+
+  QImage* pImage;
+  QString strFileName, strFormat;
+  int iCompression;
+  bool bLock, bOverwrite;
+};
+
+class PiiImageFileWriter::Encoder : public QThread
+{
+public:
+  Encoder(PiiImageFileWriter* writer) : _pWriter(writer) {}
+
+protected:
+  void run() { _pWriter->encodeJobs(); }
+
+private:
+  PiiImageFileWriter* _pWriter;
+};
 
 PiiImageFileWriter::Data::Data() :
   strNamePrefix("img"),
@@ -36,7 +94,15 @@ PiiImageFileWriter::Data::Data() :
   nameObject(0),
   bStoreAlpha(false),
   bChangeExtension(false),
-  bOverwrite(true)
+  bOverwrite(true),
+  iQueueSize(0),
+  iEncoderThreadCount(1),
+  overflowPolicy(BlockWhenFull),
+  iSyncInterval(0),
+  bEncodersRunning(false),
+  iDroppedCount(0),
+  iRateBytes(0),
+  dBytesPerSecond(0)
 {
 }
 
@@ -67,6 +133,13 @@ PiiImageFileWriter::PiiImageFileWriter() :
 
   d->iStaticInputCount = inputCount();
   setProtectionLevel("metaFields", WriteWhenStoppedOrPaused);
+  setProtectionLevel("queueSize", WriteWhenStoppedOrPaused);
+  setProtectionLevel("encoderThreadCount", WriteWhenStoppedOrPaused);
+}
+
+PiiImageFileWriter::~PiiImageFileWriter()
+{
+  stopEncoders();
 }
 
 void PiiImageFileWriter::check(bool reset)
@@ -77,6 +150,7 @@ void PiiImageFileWriter::check(bool reset)
     {
       d->iNextIndex = 0;
       clearKeyValues();
+      synchronized (d->queueMutex) d->iDroppedCount = 0;
     }
 
   if (d->pKeyInput->isConnected() != d->pValueInput->isConnected())
@@ -191,6 +265,9 @@ void PiiImageFileWriter::processImage()
         }
     }
 
+  if (d->iQueueSize > 0 && !d->bEncodersRunning)
+    startEncoders();
+
   switch (d->imageObject.type())
     {
       PII_GRAY_IMAGE_CASES_M(writeGrayImage, (d->imageObject, strFileName));
@@ -245,41 +322,53 @@ void PiiImageFileWriter::writeKeyValues(QImage* image)
     }
 }
 
-// There is no advisory file locking on Windows
-#ifdef Q_OS_WIN
-bool PiiImageFileWriter::writeImage(QImage* image, const QString& fileName, bool /*lock*/)
+bool PiiImageFileWriter::writeImage(QImage* image, const QString& fileName, bool lock)
 {
   PII_D;
   // Delete image on return
   PiiSmartPtr<QImage> pImage(image);
-
   writeKeyValues(image);
+
   QString format = QFileInfo(fileName).suffix();
-  if (format.isEmpty()) format = _d()->strExtension;
-  if (d->bOverwrite || !QFileInfo(fileName).exists())
-    return image->save(fileName, qPrintable(format), d->iCompression);
+  if (format.isEmpty()) format = d->strExtension;
+
+  if (d->bEncodersRunning)
+    {
+      enqueue(new Job(pImage.release(), fileName, format, d->iCompression, lock, d->bOverwrite));
+      return true;
+    }
+
+  qint64 iBytes = 0;
+  if (!saveImage(image, fileName, format, d->iCompression, lock, d->bOverwrite, &iBytes))
+    return false;
+  fileWritten(fileName, iBytes);
+  return true;
+}
+
+// There is no advisory file locking on Windows
+#ifdef Q_OS_WIN
+bool PiiImageFileWriter::saveImage(const QImage* image, const QString& fileName, const QString& format,
+                                   int compression, bool /*lock*/, bool overwrite, qint64* bytes)
+{
+  if (overwrite || !QFileInfo(fileName).exists())
+    {
+      if (!image->save(fileName, qPrintable(format), compression))
+        return false;
+      *bytes = QFileInfo(fileName).size();
+      return true;
+    }
   else
     piiWarning(tr("Will not overwrite %1.").arg(fileName));
   return false;
 }
 // On Unix, we can selectively protect against concurrent usage
 #else
-#include <sys/file.h>
-#include <QFile>
-
-bool PiiImageFileWriter::writeImage(QImage* image, const QString& fileName, bool lock)
+bool PiiImageFileWriter::saveImage(const QImage* image, const QString& fileName, const QString& format,
+                                   int compression, bool lock, bool overwrite, qint64* bytes)
 {
-  PII_D;
-  // Delete image on return
-  PiiSmartPtr<QImage> pImage(image);
-  writeKeyValues(image);
-
-  QString format = QFileInfo(fileName).suffix();
-  if (format.isEmpty()) format = d->strExtension;
-
   // Must manually open the file to obtain its handle
   QFile f(fileName);
-  if (!d->bOverwrite && f.exists())
+  if (!overwrite && f.exists())
     {
       piiWarning(tr("Will not overwrite %1.").arg(fileName));
       return false;
@@ -303,7 +392,8 @@ bool PiiImageFileWriter::writeImage(QImage* image, const QString& fileName, bool
       return false;
     }
   // Save to the locked file
-  bool result = image->save(&f, qPrintable(format), d->iCompression);
+  bool result = image->save(&f, qPrintable(format), compression);
+  *bytes = f.size();
 
   // Close the file (this also unlocks it)
   f.close();
@@ -311,6 +401,131 @@ bool PiiImageFileWriter::writeImage(QImage* image, const QString& fileName, bool
 }
 #endif
 
+void PiiImageFileWriter::fileWritten(const QString& fileName, qint64 bytes)
+{
+  PII_D;
+  QStringList lstToSync;
+  synchronized (d->queueMutex)
+    {
+      if (!d->rateTime.isValid())
+        d->rateTime.start();
+      d->iRateBytes += bytes;
+      int iElapsed = d->rateTime.elapsed();
+      if (iElapsed >= 1000)
+        {
+          d->dBytesPerSecond = d->iRateBytes * 1000.0 / iElapsed;
+          d->iRateBytes = 0;
+          d->rateTime.restart();
+        }
+      if (d->iSyncInterval > 0)
+        {
+          d->lstUnsyncedFiles << fileName;
+          if (d->lstUnsyncedFiles.size() >= d->iSyncInterval)
+            qSwap(lstToSync, d->lstUnsyncedFiles);
+        }
+    }
+  // Synchronize outside of the lock to let others continue writing.
+  syncFiles(lstToSync);
+}
+
+void PiiImageFileWriter::enqueue(Job* job)
+{
+  PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  if (d->lstJobs.size() >= d->iQueueSize)
+    {
+      switch (d->overflowPolicy)
+        {
+        case BlockWhenFull:
+          while (d->lstJobs.size() >= d->iQueueSize)
+            d->jobTaken.wait(&d->queueMutex);
+          break;
+        case DropOldest:
+          delete d->lstJobs.takeFirst();
+          ++d->iDroppedCount;
+          break;
+        case DropNewest:
+          delete job;
+          ++d->iDroppedCount;
+          return;
+        }
+    }
+  d->lstJobs << job;
+  d->jobAdded.wakeOne();
+}
+
+void PiiImageFileWriter::encodeJobs()
+{
+  PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  forever
+    {
+      while (d->bEncodersRunning && d->lstJobs.isEmpty())
+        d->jobAdded.wait(&d->queueMutex);
+      // Pending jobs are written even after a stop request.
+      if (d->lstJobs.isEmpty())
+        return;
+
+      Job* pJob = d->lstJobs.takeFirst();
+      d->jobTaken.wakeAll();
+      lock.unlock();
+
+      qint64 iBytes = 0;
+      if (saveImage(pJob->pImage, pJob->strFileName, pJob->strFormat,
+                    pJob->iCompression, pJob->bLock, pJob->bOverwrite, &iBytes))
+        fileWritten(pJob->strFileName, iBytes);
+      else
+        piiWarning(tr("Cannot write %1.").arg(pJob->strFileName));
+      delete pJob;
+
+      lock.relock();
+    }
+}
+
+void PiiImageFileWriter::startEncoders()
+{
+  PII_D;
+  d->bEncodersRunning = true;
+  const int iThreads = Pii::threadCount(d->iEncoderThreadCount);
+  for (int i=0; i<iThreads; ++i)
+    {
+      d->lstEncoders << new Encoder(this);
+      d->lstEncoders.last()->start();
+    }
+}
+
+void PiiImageFileWriter::stopEncoders()
+{
+  PII_D;
+  if (d->lstEncoders.isEmpty())
+    return;
+
+  synchronized (d->queueMutex)
+    {
+      d->bEncodersRunning = false;
+      d->jobAdded.wakeAll();
+    }
+  // Encoders exit once the queue is empty.
+  for (int i=0; i<d->lstEncoders.size(); ++i)
+    {
+      d->lstEncoders[i]->wait();
+      delete d->lstEncoders[i];
+    }
+  d->lstEncoders.clear();
+}
+
+void PiiImageFileWriter::aboutToChangeState(State state)
+{
+  PII_D;
+  if (state == Stopped)
+    {
+      stopEncoders();
+      QStringList lstToSync;
+      synchronized (d->queueMutex) qSwap(lstToSync, d->lstUnsyncedFiles);
+      syncFiles(lstToSync);
+    }
+  PiiDefaultOperation::aboutToChangeState(state);
+}
 
 QString PiiImageFileWriter::outputDirectory() const { return _d()->strOutputDirectory; }
 void PiiImageFileWriter::setOutputDirectory(const QString& dirName) { _d()->strOutputDirectory = dirName; }
@@ -348,3 +563,39 @@ void PiiImageFileWriter::setChangeExtension(bool changeExtension) { _d()->bChang
 bool PiiImageFileWriter::changeExtension() const { return _d()->bChangeExtension; }
 void PiiImageFileWriter::setOverwrite(bool overwrite) { _d()->bOverwrite = overwrite; }
 bool PiiImageFileWriter::overwrite() const { return _d()->bOverwrite; }
+void PiiImageFileWriter::setQueueSize(int queueSize) { _d()->iQueueSize = qMax(0, queueSize); }
+int PiiImageFileWriter::queueSize() const { return _d()->iQueueSize; }
+void PiiImageFileWriter::setEncoderThreadCount(int encoderThreadCount) { _d()->iEncoderThreadCount = qMax(0, encoderThreadCount); }
+int PiiImageFileWriter::encoderThreadCount() const { return _d()->iEncoderThreadCount; }
+void PiiImageFileWriter::setOverflowPolicy(OverflowPolicy overflowPolicy) { _d()->overflowPolicy = overflowPolicy; }
+PiiImageFileWriter::OverflowPolicy PiiImageFileWriter::overflowPolicy() const { return _d()->overflowPolicy; }
+void PiiImageFileWriter::setSyncInterval(int syncInterval) { _d()->iSyncInterval = qMax(0, syncInterval); }
+int PiiImageFileWriter::syncInterval() const { return _d()->iSyncInterval; }
+
+int PiiImageFileWriter::queueDepth() const
+{
+  const PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  return d->lstJobs.size();
+}
+
+int PiiImageFileWriter::droppedImageCount() const
+{
+  const PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  return d->iDroppedCount;
+}
+
+double PiiImageFileWriter::bytesPerSecond() const
+{
+  const PII_D;
+  QMutexLocker lock(&d->queueMutex);
+  if (!d->rateTime.isValid())
+    return 0;
+  // If nothing has been written for a while, the last measurement is
+  // stale.
+  int iElapsed = d->rateTime.elapsed();
+  if (iElapsed >= 2000)
+    return d->iRateBytes * 1000.0 / iElapsed;
+  return d->dBytesPerSecond;
+}
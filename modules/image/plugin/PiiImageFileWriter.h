@@ -19,6 +19,10 @@
 #include <PiiDefaultOperation.h>
 #include <PiiQImage.h>
 #include <QFileInfo>
+#include <QList>
+#include <QMutex>
+#include <QTime>
+#include <QWaitCondition>
 #include "PiiImageGlobal.h"
 
 /**
@@ -220,9 +224,89 @@ class PII_IMAGE_EXPORT PiiImageFileWriter : public PiiDefaultOperation
    */
   Q_PROPERTY(bool storeAlpha READ storeAlpha WRITE setStoreAlpha);
 
+  /**
+   * The maximum number of images waiting to be written in
+   * write-behind mode. If this value is greater than zero, process()
+   * only prepares the image for writing and puts it into a queue.
+   * The images are encoded and written to disk by
+   * [encoderThreadCount] background threads. If the queue is full,
+   * [overflowPolicy] determines what happens. Pending images will be
+   * written before the operation stops.
+   *
+   * In write-behind mode, errors in writing files cannot be reported
+   * to the processing pipeline. They are logged with `piiWarning()`
+   * instead. File names are still generated and emitted in the same
+   * order as in synchronous mode.
+   *
+   * The default value is zero, which writes each image synchronously
+   * in process().
+   */
+  Q_PROPERTY(int queueSize READ queueSize WRITE setQueueSize);
+
+  /**
+   * The number of background threads that encode and write images in
+   * write-behind mode. Zero means the number of processor cores.
+   * Using many threads is useful with slow encoders such as PNG. Each
+   * thread respects the [compression] setting. The default value is
+   * one.
+   */
+  Q_PROPERTY(int encoderThreadCount READ encoderThreadCount WRITE setEncoderThreadCount);
+
+  /**
+   * Determines what happens if a new image arrives while the
+   * write-behind queue is full. The default value is `BlockWhenFull`.
+   */
+  Q_PROPERTY(OverflowPolicy overflowPolicy READ overflowPolicy WRITE setOverflowPolicy);
+  Q_ENUMS(OverflowPolicy);
+
+  /**
+   * The number of written files after which the files are flushed to
+   * disk with `fsync()` in one batch. This ensures images are
+   * actually on disk after a crash or power failure, without the
+   * cost of synchronizing each file separately. Files that have not
+   * been synchronized yet will be synchronized when the operation
+   * stops. Zero disables synchronization and leaves flushing to the
+   * operating system. The default value is zero. This property has
+   * no effect on Windows.
+   */
+  Q_PROPERTY(int syncInterval READ syncInterval WRITE setSyncInterval);
+
+  /**
+   * The current number of images waiting in the write-behind queue.
+   */
+  Q_PROPERTY(int queueDepth READ queueDepth);
+
+  /**
+   * The number of images dropped due to [overflowPolicy] since the
+   * operation was last reset.
+   */
+  Q_PROPERTY(int droppedImageCount READ droppedImageCount);
+
+  /**
+   * The rate at which encoded images have been written to disk,
+   * measured over the last second or so. Updated in both synchronous
+   * and write-behind mode.
+   */
+  Q_PROPERTY(double bytesPerSecond READ bytesPerSecond);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
+  /**
+   * Actions to take when the write-behind queue is full.
+   *
+   * - `BlockWhenFull` - wait until there is space in the queue. No
+   * image will be lost, but a slow disk will eventually throttle
+   * the processing pipeline.
+   *
+   * - `DropOldest` - discard the oldest image that is still waiting
+   * in the queue.
+   *
+   * - `DropNewest` - discard the incoming image.
+   */
+  enum OverflowPolicy { BlockWhenFull, DropOldest, DropNewest };
+
   PiiImageFileWriter();
+  ~PiiImageFileWriter();
 
   /**
    * Write a matrix as an image to a file.
@@ -247,6 +331,7 @@ public:
 protected:
   void syncEvent(SyncEvent* event);
   void process();
+  void aboutToChangeState(State state);
 
   QString outputDirectory() const;
   void setOutputDirectory(const QString& dirName);
@@ -290,11 +375,34 @@ protected:
   void setOverwrite(bool overwrite);
   bool overwrite() const;
 
+  void setQueueSize(int queueSize);
+  int queueSize() const;
+  void setEncoderThreadCount(int encoderThreadCount);
+  int encoderThreadCount() const;
+  void setOverflowPolicy(OverflowPolicy overflowPolicy);
+  OverflowPolicy overflowPolicy() const;
+  void setSyncInterval(int syncInterval);
+  int syncInterval() const;
+  int queueDepth() const;
+  int droppedImageCount() const;
+  double bytesPerSecond() const;
+
 private:
+  struct Job;
+  class Encoder;
+  friend class Encoder;
+
   void clearKeyValues();
   void processImage();
   void writeKeyValues(QImage* image);
   bool writeImage(QImage* image, const QString& fileName, bool lock);
+  static bool saveImage(const QImage* image, const QString& fileName, const QString& format,
+                        int compression, bool lock, bool overwrite, qint64* bytes);
+  void enqueue(Job* job);
+  void encodeJobs();
+  void fileWritten(const QString& fileName, qint64 bytes);
+  void startEncoders();
+  void stopEncoders();
   template <class T> void writeGrayImage(const PiiVariant& obj, const QString& fileName);
   template <class T> void writeColorImage(const PiiVariant& obj, const QString& fileName);
 
@@ -327,6 +435,22 @@ private:
     bool bStoreAlpha;
     bool bChangeExtension;
     bool bOverwrite;
+
+    int iQueueSize, iEncoderThreadCount;
+    OverflowPolicy overflowPolicy;
+    int iSyncInterval;
+    // Write-behind state, protected by queueMutex.
+    mutable QMutex queueMutex;
+    QWaitCondition jobAdded, jobTaken;
+    QList<Job*> lstJobs;
+    QList<Encoder*> lstEncoders;
+    bool bEncodersRunning;
+    int iDroppedCount;
+    QStringList lstUnsyncedFiles;
+    // Throughput measurement, protected by queueMutex.
+    QTime rateTime;
+    qint64 iRateBytes;
+    double dBytesPerSecond;
   };
   PII_D_FUNC;
 };
@@ -25,6 +25,7 @@ PiiThresholdingOperation::Data::Data() :
   dRelativeThreshold(1.0),
   thresholdType(StaticThreshold),
   bThresholdConnected(false),
+  bHistogramConnected(false),
   bInverse(false),
   windowSize(15,15)
 {
@@ -37,12 +38,15 @@ PiiThresholdingOperation::PiiThresholdingOperation() :
   PII_D;
   d->pImageInput = new PiiInputSocket("image");
   d->pThresholdInput = new PiiInputSocket("threshold");
+  d->pHistogramInput = new PiiInputSocket("histogram");
   d->pBinaryImageOutput = new PiiOutputSocket("image");
   d->pThresholdOutput = new PiiOutputSocket("threshold");
   d->pThresholdInput->setOptional(true);
+  d->pHistogramInput->setOptional(true);
 
   addSocket(d->pImageInput);
   addSocket(d->pThresholdInput);
+  addSocket(d->pHistogramInput);
   addSocket(d->pBinaryImageOutput);
   addSocket(d->pThresholdOutput);
 }
@@ -59,6 +63,7 @@ void PiiThresholdingOperation::check(bool reset)
     PII_THROW(PiiExecutionException, tr("Window size is too small for adaptive thresholding."));
 
   d->bThresholdConnected = d->pThresholdInput->isConnected();
+  d->bHistogramConnected = d->pHistogramInput->isConnected();
 }
 
 void PiiThresholdingOperation::process()
@@ -104,13 +109,19 @@ template <class T> void PiiThresholdingOperation::threshold(const PiiMatrix<T>&
           threshold = d->dAbsoluteThreshold;
           break;
         case OtsuThreshold:
-          {
-            PiiMatrix<double> normalized(PiiImage::normalize<double>(PiiImage::histogram(image)));
-            if ( normalized.columns() < 2 )
-              threshold = d->dAbsoluteThreshold;
-            else
-              threshold = d->dRelativeThreshold * PiiImage::otsuThreshold(normalized) + d->dAbsoluteThreshold;
-          }
+        case PercentageThreshold:
+          if (d->bHistogramConnected)
+            {
+              // Normalized histograms cannot be converted to integers.
+              PiiVariant histogramObj = d->pHistogramInput->firstObject();
+              if (histogramObj.type() == PiiYdin::FloatMatrixType ||
+                  histogramObj.type() == PiiYdin::DoubleMatrixType)
+                threshold = histogramThreshold(PiiYdin::convertMatrixTo<double>(d->pHistogramInput));
+              else
+                threshold = histogramThreshold(PiiYdin::convertMatrixTo<int>(d->pHistogramInput));
+            }
+          else
+            threshold = histogramThreshold(PiiImage::histogram(image));
           break;
         case RelativeToMeanThreshold:
           threshold = Pii::mean<double>(image) * d->dRelativeThreshold + d->dAbsoluteThreshold;
@@ -133,19 +144,6 @@ template <class T> void PiiThresholdingOperation::threshold(const PiiMatrix<T>&
               threshold = Pii::mean<double>(image) + d->dAbsoluteThreshold;
           }
           break;
-        case PercentageThreshold:
-          {
-            PiiMatrix<int> matCumulative(PiiImage::cumulative(PiiImage::histogram(image)));
-            // Relative threshold times the number of pixels in image
-            int iLimit = int(d->dRelativeThreshold * matCumulative(0, matCumulative.columns()-1));
-            // Binary search for the first bin in cumulative
-            // distribution that exceeds iLimit.
-            PiiMatrix<int>::row_iterator i = qLowerBound(matCumulative.rowBegin(0), matCumulative.rowEnd(0), iLimit);
-            // The position i can be outside of matrix if
-            // d->dRelativeThreshold > 1, but we don't care.
-            threshold = int(i - matCumulative.rowBegin(0)) + d->dAbsoluteThreshold;
-          }
-          break;
 
           // The rest of the techniques are special cases which must
           // be handled differently.
@@ -235,6 +233,28 @@ template <class T> void PiiThresholdingOperation::threshold(const PiiMatrix<T>&
   d->pThresholdOutput->emitObject(threshold);
 }
 
+template <class T> double PiiThresholdingOperation::histogramThreshold(const PiiMatrix<T>& histogram) const
+{
+  const PII_D;
+  if (d->thresholdType == OtsuThreshold)
+    {
+      PiiMatrix<double> normalized(PiiImage::normalize<double>(histogram));
+      if ( normalized.columns() < 2 )
+        return d->dAbsoluteThreshold;
+      return d->dRelativeThreshold * PiiImage::otsuThreshold(normalized) + d->dAbsoluteThreshold;
+    }
+
+  PiiMatrix<T> matCumulative(PiiImage::cumulative(histogram));
+  // Relative threshold times the number of pixels in image
+  T limit = T(d->dRelativeThreshold * matCumulative(0, matCumulative.columns()-1));
+  // Binary search for the first bin in cumulative
+  // distribution that exceeds the limit.
+  typename PiiMatrix<T>::row_iterator i = qLowerBound(matCumulative.rowBegin(0), matCumulative.rowEnd(0), limit);
+  // The position i can be outside of matrix if
+  // d->dRelativeThreshold > 1, but we don't care.
+  return int(i - matCumulative.rowBegin(0)) + d->dAbsoluteThreshold;
+}
+
 double PiiThresholdingOperation::absoluteThreshold() const { return _d()->dAbsoluteThreshold; }
 void PiiThresholdingOperation::setAbsoluteThreshold(double absoluteThreshold) { _d()->dAbsoluteThreshold = absoluteThreshold; }
 void PiiThresholdingOperation::setRelativeThreshold(double relativeThreshold) { _d()->dRelativeThreshold = relativeThreshold; }
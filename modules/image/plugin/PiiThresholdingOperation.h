@@ -39,6 +39,14 @@
  * [relativeThreshold] will be added to the input to get the lower
  * threshold.
  *
+ * @in histogram - an optional histogram of the input image (1-by-N
+ * numeric matrix). If connected, `OtsuThreshold` and
+ * `PercentageThreshold` use the received histogram instead of
+ * calculating their own. This makes it possible to share the output
+ * of PiiHistogramOperation with other operations. With color images,
+ * the histogram must be that of the gray-level image. Other
+ * threshold types ignore this input.
+ *
  * Outputs
  * -------
  *
@@ -211,6 +219,7 @@ private:
   template <class T> void thresholdColor(const PiiVariant& obj);
   template <class T> void thresholdGray(const PiiVariant& obj);
   template <class T> void threshold(const PiiMatrix<T>& image);
+  template <class T> double histogramThreshold(const PiiMatrix<T>& histogram) const;
 
   /// @internal
   class Data : public PiiDefaultOperation::Data
@@ -221,8 +230,9 @@ private:
     double dRelativeThreshold;
     ThresholdType thresholdType;
     bool bThresholdConnected;
+    bool bHistogramConnected;
 
-    PiiInputSocket* pImageInput, *pThresholdInput;
+    PiiInputSocket* pImageInput, *pThresholdInput, *pHistogramInput;
     PiiOutputSocket* pBinaryImageOutput, *pThresholdOutput;
     bool bInverse;
     QSize windowSize;
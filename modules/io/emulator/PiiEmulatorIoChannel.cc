@@ -15,9 +15,13 @@
 
 #include "PiiEmulatorIoChannel.h"
 #include <PiiEmulatorIoDriver.h>
+#include <PiiIoThread.h>
 
 PiiEmulatorIoChannel::Data::Data() :
-  bCurrentState(false)
+  bCurrentState(false),
+  iTransitionCount(0),
+  iActivationTime(0),
+  iLastPulseWidth(0)
 {
 }
 
@@ -41,5 +45,17 @@ void PiiEmulatorIoChannel::setOutputState(bool state)
   if (channelMode() == NoMode)
     channelError(tr("Cannot set output state (mode == NoMode)"));
 
+  if (state != d->bCurrentState)
+    {
+      qint64 iTime = PiiIoThread::currentTime();
+      if (state == activeState())
+        d->iActivationTime = iTime;
+      else if (d->iTransitionCount > 0)
+        d->iLastPulseWidth = int(iTime - d->iActivationTime);
+      ++d->iTransitionCount;
+    }
   d->bCurrentState = state;
 }
+
+int PiiEmulatorIoChannel::transitionCount() const { return _d()->iTransitionCount; }
+int PiiEmulatorIoChannel::lastPulseWidth() const { return _d()->iLastPulseWidth; }
@@ -22,19 +22,37 @@
 class PiiEmulatorIoDriver;
 
 /**
- * I/O channel accessed through the emulator I/O-driver.
+ * I/O channel accessed through the emulator I/O-driver. The emulated
+ * channel records the times of its state changes, which makes it
+ * possible to measure the accuracy of output pulses without hardware.
  *
  */
 class PII_EMULATORIODRIVER_EXPORT PiiEmulatorIoChannel : public PiiDefaultIoChannel
 {
   Q_OBJECT
 
+  /**
+   * The number of times the output state of the channel has changed.
+   */
+  Q_PROPERTY(int transitionCount READ transitionCount);
+
+  /**
+   * The measured width of the last complete output pulse in
+   * microseconds, i.e. the time between the last transition to
+   * [activeState] and the transition back. Compare to [pulseWidth]
+   * to see the timing error of the pulse.
+   */
+  Q_PROPERTY(int lastPulseWidth READ lastPulseWidth);
+
 public:
   PiiEmulatorIoChannel(PiiEmulatorIoDriver *parent, int channelIndex);
 
   void setOutputState(bool state);
   bool currentState() const;
 
+  int transitionCount() const;
+  int lastPulseWidth() const;
+
 private:
   /// @internal
   class Data : public PiiDefaultIoChannel::Data
@@ -42,6 +60,9 @@ private:
   public:
     Data();
     bool bCurrentState;
+    int iTransitionCount;
+    qint64 iActivationTime;
+    int iLastPulseWidth;
   };
   PII_D_FUNC;
 };
@@ -22,7 +22,9 @@ QMutex PiiModbusIoDriver::_instanceMutex;
 
 PiiModbusIoDriver::Data::Data() :
   pHandle(0),
-  strUnit("")
+  strUnit(""),
+  bBatchedPolling(true),
+  iRequestCount(0)
 {
 }
 
@@ -196,23 +198,174 @@ PiiIoChannel* PiiModbusIoDriver::createChannel(int channel)
   return new PiiModbusIoChannel(this, channel);
 }
 
+void PiiModbusIoDriver::checkInputStates(const QList<PiiIoChannel*>& inputs)
+{
+  PII_D;
+  if (!d->bBatchedPolling || inputs.size() < 2)
+    {
+      PiiDefaultIoDriver::checkInputStates(inputs);
+      return;
+    }
+
+  // Input channels are discrete inputs, output channels are coils.
+  QList<AddressedChannel> lstDiscreteInputs, lstCoils;
+  QList<PiiIoChannel*> lstOthers;
+  for (int i=0; i<inputs.size(); ++i)
+    {
+      PiiModbusIoChannel *pChannel = static_cast<PiiModbusIoChannel*>(inputs[i]);
+      AddressedChannel channel = { pChannel->address(), i, pChannel };
+      if (channel.iAddress < 0)
+        lstOthers << pChannel;
+      else if (pChannel->channelMode() == PiiDefaultIoChannel::Input)
+        lstDiscreteInputs << channel;
+      else if (pChannel->channelMode() == PiiDefaultIoChannel::Output)
+        lstCoils << channel;
+      else
+        lstOthers << pChannel;
+    }
+
+  checkInputRanges(lstDiscreteInputs, true);
+  checkInputRanges(lstCoils, false);
+  // Let the rest report their errors.
+  PiiDefaultIoDriver::checkInputStates(lstOthers);
+}
+
+void PiiModbusIoDriver::checkInputRanges(QList<AddressedChannel>& channels, bool discreteInputs)
+{
+  qSort(channels);
+  uint8_t aBits[MODBUS_MAX_READ_BITS];
+  for (int iStart = 0, iEnd; iStart < channels.size(); iStart = iEnd)
+    {
+      // Find a range of contiguous addresses. The same address may
+      // appear many times.
+      const int iFirstAddress = channels[iStart].iAddress;
+      for (iEnd = iStart + 1;
+           iEnd < channels.size() &&
+             channels[iEnd].iAddress <= channels[iEnd-1].iAddress + 1 &&
+             channels[iEnd].iAddress - iFirstAddress < MODBUS_MAX_READ_BITS;
+           ++iEnd) ;
+      const int iCount = channels[iEnd-1].iAddress - iFirstAddress + 1;
+      const int iResult = discreteInputs ?
+        readInputBits(iFirstAddress, iCount, aBits) :
+        readBits(iFirstAddress, iCount, aBits);
+
+      for (int i=iStart; i<iEnd; ++i)
+        {
+          try
+            {
+              if (iResult == iCount)
+                channels[i].pChannel->checkInputState(aBits[channels[i].iAddress - iFirstAddress] == 1);
+              else
+                // Read the channel again to report the error.
+                channels[i].pChannel->checkInputState();
+            }
+          catch (PiiException &ex)
+            {
+            }
+        }
+    }
+}
+
+void PiiModbusIoDriver::setOutputStates(const QList<PiiIoChannel*>& channels, const QList<bool>& states)
+{
+  PII_D;
+  if (!d->bBatchedPolling || channels.size() < 2)
+    {
+      PiiDefaultIoDriver::setOutputStates(channels, states);
+      return;
+    }
+
+  QList<AddressedChannel> lstCoils;
+  QList<PiiIoChannel*> lstOthers;
+  QList<bool> lstOtherStates;
+  for (int i=0; i<channels.size(); ++i)
+    {
+      PiiModbusIoChannel *pChannel = static_cast<PiiModbusIoChannel*>(channels[i]);
+      AddressedChannel channel = { pChannel->address(), i, pChannel };
+      if (channel.iAddress >= 0 && pChannel->channelMode() == PiiDefaultIoChannel::Output)
+        lstCoils << channel;
+      else
+        {
+          lstOthers << pChannel;
+          lstOtherStates << states[i];
+        }
+    }
+
+  qSort(lstCoils);
+  uint8_t aBits[MODBUS_MAX_WRITE_BITS];
+  for (int iStart = 0, iEnd; iStart < lstCoils.size(); iStart = iEnd)
+    {
+      // Two channels at the same address cannot be written at once.
+      const int iFirstAddress = lstCoils[iStart].iAddress;
+      for (iEnd = iStart + 1;
+           iEnd < lstCoils.size() &&
+             lstCoils[iEnd].iAddress == lstCoils[iEnd-1].iAddress + 1 &&
+             iEnd - iStart < MODBUS_MAX_WRITE_BITS;
+           ++iEnd) ;
+      const int iCount = iEnd - iStart;
+      if (iCount > 1)
+        {
+          for (int i=iStart; i<iEnd; ++i)
+            aBits[i-iStart] = states[lstCoils[i].iIndex] ? 1 : 0;
+          if (writeBits(iFirstAddress, iCount, aBits) == iCount)
+            continue;
+        }
+      // Single channels and failed ranges are written one by one.
+      for (int i=iStart; i<iEnd; ++i)
+        {
+          try
+            {
+              lstCoils[i].pChannel->setOutputState(states[lstCoils[i].iIndex]);
+            }
+          catch (PiiException &ex)
+            {
+            }
+        }
+    }
+
+  PiiDefaultIoDriver::setOutputStates(lstOthers, lstOtherStates);
+}
+
 int PiiModbusIoDriver::readInputBits(int addr, int nb, uint8_t *dest)
 {
   QMutexLocker lock(&_instanceMutex);
   PII_D;
-  return d->pHandle ? modbus_read_input_bits(d->pHandle, addr, nb, dest) : -1;
+  if (d->pHandle == 0)
+    return -1;
+  ++d->iRequestCount;
+  return modbus_read_input_bits(d->pHandle, addr, nb, dest);
 }
 
 int PiiModbusIoDriver::readBits(int addr, int nb, uint8_t *dest)
 {
   QMutexLocker lock(&_instanceMutex);
   PII_D;
-  return d->pHandle ? modbus_read_bits(d->pHandle, addr, nb, dest) : -1;
+  if (d->pHandle == 0)
+    return -1;
+  ++d->iRequestCount;
+  return modbus_read_bits(d->pHandle, addr, nb, dest);
 }
 
 int PiiModbusIoDriver::writeBit(int addr, int status)
 {
   QMutexLocker lock(&_instanceMutex);
   PII_D;
-  return d->pHandle ? modbus_write_bit(d->pHandle, addr, status) : -1;
+  if (d->pHandle == 0)
+    return -1;
+  ++d->iRequestCount;
+  return modbus_write_bit(d->pHandle, addr, status);
 }
+
+int PiiModbusIoDriver::writeBits(int addr, int nb, const uint8_t *data)
+{
+  QMutexLocker lock(&_instanceMutex);
+  PII_D;
+  if (d->pHandle == 0)
+    return -1;
+  ++d->iRequestCount;
+  return modbus_write_bits(d->pHandle, addr, nb, data);
+}
+
+void PiiModbusIoDriver::setBatchedPolling(bool batchedPolling) { _d()->bBatchedPolling = batchedPolling; }
+bool PiiModbusIoDriver::batchedPolling() const { return _d()->bBatchedPolling; }
+int PiiModbusIoDriver::requestCount() const { return _d()->iRequestCount; }
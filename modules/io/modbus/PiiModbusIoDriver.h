@@ -28,11 +28,31 @@ class PiiModbusIoChannel;
  * An implementation of the PiiIoChannel-interface for Modbus I/O
  * driver.
  *
+ * Each Modbus request is a network round trip. By default, the
+ * driver reads polled input channels whose addresses form a
+ * contiguous range with a single request, and writes output channels
+ * that change their state at the same instant with a single request
+ * if their addresses are contiguous. Polling 32 inputs at addresses
+ * 0-31 thus takes one request instead of 32.
+ *
  */
 class PII_MODBUSIODRIVER_EXPORT PiiModbusIoDriver : public PiiDefaultIoDriver
 {
   Q_OBJECT
 
+  /**
+   * Enables batched reads and writes. If this property is `false`,
+   * each channel is read and written with a separate request. The
+   * default is `true`.
+   */
+  Q_PROPERTY(bool batchedPolling READ batchedPolling WRITE setBatchedPolling);
+
+  /**
+   * The number of Modbus requests sent by this driver. Useful for
+   * diagnostics.
+   */
+  Q_PROPERTY(int requestCount READ requestCount);
+
 public:
   PiiModbusIoDriver();
   ~PiiModbusIoDriver();
@@ -72,6 +92,23 @@ public:
    */
   modbus_t* handle() const;
 
+  /**
+   * Reads the states of *inputs* with as few requests as possible.
+   * If a batched read fails, the channels in the failed range will be
+   * read one by one so that errors are reported per channel.
+   */
+  void checkInputStates(const QList<PiiIoChannel*>& inputs);
+
+  /**
+   * Writes the states of *channels* with as few requests as
+   * possible.
+   */
+  void setOutputStates(const QList<PiiIoChannel*>& channels, const QList<bool>& states);
+
+  void setBatchedPolling(bool batchedPolling);
+  bool batchedPolling() const;
+  int requestCount() const;
+
 protected:
   /**
    * Create a new PiiIoChannel.
@@ -89,6 +126,8 @@ private:
 
     modbus_t *pHandle;
     QString strUnit;
+    bool bBatchedPolling;
+    int iRequestCount;
   };
   PII_D_FUNC;
 
@@ -108,11 +147,27 @@ private:
     QString strUnit;
   };
 
+  // A channel and its index in the list passed to checkInputStates()
+  // or setOutputStates(). Sorted by address, then by index.
+  struct AddressedChannel
+  {
+    int iAddress;
+    int iIndex;
+    PiiModbusIoChannel *pChannel;
+
+    bool operator< (const AddressedChannel& other) const
+    {
+      return iAddress < other.iAddress || (iAddress == other.iAddress && iIndex < other.iIndex);
+    }
+  };
+
   bool initialize(const QString& unit);
+  void checkInputRanges(QList<AddressedChannel>& channels, bool discreteInputs);
   friend class PiiModbusIoChannel;
   int readInputBits(int addr, int nb, uint8_t *dest);
   int readBits(int addr, int nb, uint8_t *dest);
   int writeBit(int addr, int status);
+  int writeBits(int addr, int nb, const uint8_t *data);
 
   typedef QList<Instance> InstanceList;
   template <class T> static InstanceList::iterator findInstance(const T& value);
@@ -15,15 +15,14 @@
 
 #include "PiiDefaultIoChannel.h"
 #include "PiiDefaultIoDriver.h"
-#include <QDateTime>
-#include <QTime>
+#include "PiiIoThread.h"
 
 PiiDefaultIoChannel::Data::Data() :
   pDriver(0),
   iChannelIndex(0),
   channelMode(NoMode),
-  iPulseWidth(50),
-  iPulseDelay(0),
+  dPulseWidth(50),
+  dPulseDelay(0),
   iPreviousInputState(-1),
   bSignalFallingEdge(false),
   bActiveState(true),
@@ -81,18 +80,21 @@ void PiiDefaultIoChannel::setSignalEnabled(bool enabled)
 
 void PiiDefaultIoChannel::checkInputState()
 {
-  bool bState = currentState();
+  checkInputState(currentState());
+}
 
+void PiiDefaultIoChannel::checkInputState(bool state)
+{
   if (d->iPreviousInputState == -1)
     {
-      d->iPreviousInputState = int(bState);
+      d->iPreviousInputState = int(state);
       return;
     }
-  if (d->iPreviousInputState == int(bState))
+  if (d->iPreviousInputState == int(state))
     return;
 
-  d->iPreviousInputState = int(bState);
-  bool bActive = d->bActiveState ? bState : !bState;
+  d->iPreviousInputState = int(state);
+  bool bActive = d->bActiveState ? state : !state;
 
   if (d->bSignalFallingEdge || bActive)
     emit inputStateChanged(bActive);
@@ -102,8 +104,8 @@ void PiiDefaultIoChannel::activate()
 {
   if (d->pDriver != 0 && d->channelMode == Output)
     {
-      qint64 time = QDateTime::currentDateTime().addMSecs(d->iPulseDelay).toMSecsSinceEpoch();
-      d->pDriver->sendSignal(this, d->bActiveState, time, d->iPulseWidth);
+      qint64 iTime = PiiIoThread::currentTime() + qRound64(d->dPulseDelay * 1000);
+      d->pDriver->sendSignal(this, d->bActiveState, iTime, qRound64(d->dPulseWidth * 1000));
     }
 }
 
@@ -127,10 +129,10 @@ PiiDefaultIoDriver* PiiDefaultIoChannel::driver() const { return d->pDriver; }
 void PiiDefaultIoChannel::setChannelName(const QString& channelName) { d->strChannelName = channelName; }
 QString PiiDefaultIoChannel::channelName() const { return d->strChannelName; }
 PiiDefaultIoChannel::ChannelMode PiiDefaultIoChannel::channelMode() const { return d->channelMode; }
-void PiiDefaultIoChannel::setPulseWidth(int pulseWidth) { d->iPulseWidth = pulseWidth; }
-int PiiDefaultIoChannel::pulseWidth() const { return d->iPulseWidth; }
-void PiiDefaultIoChannel::setPulseDelay(int pulseDelay) { d->iPulseDelay = pulseDelay; }
-int PiiDefaultIoChannel::pulseDelay() const { return d->iPulseDelay; }
+void PiiDefaultIoChannel::setPulseWidth(double pulseWidth) { d->dPulseWidth = qMax(pulseWidth, 0.0); }
+double PiiDefaultIoChannel::pulseWidth() const { return d->dPulseWidth; }
+void PiiDefaultIoChannel::setPulseDelay(double pulseDelay) { d->dPulseDelay = qMax(pulseDelay, 0.0); }
+double PiiDefaultIoChannel::pulseDelay() const { return d->dPulseDelay; }
 bool PiiDefaultIoChannel::signalFallingEdge() const { return d->bSignalFallingEdge; }
 bool PiiDefaultIoChannel::activeState() const { return d->bActiveState; }
 int PiiDefaultIoChannel::channelIndex() const { return d->iChannelIndex; }
@@ -58,14 +58,16 @@ class PII_IO_EXPORT PiiDefaultIoChannel : public PiiIoChannel
 
   /**
    * The width of an output pulse in milliseconds. 0 means
-   * that output requires acknowledgement.
+   * that output requires acknowledgement. Fractional values can be
+   * used for sub-millisecond pulses; the resolution is one
+   * microsecond.
    */
-  Q_PROPERTY(int pulseWidth READ pulseWidth WRITE setPulseWidth);
+  Q_PROPERTY(double pulseWidth READ pulseWidth WRITE setPulseWidth);
   /**
    * Initial delay of an output pulse, in milliseconds. This property
-   * is effective only in  `Output`.
+   * is effective only in  `Output`. The resolution is one microsecond.
    */
-  Q_PROPERTY(int pulseDelay READ pulseDelay WRITE setPulseDelay);
+  Q_PROPERTY(double pulseDelay READ pulseDelay WRITE setPulseDelay);
 
 
   /**
@@ -107,6 +109,14 @@ public:
   void checkInputState();
   void activate();
 
+  /**
+   * Checks for a change in the input state like checkInputState(),
+   * but uses *state* as the current state instead of reading it.
+   * Drivers that read many channels with a single request use this
+   * function to pass the state to each channel.
+   */
+  void checkInputState(bool state);
+
   /**
    * Returns a pointer to the I/O driver that owns this channel.
    */
@@ -118,11 +128,11 @@ public:
   void setChannelMode(const ChannelMode& channelMode);
   ChannelMode channelMode() const;
 
-  void setPulseWidth(int pulseWidth);
-  int pulseWidth() const;
+  void setPulseWidth(double pulseWidth);
+  double pulseWidth() const;
 
-  void setPulseDelay(int pulseDelay);
-  int pulseDelay() const;
+  void setPulseDelay(double pulseDelay);
+  double pulseDelay() const;
 
   void setSignalFallingEdge(bool signalFallingEdge);
   bool signalFallingEdge() const;
@@ -152,8 +162,8 @@ protected:
     int iChannelIndex;
     QString strChannelName;
     ChannelMode channelMode;
-    int iPulseWidth;
-    int iPulseDelay;
+    double dPulseWidth;
+    double dPulseDelay;
     int iPreviousInputState;
     bool bSignalFallingEdge;
     bool bActiveState;
@@ -15,6 +15,7 @@
 
 #include "PiiDefaultIoDriver.h"
 #include "PiiDefaultIoChannel.h"
+#include <PiiMath.h>
 
 int PiiDefaultIoDriver::_iInstanceCounter = 0;
 PiiIoThread* PiiDefaultIoDriver::_pSendingThread = 0;
@@ -91,10 +92,10 @@ void PiiDefaultIoDriver::reconnect(PiiIoChannel* channel, const QString& message
     emit connectionLost();
 }
 
-void PiiDefaultIoDriver::sendSignal(PiiIoChannel *channel, bool value, qint64 time, int pulseWidth)
+void PiiDefaultIoDriver::sendSignal(PiiIoChannel *channel, bool value, qint64 time, qint64 pulseWidth)
 {
   if (_pSendingThread != 0)
-    _pSendingThread->sendSignal(channel,value,time,pulseWidth);
+    _pSendingThread->sendSignal(this, channel, value, time, pulseWidth);
 }
 
 PiiIoChannel* PiiDefaultIoDriver::channel(int channel)
@@ -123,13 +124,92 @@ int PiiDefaultIoDriver::channelCount() const
   return d->lstChannels.size();
 }
 
+void PiiDefaultIoDriver::checkInputStates(const QList<PiiIoChannel*>& inputs)
+{
+  for (int i=0; i<inputs.size(); ++i)
+    {
+      try
+        {
+          inputs[i]->checkInputState();
+        }
+      catch (PiiException &ex)
+        {
+        }
+    }
+}
+
+void PiiDefaultIoDriver::setOutputStates(const QList<PiiIoChannel*>& channels, const QList<bool>& states)
+{
+  for (int i=0; i<channels.size(); ++i)
+    {
+      try
+        {
+          channels[i]->setOutputState(states[i]);
+        }
+      catch (PiiException &ex)
+        {
+        }
+    }
+}
+
 void PiiDefaultIoDriver::addPollingInput(PiiIoChannel *input)
 {
   if (_pSendingThread)
-    _pSendingThread->addPollingInput(input);
+    _pSendingThread->addPollingInput(this, input);
 }
 void PiiDefaultIoDriver::removePollingInput(PiiIoChannel *input)
 {
   if (_pSendingThread)
     _pSendingThread->removePollingInput(input);
 }
+
+void PiiDefaultIoDriver::resetTimingStatistics()
+{
+  if (_pSendingThread)
+    _pSendingThread->resetTimingStatistics();
+}
+
+QVariantMap PiiDefaultIoDriver::timingStatistics() const
+{
+  QVariantMap mapStatistics;
+  if (_pSendingThread)
+    {
+      PiiIoThread::TimingStatistics statistics(_pSendingThread->timingStatistics());
+      double dMean = 0, dStdDev = 0;
+      if (statistics.iEdgeCount > 0)
+        {
+          dMean = double(statistics.iTotalLatency) / statistics.iEdgeCount;
+          // Rounding may make the variance slightly negative.
+          dStdDev = Pii::sqrt(qMax(0.0, statistics.dSquaredLatency / statistics.iEdgeCount - dMean * dMean));
+        }
+      mapStatistics["edgeCount"] = int(statistics.iEdgeCount);
+      mapStatistics["meanLatency"] = dMean;
+      mapStatistics["stdDevLatency"] = dStdDev;
+      mapStatistics["minLatency"] = int(statistics.iMinLatency);
+      mapStatistics["maxLatency"] = int(statistics.iMaxLatency);
+      mapStatistics["lastLatency"] = int(statistics.iLastLatency);
+    }
+  return mapStatistics;
+}
+
+void PiiDefaultIoDriver::setPollingInterval(int pollingInterval)
+{
+  if (_pSendingThread)
+    _pSendingThread->setPollingInterval(pollingInterval);
+}
+
+int PiiDefaultIoDriver::pollingInterval() const
+{
+  return _pSendingThread ? _pSendingThread->pollingInterval() : 0;
+}
+
+void PiiDefaultIoDriver::setRealTimeScheduling(bool realTimeScheduling)
+{
+  if (_pSendingThread)
+    _pSendingThread->setRealTimeScheduling(realTimeScheduling);
+}
+
+bool PiiDefaultIoDriver::realTimeScheduling() const
+{
+  return _pSendingThread && _pSendingThread->realTimeScheduling();
+}
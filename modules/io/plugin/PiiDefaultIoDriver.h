@@ -20,16 +20,61 @@
 #include "PiiIoThread.h"
 #include "PiiIoDriverException.h"
 #include <QVector>
+#include <QVariantMap>
 
 class PiiDefaultIoChannel;
 
 /**
  * The default implementation of the PiiIoDriver-interface for input/output drivers.
  *
+ * Delayed output pulses and input polling are handled by a
+ * background thread shared by all drivers derived from this class.
+ * The thread sleeps until the next output edge is due, which keeps
+ * the timing error of output pulses well below a millisecond on an
+ * unloaded system. The scheduling properties below affect the shared
+ * thread and thus all drivers.
  */
 class PII_IO_EXPORT PiiDefaultIoDriver : public PiiIoDriver
 {
   Q_OBJECT
+
+  /**
+   * The interval between two successive polls of input channels, in
+   * microseconds. The default is 10000. Values smaller than 100 will
+   * be rounded up to 100.
+   */
+  Q_PROPERTY(int pollingInterval READ pollingInterval WRITE setPollingInterval);
+
+  /**
+   * Enables the `SCHED_FIFO` real-time scheduling policy for the I/O
+   * thread. This reduces the timing error of output pulses on a
+   * loaded system, but requires special privileges (e.g.
+   * `CAP_SYS_NICE`). If the policy cannot be changed, a warning will
+   * be printed. Supported on Linux only. The default is `false`.
+   */
+  Q_PROPERTY(bool realTimeScheduling READ realTimeScheduling WRITE setRealTimeScheduling);
+
+  /**
+   * Statistics of the timing error of output edges since the last
+   * call to [resetTimingStatistics()]. The map contains the
+   * following values:
+   *
+   * - `edgeCount` - the number of output edges handled (int).
+   * - `meanLatency` - the mean delay between the scheduled and
+   * actual time of an edge, in microseconds (double).
+   * - `stdDevLatency` - the standard deviation of the delay (the
+   * jitter) in microseconds (double).
+   * - `minLatency` - the smallest delay in microseconds (int).
+   * - `maxLatency` - the largest delay in microseconds (int).
+   * - `lastLatency` - the delay of the last edge in microseconds (int).
+   *
+   * The delays measure scheduling only; the time it takes for the
+   * hardware to change its state is not included. With
+   * PiiEmulatorIoDriver, the figures reflect the scheduling accuracy
+   * of the system alone.
+   */
+  Q_PROPERTY(QVariantMap timingStatistics READ timingStatistics);
+
 public:
   ~PiiDefaultIoDriver();
 
@@ -46,6 +91,44 @@ public:
    */
   int channelCount() const;
 
+  /**
+   * Checks the state of many input channels at once. The I/O thread
+   * calls this function once in each polling cycle with all polled
+   * inputs of this driver. The default implementation calls
+   * PiiIoChannel::checkInputState() for each channel. Drivers that
+   * can read many channels with a single request should override
+   * this function and pass the states to the channels with
+   * PiiDefaultIoChannel::checkInputState(bool).
+   *
+   * Errors in individual channels must not prevent checking the
+   * others.
+   */
+  virtual void checkInputStates(const QList<PiiIoChannel*>& inputs);
+
+  /**
+   * Changes the state of many output channels at once. The I/O
+   * thread calls this function with all output edges of this driver
+   * that are scheduled to the same instant. Each channel appears in
+   * *channels* at most once, and `states[i]` is the new state of
+   * `channels[i]`. The default implementation calls
+   * PiiIoChannel::setOutputState() for each channel.
+   *
+   * Errors in individual channels must not prevent changing the
+   * others.
+   */
+  virtual void setOutputStates(const QList<PiiIoChannel*>& channels, const QList<bool>& states);
+
+  /**
+   * Resets [timingStatistics].
+   */
+  Q_INVOKABLE void resetTimingStatistics();
+
+  void setPollingInterval(int pollingInterval);
+  int pollingInterval() const;
+  void setRealTimeScheduling(bool realTimeScheduling);
+  bool realTimeScheduling() const;
+  QVariantMap timingStatistics() const;
+
 protected:
   /**
    * Create a PiiIoChannel depends on given channel-index.
@@ -77,10 +160,11 @@ private:
    *
    * @param channel - the pointer to the output-channel
    * @param value - true = on, false = off
-   * @param time - msecs from 1970-01-01T00:00:00.000
-   * @param pulseWidth - pulse width in msecs.
+   * @param time - the time of the edge in microseconds, see
+   * PiiIoThread::currentTime()
+   * @param pulseWidth - pulse width in microseconds.
    */
-  void sendSignal(PiiIoChannel *channel, bool value, qint64 time, int pulseWidth);
+  void sendSignal(PiiIoChannel *channel, bool value, qint64 time, qint64 pulseWidth);
 
   /**
    * Add the input channel in the polling input list.
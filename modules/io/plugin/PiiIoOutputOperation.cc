@@ -41,7 +41,7 @@ QVariantList PiiIoOutputOperation::pulseWidths() const
   const PII_D;
   QVariantList lstWidths;
   for (int i=0; i<d->lstChannels.size(); ++i)
-    lstWidths << d->lstChannels[i]->property("pulseWidth").toInt();
+    lstWidths << d->lstChannels[i]->property("pulseWidth").toDouble();
   return lstWidths;
 }
 
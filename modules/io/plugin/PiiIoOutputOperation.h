@@ -42,7 +42,7 @@ class PiiIoOutputOperation : public PiiIoOperation
   Q_OBJECT
 
   /**
-   * A list of integers that stores the `pulseWidth` configuration
+   * A list of doubles that stores the `pulseWidth` configuration
    * value for each output channel.
    */
   Q_PROPERTY(QVariantList pulseWidths READ pulseWidths);
@@ -13,128 +13,318 @@
  * refer to LICENSE.AGPL3 for details.
  */
 
+
 #include "PiiIoThread.h"
-#include <PiiDelay.h>
-#include <QDateTime>
+#include "PiiDefaultIoDriver.h"
+#include <PiiTimer.h>
 #include "PiiIoDriverException.h"
 
-PiiIoThread::PiiIoThread(QObject *parent) : QThread(parent), _bRunning(true)
+#ifdef Q_OS_LINUX
+#  include <time.h>
+#  include <errno.h>
+#  include <string.h>
+#  include <pthread.h>
+#  include <sched.h>
+#  include <sys/prctl.h>
+#endif
+
+const int PiiIoThread::PreciseSleepWindow;
+
+namespace
+{
+  // The uninterruptible sleep is done in slices of at most this many
+  // microseconds. An edge added while the thread is in the precise
+  // phase will thus be late by at most one slice.
+  const int iPreciseSleepSlice = 250;
+
+#ifndef Q_OS_LINUX
+  // Monotonic reference time for platforms without clock_gettime().
+  PiiTimer ioClock;
+#endif
+
+  bool containsChannel(const QList<PiiIoThread::OutputEdge>& edges, PiiIoChannel* channel)
+  {
+    for (int i=0; i<edges.size(); ++i)
+      if (edges[i].channel == channel)
+        return true;
+    return false;
+  }
+}
+
+PiiIoThread::PiiIoThread(QObject *parent) :
+  QThread(parent),
+  _bRunning(true),
+  _heapWaitingOutputEdges(0, Pii::InverseHeap),
+  _iSequence(0),
+  _iPollingInterval(10000),
+  _bRealTimeScheduling(false),
+  _bSchedulingChanged(false)
+{
+}
+
+qint64 PiiIoThread::currentTime()
 {
+#ifdef Q_OS_LINUX
+  timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return qint64(t.tv_sec) * 1000000 + t.tv_nsec / 1000;
+#else
+  return ioClock.microseconds();
+#endif
+}
+
+void PiiIoThread::sleepUntil(qint64 time)
+{
+#ifdef Q_OS_LINUX
+  timespec t;
+  t.tv_sec = time / 1000000;
+  t.tv_nsec = long(time % 1000000) * 1000;
+  // Absolute deadlines don't accumulate the error of signal
+  // interruptions.
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &t, 0) == EINTR) ;
+#else
+  qint64 iRemaining = time - currentTime();
+  if (iRemaining > 0)
+    usleep((unsigned long)iRemaining);
+#endif
+}
+
+void PiiIoThread::applySchedulingPolicy()
+{
+  _bSchedulingChanged = false;
+#ifdef Q_OS_LINUX
+  sched_param param;
+  int iPolicy = SCHED_OTHER;
+  param.sched_priority = 0;
+  if (_bRealTimeScheduling)
+    {
+      iPolicy = SCHED_FIFO;
+      param.sched_priority = (sched_get_priority_min(SCHED_FIFO) + sched_get_priority_max(SCHED_FIFO)) / 2;
+    }
+  int iError = pthread_setschedparam(pthread_self(), iPolicy, &param);
+  if (iError != 0)
+    piiWarning(tr("Cannot change the scheduling policy of the I/O thread. %1").arg(strerror(iError)));
+  if (iError != 0 || !_bRealTimeScheduling)
+    setPriority(TimeCriticalPriority);
+#else
+  if (_bRealTimeScheduling)
+    piiWarning(tr("Real-time scheduling is not supported on this platform."));
+#endif
 }
 
 void PiiIoThread::run()
 {
   setPriority(TimeCriticalPriority);
+#ifdef Q_OS_LINUX
+  // The default timer slack (50 us) would dominate the scheduling
+  // error of output edges.
+  prctl(PR_SET_TIMERSLACK, 1);
+#endif
+
+  _mutex.lock();
+  qint64 iNextPollTime = currentTime();
   while (_bRunning)
     {
-      _mutex.lock();
+      if (_bSchedulingChanged)
+        applySchedulingPolicy();
 
-      for (int i=_lstPollingInputs.size(); i--; )
+      qint64 iCurrentTime = currentTime();
+      if (!_lstPollingGroups.isEmpty() && iCurrentTime >= iNextPollTime)
         {
-          try
-            {
-              _lstPollingInputs[i]->checkInputState();
-            }
-          catch (PiiException &ex)
-            {
-            }
-        }
-
-      //HANDLE OUTPUTS ->
-      qint64 currentTime = QDateTime::currentDateTime().toMSecsSinceEpoch();
-      int size = _lstWaitingOutputSignals.size();
-
-      //handle all current output structs
-      for (int i=0; i<size; i++)
-        {
-          OutputSignal stru = _lstWaitingOutputSignals[i];
-          if (currentTime > stru.time)
+          for (int i=0; i<_lstPollingGroups.size(); ++i)
             {
               try
                 {
-                  stru.channel->setOutputState(stru.active);
+                  _lstPollingGroups[i].driver->checkInputStates(_lstPollingGroups[i].lstInputs);
                 }
               catch (PiiException &ex)
                 {
                 }
-              _lstWaitingOutputSignals[i].handled = true;
             }
+          // Keep the polling period constant, but don't try to catch
+          // up missed polls.
+          iNextPollTime += _iPollingInterval;
+          if (iNextPollTime <= iCurrentTime)
+            iNextPollTime = iCurrentTime + _iPollingInterval;
         }
 
-      //remove all handled output structs
-      for (int i=_lstWaitingOutputSignals.size(); i--; )
-        if (_lstWaitingOutputSignals[i].handled)
-          _lstWaitingOutputSignals.removeAt(i);
+      handleEdges(iCurrentTime);
 
-      _mutex.unlock();
+      // Find the next deadline. -1 means there is none.
+      qint64 iDeadline = _lstPollingGroups.isEmpty() ? -1 : iNextPollTime;
+      if (_heapWaitingOutputEdges.size() > 0 &&
+          (iDeadline == -1 || _heapWaitingOutputEdges[0].time < iDeadline))
+        iDeadline = _heapWaitingOutputEdges[0].time;
 
-      PiiDelay::msleep(10);
+      if (iDeadline == -1)
+        _wakeCondition.wait(&_mutex);
+      else
+        {
+          qint64 iNow = currentTime(), iRemaining = iDeadline - iNow;
+          // Far from the deadline, wait so that new edges and stop()
+          // can wake us up. QWaitCondition has a resolution of one
+          // millisecond.
+          if (iRemaining >= PreciseSleepWindow + 1000)
+            _wakeCondition.wait(&_mutex, (unsigned long)((iRemaining - PreciseSleepWindow) / 1000));
+          else if (iRemaining > 0)
+            {
+              _mutex.unlock();
+              sleepUntil(qMin(iDeadline, iNow + iPreciseSleepSlice));
+              _mutex.lock();
+            }
+        }
     }
+  _mutex.unlock();
 }
 
-void PiiIoThread::removeOutputList(const QVector<PiiIoChannel*>& lstChannels)
+void PiiIoThread::stop()
 {
   _mutex.lock();
+  _bRunning = false;
+  _wakeCondition.wakeAll();
+  _mutex.unlock();
+}
 
-  // First handle all waiting output signals depends on lstChannels
-  for (int i=0; i<_lstWaitingOutputSignals.size(); i++)
+void PiiIoThread::handleEdges(qint64 currentTime)
+{
+  // Handle all edges whose deadline has passed.
+  while (_heapWaitingOutputEdges.size() > 0 &&
+         _heapWaitingOutputEdges[0].time <= currentTime)
     {
-      OutputSignal& stru = _lstWaitingOutputSignals[i];
-      if (lstChannels.contains(stru.channel))
+      // Take all edges due at the same instant. If a channel changes
+      // its state twice, the second change goes to the next batch.
+      QList<OutputEdge> lstEdges;
+      const qint64 iTime = _heapWaitingOutputEdges[0].time;
+      do
+        lstEdges << _heapWaitingOutputEdges.take(0);
+      while (_heapWaitingOutputEdges.size() > 0 &&
+             _heapWaitingOutputEdges[0].time == iTime &&
+             !containsChannel(lstEdges, _heapWaitingOutputEdges[0].channel));
+      setOutputStates(lstEdges);
+    }
+}
+
+void PiiIoThread::setOutputStates(const QList<OutputEdge>& edges)
+{
+  qint64 iLatency = currentTime() - edges[0].time;
+  if (_statistics.iEdgeCount == 0 || iLatency < _statistics.iMinLatency)
+    _statistics.iMinLatency = iLatency;
+  if (_statistics.iEdgeCount == 0 || iLatency > _statistics.iMaxLatency)
+    _statistics.iMaxLatency = iLatency;
+  _statistics.iEdgeCount += edges.size();
+  _statistics.iTotalLatency += iLatency * edges.size();
+  _statistics.dSquaredLatency += double(iLatency) * double(iLatency) * edges.size();
+  _statistics.iLastLatency = iLatency;
+
+  // Pass the edges to their drivers in the order they were
+  // scheduled.
+  QList<PiiDefaultIoDriver*> lstDrivers;
+  for (int i=0; i<edges.size(); ++i)
+    if (!lstDrivers.contains(edges[i].driver))
+      lstDrivers << edges[i].driver;
+
+  for (int i=0; i<lstDrivers.size(); ++i)
+    {
+      QList<PiiIoChannel*> lstChannels;
+      QList<bool> lstStates;
+      for (int j=0; j<edges.size(); ++j)
+        if (edges[j].driver == lstDrivers[i])
+          {
+            lstChannels << edges[j].channel;
+            lstStates << edges[j].active;
+          }
+      try
+        {
+          lstDrivers[i]->setOutputStates(lstChannels, lstStates);
+        }
+      catch (PiiException &ex)
         {
-          try
-            {
-              stru.channel->setOutputState(stru.active);
-            }
-          catch (PiiException &ex)
-            {
-            }
-          stru.handled = true;
         }
     }
+}
 
-  // Second remove all handled output structs
-  for (int i=_lstWaitingOutputSignals.size(); i--; )
-    if (_lstWaitingOutputSignals[i].handled)
-      _lstWaitingOutputSignals.removeAt(i);
+void PiiIoThread::removeOutputList(const QVector<PiiIoChannel*>& lstChannels)
+{
+  _mutex.lock();
 
-  _mutex.unlock();
+  // Separate the edges of the given channels from the rest.
+  PiiHeap<OutputEdge> heapRemaining(0, Pii::InverseHeap);
+  QList<OutputEdge> lstRemoved;
+  for (int i=0; i<_heapWaitingOutputEdges.size(); ++i)
+    {
+      const OutputEdge& edge = _heapWaitingOutputEdges[i];
+      if (lstChannels.contains(edge.channel))
+        lstRemoved << edge;
+      else
+        heapRemaining.append(edge);
+    }
+  _heapWaitingOutputEdges = heapRemaining;
+
+  // Handle the removed edges immediately, in the order they were
+  // scheduled to happen.
+  qSort(lstRemoved);
+  for (int i=0; i<lstRemoved.size(); ++i)
+    {
+      try
+        {
+          lstRemoved[i].channel->setOutputState(lstRemoved[i].active);
+        }
+      catch (PiiException &ex)
+        {
+        }
+    }
 
+  _mutex.unlock();
 }
 
-void PiiIoThread::addNewStruct(PiiIoChannel *channel, bool active, qint64 time, int width)
+void PiiIoThread::addEdge(PiiDefaultIoDriver *driver, PiiIoChannel *channel, bool active, qint64 time)
 {
-  OutputSignal stru;
-  stru.handled = false;
-  stru.channel = channel;
-  stru.active = active;
-  stru.time = time;
-  stru.pulseWidth = width;
-  _lstWaitingOutputSignals << stru;
+  OutputEdge edge;
+  edge.time = time;
+  edge.sequence = _iSequence++;
+  edge.driver = driver;
+  edge.channel = channel;
+  edge.active = active;
+  _heapWaitingOutputEdges.append(edge);
 }
 
-void PiiIoThread::addPollingInput(PiiIoChannel *input)
+void PiiIoThread::addPollingInput(PiiDefaultIoDriver *driver, PiiIoChannel *input)
 {
   _mutex.lock();
-  if (!_lstPollingInputs.contains(input))
-    _lstPollingInputs << input;
+  int i = 0;
+  while (i < _lstPollingGroups.size() && _lstPollingGroups[i].driver != driver)
+    ++i;
+  if (i == _lstPollingGroups.size())
+    {
+      PollingGroup group;
+      group.driver = driver;
+      _lstPollingGroups << group;
+    }
+  if (!_lstPollingGroups[i].lstInputs.contains(input))
+    _lstPollingGroups[i].lstInputs << input;
+  _wakeCondition.wakeAll();
   _mutex.unlock();
 }
 
 void PiiIoThread::removePollingInput(PiiIoChannel *input)
 {
   _mutex.lock();
-  _lstPollingInputs.removeAll(input);
+  for (int i=_lstPollingGroups.size(); i--; )
+    {
+      _lstPollingGroups[i].lstInputs.removeAll(input);
+      if (_lstPollingGroups[i].lstInputs.isEmpty())
+        _lstPollingGroups.removeAt(i);
+    }
   _mutex.unlock();
 }
 
 
-void PiiIoThread::sendSignal(PiiIoChannel *channel, bool active, qint64 time, int width)
+void PiiIoThread::sendSignal(PiiDefaultIoDriver *driver, PiiIoChannel *channel, bool active, qint64 time, qint64 width)
 {
   _mutex.lock();
 
   if (width == 0)
-    addNewStruct(channel,active,time,width);
+    addEdge(driver, channel, active, time);
   else
     {
       /**
@@ -153,21 +343,24 @@ void PiiIoThread::sendSignal(PiiIoChannel *channel, bool active, qint64 time, in
        */
 
       bool bAddNew = true;
-      for (int i=0; i<_lstWaitingOutputSignals.size(); i++)
+      for (int i=0; i<_heapWaitingOutputEdges.size(); i++)
         {
-          OutputSignal& stru = _lstWaitingOutputSignals[i];
-          if (stru.channel == channel)
+          const OutputEdge& edge = _heapWaitingOutputEdges[i];
+          if (edge.channel == channel)
             {
-              if (stru.time == time &&
-                  stru.active == active)
+              if (edge.time == time &&
+                  edge.active == active)
                 {
                   bAddNew = false;
                   break;
                 }
-              else if(stru.time >= time &&
-                      stru.time <= (time + qint64(width)))
+              else if (edge.time >= time &&
+                       edge.time <= time + width)
                 {
-                  stru.time = time + qint64(width);
+                  // Moving the edge may break the heap property.
+                  OutputEdge movedEdge(edge);
+                  movedEdge.time = time + width;
+                  _heapWaitingOutputEdges.replace(i, movedEdge);
                   bAddNew = false;
                   break;
                 }
@@ -176,9 +369,45 @@ void PiiIoThread::sendSignal(PiiIoChannel *channel, bool active, qint64 time, in
 
       if (bAddNew)
         {
-          addNewStruct(channel, active, time, width);
-          addNewStruct(channel, !active, time + qint64(width), 0);
+          addEdge(driver, channel, active, time);
+          addEdge(driver, channel, !active, time + width);
         }
     }
+  // The new edge may be due earlier than the one the thread is
+  // waiting for.
+  _wakeCondition.wakeAll();
   _mutex.unlock();
 }
+
+PiiIoThread::TimingStatistics PiiIoThread::timingStatistics() const
+{
+  QMutexLocker lock(&_mutex);
+  return _statistics;
+}
+
+void PiiIoThread::resetTimingStatistics()
+{
+  QMutexLocker lock(&_mutex);
+  _statistics = TimingStatistics();
+}
+
+void PiiIoThread::setPollingInterval(int pollingInterval)
+{
+  QMutexLocker lock(&_mutex);
+  _iPollingInterval = qMax(pollingInterval, 100);
+  _wakeCondition.wakeAll();
+}
+
+void PiiIoThread::setRealTimeScheduling(bool realTimeScheduling)
+{
+  QMutexLocker lock(&_mutex);
+  if (realTimeScheduling != _bRealTimeScheduling)
+    {
+      _bRealTimeScheduling = realTimeScheduling;
+      _bSchedulingChanged = true;
+      _wakeCondition.wakeAll();
+    }
+}
+
+int PiiIoThread::pollingInterval() const { return _iPollingInterval; }
+bool PiiIoThread::realTimeScheduling() const { return _bRealTimeScheduling; }
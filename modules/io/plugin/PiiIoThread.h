@@ -17,48 +17,169 @@
 #define _PIIIOTHREAD_H
 
 #include <QMutex>
+#include <QWaitCondition>
 #include <QThread>
 #include <QVector>
+#include <PiiHeap.h>
 #include "PiiIoChannel.h"
 
-class PiiIoThread : public QThread
+class PiiDefaultIoDriver;
+
+/**
+ * A thread that drives delayed output edges and polls input
+ * channels. Pending output edges are kept in a heap ordered by their
+ * deadlines, and the thread sleeps until the earliest of them (or the
+ * next input poll) is due. All times are microseconds on a monotonic
+ * clock, see [currentTime()].
+ *
+ * Long waits are interruptible so that an edge with an earlier
+ * deadline can be scheduled at any time. The last
+ * [PreciseSleepWindow] microseconds before a deadline are slept in
+ * short slices with an absolute `clock_nanosleep()` on Linux, which
+ * makes the scheduling error of an edge independent of the length of
+ * the wait. Timing statistics tell how late the edges actually were.
+ *
+ * Edges due at the same instant are passed to their driver in a
+ * single call to PiiDefaultIoDriver::setOutputStates(), and all
+ * polled inputs of a driver are checked with a single call to
+ * PiiDefaultIoDriver::checkInputStates(). This makes it possible for
+ * the driver to combine many channels into a single request.
+ */
+class PII_IO_EXPORT PiiIoThread : public QThread
 {
   Q_OBJECT
 
 public:
-  struct OutputSignal
+  /**
+   * The length of the final, uninterruptible sleep before a deadline
+   * in microseconds.
+   */
+  static const int PreciseSleepWindow = 2000;
+
+  /**
+   * A pending change in the state of an output channel.
+   */
+  struct OutputEdge
   {
-    bool handled;
+    qint64 time;
+    quint64 sequence;
+    PiiDefaultIoDriver *driver;
     PiiIoChannel *channel;
     bool active;
-    qint64 time;
-    int pulseWidth;
+
+    // Edges with equal deadlines fire in the order they were added.
+    bool operator< (const OutputEdge& other) const
+    {
+      return time < other.time || (time == other.time && sequence < other.sequence);
+    }
+    bool operator> (const OutputEdge& other) const { return other < *this; }
+  };
+
+  /**
+   * The difference between the scheduled and actual times of output
+   * edges. All times are in microseconds.
+   */
+  struct TimingStatistics
+  {
+    TimingStatistics() :
+      iEdgeCount(0), iTotalLatency(0), dSquaredLatency(0),
+      iMinLatency(0), iMaxLatency(0), iLastLatency(0)
+    {}
+
+    qint64 iEdgeCount;
+    qint64 iTotalLatency;
+    // Sum of squared latencies, for the standard deviation.
+    double dSquaredLatency;
+    qint64 iMinLatency;
+    qint64 iMaxLatency;
+    qint64 iLastLatency;
   };
 
   PiiIoThread(QObject *parent = 0);
 
   void run();
-  void stop() { _bRunning = false; }
+  void stop();
 
-  void sendSignal(PiiIoChannel *channel, bool value, qint64 time, int pulseWidth);
+  /**
+   * Returns the current time in microseconds on a monotonic clock.
+   * The zero point is arbitrary but fixed during the lifetime of the
+   * process.
+   */
+  static qint64 currentTime();
 
-  void addPollingInput(PiiIoChannel *input);
+  /**
+   * Schedules an output edge.
+   *
+   * @param driver the driver that owns *channel*
+   * @param channel the output channel
+   * @param value the state the channel will be set to
+   * @param time the time of the edge, see [currentTime()]
+   * @param pulseWidth the width of the pulse in microseconds. If
+   * this value is non-zero, the channel will be turned back to
+   * `!value` after *pulseWidth* microseconds.
+   */
+  void sendSignal(PiiDefaultIoDriver *driver, PiiIoChannel *channel, bool value, qint64 time, qint64 pulseWidth);
+
+  void addPollingInput(PiiDefaultIoDriver *driver, PiiIoChannel *input);
   void removePollingInput(PiiIoChannel *input);
 
   /**
-   * Handle and remove all outputs from the _lstWaitingOutputSignals
+   * Handle and remove all outputs from the _heapWaitingOutputEdges
    * depends on given parameter lstChannels.
    */
   void removeOutputList(const QVector<PiiIoChannel*>& lstChannels);
 
+  /**
+   * Sets the interval between two successive input polls in
+   * microseconds.
+   */
+  void setPollingInterval(int pollingInterval);
+  int pollingInterval() const;
+
+  /**
+   * Enables or disables the `SCHED_FIFO` real-time scheduling policy.
+   * Changing the policy requires special privileges (e.g.
+   * `CAP_SYS_NICE`). If the policy cannot be changed, a warning will
+   * be printed and the thread will continue with a normal time
+   * critical priority. Real-time scheduling is supported on Linux
+   * only.
+   */
+  void setRealTimeScheduling(bool realTimeScheduling);
+  bool realTimeScheduling() const;
+
+  /**
+   * Returns the timing statistics of output edges handled since the
+   * last reset.
+   */
+  TimingStatistics timingStatistics() const;
+  /**
+   * Resets the timing statistics.
+   */
+  void resetTimingStatistics();
+
 private:
-  bool needAppend(PiiIoChannel *channel, bool active, qint64 checkTime);
-  void addNewStruct(PiiIoChannel *channel, bool active, qint64 time, int width);
+  struct PollingGroup
+  {
+    PiiDefaultIoDriver *driver;
+    QList<PiiIoChannel*> lstInputs;
+  };
+
+  void addEdge(PiiDefaultIoDriver *driver, PiiIoChannel *channel, bool active, qint64 time);
+  void handleEdges(qint64 currentTime);
+  void setOutputStates(const QList<OutputEdge>& edges);
+  void applySchedulingPolicy();
+  void sleepUntil(qint64 time);
 
-  bool _bRunning;
-  QMutex _mutex;
-  QList<OutputSignal> _lstWaitingOutputSignals;
-  QList<PiiIoChannel*> _lstPollingInputs;
+  volatile bool _bRunning;
+  mutable QMutex _mutex;
+  QWaitCondition _wakeCondition;
+  PiiHeap<OutputEdge> _heapWaitingOutputEdges;
+  QList<PollingGroup> _lstPollingGroups;
+  quint64 _iSequence;
+  int _iPollingInterval;
+  bool _bRealTimeScheduling;
+  bool _bSchedulingChanged;
+  TimingStatistics _statistics;
 };
 
 #endif //_PIIIOTHREAD_H
@@ -17,15 +17,155 @@
 #include <PiiMath.h>
 #include <PiiMatrixUtil.h>
 #include <PiiPoint.h>
+#include <PiiParallel.h>
 
 #include <iostream>
 
+namespace
+{
+  // Returns Pii::atan2(dy, dx) + M_PI without branches. The
+  // polynomial is the one in Pii::atan2(); it must be evaluated with
+  // exactly the same operations to produce the same bins. (dx, dy)
+  // must not be (0, 0).
+  inline float shapeContextAngle(int dx, int dy)
+  {
+    const float x = float(dx), y = float(dy), absY = std::fabs(y);
+    const bool bRight = x >= 0;
+    const float fNumerator = bRight ? x - absY : x + absY;
+    const float fDenominator = bRight ? x + absY : absY - x;
+    const float r = fNumerator / fDenominator;
+    const float angle = 0.1963 * r*r*r - 0.9817 * r + (bRight ? M_PI_4 : M_PI_4*3);
+    return float((y < 0 ? -angle : angle) + M_PI);
+  }
+
+  struct ShapeContextBand
+  {
+    ShapeContextBand(const int* boundaryX, const int* boundaryY, int boundaryPoints,
+                     const PiiMatrix<int>& keyPoints, const double* distances, int distanceCount,
+                     bool ascendingDistances, double maxDistance, int angles,
+                     const double* directions, PiiMatrix<float>& features) :
+      pBoundaryX(boundaryX), pBoundaryY(boundaryY), iBoundaryPoints(boundaryPoints),
+      keyPoints(keyPoints), pDistances(distances), iDistances(distanceCount),
+      bAscendingDistances(ascendingDistances), dMaxDistance(maxDistance),
+      dAngleStep(2*M_PI / qMax(1,angles)), iColumns(angles * distanceCount),
+      pDirections(directions), features(features)
+    {}
+
+    void operator() (int begin, int end, int /*band*/) const
+    {
+      QVector<int> vecDx(iBoundaryPoints), vecDy(iBoundaryPoints), vecBins(iBoundaryPoints);
+      QVector<int> vecCounts(iColumns);
+      int* pDx = vecDx.data(), *pDy = vecDy.data(), *pBins = vecBins.data();
+      int* pCounts = vecCounts.data();
+      for (int i=begin; i<end; ++i)
+        {
+          const int iPoints = bAscendingDistances ?
+            selectPoints<true>(i, pDx, pDy, pBins) :
+            selectPoints<false>(i, pDx, pDy, pBins);
+          if (pDirections != 0)
+            binPoints<true>(i, iPoints, pDx, pDy, pBins);
+          else
+            binPoints<false>(i, iPoints, pDx, pDy, pBins);
+
+          Pii::fillN(pCounts, iColumns, 0);
+          for (int j=0; j<iPoints; ++j)
+            ++pCounts[pBins[j]];
+
+          // Normalize histogram
+          float* pRow = features[i];
+          for (int c=0; c<iColumns; ++c)
+            pRow[c] = float(pCounts[c]);
+          float fSum = Pii::accumulateN(pRow, iColumns, std::plus<float>(), 0.0f);
+          if (fSum != 0)
+            Pii::mapN(pRow, iColumns, std::bind2nd(std::multiplies<float>(), 1.0f/fSum));
+        }
+    }
+
+    // Collects the boundary points within the maximum distance from
+    // key point i. Stores the coordinate differences to dxs and dys,
+    // the distance bins to distanceIndices and returns the number of
+    // points. Every point is written, but the write position only
+    // advances for the selected ones.
+    template <bool ascendingDistances> int selectPoints(int i, int* dxs, int* dys, int* distanceIndices) const
+    {
+      const int x = keyPoints(i,0), y = keyPoints(i,1);
+      const double dFirstDistance = pDistances[0];
+      int iCount = 0;
+      for (int j=0; j<iBoundaryPoints; ++j)
+        {
+          const int dx = x - pBoundaryX[j], dy = y - pBoundaryY[j];
+          const double dDistance = dx*dx + dy*dy;
+
+          // The distance bin is the last index in the leading run of
+          // limits greater than the distance (or zero). With
+          // ascending limits, the run covers either all limits or
+          // none.
+          int iDistanceIndex;
+          if (ascendingDistances)
+            iDistanceIndex = dDistance < dFirstDistance ? iDistances - 1 : 0;
+          else
+            {
+              int iRun = 0, iAlive = 1;
+              for (int c=0; c<iDistances; ++c)
+                {
+                  iAlive &= int(dDistance < pDistances[c]);
+                  iRun += iAlive;
+                }
+              iDistanceIndex = qMax(iRun - 1, 0);
+            }
+
+          dxs[iCount] = dx;
+          dys[iCount] = dy;
+          distanceIndices[iCount] = iDistanceIndex;
+          iCount += int(dDistance < dMaxDistance) & int(dDistance != 0);
+        }
+      return iCount;
+    }
+
+    // Converts the distance bins of count selected points to
+    // histogram bins by adding the angle bin. The loop has no
+    // branches and can be vectorized.
+    template <bool rotate> void binPoints(int i, int count, const int* dxs, const int* dys, int* bins) const
+    {
+      const double dDirection = rotate ? pDirections[i] : 0.0;
+      for (int j=0; j<count; ++j)
+        {
+          float fAngle = shapeContextAngle(dxs[j], dys[j]);
+          if (rotate)
+            {
+              // Calculate both wrapped alternatives and select to keep
+              // the loop free of conditional floating-point operations.
+              fAngle = float(fAngle - dDirection);
+              const float fAbove = float(fAngle + 2*M_PI), fBelow = float(fAngle - 2*M_PI);
+              fAngle = fAngle < 0 ? fAbove : fAngle > 2*M_PI ? fBelow : fAngle;
+            }
+
+          const int iBinIndex = iDistances * int(fAngle / dAngleStep) + bins[j];
+          // Special case: fAngle == 2*M_PI
+          bins[j] = unsigned(iBinIndex) >= unsigned(iColumns) ? 0 : iBinIndex;
+        }
+    }
+
+    const int* pBoundaryX, *pBoundaryY;
+    const int iBoundaryPoints;
+    const PiiMatrix<int>& keyPoints;
+    const double* pDistances;
+    const int iDistances;
+    const bool bAscendingDistances;
+    const double dMaxDistance, dAngleStep;
+    const int iColumns;
+    const double* pDirections;
+    PiiMatrix<float>& features;
+  };
+}
+
 PiiMatrix<float> PiiMatching::shapeContextDescriptor(const PiiMatrix<int>& boundaryPoints,
                                                      const PiiMatrix<int>& keyPoints,
                                                      int angles,
                                                      const QVector<double>& distances,
                                                      const QVector<double>& directions,
-                                                     InvarianceFlags invariance)
+                                                     InvarianceFlags invariance,
+                                                     int threads)
 {
   const int iColumns = angles * distances.size();
   const int iKeyPoints = keyPoints.rows(), iDistances = distances.size();
@@ -45,12 +185,10 @@ PiiMatrix<float> PiiMatching::shapeContextDescriptor(const PiiMatrix<int>& bound
   if (iBoundaryPoints < 2)
     return matFeatures;
 
-  // Calculate max distance and angle step
+  // Calculate max distance
   double dMaxDistance = distances.last();
-  double dAngleStep = 2*M_PI / qMax(1,angles);
 
-  double* pNewDistances = 0;
-  const double* pDistances = 0;
+  QVector<double> vecDistances(distances);
   if (invariance & ScaleInvariant)
     {
       double dMeanDistance = 0;
@@ -73,69 +211,29 @@ PiiMatrix<float> PiiMatching::shapeContextDescriptor(const PiiMatrix<int>& bound
           }
       // Scale distance limits (same as dividing each distance by the
       // mean)
-      pDistances = pNewDistances = new double[iDistances];
       for (int i=0; i<iDistances; ++i)
-        pNewDistances[i] = distances[i] * dMeanDistance;
+        vecDistances[i] = distances[i] * dMeanDistance;
     }
-  else
-    pDistances = distances.data();
-
-  // Calculate features for selected points
-  for (int i=0; i<iKeyPoints; ++i)
-    {
-      float* pCurrentRow = matFeatures[i];
-
-      // Get the main point
-      int x = keyPoints(i,0);
-      int y = keyPoints(i,1);
-
-      // Loop all points
-      for (int j=0; j<iBoundaryPoints; ++j)
-        {
-          // Calculate distance
-          int dx = x-boundaryPoints(j,0);
-          int dy = y-boundaryPoints(j,1);
-          double dDistance = dx*dx + dy*dy;
 
-          if (dDistance < dMaxDistance && dDistance != 0)
-            {
-              // Find distance bin index
-              int iDistanceIndex = 0;
-              for (int c=0; c<iDistances; ++c)
-                {
-                  if (dDistance < pDistances[c])
-                    iDistanceIndex = c;
-                  else
-                    break;
-                }
-
-              // Calculate angle between feature point and current boundary point
-              float dAngle = Pii::atan2((float)dy,(float)dx) + M_PI;
+  bool bAscendingDistances = true;
+  for (int i=1; i<iDistances; ++i)
+    if (!(vecDistances[i-1] <= vecDistances[i]))
+      bAscendingDistances = false;
 
-              // Rotate along boundary direction
-              if (directions.size() > 0)
-                {
-                  dAngle -= directions[i];
-                  if (dAngle < 0)
-                    dAngle += 2*M_PI;
-                  else if (dAngle > 2*M_PI)
-                    dAngle -= 2*M_PI;
-                }
-
-              int iBinIndex = iDistances * int(dAngle / dAngleStep) + iDistanceIndex;
-              // Special case: dAngle == 2*M_PI
-              if (iBinIndex >= iColumns)
-                iBinIndex = 0;
-              ++pCurrentRow[iBinIndex];
-            }
-        }
-      // Normalize histogram and return it
-      float fSum = Pii::accumulateN(pCurrentRow, iColumns, std::plus<float>(), 0.0f);
-      if (fSum != 0)
-        Pii::mapN(pCurrentRow, iColumns, std::bind2nd(std::multiplies<float>(), 1.0f/fSum));
+  // Store boundary coordinates in separate arrays for vectorization.
+  QVector<int> vecBoundaryX(iBoundaryPoints), vecBoundaryY(iBoundaryPoints);
+  for (int j=0; j<iBoundaryPoints; ++j)
+    {
+      vecBoundaryX[j] = boundaryPoints(j,0);
+      vecBoundaryY[j] = boundaryPoints(j,1);
     }
 
-  delete[] pNewDistances;
+  ShapeContextBand band(vecBoundaryX.constData(), vecBoundaryY.constData(), iBoundaryPoints,
+                        keyPoints, vecDistances.constData(), iDistances, bAscendingDistances,
+                        dMaxDistance, angles, directions.size() > 0 ? directions.constData() : 0,
+                        matFeatures);
+  // Calculate features for selected points
+  Pii::parallelFor(iKeyPoints, band, threads, qMax(1, 16384 / iBoundaryPoints));
 
   return matFeatures;
 }
@@ -118,13 +118,19 @@ public:
    * `ScaleInvariant` mode, all distances will be divided by the mean
    * (squared) distance between key points. Thus, *distances* must
    * not be absolute values but relative to the mean distance.
+   *
+   * @param threads the number of threads. The key points are divided
+   * into bands that are processed in parallel. Zero means the number
+   * of processor cores. The result does not depend on the number of
+   * threads.
    */
   PII_MATCHING_EXPORT PiiMatrix<float> shapeContextDescriptor(const PiiMatrix<int>& boundaryPoints,
                                                               const PiiMatrix<int>& keyPoints,
                                                               int angles,
                                                               const QVector<double>& distances,
                                                               const QVector<double>& boundaryDirections = QVector<double>(),
-                                                              InvarianceFlags invariance = NonInvariant);
+                                                              InvarianceFlags invariance = NonInvariant,
+                                                              int threads = 1);
 
   /**
    * Returns the direction of the boundary for each point in
@@ -44,6 +44,10 @@ void PiiRansacPointMatcher::setFittingThreshold(double fittingThreshold) { _d()-
 double PiiRansacPointMatcher::fittingThreshold() const { return _d()->pRansac->fittingThreshold(); }
 void PiiRansacPointMatcher::setSelectionProbability(double selectionProbability) { _d()->pRansac->setSelectionProbability(selectionProbability); }
 double PiiRansacPointMatcher::selectionProbability() const { return _d()->pRansac->selectionProbability(); }
+void PiiRansacPointMatcher::setRansacThreadCount(int ransacThreadCount) { _d()->pRansac->setThreadCount(ransacThreadCount); }
+int PiiRansacPointMatcher::ransacThreadCount() const { return _d()->pRansac->threadCount(); }
+void PiiRansacPointMatcher::setPreemptiveTestSize(int preemptiveTestSize) { _d()->pRansac->setPreemptiveTestSize(preemptiveTestSize); }
+int PiiRansacPointMatcher::preemptiveTestSize() const { return _d()->pRansac->preemptiveTestSize(); }
 
 PiiRansac& PiiRansacPointMatcher::ransac() { return *_d()->pRansac; }
 const PiiRansac& PiiRansacPointMatcher::ransac() const { return *_d()->pRansac; }
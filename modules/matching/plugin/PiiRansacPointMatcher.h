@@ -37,6 +37,8 @@ class PII_MATCHING_EXPORT PiiRansacPointMatcher : public PiiPointMatchingOperati
   Q_PROPERTY(int minInliers READ minInliers WRITE setMinInliers);
   Q_PROPERTY(double fittingThreshold READ fittingThreshold WRITE setFittingThreshold);
   Q_PROPERTY(double selectionProbability READ selectionProbability WRITE setSelectionProbability);
+  Q_PROPERTY(int ransacThreadCount READ ransacThreadCount WRITE setRansacThreadCount);
+  Q_PROPERTY(int preemptiveTestSize READ preemptiveTestSize WRITE setPreemptiveTestSize);
 
 public:
   void setMaxIterations(int maxIterations);
@@ -49,6 +51,10 @@ public:
   double fittingThreshold() const;
   void setSelectionProbability(double selectionProbability);
   double selectionProbability() const;
+  void setRansacThreadCount(int ransacThreadCount);
+  int ransacThreadCount() const;
+  void setPreemptiveTestSize(int preemptiveTestSize);
+  int preemptiveTestSize() const;
 
 protected:
   /// @internal
@@ -36,7 +36,8 @@ PiiShapeContextOperation::Data::Data() :
   shapeJoiningMode(JoinNestedShapes),
   iLastImageRows(0),
   iLastImageColumns(0),
-  iMaxPoints(0)
+  iMaxPoints(0),
+  iDescriptorThreadCount(1)
 {
 }
 
@@ -272,7 +273,8 @@ void PiiShapeContextOperation::processBoundary(const PiiMatrix<int>& boundary, c
                                                                      d->iAngles,
                                                                      d->vecDistances,
                                                                      vecAngles,
-                                                                     d->invariance);
+                                                                     d->invariance,
+                                                                     d->iDescriptorThreadCount);
 
   d->pPointsOutput->emitObject(matKeyPoints);
   d->pFeaturesOutput->emitObject(matFeatures);
@@ -435,3 +437,5 @@ PiiShapeContextOperation::ShapeJoiningMode PiiShapeContextOperation::shapeJoinin
 { return _d()->shapeJoiningMode; }
 void PiiShapeContextOperation::setMaxPoints(int maxPoints) { _d()->iMaxPoints = qMax(0, maxPoints); }
 int PiiShapeContextOperation::maxPoints() const { return _d()->iMaxPoints; }
+void PiiShapeContextOperation::setDescriptorThreadCount(int descriptorThreadCount) { _d()->iDescriptorThreadCount = qMax(0, descriptorThreadCount); }
+int PiiShapeContextOperation::descriptorThreadCount() const { return _d()->iDescriptorThreadCount; }
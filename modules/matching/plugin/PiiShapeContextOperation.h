@@ -179,6 +179,14 @@ class PiiShapeContextOperation : public PiiDefaultOperation
   Q_PROPERTY(ShapeJoiningMode shapeJoiningMode READ shapeJoiningMode WRITE setShapeJoiningMode);
   Q_ENUMS(ShapeJoiningMode);
 
+  /**
+   * The number of threads used in calculating the descriptors of a
+   * single set of boundaries. The key points are divided among the
+   * threads. Zero means the number of processor cores. The default
+   * value is one.
+   */
+  Q_PROPERTY(int descriptorThreadCount READ descriptorThreadCount WRITE setDescriptorThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 
 public:
@@ -243,6 +251,8 @@ protected:
   PiiMatching::InvarianceFlags invariance() const;
   void setMaxPoints(int maxPoints);
   int maxPoints() const;
+  void setDescriptorThreadCount(int descriptorThreadCount);
+  int descriptorThreadCount() const;
 
 private:
   void processBoundary(const PiiMatrix<int>& boundary, const PiiMatrix<int>& limits);
@@ -286,6 +296,7 @@ private:
     PiiOutputSocket *pPointsOutput, *pFeaturesOutput, *pBoundariesOutput, *pLimitsOutput;
     int iLastImageRows, iLastImageColumns;
     int iMaxPoints;
+    int iDescriptorThreadCount;
   };
   PII_D_FUNC;
 };
@@ -157,6 +157,11 @@ protected:
    */
   double fitToModel(int dataIndex, const double* model);
 
+  /**
+   * Calculates the fit of *count* successive points at once.
+   */
+  void fitRangeToModel(int firstIndex, int count, const double* model, double* fits);
+
   int minInliers(const double* model) const;
   double fittingThreshold(const double* model) const;
 
@@ -284,14 +289,15 @@ template <class T> int PiiCircleRansac<T>::minSamples() const { return 3; }
 template <class T>
 PiiMatrix<double> PiiCircleRansac<T>::findPossibleModels(const int* dataIndices)
 {
-  PII_D;
+  const PII_D;
+  const PiiMatrix<T>& matPoints = d->matPoints;
 
   // Use the first point as the origin and translate the other two
   // accordingly.
   PiiVector<T, 2>
-    a = d->matPoints.template rowAs<PiiVector<T, 2> >(dataIndices[0]),
-    b = d->matPoints.template rowAs<PiiVector<T, 2> >(dataIndices[1]) - a,
-    c = d->matPoints.template rowAs<PiiVector<T, 2> >(dataIndices[2]) - a;
+    a = matPoints.template rowAs<PiiVector<T, 2> >(dataIndices[0]),
+    b = matPoints.template rowAs<PiiVector<T, 2> >(dataIndices[1]) - a,
+    c = matPoints.template rowAs<PiiVector<T, 2> >(dataIndices[2]) - a;
 
   // Calculate the circumcenter origin of the triangle.
   double dd = 2 * (b[0] * c[1] - b[1] * c[0]);
@@ -316,12 +322,24 @@ PiiMatrix<double> PiiCircleRansac<T>::findPossibleModels(const int* dataIndices)
 template <class T>
 double PiiCircleRansac<T>::fitToModel(int dataIndex, const double* model)
 {
-  const T* pData = _d()->matPoints[dataIndex];
+  const T* pData = _d()->matPoints.constRowBegin(dataIndex);
   return Pii::abs(Pii::fastHypotenuse(pData[0] - model[0],
                                       pData[1] - model[1]) -
                   model[2]);
 }
 
+template <class T>
+void PiiCircleRansac<T>::fitRangeToModel(int firstIndex, int count, const double* model, double* fits)
+{
+  const PiiMatrix<T>& matPoints = _d()->matPoints;
+  const double dCx = model[0], dCy = model[1], dRadius = model[2];
+  for (int i=0; i<count; ++i)
+    {
+      const T* pData = matPoints.constRowBegin(firstIndex + i);
+      fits[i] = Pii::abs(Pii::fastHypotenuse(pData[0] - dCx, pData[1] - dCy) - dRadius);
+    }
+}
+
 template <class T>
 int PiiCircleRansac<T>::minInliers(const double* model) const
 {
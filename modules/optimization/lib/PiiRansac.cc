@@ -19,14 +19,61 @@
 #include <PiiFunctional.h>
 #include <PiiRandom.h>
 #include <PiiMath.h>
+#include <PiiParallel.h>
 #include <QVector>
+#include <QMutexLocker>
+#include <cstdlib>
+
+namespace
+{
+  // A xorshift64* generator. Each thread gets its own stream.
+  class RandomStream
+  {
+  public:
+    RandomStream(quint64 seed) : _iState(seed != 0 ? seed : Q_UINT64_C(0x9e3779b97f4a7c15)) {}
+
+    int next(int max)
+    {
+      _iState ^= _iState >> 12;
+      _iState ^= _iState << 25;
+      _iState ^= _iState >> 27;
+      return int(((_iState * Q_UINT64_C(2685821657736338717)) >> 33) % quint64(max));
+    }
+
+  private:
+    quint64 _iState;
+  };
+
+  // Scoring is done in blocks of this many samples.
+  const int iFitBlockSize = 64;
+}
+
+class PiiRansac::Worker
+{
+public:
+  Worker(PiiRansac* ransac, quint64* seeds) :
+    _pRansac(ransac), _pSeeds(seeds)
+  {}
+
+  void operator() (int begin, int end, int /*band*/)
+  {
+    for (int i=begin; i<end; ++i)
+      _pRansac->runWorker(_pSeeds[i]);
+  }
+
+private:
+  PiiRansac* _pRansac;
+  quint64* _pSeeds;
+};
 
 PiiRansac::Data::Data() :
   iMaxIterations(1000),
   iMaxSamplings(100),
   iMinInliers(0),
   dFittingThreshold(16),
-  dSelectionProbability(0.99)
+  dSelectionProbability(0.99),
+  iThreadCount(1),
+  iPreemptiveTestSize(0)
 {
 }
 
@@ -50,25 +97,74 @@ bool PiiRansac::findBestModel()
 {
   const int iSamples = totalSampleCount();
   const int iMinSamples = minSamples();
-  const double dLogProp = Pii::log(1.0 - d->dSelectionProbability);
 
   if (iSamples < iMinSamples)
     return false;
 
-  int iIterations = 0, iRequiredIterations = 1;
-
   d->vecBestInliers.clear();
   d->matBestModel.clear();
+  d->iIterations = 0;
+  d->iBestInlierCount = 0;
+  d->iFailed = 0;
+
+  /* There is no estimate of the required number of iterations until
+   * a model has passed the preemptive test and been scored. The
+   * estimate is updated whenever a better model is found.
+   */
+  d->iRequiredIterations = d->iMaxIterations;
+
+  const int iThreads = Pii::threadCount(d->iThreadCount);
+  if (iThreads == 1)
+    // Zero seed means the global random number generator.
+    runWorker(0);
+  else
+    {
+      QVector<quint64> vecSeeds(iThreads);
+      for (int i=0; i<iThreads; ++i)
+        vecSeeds[i] = (quint64(std::rand()) << 32 | quint64(std::rand())) | 1;
+      Worker worker(this, vecSeeds.data());
+      Pii::parallelFor(iThreads, worker, iThreads);
+    }
+
+  if (d->iFailed.load() != 0)
+    return false;
+
+  return !d->matBestModel.isEmpty();
+}
+
+void PiiRansac::runWorker(quint64 seed)
+{
+  const int iSamples = totalSampleCount();
+  const int iMinSamples = minSamples();
+  const int iTestSize = qMin(d->iPreemptiveTestSize, iSamples);
+  const double dLogProp = Pii::log(1.0 - d->dSelectionProbability);
+
+  RandomStream random(seed);
+  const bool bGlobalRandom = seed == 0;
 
   // This vector stores the indices of all points.
   QVector<int> vecIndices(iSamples);
   Pii::generateN(vecIndices.begin(), iSamples, Pii::CountFunction<int>());
+  int* piIndices = vecIndices.data();
   // Randomize order
-  Pii::shuffleN(vecIndices.begin(), iSamples);
+  if (bGlobalRandom)
+    Pii::shuffleN(piIndices, iSamples);
+  else
+    for (int i=iSamples; i>1; --i)
+      qSwap(piIndices[i-1], piIndices[random.next(i)]);
   int iSubsetStartIndex = 0;
 
-  while (iIterations < qMin(d->iMaxIterations, iRequiredIterations))
+  // This vector stores the indices of selected inlying points.
+  QVector<int> vecInliers(iSamples);
+  int* piInliers = vecInliers.data();
+  double adFits[iFitBlockSize];
+
+  for (;;)
     {
+      if (d->iFailed.load() != 0 ||
+          d->iIterations++ >= qMin(d->iMaxIterations, d->iRequiredIterations.load()))
+        break;
+
       PiiMatrix<double> matModels;
       int iSamplingCount = 0;
 
@@ -77,12 +173,16 @@ bool PiiRansac::findBestModel()
         {
           // No more random orderings left -> reshuffle the samples
           // and start over.
-          if (iSubsetStartIndex + iMinSamples > vecIndices.size())
+          if (iSubsetStartIndex + iMinSamples > iSamples)
             {
-              Pii::shuffleN(vecIndices.begin(), iSamples);
+              if (bGlobalRandom)
+                Pii::shuffleN(piIndices, iSamples);
+              else
+                for (int i=iSamples; i>1; --i)
+                  qSwap(piIndices[i-1], piIndices[random.next(i)]);
               iSubsetStartIndex = 0;
             }
-          matModels = findPossibleModels(vecIndices.data() + iSubsetStartIndex);
+          matModels = findPossibleModels(piIndices + iSubsetStartIndex);
           iSubsetStartIndex += iMinSamples;
           ++iSamplingCount;
           // Special case: if there is only one way to select the
@@ -93,54 +193,90 @@ bool PiiRansac::findBestModel()
 
       // We are out of luck. No model could be found.
       if (matModels.isEmpty())
-        return false;
-
-      // This vector stores the indices of selected inlying points.
-      QVector<int> vecInliers;
-      vecInliers.reserve(iSamples);
+        {
+          d->iFailed = 1;
+          break;
+        }
 
       // Test all possible models
       for (int iModel = 0; iModel < matModels.rows(); ++iModel)
         {
-          // Clear the inlier list at the beginning of each round.
-          vecInliers.resize(0);
-
           const double* pModel = matModels.constRowBegin(iModel);
-          double dFittingThreshold = fittingThreshold(pModel);
-          // Match all points against the current model
-          for (int iPoint = 0; iPoint < iSamples; ++iPoint)
+          const double dFittingThreshold = fittingThreshold(pModel);
+
+          // Preemptive T(d,d) test: all randomly selected samples
+          // must be inliers.
+          bool bRejected = false;
+          for (int i=0; i<iTestSize; ++i)
             {
+              int iPoint = bGlobalRandom ? std::rand() % iSamples : random.next(iSamples);
+              if (!(fitToModel(iPoint, pModel) < dFittingThreshold))
+                {
+                  bRejected = true;
+                  break;
+                }
+            }
+          if (bRejected)
+            continue;
+
+          // Match all points against the current model, one block at
+          // a time. Stop once the model cannot beat the best one.
+          int iInlierCount = 0;
+          for (int iStart = 0; iStart < iSamples; iStart += iFitBlockSize)
+            {
+              const int iCount = qMin(iFitBlockSize, iSamples - iStart);
+              fitRangeToModel(iStart, iCount, pModel, adFits);
               // Store points that match to the model with an error
               // less than the threshold.
-              if (fitToModel(iPoint, pModel) < dFittingThreshold)
-                vecInliers << iPoint;
+              for (int i=0; i<iCount; ++i)
+                {
+                  piInliers[iInlierCount] = iStart + i;
+                  iInlierCount += adFits[i] < dFittingThreshold ? 1 : 0;
+                }
+              if (iInlierCount + iSamples - iStart - iCount <= d->iBestInlierCount.load())
+                {
+                  bRejected = true;
+                  break;
+                }
             }
+          if (bRejected)
+            continue;
 
           // If the number of inliers is the best so far, store the
           // score.
-          const int iInlierCount = vecInliers.size();
+          QMutexLocker lock(&d->bestModelMutex);
           if (iInlierCount > d->vecBestInliers.size())
             {
               //piiDebug("Inliers: %d", iInlierCount);
               if (iInlierCount > minInliers(pModel))
                 {
-                  d->vecBestInliers = vecInliers;
+                  d->vecBestInliers = vecInliers.mid(0, iInlierCount);
                   d->matBestModel = matModels(iModel, 0, 1, -1);
+                  d->iBestInlierCount = iInlierCount;
                 }
 
-              // The fraction of inliers
+              // The fraction of inliers. A good model needs to pass
+              // the preemptive test in addition to being selected.
               double dInlierFraction = double(iInlierCount) / iSamples;
               if (dInlierFraction != 1.0)
-                iRequiredIterations = Pii::round<int>(dLogProp /
-                                                      Pii::log(1.0 - Pii::pow(dInlierFraction, iMinSamples)));
+                {
+                  // With a low inlier fraction, the estimate may be
+                  // infinite or exceed the range of int.
+                  double dIterations = dLogProp / Pii::log(1.0 - Pii::pow(dInlierFraction, iMinSamples + iTestSize));
+                  d->iRequiredIterations = dIterations < d->iMaxIterations ?
+                    Pii::round<int>(dIterations) : d->iMaxIterations;
+                }
               else
-                iRequiredIterations = 0;
+                d->iRequiredIterations = 0;
             }
         }
-      ++iIterations;
     }
+}
 
-  return !d->matBestModel.isEmpty();
+void PiiRansac::fitRangeToModel(int firstIndex, int count, const double* model, double* fits)
+{
+  for (int i=0; i<count; ++i)
+    fits[i] = fitToModel(firstIndex + i, model);
 }
 
 PiiMatrix<double> PiiRansac::bestModel() const { return d->matBestModel; }
@@ -158,3 +294,7 @@ double PiiRansac::fittingThreshold() const { return d->dFittingThreshold; }
 double PiiRansac::fittingThreshold(const double*) const { return d->dFittingThreshold; }
 void PiiRansac::setSelectionProbability(double selectionProbability) { d->dSelectionProbability = selectionProbability; }
 double PiiRansac::selectionProbability() const { return d->dSelectionProbability; }
+void PiiRansac::setThreadCount(int threadCount) { d->iThreadCount = threadCount; }
+int PiiRansac::threadCount() const { return d->iThreadCount; }
+void PiiRansac::setPreemptiveTestSize(int preemptiveTestSize) { d->iPreemptiveTestSize = qMax(0, preemptiveTestSize); }
+int PiiRansac::preemptiveTestSize() const { return d->iPreemptiveTestSize; }
@@ -18,7 +18,9 @@
 
 #include "PiiOptimizationGlobal.h"
 #include <QVector>
+#include <QMutex>
 #include <PiiMatrix.h>
+#include <PiiAtomicInt.h>
 
 /**
  * A generic implementation of the Randomized Sample Consensus
@@ -42,6 +44,29 @@
  * by N `doubles`. Therefore, models are represented as row matrices
  * with N columns.
  *
+ * Parallel and preemptive evaluation
+ * ----------------------------------
+ *
+ * By default, hypotheses are generated and scored sequentially in the
+ * calling thread. If [threadCount()] is set to a value other than
+ * one, hypotheses are generated and scored in many threads at once.
+ * Each thread draws its samples from an independent random number
+ * stream, and all threads share the best model found so far and the
+ * adaptively estimated number of required iterations. In parallel
+ * mode, [findPossibleModels()], [fitToModel()], [fitRangeToModel()],
+ * [minInliers(const double*) const] and [fittingThreshold(const
+ * double*) const] will be called concurrently and must not modify
+ * shared state.
+ *
+ * Scoring a model is always aborted as soon as the remaining samples
+ * cannot make it better than the best model found so far. This does
+ * not change the result. In addition, a preemptive T(d,d) test can be
+ * enabled with [setPreemptiveTestSize()]: each model is first tested
+ * against d randomly selected samples, and is rejected without
+ * scoring the rest unless all of them are inliers. This makes
+ * evaluation of bad models very cheap, at the cost of occasionally
+ * rejecting a good one. The number of iterations is adjusted to
+ * compensate for that.
  */
 class PII_OPTIMIZATION_EXPORT PiiRansac
 {
@@ -144,6 +169,32 @@ public:
    */
   double selectionProbability() const;
 
+  /**
+   * Sets the number of threads used in finding the best model. One
+   * means sequential processing in the calling thread. Zero means
+   * the number of processor cores. The default value is one.
+   */
+  void setThreadCount(int threadCount);
+  /**
+   * Returns the number of threads.
+   */
+  int threadCount() const;
+
+  /**
+   * Sets the number of randomly selected samples each model
+   * candidate is tested against before scoring it against all
+   * samples (the d in the T(d,d) test). A candidate is rejected right
+   * away if any of the preliminary samples is an outlier. Zero
+   * disables the preemptive test. With lots of samples and outliers,
+   * a value of one or two usually speeds up the search
+   * substantially. The default value is zero.
+   */
+  void setPreemptiveTestSize(int preemptiveTestSize);
+  /**
+   * Returns the size of the preemptive test.
+   */
+  int preemptiveTestSize() const;
+
 protected:
   /// @internal
   class PII_OPTIMIZATION_EXPORT Data
@@ -157,8 +208,15 @@ protected:
     int iMinInliers;
     double dFittingThreshold;
     double dSelectionProbability;
+    int iThreadCount;
+    int iPreemptiveTestSize;
     QVector<int> vecBestInliers;
     PiiMatrix<double> matBestModel;
+
+    // Shared state of a findBestModel() call
+    QMutex bestModelMutex;
+    PiiAtomicInt iIterations, iRequiredIterations, iBestInlierCount;
+    PiiAtomicInt iFailed;
   } *d;
 
   /// @internal
@@ -231,6 +289,16 @@ protected:
    */
   virtual double fitToModel(int dataIndex, const double* model) = 0;
 
+  /**
+   * Fits *count* successive samples starting at *firstIndex* to the
+   * given *model* and stores the fits to *fits*. The result must be
+   * equal to calling [fitToModel()] for each index separately, which
+   * is what the default implementation does. Subclasses should
+   * override this function with a tight loop over their sample data
+   * the compiler can vectorize.
+   */
+  virtual void fitRangeToModel(int firstIndex, int count, const double* model, double* fits);
+
   /**
    * Returns the minimum number of inliers required to match the given
    * *model*. Subclasses may override this function to return a
@@ -247,6 +315,11 @@ protected:
    */
   virtual double fittingThreshold(const double* model) const;
 
+private:
+  class Worker;
+  friend class Worker;
+  void runWorker(quint64 seed);
+
   PII_DISABLE_COPY(PiiRansac);
 };
 
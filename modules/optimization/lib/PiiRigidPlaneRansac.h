@@ -218,6 +218,12 @@ protected:
    */
   double fitToModel(int dataIndex, const double* model);
 
+  /**
+   * Calculates the fit of *count* successive point pairs at once.
+   * The rotation matrix is calculated only once for all points.
+   */
+  void fitRangeToModel(int firstIndex, int count, const double* model, double* fits);
+
 private:
   class Data :
     public PiiRansac::Data,
@@ -337,12 +343,13 @@ template <class T> int PiiRigidPlaneRansac<T>::minSamples() const
 
 template <class T> PiiMatrix<double> PiiRigidPlaneRansac<T>::findPossibleModels(const int* dataIndices)
 {
-  PII_D;
+  const PII_D;
+  const PiiMatrix<T>& matPoints1 = d->matPoints1, &matPoints2 = d->matPoints2;
   // The selected pair of points in the first point set, and the
   // vector between them.
   PiiVector<T,2>
-    pt11 = d->matPoints1.template rowAs<PiiVector<T,2> >(dataIndices[0]),
-    pt12 = d->matPoints1.template rowAs<PiiVector<T,2> >(dataIndices[1]),
+    pt11 = matPoints1.template rowAs<PiiVector<T,2> >(dataIndices[0]),
+    pt12 = matPoints1.template rowAs<PiiVector<T,2> >(dataIndices[1]),
     vec1 = pt12 - pt11;
   double dLength1 = vec1.length();
   // Degenerate case
@@ -351,8 +358,8 @@ template <class T> PiiMatrix<double> PiiRigidPlaneRansac<T>::findPossibleModels(
 
   // Same for the second point set
   PiiVector<T,2>
-    pt21 = d->matPoints2.template rowAs<PiiVector<T,2> >(dataIndices[0]),
-    pt22 = d->matPoints2.template rowAs<PiiVector<T,2> >(dataIndices[1]),
+    pt21 = matPoints2.template rowAs<PiiVector<T,2> >(dataIndices[0]),
+    pt22 = matPoints2.template rowAs<PiiVector<T,2> >(dataIndices[1]),
     vec2 = pt22 - pt21;
   double dLength2 = vec2.length();
   if (dLength2 == 0)
@@ -405,13 +412,29 @@ template <class T> PiiMatrix<double> PiiRigidPlaneRansac<T>::toTransformMatrix(c
 
 template <class T> double PiiRigidPlaneRansac<T>::fitToModel(int dataIndex, const double* model)
 {
-  PII_D;
+  const PII_D;
   PiiVector<double,2> ptTransformed = transform(d->matPoints1[dataIndex], model);
   return Pii::squaredDistanceN(ptTransformed.begin(), 2,
                                d->matPoints2[dataIndex],
                                0.0);
 }
 
+template <class T> void PiiRigidPlaneRansac<T>::fitRangeToModel(int firstIndex, int count,
+                                                                const double* model, double* fits)
+{
+  const PII_D;
+  const double dCos = model[0] * Pii::cos(model[1]), dSin = model[0] * Pii::sin(model[1]);
+  const double dTx = model[2], dTy = model[3];
+  for (int i=0; i<count; ++i)
+    {
+      const T* pPoint1 = d->matPoints1[firstIndex + i];
+      const T* pPoint2 = d->matPoints2[firstIndex + i];
+      double dX = dCos * pPoint1[0] - dSin * pPoint1[1] + dTx - double(pPoint2[0]);
+      double dY = dSin * pPoint1[0] + dCos * pPoint1[1] + dTy - double(pPoint2[1]);
+      fits[i] = dX * dX + dY * dY;
+    }
+}
+
 template <class T> PiiMatrix<double> PiiRigidPlaneRansac<T>::transform(const PiiMatrix<T>& points, const double* model)
 {
   PiiMatrix<double> matResult(points.rows(), 2);
@@ -17,12 +17,77 @@
 #include <PiiUtil.h>
 #include <PiiYdinTypes.h>
 #include <PiiMath.h>
+#include <PiiParallel.h>
 
 #define LENGTH_LIMIT (1<<24)
 
+namespace
+{
+  // Counts a band of rows into a histogram of its own. Indices are
+  // folded a row at a time so that each input matrix is read
+  // sequentially.
+  struct MultiVariableHistogramBand
+  {
+    MultiVariableHistogramBand(const QList<PiiMatrix<int> >& matrices,
+                               const QVector<int>& levels, const QVector<int>& steps,
+                               bool joint, int* firstHistogram, int* otherHistograms) :
+      matrices(matrices), levels(levels), steps(steps), bJoint(joint),
+      pFirstHistogram(firstHistogram), pOtherHistograms(otherHistograms)
+    {}
+
+    void operator() (int firstRow, int lastRow, int band) const
+    {
+      const int iColumns = matrices[0].columns();
+      int* pHistogram = band == 0 ? pFirstHistogram : pOtherHistograms + (band-1) * steps.last();
+      QVector<int> vecIndices(iColumns);
+      int* pIndices = vecIndices.data();
+      for (int r=firstRow; r<lastRow; ++r)
+        {
+          if (bJoint)
+            {
+              // Fold multi-dimensional values into one dimension. All
+              // pixels need to be checked to prevent over/underflows.
+              const int* pRow = matrices[0][r];
+              const int iMaxValue = levels[0]-1;
+              for (int c=0; c<iColumns; ++c)
+                pIndices[c] = qBound(0, pRow[c], iMaxValue);
+              for (int k=1; k<matrices.size(); ++k)
+                {
+                  pRow = matrices[k][r];
+                  const int iMaxValue = levels[k]-1, iStep = steps[k-1];
+                  for (int c=0; c<iColumns; ++c)
+                    pIndices[c] += iStep * qBound(0, pRow[c], iMaxValue);
+                }
+              for (int c=0; c<iColumns; ++c)
+                ++pHistogram[pIndices[c]];
+            }
+          else
+            {
+              int* pMarginal = pHistogram;
+              for (int k=0; k<matrices.size(); ++k)
+                {
+                  const int* pRow = matrices[k][r];
+                  const int iMaxValue = levels[k]-1;
+                  for (int c=0; c<iColumns; ++c)
+                    ++pMarginal[qBound(0, pRow[c], iMaxValue)];
+                  pMarginal += levels[k];
+                }
+            }
+        }
+    }
+
+    const QList<PiiMatrix<int> >& matrices;
+    const QVector<int>& levels;
+    const QVector<int>& steps;
+    bool bJoint;
+    int* pFirstHistogram, *pOtherHistograms;
+  };
+}
+
 PiiMultiVariableHistogram::Data::Data() :
   distributionType(JointDistribution),
-  bNormalized(false)
+  bNormalized(false),
+  iHistogramThreadCount(1)
 {
 }
 
@@ -168,10 +233,10 @@ void PiiMultiVariableHistogram::process()
                   PII_THROW_UNKNOWN_TYPE(inputAt(i));
                 }
             }
-          if (i > 0 && (matrix.rows() != iRows || matrix.columns() != iColumns))
-            PII_THROW_WRONG_SIZE(inputAt(i), matrix, iRows, iColumns);
           lstMatrices << matrix;
         }
+      if (i > 0 && (lstMatrices[i].rows() != iRows || lstMatrices[i].columns() != iColumns))
+        PII_THROW_WRONG_SIZE(inputAt(i), lstMatrices[i], iRows, iColumns);
 
       if (i == 0)
         {
@@ -180,12 +245,23 @@ void PiiMultiVariableHistogram::process()
         }
     }
 
-  // Allocate size for the histogram
+  // Allocate size for the histogram. Additional threads count into
+  // histograms of their own.
   PiiMatrix<int> matResult(1, d->vecSteps.last());
-  if (d->distributionType == JointDistribution)
-    jointHistogram(lstMatrices, iRows, iColumns, &matResult);
-  else
-    marginalHistograms(lstMatrices, iRows, iColumns, &matResult);
+  const int iMinBandRows = Pii::reductionMinBandRows(iColumns * lstMatrices.size());
+  const int iBands = Pii::parallelBandCount(iRows, d->iHistogramThreadCount, iMinBandRows);
+  QVector<int> vecOtherHistograms(qMax(iBands-1, 0) * d->vecSteps.last());
+  MultiVariableHistogramBand band(lstMatrices, d->vecLevels, d->vecSteps,
+                                  d->distributionType == JointDistribution,
+                                  matResult[0], vecOtherHistograms.data());
+  Pii::parallelFor(iRows, band, d->iHistogramThreadCount, iMinBandRows);
+  int* pResult = matResult[0];
+  for (int b=1; b<iBands; ++b)
+    {
+      const int* pOther = vecOtherHistograms.constData() + (b-1) * d->vecSteps.last();
+      for (int i=0; i<d->vecSteps.last(); ++i)
+        pResult[i] += pOther[i];
+    }
 
   if (d->bNormalized)
     d->pHistogramOutput->emitObject(Pii::matrix(matResult.mapped(std::bind2nd(std::multiplies<double>(),
@@ -194,50 +270,7 @@ void PiiMultiVariableHistogram::process()
     d->pHistogramOutput->emitObject(matResult);
 }
 
-void PiiMultiVariableHistogram::jointHistogram(const QList<PiiMatrix<int> >& matrices,
-                                               int rows, int columns,
-                                               PiiMatrix<int>* result)
-{
-  PII_D;
-
-  const int iDimensions = matrices.size();
-  for (int r=0; r<rows; ++r)
-    {
-      for (int c=0; c<columns; ++c)
-        {
-          // Fold multi-dimensional values into one dimension. Index 0
-          // is treated separately to save an unnecessary
-          // multiplication by one. All pixels need to be checked to
-          // prevent over/underflows.
-          int index = qBound(0, const_cast<const PiiMatrix<int>&>(matrices[0])(r, c), d->vecLevels[0]-1);
-          for (int k=1; k<iDimensions; ++k)
-            index += d->vecSteps[k-1] * qBound(0, const_cast<const PiiMatrix<int>&>(matrices[k])(r, c), d->vecLevels[k]-1);
-
-          // Increase histogram at the folded index
-          ++(*result)(0, index);
-        }
-    }
-}
-
-void PiiMultiVariableHistogram::marginalHistograms(const QList<PiiMatrix<int> >& matrices,
-                                                   int rows, int columns,
-                                                   PiiMatrix<int>* result)
-{
-  PII_D;
-
-  int* pHistogram = result->row(0);
-  for (int k=0; k<matrices.size(); ++k)
-    {
-      int iMaxValue = d->vecLevels[k]-1;
-      for (int r=0; r<rows; ++r)
-        {
-          const int* pRow = const_cast<const PiiMatrix<int>&>(matrices[k])[r];
-          for (int c=0; c<columns; ++c)
-            ++pHistogram[qBound(0, pRow[c], iMaxValue)];
-        }
-      pHistogram += d->vecLevels[k];
-    }
-}
-
 void PiiMultiVariableHistogram::setNormalized(bool normalize) { _d()->bNormalized = normalize; }
 bool PiiMultiVariableHistogram::normalized() const { return _d()->bNormalized; }
+void PiiMultiVariableHistogram::setHistogramThreadCount(int histogramThreadCount) { _d()->iHistogramThreadCount = qMax(0, histogramThreadCount); }
+int PiiMultiVariableHistogram::histogramThreadCount() const { return _d()->iHistogramThreadCount; }
@@ -112,6 +112,14 @@ class PiiMultiVariableHistogram : public PiiDefaultOperation
    */
   Q_PROPERTY(bool normalized READ normalized WRITE setNormalized);
 
+  /**
+   * The number of threads used in building the histogram. Zero means
+   * the number of processor cores. Each thread counts into a
+   * histogram of its own, so a large number of threads is not
+   * suggested with long joint distributions. The default is one.
+   */
+  Q_PROPERTY(int histogramThreadCount READ histogramThreadCount WRITE setHistogramThreadCount);
+
   PII_OPERATION_SERIALIZATION_FUNCTION
 public:
   /**
@@ -141,6 +149,8 @@ public:
 
   void setNormalized(bool normalize);
   bool normalized() const;
+  void setHistogramThreadCount(int histogramThreadCount);
+  int histogramThreadCount() const;
 
 protected:
   void process();
@@ -150,8 +160,6 @@ private:
   inline void throwTooLong() { PII_THROW(PiiExecutionException, tr("The resulting histogram would be too long. Please reduce levels.")); }
   template <class T> inline PiiMatrix<int> scale(const PiiVariant& obj, double factor);
   void setInputCount(int cnt);
-  void jointHistogram(const QList<PiiMatrix<int> >& matrices, int rows, int columns, PiiMatrix<int>* result);
-  void marginalHistograms(const QList<PiiMatrix<int> >& matrices, int rows, int columns, PiiMatrix<int>* result);
 
   /// @internal
   class Data : public PiiDefaultOperation::Data
@@ -165,6 +173,7 @@ private:
     PiiOutputSocket* pHistogramOutput;
     DistributionType distributionType;
     bool bNormalized;
+    int iHistogramThreadCount;
   };
   PII_D_FUNC;
 };
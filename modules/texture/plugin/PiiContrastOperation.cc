@@ -16,11 +16,12 @@
 
 #include "PiiContrastOperation.h"
 #include <PiiYdinTypes.h>
-#include <PiiMath.h>
+#include <PiiLocalStatistics.h>
 
 PiiContrastOperation::Data::Data() :
   type(MaxDiff),
-  iRadius(1)
+  iRadius(1),
+  iContrastThreadCount(1)
 {
 }
 
@@ -59,47 +60,24 @@ template <class T> void PiiContrastOperation::contrast(const PiiVariant& obj)
   if (image.rows() <= doubleMargin || image.columns() <= doubleMargin)
     PII_THROW(PiiExecutionException, tr("Input image is too small"));
 
+  // Both statistics are calculated over the whole image, and the
+  // borders where the window does not fit are cut away.
+  const int iRows = image.rows()-doubleMargin, iColumns = image.columns()-doubleMargin;
   switch (d->type)
     {
     case MaxDiff:
       {
-        PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(image.rows()-doubleMargin, image.columns()-doubleMargin));
-        for (int r=margin; r<image.rows()-margin; r++)
-          {
-            const T* centerRow = image.row(r);
-            T* resultRow = matResult.row(r-margin);
-            for (int c=margin; c<image.columns()-margin; c++)
-              {
-                T center = centerRow[c];
-                T maxDiff = 0;
-                for (int neighborY=r-margin; neighborY<r+margin; neighborY++)
-                  {
-                    const T* neighborRow = image.row(neighborY);
-                    for (int neighborX=c-margin; neighborX<c+margin; neighborX++)
-                      {
-                        T neighbor = neighborRow[neighborX];
-                        T diff = Pii::abs(neighbor - center);
-                        if (diff > maxDiff)
-                          maxDiff = diff;
-                      }
-                  }
-                resultRow[c-margin] = maxDiff;
-              }
-          }
-        d->pImageOutput->emitObject(matResult);
+        PiiMatrix<T> matContrast(PiiImage::localContrast(image, windowSize, windowSize,
+                                                         d->iContrastThreadCount));
+        d->pImageOutput->emitObject(PiiMatrix<T>(matContrast(margin, margin, iRows, iColumns)));
       }
       break;
     case LocalVar:
       {
-        PiiMatrix<float> matResult(PiiMatrix<float>::uninitialized(image.rows()-doubleMargin,
-                                                                   image.columns()-doubleMargin));
-        for (int r=matResult.rows(); r--; )
-          {
-            float *resultRow = matResult.row(r);
-            for (int c=matResult.columns(); c--; )
-              resultRow[c] = Pii::var<float,PiiMatrix<T> >(image(r,c, windowSize, windowSize));
-          }
-        d->pImageOutput->emitObject(matResult);
+        PiiLocalStatistics<T> stats(image, true, d->iContrastThreadCount);
+        PiiMatrix<float> matVariance(stats.template varianceImage<float>(windowSize, windowSize,
+                                                                         d->iContrastThreadCount));
+        d->pImageOutput->emitObject(PiiMatrix<float>(matVariance(margin, margin, iRows, iColumns)));
       }
       break;
     }
@@ -109,3 +87,5 @@ PiiContrastOperation::ContrastType PiiContrastOperation::type() const { return _
 void PiiContrastOperation::setType(ContrastType type) { _d()->type = type; }
 int PiiContrastOperation::radius() const { return _d()->iRadius; }
 void PiiContrastOperation::setRadius(int radius) { _d()->iRadius = radius; }
+int PiiContrastOperation::contrastThreadCount() const { return _d()->iContrastThreadCount; }
+void PiiContrastOperation::setContrastThreadCount(int contrastThreadCount) { _d()->iContrastThreadCount = contrastThreadCount; }
@@ -49,6 +49,11 @@ class PiiContrastOperation : public PiiDefaultOperation
    * the center.
    */
   Q_PROPERTY(int radius READ radius WRITE setRadius);
+  /**
+   * The number of threads used in calculating the contrast. Zero
+   * means the number of processor cores. The default is 1.
+   */
+  Q_PROPERTY(int contrastThreadCount READ contrastThreadCount WRITE setContrastThreadCount);
 
   PII_OPERATION_SERIALIZATION_FUNCTION;
 public:
@@ -57,10 +62,12 @@ public:
    * Contrast calculation modes.
    *
    * - `MaxDiff` - maximum absolute difference between the center and
-   * a neighbor. The output is of the same type as the input.
+   * a neighbor. The output is of the same type as the input. See
+   * PiiImage::localContrast().
    *
    * - `LocalVar` - contrast calculated as the variance of gray
    * levels in a local neighborhood. The output is PiiMatrix<float>.
+   * See PiiLocalStatistics.
    */
   enum ContrastType { MaxDiff, LocalVar };
 
@@ -71,6 +78,8 @@ protected:
   void setType(ContrastType type);
   int radius() const;
   void setRadius(int radius);
+  int contrastThreadCount() const;
+  void setContrastThreadCount(int contrastThreadCount);
 
 private:
   template <class T> void contrast(const PiiVariant& obj);
@@ -82,6 +91,7 @@ private:
     Data();
     ContrastType type;
     int iRadius;
+    int iContrastThreadCount;
     PiiInputSocket* pImageInput;
     PiiOutputSocket* pImageOutput;
   };
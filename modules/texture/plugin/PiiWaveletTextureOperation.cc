@@ -22,7 +22,8 @@ PiiWaveletTextureOperation::Data::Data() :
   iFeaturesPerLevel(3),
   iNorm(1),
   waveletFamily(PiiDsp::Daubechies),
-  iWaveletIndex(2)
+  iWaveletIndex(2),
+  bLiftingScheme(false)
 {
 }
 
@@ -50,6 +51,9 @@ QString PiiWaveletTextureOperation::wavelet() const
     case PiiDsp::Daubechies:
       name = "Daubechies" + QString::number(d->iWaveletIndex);
       break;
+    case PiiDsp::Biorthogonal:
+      name = "Biorthogonal" + QString::number(d->iWaveletIndex);
+      break;
     }
   return name;
 }
@@ -66,6 +70,14 @@ void PiiWaveletTextureOperation::setWavelet(const QString& name)
       d->waveletFamily = PiiDsp::Daubechies;
       d->iWaveletIndex = number;
     }
+  else if (name.startsWith("Biorthogonal"))
+    {
+      int number = name.mid(12).toInt();
+      if (number < 1 || number > 2)
+        number = 2;
+      d->waveletFamily = PiiDsp::Biorthogonal;
+      d->iWaveletIndex = number;
+    }
   else //if (name == "Haar")
     {
       d->waveletFamily = PiiDsp::Haar;
@@ -102,6 +114,13 @@ template <class T> void PiiWaveletTextureOperation::waveletNormFloat(const PiiVa
 template <class T> void PiiWaveletTextureOperation::waveletNorm(const PiiMatrix<T>& mat)
 {
   PII_D;
+  if (d->waveletFamily == PiiDsp::Biorthogonal ||
+      (d->bLiftingScheme && PiiDsp::hasLiftingScheme(d->waveletFamily, d->iWaveletIndex)))
+    {
+      liftingWaveletNorm(mat);
+      return;
+    }
+
   PiiMatrix<float> result(1, d->iLevels * d->iFeaturesPerLevel + 1);
   // Perform a N-level wavelet decomposition
   QList<PiiMatrix<T> > decomposition;
@@ -110,20 +129,7 @@ template <class T> void PiiWaveletTextureOperation::waveletNorm(const PiiMatrix<
   for (int i=d->iLevels; i--; )
     {
       decomposition = PiiDsp::dwt(decomposition[0], d->waveletFamily, d->iWaveletIndex);
-      switch (d->iFeaturesPerLevel)
-        {
-        case 1: // rotation invariant
-          result(0,index++) = Pii::norm(PiiMatrix<T>(decomposition[1] + decomposition[2]), d->iNorm);
-          break;
-        case 4: // all decomposition results taken
-          result(0,index++) = Pii::norm(decomposition[0], d->iNorm);
-        case 3: // all but approximation
-          result(0,index++) = Pii::norm(decomposition[3], d->iNorm);
-        case 2: // only horizontal and vertical details
-          result(0,index++) = Pii::norm(decomposition[1], d->iNorm);
-          result(0,index++) = Pii::norm(decomposition[2], d->iNorm);
-          break;
-        }
+      storeFeatures(decomposition, result[0], index);
     }
 
   // Last level approximation is always included (except for the case
@@ -134,9 +140,66 @@ template <class T> void PiiWaveletTextureOperation::waveletNorm(const PiiMatrix<
   d->pFeatureOutput->emitObject(result);
 }
 
+template <class T> void PiiWaveletTextureOperation::liftingWaveletNorm(const PiiMatrix<T>& mat)
+{
+  PII_D;
+  PiiMatrix<float> result(1, d->iLevels * d->iFeaturesPerLevel + 1);
+  PiiMatrix<T> matBuffer(mat);
+  int index = 0;
+  if (d->iFeaturesPerLevel == 4)
+    {
+      // The approximation of each level is overwritten by the next
+      // one. Decompose one level at a time to catch it.
+      for (int iLevel=1; iLevel<=d->iLevels; ++iLevel)
+        {
+          PiiDsp::liftingDwt(matBuffer, d->waveletFamily, d->iWaveletIndex, iLevel, 1, iLevel);
+          storeFeatures(PiiDsp::dwtSubbands(matBuffer, iLevel), result[0], index);
+        }
+    }
+  else
+    {
+      // Details stay in place. Decompose all levels at once.
+      PiiDsp::liftingDwt(matBuffer, d->waveletFamily, d->iWaveletIndex, d->iLevels);
+      for (int iLevel=1; iLevel<=d->iLevels; ++iLevel)
+        storeFeatures(PiiDsp::dwtSubbands(matBuffer, iLevel), result[0], index);
+      result(0,index) = Pii::norm(PiiDsp::dwtSubbands(matBuffer, d->iLevels)[0], d->iNorm);
+    }
+
+  d->pFeatureOutput->emitObject(result);
+}
+
+template <class T> void PiiWaveletTextureOperation::storeFeatures(const QList<PiiMatrix<T> >& decomposition,
+                                                                  float* features, int& index)
+{
+  PII_D;
+  switch (d->iFeaturesPerLevel)
+    {
+    case 1: // rotation invariant
+      {
+        // With lifting, the detail subbands of odd-sized images differ
+        // in size by one row or column.
+        const int iRows = qMin(decomposition[1].rows(), decomposition[2].rows());
+        const int iColumns = qMin(decomposition[1].columns(), decomposition[2].columns());
+        features[index++] = Pii::norm(PiiMatrix<T>(decomposition[1](0, 0, iRows, iColumns) +
+                                                   decomposition[2](0, 0, iRows, iColumns)), d->iNorm);
+      }
+      break;
+    case 4: // all decomposition results taken
+      features[index++] = Pii::norm(decomposition[0], d->iNorm);
+    case 3: // all but approximation
+      features[index++] = Pii::norm(decomposition[3], d->iNorm);
+    case 2: // only horizontal and vertical details
+      features[index++] = Pii::norm(decomposition[1], d->iNorm);
+      features[index++] = Pii::norm(decomposition[2], d->iNorm);
+      break;
+    }
+}
+
 int PiiWaveletTextureOperation::levels() const { return _d()->iLevels; }
 void PiiWaveletTextureOperation::setLevels(int levels) { _d()->iLevels = levels; }
 int PiiWaveletTextureOperation::featuresPerLevel() const { return _d()->iFeaturesPerLevel; }
 void PiiWaveletTextureOperation::setFeaturesPerLevel(int features) { _d()->iFeaturesPerLevel = features; }
 int PiiWaveletTextureOperation::norm() const { return _d()->iNorm; }
 void PiiWaveletTextureOperation::setNorm(int norm) { _d()->iNorm = norm; }
+bool PiiWaveletTextureOperation::liftingScheme() const { return _d()->bLiftingScheme; }
+void PiiWaveletTextureOperation::setLiftingScheme(bool liftingScheme) { _d()->bLiftingScheme = liftingScheme; }
@@ -75,10 +75,21 @@ class PiiWaveletTextureOperation : public PiiDefaultOperation
    */
   Q_PROPERTY(int norm READ norm WRITE setNorm);
   /**
-   * The name of the wavelet to use. Known values are "Haar" and
-   * "Daubechies1" ... "Daubechies10". The default is "Daubechies2".
+   * The name of the wavelet to use. Known values are "Haar",
+   * "Daubechies1" ... "Daubechies10", "Biorthogonal1" (CDF 5/3) and
+   * "Biorthogonal2" (CDF 9/7). The default is "Daubechies2".
    */
   Q_PROPERTY(QString wavelet READ wavelet WRITE setWavelet);
+  /**
+   * Calculate the decomposition in place with the lifting scheme
+   * (see PiiDsp::liftingDwt()) if the selected wavelet supports it.
+   * This is much faster than convolution and transforms all levels
+   * in a single buffer, but the features are not
+   * compatible with those calculated by convolution because borders
+   * are handled differently. The biorthogonal wavelets are always
+   * calculated with lifting. The default is `false`.
+   */
+  Q_PROPERTY(bool liftingScheme READ liftingScheme WRITE setLiftingScheme);
 
   PII_OPERATION_SERIALIZATION_FUNCTION
 
@@ -97,6 +108,9 @@ public:
   int norm() const;
   void setNorm(int norm);
 
+  bool liftingScheme() const;
+  void setLiftingScheme(bool liftingScheme);
+
 protected:
   void process();
 
@@ -104,6 +118,9 @@ private:
   template <class T> void waveletNormFloat(const PiiVariant& obj);
   template <class T> void waveletNormInt(const PiiVariant& obj);
   template <class T> void waveletNorm(const PiiMatrix<T>& mat);
+  template <class T> void liftingWaveletNorm(const PiiMatrix<T>& mat);
+  template <class T> void storeFeatures(const QList<PiiMatrix<T> >& decomposition,
+                                        float* features, int& index);
 
   /// @internal
   class Data : public PiiDefaultOperation::Data
@@ -113,6 +130,7 @@ private:
     int iLevels, iFeaturesPerLevel, iNorm;
     PiiDsp::WaveletFamily waveletFamily;
     int iWaveletIndex;
+    bool bLiftingScheme;
 
     PiiInputSocket *pImageInput;
     PiiOutputSocket *pFeatureOutput;
@@ -23,6 +23,8 @@ PiiVideoFileReader::Data::Data() :
   pFileNameInput(0),
   iFrameStep(1),
   iVideoIndex(0),
+  iDecoderThreadCount(1),
+  iFrameQueueSize(0),
   bFileNameConnected(false),
   bTriggered(false)
 {}
@@ -35,6 +37,9 @@ PiiVideoFileReader::PiiVideoFileReader() :
 
   addSocket(d->pFileNameInput = new PiiInputSocket("filename"));
   d->pFileNameInput->setOptional(true);
+
+  setProtectionLevel("decoderThreadCount", WriteWhenStoppedOrPaused);
+  setProtectionLevel("frameQueueSize", WriteWhenStoppedOrPaused);
 }
 
 PiiVideoFileReader::~PiiVideoFileReader()
@@ -56,8 +61,12 @@ void PiiVideoFileReader::check(bool reset)
   if (d->strFileName.isEmpty() && !d->bFileNameConnected)
     PII_THROW(PiiExecutionException, tr("Video source cannot start because filename is empty."));
 
-  if (!d->bFileNameConnected && (d->pVideoReader->fileName() != d->strFileName || reset))
+  if (!d->bFileNameConnected &&
+      (d->pVideoReader->fileName() != d->strFileName ||
+       d->pVideoReader->decoderThreadCount() != d->iDecoderThreadCount ||
+       reset))
     initializeVideoReader(d->strFileName);
+  d->pVideoReader->setQueueSize(d->iFrameQueueSize);
 
   if (d->bTriggered && d->bFileNameConnected)
     PII_THROW(PiiExecutionException, tr("Both trigger and filename cannot be connected."));
@@ -67,6 +76,7 @@ void PiiVideoFileReader::initializeVideoReader(const QString& fileName)
 {
   PII_D;
   d->pVideoReader->setFileName(fileName);
+  d->pVideoReader->setDecoderThreadCount(d->iDecoderThreadCount);
   try
     {
       d->pVideoReader->initialize();
@@ -174,3 +184,7 @@ int PiiVideoFileReader::repeatCount() const { return _d()->iRepeatCount; }
 void PiiVideoFileReader::setRepeatCount(int cnt) { _d()->iRepeatCount = cnt; }
 void PiiVideoFileReader::setFrameStep(int frameStep) { _d()->iFrameStep = frameStep; }
 int PiiVideoFileReader::frameStep() const { return _d()->iFrameStep; }
+void PiiVideoFileReader::setDecoderThreadCount(int decoderThreadCount) { _d()->iDecoderThreadCount = decoderThreadCount; }
+int PiiVideoFileReader::decoderThreadCount() const { return _d()->iDecoderThreadCount; }
+void PiiVideoFileReader::setFrameQueueSize(int frameQueueSize) { _d()->iFrameQueueSize = frameQueueSize; }
+int PiiVideoFileReader::frameQueueSize() const { return _d()->iFrameQueueSize; }
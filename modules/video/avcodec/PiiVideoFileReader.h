@@ -57,6 +57,23 @@ class PII_VIDEO_EXPORT PiiVideoFileReader : public PiiImageReaderOperation
    */
   Q_PROPERTY(int frameStep READ frameStep WRITE setFrameStep);
 
+  /**
+   * The number of threads used for decoding the video. Zero means the
+   * number of processor cores. The default value is one. See
+   * PiiVideoReader::setDecoderThreadCount().
+   */
+  Q_PROPERTY(int decoderThreadCount READ decoderThreadCount WRITE setDecoderThreadCount);
+
+  /**
+   * The maximum number of frames decoded ahead of time in a
+   * background thread. If this value is greater than zero, reading,
+   * decoding and color conversion run in parallel with the
+   * processing pipeline. [frameStep] and seeking work the same way
+   * in both modes. The default value is zero. See
+   * PiiVideoReader::setQueueSize().
+   */
+  Q_PROPERTY(int frameQueueSize READ frameQueueSize WRITE setFrameQueueSize);
+
 
   PII_OPERATION_SERIALIZATION_FUNCTION
 
@@ -74,6 +91,12 @@ public:
   void setFrameStep(int frameStep);
   int frameStep() const;
 
+  void setDecoderThreadCount(int decoderThreadCount);
+  int decoderThreadCount() const;
+
+  void setFrameQueueSize(int frameQueueSize);
+  int frameQueueSize() const;
+
 protected:
 
   void process();
@@ -96,6 +119,7 @@ private:
     PiiVideoReader* pVideoReader;
     PiiInputSocket *pFileNameInput;
     int iFrameStep, iVideoIndex;
+    int iDecoderThreadCount, iFrameQueueSize;
     bool bFileNameConnected, bTriggered;
   };
   PII_D_FUNC;
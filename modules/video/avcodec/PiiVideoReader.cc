@@ -15,9 +15,55 @@
 
 #include "PiiVideoReader.h"
 #include <PiiFraction.h>
+#include <PiiParallel.h>
 #include "avcodec_hacks.h"
 #include <imgconvert.h>
 
+#include <QMutexLocker>
+#include <QThread>
+#include <cstring>
+
+namespace
+{
+  // Returns a matrix from the pool that nobody else uses. If there is
+  // no such matrix, a new one will be allocated and added to the pool
+  // if it is not full yet. The data of the returned matrix must be
+  // modified through const_cast to avoid detaching it from the pool.
+  template <class T> PiiMatrix<T> pooledMatrix(QList<PiiMatrix<T> >& pool, int rows, int columns, int maxSize)
+  {
+    for (int i=0; i<pool.size(); ++i)
+      {
+        if (pool[i].isShared())
+          continue;
+        if (pool[i].rows() == rows && pool[i].columns() == columns)
+          return pool[i];
+        // Frame size has changed. Get rid of the old buffer.
+        pool.removeAt(i--);
+      }
+    PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(rows, columns));
+    if (pool.size() < maxSize)
+      pool << matResult;
+    return matResult;
+  }
+
+  template <class T> inline T* mutableRow(const PiiMatrix<T>& matrix, int row)
+  {
+    return const_cast<T*>(matrix.row(row));
+  }
+}
+
+class PiiVideoReader::Decoder : public QThread
+{
+public:
+  Decoder(PiiVideoReader* reader) : _pReader(reader) {}
+
+protected:
+  void run() { _pReader->decodeFrames(); }
+
+private:
+  PiiVideoReader* _pReader;
+};
+
 PiiVideoReader::Data::Data(const QString& fileName) :
   pFormatCtx(0),
   iVideoStream(-1),
@@ -28,7 +74,20 @@ PiiVideoReader::Data::Data(const QString& fileName) :
   iLastFramePts(0),
   iTargetPts(0),
   bTargetChanged(false),
-  strFileName(fileName)
+  bFrameRead(false),
+  bResync(false),
+  bFrameThreads(false),
+  strFileName(fileName),
+  iDecoderThreadCount(1),
+  iQueueSize(0),
+  pDecoder(0),
+  bPipelineRunning(false),
+  pipelineType(GrayFrame),
+  iPipelineStep(1),
+  iConsumedPts(0),
+  iConsumedTargetPts(0),
+  bConsumedTargetChanged(false),
+  bConsumedFrameRead(false)
 {
 }
 
@@ -54,6 +113,7 @@ PiiVideoReader::PiiVideoReader(const QString& filename) :
 
 PiiVideoReader::~PiiVideoReader()
 {
+  stopPipeline();
   delete d;
 }
 
@@ -69,6 +129,10 @@ QString PiiVideoReader::fileName() const
 
 void PiiVideoReader::initialize() throw(PiiVideoException&)
 {
+  stopPipeline();
+  d->lstGrayPool.clear();
+  d->lstColorPool.clear();
+
   // Free frame.
   if (d->pFrame != 0)
     av_free(d->pFrame);
@@ -132,6 +196,20 @@ void PiiVideoReader::initialize() throw(PiiVideoException&)
   if (pCodec->capabilities & CODEC_CAP_TRUNCATED)
     d->pCodecCtx->flags |= CODEC_FLAG_TRUNCATED;
 
+  // Threading must be configured before the codec is opened.
+  const int iThreads = Pii::threadCount(d->iDecoderThreadCount);
+  d->bFrameThreads = false;
+  if (iThreads > 1)
+    {
+#ifdef FF_THREAD_FRAME
+      d->pCodecCtx->thread_count = iThreads;
+      d->pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+      d->bFrameThreads = true;
+#else
+      avcodec_thread_init(d->pCodecCtx, iThreads);
+#endif
+    }
+
   // Open codec
   if (avcodec_open(d->pCodecCtx, pCodec) < 0)
     PII_THROW(PiiVideoException, tr("Couldn't open codec."));
@@ -163,6 +241,8 @@ void PiiVideoReader::initialize() throw(PiiVideoException&)
   d->iLastFramePts = 0;
   d->iTargetPts = 0;
   d->bTargetChanged = false;
+  d->bFrameRead = false;
+  d->bResync = false;
 
   // Allocate a video frame
   d->pFrame = avcodec_alloc_frame();
@@ -185,6 +265,18 @@ bool PiiVideoReader::getFrame(AVFrame *frame, int frameStep = 1)
 
   bool bSeeked = false;
 
+  // The pipeline has read past the last frame returned to the
+  // caller. Continue right after it.
+  if (d->bResync)
+    {
+      d->bResync = false;
+      if (!d->bTargetChanged && frameStep == 1)
+        {
+          d->iTargetPts = d->bFrameRead ? d->iLastFramePts + d->iFrameTime : 0;
+          d->bTargetChanged = true;
+        }
+    }
+
   /**
    * If the target of the next frame has changed OR frameStep != 1, we
    * must to seek the stream.
@@ -203,6 +295,9 @@ bool PiiVideoReader::getFrame(AVFrame *frame, int frameStep = 1)
       // Seek the video stream to the next target
       if (av_seek_frame(d->pFormatCtx, d->iVideoStream, d->iTargetPts, frameStep < 0 ? AVSEEK_FLAG_BACKWARD : 0) < 0)
         return false;
+      // Drop frames buffered inside the decoder (frame threads, B
+      // frames) from the old position.
+      avcodec_flush_buffers(d->pCodecCtx);
 
       d->pCodecCtx->skip_frame = AVDISCARD_BIDIR;
     }
@@ -232,7 +327,13 @@ bool PiiVideoReader::getFrame(AVFrame *frame, int frameStep = 1)
               // Full video frame received. Store the presentation
               // time stamp of the packet as the last decoded frame
               // time (global stream pos).
+#ifdef FF_THREAD_FRAME
+              // With frame threads, the frame is not the one in packet.
+              d->iLastFramePts = d->bFrameThreads ? frame->pkt_pts : packet.pts;
+#else
               d->iLastFramePts = packet.pts;
+#endif
+              d->bFrameRead = true;
 
               // If we weren't seeking, return now. Otherwise continue
               // until we hit the correct position.
@@ -246,12 +347,50 @@ bool PiiVideoReader::getFrame(AVFrame *frame, int frameStep = 1)
       av_free_packet(&packet);
     }
 
+#ifdef FF_THREAD_FRAME
+  // Frame threads delay output by a few frames. Drain them at the
+  // end of the stream.
+  if (d->bFrameThreads)
+    {
+      int iFrameFinished = 0;
+      while (AVCODEC_DECODE_VIDEO(d->pCodecCtx, frame, &iFrameFinished, 0, 0) >= 0 &&
+             iFrameFinished)
+        {
+          d->iLastFramePts = frame->pkt_pts;
+          d->bFrameRead = true;
+          if (!bSeeked || d->iLastFramePts >= d->iTargetPts)
+            return true;
+        }
+    }
+#endif
+
   return false;
 }
 
 template <> PiiMatrix<unsigned char> PiiVideoReader::getFrame(int frameStep)
 {
-  bool bSuccess = getFrame(d->pFrame, frameStep);
+  if (d->iQueueSize > 0)
+    return takeFrame(GrayFrame, frameStep).matGray;
+
+  PiiMatrix<unsigned char> matResult;
+  if (getFrame(d->pFrame, frameStep))
+    convertFrame(&matResult);
+  return matResult;
+}
+
+template <> PiiMatrix<PiiColor4<> > PiiVideoReader::getFrame(int frameStep)
+{
+  if (d->iQueueSize > 0)
+    return takeFrame(ColorFrame, frameStep).matColor;
+
+  PiiMatrix<PiiColor4<> > matResult;
+  if (getFrame(d->pFrame, frameStep))
+    convertFrame(&matResult);
+  return matResult;
+}
+
+bool PiiVideoReader::convertFrame(PiiMatrix<unsigned char>* result)
+{
   /*qDebug("Frame size: %d x %d\n"
          "  Data:       %p %p %p %p\n"
          "  Linesizes:  %d %d %d %d\n"
@@ -261,72 +400,145 @@ template <> PiiMatrix<unsigned char> PiiVideoReader::getFrame(int frameStep)
          d->pFrame->linesize[0], d->pFrame->linesize[1], d->pFrame->linesize[2], d->pFrame->linesize[3],
          d->pFrame->linesize[0] - d->pCodecCtx->width);
   */
-  if (bSuccess)
+  const int iRows = d->pCodecCtx->height, iColumns = d->pCodecCtx->width;
+  // The luminance plane is the gray-level image.
+  *result = pooledMatrix(d->lstGrayPool, iRows, iColumns, d->iQueueSize + 2);
+  const uchar* pSource = static_cast<const uchar*>(d->pFrame->data[0]);
+  for (int r=0; r<iRows; ++r, pSource += d->pFrame->linesize[0])
+    std::memcpy(mutableRow(*result, r), pSource, iColumns);
+  return true;
+}
+
+bool PiiVideoReader::convertFrame(PiiMatrix<PiiColor4<> >* result)
+{
+  const int iRows = d->pCodecCtx->height, iColumns = d->pCodecCtx->width;
+  PiiMatrix<PiiColor4<> > matResult(pooledMatrix(d->lstColorPool, iRows, iColumns, d->iQueueSize + 2));
+
+  // Point the conversion target directly to matrix data.
+  AVPicture target;
+  std::memset(&target, 0, sizeof(target));
+  target.data[0] = reinterpret_cast<uint8_t*>(mutableRow(matResult, 0));
+  target.linesize[0] = int(matResult.stride());
+
+  // Convert color space (this stores the result into matResult)
+  if (IMGCONVERT(&target, PIX_FMT_RGB32, (AVPicture*)d->pFrame,
+                 d->pCodecCtx->pix_fmt, iColumns, iRows) < 0)
+    return false;
+
+  *result = matResult;
+  return true;
+}
+
+PiiVideoReader::Frame PiiVideoReader::takeFrame(FrameType type, int frameStep)
+{
+  if (d->pDecoder == 0 || type != d->pipelineType || frameStep != d->iPipelineStep)
     {
-      PiiMatrix<unsigned char> matResult(d->pCodecCtx->height,
-                                         d->pCodecCtx->width,
-                                         static_cast<unsigned char*>(d->pFrame->data[0]),
-                                         d->pFrame->linesize[0]);
-      return matResult;
+      stopPipeline();
+      startPipeline(type, frameStep);
     }
 
-  return PiiMatrix<unsigned char>();
+  QMutexLocker lock(&d->queueMutex);
+  while (d->lstFrames.isEmpty())
+    d->frameAdded.wait(&d->queueMutex);
+
+  Frame frame(d->lstFrames.first());
+  // The end-of-stream marker stays in the queue. Every subsequent
+  // call will return an empty frame until the stream is seeked.
+  if (!frame.isEmpty())
+    {
+      d->lstFrames.removeFirst();
+      d->frameTaken.wakeAll();
+      d->iConsumedPts = frame.iLastFramePts;
+      d->iConsumedTargetPts = frame.iTargetPts;
+      d->bConsumedTargetChanged = false;
+      d->bConsumedFrameRead = true;
+    }
+  return frame;
 }
 
-template <> PiiMatrix<PiiColor4<> > PiiVideoReader::getFrame(int frameStep)
+void PiiVideoReader::startPipeline(FrameType type, int frameStep)
 {
-  bool bSuccess = getFrame(d->pFrame, frameStep);
-  /*qDebug("Frame size: %d x %d\n"
-         "Data:       %p %p %p %p\n"
-         "Linesizes:  %d %d %d %d",
-         d->pCodecCtx->width, d->pCodecCtx->height,
-         d->pFrame->data[0], d->pFrame->data[1], d->pFrame->data[2], d->pFrame->data[3],
-         d->pFrame->linesize[0], d->pFrame->linesize[1],
-         d->pFrame->linesize[2], d->pFrame->linesize[3]);
-  */
+  d->pipelineType = type;
+  d->iPipelineStep = frameStep;
+  d->iConsumedPts = d->iLastFramePts;
+  d->iConsumedTargetPts = d->iTargetPts;
+  d->bConsumedTargetChanged = d->bTargetChanged;
+  d->bConsumedFrameRead = d->bFrameRead;
+  d->bPipelineRunning = true;
+  d->pDecoder = new Decoder(this);
+  d->pDecoder->start();
+}
 
-  if (bSuccess)
-    {
-      // Allocate an AVFrame structure for conversion result
-      AVFrame *pResultFrame = avcodec_alloc_frame();
-      if (pResultFrame == 0)
-        return PiiMatrix<PiiColor4<> >();
+void PiiVideoReader::stopPipeline()
+{
+  if (d->pDecoder == 0)
+    return;
 
-      // Malloc ensures we can safely leave the buffer to PiiMatrix.
-      void* bfr = ::malloc(avpicture_get_size(PIX_FMT_RGB32, d->pCodecCtx->width, d->pCodecCtx->height));
+  synchronized (d->queueMutex)
+    {
+      d->bPipelineRunning = false;
+      d->frameTaken.wakeAll();
+    }
+  d->pDecoder->wait();
+  delete d->pDecoder;
+  d->pDecoder = 0;
+  d->lstFrames.clear();
+
+  // Rewind the decoding state to the last frame the caller has seen.
+  d->iLastFramePts = d->iConsumedPts;
+  d->iTargetPts = d->iConsumedTargetPts;
+  d->bTargetChanged = d->bConsumedTargetChanged;
+  d->bFrameRead = d->bConsumedFrameRead;
+  d->bResync = true;
+}
 
-      if (bfr == 0)
+void PiiVideoReader::decodeFrames()
+{
+  forever
+    {
+      synchronized (d->queueMutex)
         {
-          av_free(pResultFrame);
-          return PiiMatrix<PiiColor4<> >();
+          while (d->bPipelineRunning && d->lstFrames.size() >= d->iQueueSize)
+            d->frameTaken.wait(&d->queueMutex);
+          if (!d->bPipelineRunning)
+            return;
         }
 
-      // Assign appropriate parts of buffer to image planes in pResultFrame
-      avpicture_fill((AVPicture *)pResultFrame, (uint8_t*)bfr, PIX_FMT_RGB32,
-                     d->pCodecCtx->width, d->pCodecCtx->height);
-
-      // Convert color space (this stores the result into bfr)
-      int iResult = IMGCONVERT((AVPicture *)pResultFrame, PIX_FMT_RGB32, (AVPicture*)d->pFrame,
-                               d->pCodecCtx->pix_fmt, d->pCodecCtx->width, d->pCodecCtx->height);
-
-      // Get rid of the conversion result frame. This does not free
-      // the data buffer itself.
-      av_free(pResultFrame);
-
-      if (iResult < 0)
+      Frame frame;
+      if (getFrame(d->pFrame, d->iPipelineStep))
         {
-          free(bfr);
-          return PiiMatrix<PiiColor4<> >();
+          if (d->pipelineType == GrayFrame)
+            convertFrame(&frame.matGray);
+          else
+            convertFrame(&frame.matColor);
         }
+      frame.iLastFramePts = d->iLastFramePts;
+      frame.iTargetPts = d->iTargetPts;
 
-      // Let PiiMatrix take the ownership of the buffer.
-      return PiiMatrix<PiiColor4<> >(d->pCodecCtx->height, d->pCodecCtx->width, bfr, Pii::ReleaseOwnership, 0);
+      synchronized (d->queueMutex)
+        {
+          d->lstFrames << frame;
+          d->frameAdded.wakeAll();
+        }
+      // Stop at the end of the stream.
+      if (frame.isEmpty())
+        return;
     }
-  return PiiMatrix<PiiColor4<> >();
 }
 
+void PiiVideoReader::setDecoderThreadCount(int decoderThreadCount) { d->iDecoderThreadCount = qMax(0, decoderThreadCount); }
+int PiiVideoReader::decoderThreadCount() const { return d->iDecoderThreadCount; }
+
+void PiiVideoReader::setQueueSize(int queueSize)
+{
+  stopPipeline();
+  d->iQueueSize = qMax(0, queueSize);
+}
+int PiiVideoReader::queueSize() const { return d->iQueueSize; }
+
 void PiiVideoReader::seekToBegin()
 {
+  stopPipeline();
   // Initialize the next target to the start of the stream and switch
   // bTargetChanged flag on.
   d->iTargetPts = 0;
@@ -335,6 +547,7 @@ void PiiVideoReader::seekToBegin()
 
 void PiiVideoReader::seekToEnd()
 {
+  stopPipeline();
   // If we don't know a stream duration, we must find it to search the
   // latest frame of the stream.
   if (d->iStreamDuration <= 0)
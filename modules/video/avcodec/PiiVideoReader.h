@@ -23,6 +23,9 @@ extern "C"
 }
 
 #include <QString>
+#include <QList>
+#include <QMutex>
+#include <QWaitCondition>
 #include <PiiMatrix.h>
 #include <PiiColor.h>
 #include <PiiVideoException.h>
@@ -61,6 +64,28 @@ extern "C"
  *   }
  * ~~~
  *
+ * Decoding can be pipelined by setting [queueSize()] to a positive
+ * value. In this mode, a background thread reads, decodes and
+ * converts frames ahead of time while the caller processes the
+ * previous ones. Decoded frames are stored into a pool of
+ * preallocated matrices that are reused once the caller (and
+ * everybody else) has released them. Additionally, libavcodec can
+ * be configured to decode in many threads (see
+ * [setDecoderThreadCount()]).
+ *
+ * ~~~(c++)
+ * PiiVideoReader reader("inspection.avi");
+ * reader.setDecoderThreadCount(0); // all cores
+ * reader.setQueueSize(8);
+ * reader.initialize();
+ * for (;;)
+ *   {
+ *     PiiMatrix<PiiColor4<> > frame(reader.getFrame<PiiColor4<> >(1));
+ *     if (frame.isEmpty())
+ *       break;
+ *     // Frame data is reused once frame goes out of scope.
+ *   }
+ * ~~~
  */
 class PII_VIDEO_EXPORT PiiVideoReader
 {
@@ -109,6 +134,38 @@ public:
    */
   QString fileName() const;
 
+  /**
+   * Sets the number of threads libavcodec uses for decoding. Zero
+   * means the number of processor cores. Depending on the codec and
+   * the version of libavcodec, frame-level or slice-level threading
+   * (or both) will be used. The default value is one. This function
+   * has no effect after initialize().
+   */
+  void setDecoderThreadCount(int decoderThreadCount);
+  /**
+   * Returns the number of decoder threads.
+   */
+  int decoderThreadCount() const;
+
+  /**
+   * Sets the maximum number of decoded frames that will be buffered
+   * by a background decoding thread. Zero disables pipelining, and
+   * frames will be decoded in the calling thread upon [getFrame()].
+   * The default value is zero.
+   *
+   * In pipelined mode, the background thread assumes the frame type
+   * and the `skipFrames` argument of the previous getFrame() call stay
+   * the same. If they change, or if the stream is seeked,
+   * already decoded frames will be discarded and decoding continues
+   * right after the last frame returned. Thus, the frames returned
+   * are the same in both modes.
+   */
+  void setQueueSize(int queueSize);
+  /**
+   * Returns the size of the decoded frame queue.
+   */
+  int queueSize() const;
+
   /**
    * Seek at begin of the stream.
    */
@@ -128,6 +185,28 @@ private:
    */
   bool getFrame(AVFrame* frame, int skipFrames);
 
+  enum FrameType { GrayFrame, ColorFrame };
+  // A decoded frame and the stream position after decoding it. An
+  // empty frame marks the end of the stream.
+  struct Frame
+  {
+    Frame() : iLastFramePts(0), iTargetPts(0) {}
+    bool isEmpty() const { return matGray.isEmpty() && matColor.isEmpty(); }
+
+    PiiMatrix<unsigned char> matGray;
+    PiiMatrix<PiiColor4<> > matColor;
+    int64_t iLastFramePts, iTargetPts;
+  };
+  class Decoder;
+  friend class Decoder;
+
+  bool convertFrame(PiiMatrix<unsigned char>* result);
+  bool convertFrame(PiiMatrix<PiiColor4<> >* result);
+  Frame takeFrame(FrameType type, int skipFrames);
+  void startPipeline(FrameType type, int skipFrames);
+  void stopPipeline();
+  void decodeFrames();
+
   static QString tr(const char* text) { return QCoreApplication::translate("PiiVideoReader", text); }
 
   /// @internal
@@ -156,8 +235,38 @@ private:
     // The flag which tell if iTargetPts has changed outside of the
     // getFrame()-function (for example seekToBegin() or seekToEnd())
     bool bTargetChanged;
+    // True if a frame has been read since initialize() or the last
+    // seek.
+    bool bFrameRead;
+    // True if the stream must be seeked to the position after
+    // iLastFramePts because the pipeline has read ahead.
+    bool bResync;
+    // True if libavcodec returns frames with a delay (frame threads).
+    bool bFrameThreads;
 
     QString strFileName;
+
+    int iDecoderThreadCount, iQueueSize;
+
+    // Pipeline state. The decoder thread owns the stream and the
+    // decoding state above while it is running. The queue is
+    // protected by queueMutex.
+    Decoder* pDecoder;
+    bool bPipelineRunning;
+    FrameType pipelineType;
+    int iPipelineStep;
+    QMutex queueMutex;
+    QWaitCondition frameAdded, frameTaken;
+    QList<Frame> lstFrames;
+    // Stream position corresponding to the last frame returned to the
+    // caller.
+    int64_t iConsumedPts, iConsumedTargetPts;
+    bool bConsumedTargetChanged, bConsumedFrameRead;
+
+    // Reusable output buffers. Accessed only by the thread that
+    // decodes.
+    QList<PiiMatrix<unsigned char> > lstGrayPool;
+    QList<PiiMatrix<PiiColor4<> > > lstColorPool;
   } *d;
 };
 
@@ -24,6 +24,7 @@
 
 #include <QMap>
 #include <QMutexLocker>
+#include <QVarLengthArray>
 
 #define PII_ALL_IMAGE_TYPES                     \
   (PiiYdin::UnsignedCharMatrixType,             \
@@ -32,18 +33,62 @@
    PiiYdin::UnsignedCharColor4MatrixType,       \
    PiiYdin::UnsignedCharColorMatrixType)
 
+namespace
+{
+  // Calculates the size an image of the given *size* should be scaled
+  // to. Missing dimensions in *requestedSize* are calculated to
+  // retain aspect ratio.
+  QSize targetSize(const QSize& size, const QSize& requestedSize)
+  {
+    if (size.isEmpty())
+      return size;
+    if (requestedSize.width() > 0 && requestedSize.height() > 0)
+      return requestedSize;
+    if (requestedSize.width() > 0)
+      return QSize(requestedSize.width(),
+                   qMax(1, int(qint64(size.height()) * requestedSize.width() / size.width())));
+    if (requestedSize.height() > 0)
+      return QSize(qMax(1, int(qint64(size.width()) * requestedSize.height() / size.height())),
+                   requestedSize.height());
+    return size;
+  }
+
+  // Picks the pixels closest to the centers of the target pixels.
+  template <class T> PiiMatrix<T> downscale(const PiiMatrix<T>& image, const QSize& size)
+  {
+    const int iRows = size.height(), iCols = size.width();
+    PiiMatrix<T> matResult(PiiMatrix<T>::uninitialized(iRows, iCols));
+    QVarLengthArray<int,2048> vecColumns(iCols);
+    for (int c=0; c<iCols; ++c)
+      vecColumns[c] = int(qint64(2*c+1) * image.columns() / (2*iCols));
+    for (int r=0; r<iRows; ++r)
+      {
+        const T* pSource = image.row(int(qint64(2*r+1) * image.rows() / (2*iRows)));
+        T* pTarget = matResult.row(r);
+        for (int c=0; c<iCols; ++c)
+          pTarget[c] = pSource[vecColumns[c]];
+      }
+    return matResult;
+  }
+}
+
 struct PiiQmlImageProvider::Slot
 {
   Slot() :
     pProbe(0),
     pListener(0),
-    iMethodIndex(-1)
+    iMethodIndex(-1),
+    iSerial(0)
   {}
   Slot(const Slot& other) :
     varImage(other.varImage),
     pProbe(0),
     pListener(other.pListener),
-    iMethodIndex(other.iMethodIndex)
+    iMethodIndex(other.iMethodIndex),
+    iSerial(other.iSerial),
+    cachedImage(other.cachedImage),
+    cachedRequest(other.cachedRequest),
+    cachedSize(other.cachedSize)
   {}
 
   Slot& operator= (const Slot& other)
@@ -52,6 +97,10 @@ struct PiiQmlImageProvider::Slot
     pProbe = other.pProbe;
     pListener = other.pListener;
     iMethodIndex = other.iMethodIndex;
+    iSerial = other.iSerial;
+    cachedImage = other.cachedImage;
+    cachedRequest = other.cachedRequest;
+    cachedSize = other.cachedSize;
     return *this;
   }
 
@@ -59,6 +108,12 @@ struct PiiQmlImageProvider::Slot
   PiiProbeInput* pProbe;
   QObject* pListener;
   int iMethodIndex;
+  // Incremented whenever a new image is stored.
+  unsigned int iSerial;
+  // The last image returned by requestImage(), the requested size
+  // used, and the original size of the image.
+  QImage cachedImage;
+  QSize cachedRequest, cachedSize;
 };
 
 class PiiQmlImageProvider::Data
@@ -66,7 +121,7 @@ class PiiQmlImageProvider::Data
 public:
   typedef QMap<QString,Slot> SlotMap;
 
-  Data() {}
+  Data() : bDownscaleOnRequest(false) {}
   ~Data()
   {
     for (SlotMap::iterator it = mapSlots.begin(); it != mapSlots.end(); ++it)
@@ -75,6 +130,7 @@ public:
 
   SlotMap mapSlots;
   QMutex slotMutex;
+  bool bDownscaleOnRequest;
 };
 
 PiiQmlImageProvider::PiiQmlImageProvider() :
@@ -102,27 +158,70 @@ QImage PiiQmlImageProvider::requestImage(const QString& slot, QSize* size, const
       d->slotMutex.unlock();
       return QImage();
     }
+  if (!it->cachedImage.isNull() && it->cachedRequest == requestedSize)
+    {
+      QImage cachedImage(it->cachedImage);
+      *size = it->cachedSize;
+      d->slotMutex.unlock();
+      return cachedImage;
+    }
   PiiVariant varImage = it->varImage;
+  unsigned int iSerial = it->iSerial;
+  bool bDownscale = d->bDownscaleOnRequest;
   d->slotMutex.unlock();
 
   QImage qImage;
   switch (varImage.type())
     {
-      PII_ALL_IMAGE_CASES(qImage = matrixToQImage, varImage);
+      PII_ALL_IMAGE_CASES_M(qImage = matrixToQImage, (varImage, requestedSize, size, bDownscale));
     default:
       qImage = varImage.convertTo<QImage>();
+      *size = qImage.size();
     }
 
-  *size = qImage.size();
+  QSize scaledSize(targetSize(*size, requestedSize));
+  if (scaledSize != qImage.size())
+    qImage = qImage.scaled(scaledSize);
+
+  // Cache the result unless a new image was stored meanwhile.
+  synchronized (d->slotMutex)
+    {
+      it = d->mapSlots.find(strSlot);
+      if (it != d->mapSlots.end() && it->iSerial == iSerial)
+        {
+          it->cachedImage = qImage;
+          it->cachedRequest = requestedSize;
+          it->cachedSize = *size;
+        }
+    }
 
-  if (requestedSize.isValid() && requestedSize != qImage.size())
-    return qImage.scaled(requestedSize);
   return qImage;
 }
 
-template <class T> QImage PiiQmlImageProvider::matrixToQImage(const PiiVariant& image)
+template <class T> QImage PiiQmlImageProvider::matrixToQImage(const PiiVariant& image,
+                                                              const QSize& requestedSize,
+                                                              QSize* size,
+                                                              bool downscale)
+{
+  const PiiMatrix<T>& matImage = image.valueAs<PiiMatrix<T> >();
+  *size = QSize(matImage.columns(), matImage.rows());
+  QSize scaledSize(targetSize(*size, requestedSize));
+  if (downscale &&
+      scaledSize != *size &&
+      scaledSize.width() <= size->width() &&
+      scaledSize.height() <= size->height())
+    return Pii::toQImage(::downscale(matImage, scaledSize));
+  return Pii::toQImage(matImage);
+}
+
+void PiiQmlImageProvider::setDownscaleOnRequest(bool downscaleOnRequest)
+{
+  synchronized (d->slotMutex) d->bDownscaleOnRequest = downscaleOnRequest;
+}
+
+bool PiiQmlImageProvider::downscaleOnRequest() const
 {
-  return Pii::matrixToQImage(image.valueAs<PiiMatrix<T> >());
+  return d->bDownscaleOnRequest;
 }
 
 void PiiQmlImageProvider::removeSlot(const QString& slot)
@@ -242,6 +341,8 @@ bool PiiQmlImageProvider::storeImage(const QString& slot, const PiiVariant& imag
       QMutexLocker lock(&d->slotMutex);
       Slot& s = d->mapSlots[slot];
       s.varImage = image;
+      ++s.iSerial;
+      s.cachedImage = QImage();
 
       /* Always pass the signal through the event queue even if the
        * listener was in the same thread. This way the listener will
@@ -54,6 +54,18 @@ class PiiQmlImageProvider :
   public QQuickImageProvider
 {
   Q_OBJECT
+
+  /**
+   * Enables downscaling before conversion. If this flag is `true` and
+   * the size requested by QML is smaller than the stored image, the
+   * image will be resampled (nearest neighbor) to the requested size
+   * before it is converted to a QImage. This saves a lot of time with
+   * large images that are displayed in a small Image element, because
+   * only the displayed pixels will be converted. The default value is
+   * `false`, which converts the full image and lets QImage scale it.
+   */
+  Q_PROPERTY(bool downscaleOnRequest READ downscaleOnRequest WRITE setDownscaleOnRequest);
+
 public:
   PiiQmlImageProvider();
   ~PiiQmlImageProvider();
@@ -61,6 +73,14 @@ public:
   /**
    * Returns the last image saved to *slot*. Stores the original size
    * of the image to *size* and scales the image to *requestedSize*.
+   * If either dimension of *requestedSize* is zero, it will be
+   * calculated to retain the aspect ratio of the image.
+   *
+   * 8-bit gray and 32-bit color images are passed to QML without
+   * copying the pixel data (see [Pii::toQImage()]). Other image types
+   * are converted, and the result is cached until a new image is
+   * stored to the slot. Thus, requesting the same image many times
+   * costs a conversion only once.
    *
    * ! The QtQuick Image component provides no way of updating a
    *   displayed image. The only way to force an update is to change
@@ -141,13 +161,17 @@ public slots:
    */
   int updateInterval(const QString& slot) const;
 
+  void setDownscaleOnRequest(bool downscaleOnRequest);
+  bool downscaleOnRequest() const;
+
 private slots:
   void storeImage(const PiiVariant& image, PiiProbeInput* sender);
   void removeListener(QObject* listener);
   void disconnectOutput(QObject* output);
 
 private:
-  template <class T> inline QImage matrixToQImage(const PiiVariant& image);
+  template <class T> inline QImage matrixToQImage(const PiiVariant& image, const QSize& requestedSize,
+                                                  QSize* size, bool downscale);
 
   struct Slot;
   class Data;
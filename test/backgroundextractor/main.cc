@@ -0,0 +1,207 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "TestPiiBackgroundExtractor.h"
+
+#include <QtTest>
+#include <PiiMatrix.h>
+#include <PiiMath.h>
+#include <PiiRandom.h>
+
+namespace
+{
+  /* The running-average update as it was before the parallel
+   * kernels.
+   */
+  class ReferenceExtractor
+  {
+  public:
+    ReferenceExtractor(double threshold, double alpha1, double alpha2, int maxStillTime) :
+      dThreshold(threshold), dAlpha1(alpha1), dAlpha2(alpha2), iMaxStillTime(maxStillTime)
+    {}
+
+    // Returns the number of foreground pixels.
+    int update(const PiiMatrix<uchar>& image)
+    {
+      PiiMatrix<float> inputMatrix(image);
+      const int iRows = inputMatrix.rows(), iCols = inputMatrix.columns();
+      if (matBackground.isEmpty())
+        {
+          matStillCounter = PiiMatrix<int>(iRows, iCols);
+          matBackground = inputMatrix;
+          return 0;
+        }
+
+      int iValidCounter = 0;
+      for (int r=0; r<iRows; ++r)
+        {
+          const float* pInputRow = inputMatrix[r];
+          float* pBackgroundRow = matBackground[r];
+          int* pStillCounterRow = matStillCounter[r];
+          for (int c=0; c<iCols; ++c)
+            {
+              double dDifference = pInputRow[c] - pBackgroundRow[c];
+              float fForeground = 0.0f;
+              if (Pii::abs(dDifference) > dThreshold)
+                {
+                  ++pStillCounterRow[c];
+                  iValidCounter++;
+                  fForeground = 1.0f;
+                }
+              else
+                pStillCounterRow[c] = 0;
+
+              if (pStillCounterRow[c] > iMaxStillTime)
+                {
+                  pStillCounterRow[c] = 0;
+                  pBackgroundRow[c] = pInputRow[c];
+                }
+
+              pBackgroundRow[c] += float((dAlpha1 * (1.0 - fForeground) +
+                                          dAlpha2 * fForeground) * dDifference);
+            }
+        }
+      return iValidCounter;
+    }
+
+    PiiMatrix<float> matBackground;
+    PiiMatrix<int> matStillCounter;
+
+  private:
+    double dThreshold, dAlpha1, dAlpha2;
+    int iMaxStillTime;
+  };
+
+  // A noisy gradient with a bright square that moves right by two
+  // pixels in each frame.
+  PiiMatrix<uchar> createFrame(int index)
+  {
+    PiiMatrix<uchar> matFrame(48, 64);
+    for (int r=0; r<matFrame.rows(); ++r)
+      for (int c=0; c<matFrame.columns(); ++c)
+        matFrame(r,c) = uchar(r + c + Pii::uniformRandom(0, 10));
+    matFrame(16, (index * 2) % 48, 12, 12) = 220;
+    return matFrame;
+  }
+
+  int countMismatches(const PiiMatrix<int>& a, const PiiMatrix<int>& b)
+  {
+    int iCount = 0;
+    for (int r=0; r<a.rows(); ++r)
+      for (int c=0; c<a.columns(); ++c)
+        iCount += a(r,c) != b(r,c);
+    return iCount;
+  }
+}
+
+bool TestPiiBackgroundExtractor::createExtractor()
+{
+  if (!createOperation("piiimage", "PiiBackgroundExtractor"))
+    return false;
+  operation()->setProperty("threshold", 25.0);
+  operation()->setProperty("alpha1", 0.1);
+  operation()->setProperty("alpha2", 0.01);
+  // Small enough to burn in the moving square.
+  operation()->setProperty("maxStillTime", 4);
+  operation()->setProperty("movementThreshold", 0.02);
+  connectAllInputs();
+  return true;
+}
+
+void TestPiiBackgroundExtractor::runningAverage_data()
+{
+  QTest::addColumn<int>("threads");
+  QTest::newRow("1 thread") << 1;
+  QTest::newRow("4 threads") << 4;
+}
+
+void TestPiiBackgroundExtractor::runningAverage()
+{
+  QFETCH(int, threads);
+  QVERIFY(createExtractor());
+  operation()->setProperty("extractorThreadCount", threads);
+  QVERIFY(start());
+
+  Pii::seedRandom(1);
+  ReferenceExtractor reference(25.0, 0.1, 0.01, 4);
+  for (int i=0; i<30; ++i)
+    {
+      PiiMatrix<uchar> matFrame(createFrame(i));
+      int iForeground = reference.update(matFrame);
+      QVERIFY(sendObject("image", matFrame));
+      // The decisions must be exactly the same as in double
+      // precision.
+      QVERIFY(Pii::equals(outputValue("image", PiiMatrix<int>()), reference.matStillCounter));
+      QCOMPARE(outputValue("movement", false), iForeground < 0.02 * 48 * 64);
+    }
+
+  QVERIFY(stop());
+}
+
+void TestPiiBackgroundExtractor::fixedPoint()
+{
+  QVERIFY(createExtractor());
+  operation()->setProperty("fixedPoint", true);
+  QVERIFY(start());
+
+  Pii::seedRandom(1);
+  ReferenceExtractor reference(25.0, 0.1, 0.01, 4);
+  for (int i=0; i<30; ++i)
+    {
+      PiiMatrix<uchar> matFrame(createFrame(i));
+      reference.update(matFrame);
+      QVERIFY(sendObject("image", matFrame));
+      // Rounding may flip a decision close to the threshold.
+      QVERIFY(countMismatches(outputValue("image", PiiMatrix<int>()), reference.matStillCounter) <= 10);
+    }
+
+  QVERIFY(stop());
+}
+
+void TestPiiBackgroundExtractor::mixture()
+{
+  QVERIFY(createExtractor());
+  operation()->setProperty("backgroundModel", "MixtureOfGaussiansModel");
+  operation()->setProperty("maxStillTime", 1000);
+  QVERIFY(start());
+
+  // Learn a static, noisy background.
+  Pii::seedRandom(1);
+  PiiMatrix<uchar> matBackground(createFrame(0));
+  matBackground(16, 0, 12, 12) = 40;
+  for (int i=0; i<50; ++i)
+    {
+      PiiMatrix<uchar> matFrame(matBackground);
+      for (int r=0; r<matFrame.rows(); ++r)
+        for (int c=0; c<matFrame.columns(); ++c)
+          matFrame(r,c) = uchar(matFrame(r,c) + Pii::uniformRandom(0, 4));
+      QVERIFY(sendObject("image", matFrame));
+    }
+  PiiMatrix<int> matStill(outputValue("image", PiiMatrix<int>()));
+  QVERIFY(Pii::sum<int>(matStill) <= 20);
+  QVERIFY(outputValue("movement", false));
+
+  // A bright object is foreground, the rest is still background.
+  PiiMatrix<uchar> matFrame(matBackground);
+  matFrame(20, 30, 8, 8) = 250;
+  QVERIFY(sendObject("image", matFrame));
+  matStill = outputValue("image", PiiMatrix<int>());
+  QCOMPARE(Pii::sum<int>(matStill(20, 30, 8, 8)), 64);
+  QVERIFY(Pii::sum<int>(matStill) - 64 <= 20);
+
+  QVERIFY(stop());
+}
+
+QTEST_MAIN(TestPiiBackgroundExtractor)
@@ -89,6 +89,51 @@ void TestPiiCamera::bayerToRgb()
   QVERIFY(Pii::equals(gray, (red + green + blue)/3));
 }
 
+void TestPiiCamera::demosaic()
+{
+  // Odd sizes exercise all border cases.
+  PiiMatrix<unsigned char> test(7,9);
+  for (int r=0; r<test.rows(); ++r)
+    for (int c=0; c<test.columns(); ++c)
+      test(r,c) = (unsigned char)((r*37 + c*91 + r*c*13) & 0xff);
+
+  // Bilinear demosaicing must be identical to bayerToRgb()
+  QVERIFY(Pii::equals(PiiCamera::demosaic<PiiColor4<> >(test, PiiCamera::BayerRGGBFormat),
+                      PiiCamera::bayerToRgb(test, PiiCamera::RggbDecoder<>(), PiiCamera::Rgb4Pixel<>())));
+  QVERIFY(Pii::equals(PiiCamera::demosaic<PiiColor4<> >(test, PiiCamera::BayerGRBGFormat),
+                      PiiCamera::bayerToRgb(test, PiiCamera::GrbgDecoder<>(), PiiCamera::Rgb4Pixel<>())));
+  QVERIFY(Pii::equals(PiiCamera::demosaic<PiiColor<> >(test, PiiCamera::BayerBGGRFormat,
+                                                       PiiCamera::BilinearInterpolation, 0, 3),
+                      PiiCamera::bayerToRgb(test, PiiCamera::BggrDecoder<>(), PiiCamera::RgbPixel<>())));
+  QVERIFY(Pii::equals(PiiCamera::demosaic<int>(test, PiiCamera::BayerRGGBFormat),
+                      PiiCamera::bayerToRgb(test, PiiCamera::RggbDecoder<>(), PiiCamera::GrayPixel<int>())));
+
+  // 16-bit input, 8-bit output
+  PiiMatrix<unsigned short> test16(PiiMatrix<unsigned short>(test) * 256);
+  QVERIFY(Pii::equals(PiiCamera::demosaic<PiiColor4<> >(test16, PiiCamera::BayerRGGBFormat,
+                                                        PiiCamera::BilinearInterpolation, 8),
+                      PiiCamera::demosaic<PiiColor4<> >(test, PiiCamera::BayerRGGBFormat)));
+
+  // Edge-aware interpolation must not depend on the number of threads.
+  QVERIFY(Pii::equals(PiiCamera::demosaic<PiiColor4<> >(test, PiiCamera::BayerGBRGFormat,
+                                                        PiiCamera::EdgeAwareInterpolation, 0, 1),
+                      PiiCamera::demosaic<PiiColor4<> >(test, PiiCamera::BayerGBRGFormat,
+                                                        PiiCamera::EdgeAwareInterpolation, 0, 3)));
+
+  // A sharp vertical edge in a gray-level image. Edge-aware
+  // interpolation must reproduce the gray levels exactly except
+  // close to the border, which is interpolated bilinearly.
+  PiiMatrix<unsigned char> edge(8,8);
+  for (int r=0; r<edge.rows(); ++r)
+    for (int c=0; c<edge.columns(); ++c)
+      edge(r,c) = c < 4 ? 20 : 200;
+  PiiMatrix<PiiColor4<> > rgb(PiiCamera::demosaic<PiiColor4<> >(edge, PiiCamera::BayerRGGBFormat,
+                                                                PiiCamera::EdgeAwareInterpolation));
+  for (int r=2; r<edge.rows()-2; ++r)
+    for (int c=2; c<edge.columns()-2; ++c)
+      QVERIFY(rgb(r,c) == PiiColor4<>(edge(r,c), edge(r,c), edge(r,c)));
+}
+
 #if 0
 void TestPiiCamera::bayerToRgbSpeed()
 {
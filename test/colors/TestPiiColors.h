@@ -33,6 +33,8 @@ private slots:
   void rgbToFromYpbpr();
   void rgbToFromYcbcr();
   void autocorrelogram();
+  void xyzToLab();
+  void fastConversions();
 };
 
 
@@ -16,6 +16,7 @@
 #include <QtTest>
 #include "TestPiiColors.h"
 #include <PiiColors.h>
+#include <PiiFastColors.h>
 #include <PiiColor.h>
 #include <QDebug>
 #include <PiiMatrixUtil.h>
@@ -307,6 +308,104 @@ void TestPiiColors::autocorrelogram()
   QVERIFY(Pii::almostEqual(c1, r1, 1e-6));
   QVERIFY(Pii::almostEqual(c2, r2, 1e-6));
   QVERIFY(Pii::almostEqual(PiiColors::autocorrelogram(Pii::matrix(Pii::transpose(input2)), 4), r2, 1e-6));
+
+  // Compare to a pixel-by-pixel reference on an image that has both
+  // border and inner pixels. Colors above levels are ignored. The
+  // image is tall enough to be split into three bands of rows.
+  PiiMatrix<int> matImage(PiiMatrix<int>::uninitialized(1500, 150));
+  for (int r=0; r<matImage.rows(); ++r)
+    for (int c=0; c<matImage.columns(); ++c)
+      matImage(r,c) = (r/4 + c/7 + (r*c) % 3) % 6;
+  QList<int> lstDistances;
+  lstDistances << 1 << 4 << 9;
+  PiiMatrix<double> matReference(1, 15);
+  for (int d=0; d<lstDistances.size(); ++d)
+    {
+      const int iDist = lstDistances[d];
+      for (int r=0; r<matImage.rows(); ++r)
+        for (int c=0; c<matImage.columns(); ++c)
+          {
+            if (matImage(r,c) >= 5)
+              continue;
+            int iSum = 0, iCnt = 0;
+            for (int v=r-iDist; v<=r+iDist; ++v)
+              for (int h=c-iDist; h<=c+iDist; ++h)
+                if (qMax(qAbs(v-r), qAbs(h-c)) == iDist &&
+                    v >= 0 && v < matImage.rows() && h >= 0 && h < matImage.columns())
+                  {
+                    ++iCnt;
+                    iSum += matImage(v,h) == matImage(r,c);
+                  }
+            matReference(0, d*5 + matImage(r,c)) += double(iSum) / iCnt;
+          }
+    }
+  PiiMatrix<float> matCorrelogram(PiiColors::autocorrelogram(matImage, lstDistances, 5));
+  for (int i=0; i<matReference.columns(); ++i)
+    QVERIFY(Pii::almostEqualRel(double(matCorrelogram(0,i)), matReference(0,i), 1e-5));
+
+  QCOMPARE(Pii::parallelBandCount(matImage.rows(), 3, Pii::reductionMinBandRows(matImage.columns())), 3);
+  // Border fractions are summed in a different order with more threads.
+  const int aThreads[] = { 2, 3, 0 };
+  for (int t=0; t<3; ++t)
+    {
+      PiiMatrix<float> matThreaded(PiiColors::autocorrelogram(matImage, lstDistances, 5, aThreads[t]));
+      QCOMPARE(matThreaded.columns(), matCorrelogram.columns());
+      for (int i=0; i<matCorrelogram.columns(); ++i)
+        QVERIFY(Pii::almostEqualRel(matThreaded(0,i), matCorrelogram(0,i), 1e-5f));
+    }
+}
+
+void TestPiiColors::xyzToLab()
+{
+  // sRGB red under D65
+  PiiColor<float> lab(PiiColors::xyzToLab(PiiColor<float>(41.24f, 21.26f, 1.93f),
+                                          PiiColor<float>(95.047f, 100.0f, 108.883f)));
+  QVERIFY(Pii::abs(lab.labL - 53.24f) < 0.05f);
+  QVERIFY(Pii::abs(lab.labA - 80.09f) < 0.05f);
+  QVERIFY(Pii::abs(lab.labB - 67.20f) < 0.05f);
+}
+
+static int maxDifference(const PiiMatrix<PiiColor<> >& a, const PiiMatrix<PiiColor<> >& b, bool circular = false)
+{
+  int iMaxDiff = 0;
+  for (int r=0; r<a.rows(); ++r)
+    for (int c=0; c<a.columns(); ++c)
+      for (int i=0; i<3; ++i)
+        {
+          int iDiff = Pii::abs(int(a(r,c).channels[i]) - int(b(r,c).channels[i]));
+          if (circular && i == 2)
+            iDiff = qMin(iDiff, 256 - iDiff);
+          iMaxDiff = qMax(iMaxDiff, iDiff);
+        }
+  return iMaxDiff;
+}
+
+void TestPiiColors::fastConversions()
+{
+  // Every fourth level of each channel
+  PiiMatrix<PiiColor<> > matRgb(256, 4096);
+  for (int i=0; i<64*64*64; ++i)
+    matRgb(i/4096, i%4096) = PiiColor<>((i >> 12) * 4 + 3, ((i >> 6) & 63) * 4 + 1, (i & 63) * 4);
+
+  // H is the last channel and wraps around.
+  QVERIFY(maxDifference(PiiColors::rgbToHsv(matRgb), PiiColors::fastRgbToHsv(matRgb), true) <= 1);
+  QVERIFY(maxDifference(PiiColors::rgbToYcbcr(matRgb), PiiColors::fastRgbToYcbcr(matRgb)) <= 1);
+  QVERIFY(maxDifference(PiiColors::ycbcrToRgb(matRgb), PiiColors::fastYcbcrToRgb(matRgb)) <= 1);
+  QCOMPARE(maxDifference(PiiColors::correctGamma(matRgb, 0.45, 255),
+                         PiiColors::fastCorrectGamma(matRgb, 0.45, 255)), 0);
+  QCOMPARE(maxDifference(PiiColors::hsvToRgb(matRgb), PiiColors::fastHsvToRgb(matRgb, 3)), 0);
+
+  PiiMatrix<PiiColor<float> > matXyz(PiiColors::genericConversion(matRgb, PiiColors::d65_709_XyzMatrix));
+  PiiColor<float> clrWhite(95.05f, 100.0f, 108.88f);
+  matXyz *= 100.0f/255.0f;
+  QVERIFY(Pii::equals(PiiColors::genericConversion(matRgb, PiiColors::ohtaKanadeMatrix),
+                      PiiColors::fastGenericConversion(matRgb, PiiColors::ohtaKanadeMatrix)));
+  PiiMatrix<PiiColor<float> > matLab(PiiColors::xyzToLab(matXyz, clrWhite)),
+    matFastLab(PiiColors::fastXyzToLab(matXyz, clrWhite));
+  for (int r=0; r<matLab.rows(); ++r)
+    for (int c=0; c<matLab.columns(); ++c)
+      for (int i=0; i<3; ++i)
+        QVERIFY(Pii::abs(matLab(r,c).channels[i] - matFastLab(r,c).channels[i]) < 1e-3f);
 }
 
 QTEST_MAIN(TestPiiColors)
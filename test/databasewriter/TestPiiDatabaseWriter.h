@@ -25,6 +25,11 @@ class TestPiiDatabaseWriter : public PiiOperationTest
 private slots:
   void initTestCase();
   void process();
+  void batchedProcess();
+  void batchedProcess_data();
+  void flushInterval();
+  void flushInterval_data();
+  void changeWhilePaused();
 };
 
 
@@ -52,4 +52,126 @@ void TestPiiDatabaseWriter::process()
   QCOMPARE(strCsv, QString("\"\"\"abc\"\"\",\"123\"\n"));
 }
 
+void TestPiiDatabaseWriter::batchedProcess_data()
+{
+  QTest::addColumn<int>("queueSize");
+  QTest::newRow("synchronous") << 0;
+  QTest::newRow("threaded") << 2;
+}
+
+void TestPiiDatabaseWriter::batchedProcess()
+{
+  QFETCH(int, queueSize);
+
+  QString strFileName("test.csv");
+  QFile file(strFileName);
+  QVERIFY(!file.exists() || file.remove());
+
+  operation()->setProperty("batchSize", 3);
+  operation()->setProperty("queueSize", queueSize);
+
+  QVERIFY(start());
+
+  // Two full batches and a partial one that is written on stop.
+  for (int i=0; i<7; ++i)
+    {
+      QVERIFY(sendObject("input0", QString("row%1").arg(i)));
+      QVERIFY(sendObject("input1", i));
+    }
+
+  QVERIFY(stop());
+
+  QVERIFY(file.open(QIODevice::ReadOnly));
+  QString strCsv(file.readAll());
+  file.close();
+
+  QString strExpected;
+  for (int i=0; i<7; ++i)
+    strExpected += QString("\"row%1\",\"%1\"\n").arg(i);
+  QCOMPARE(strCsv, strExpected);
+}
+
+void TestPiiDatabaseWriter::flushInterval_data()
+{
+  batchedProcess_data();
+}
+
+void TestPiiDatabaseWriter::flushInterval()
+{
+  QFETCH(int, queueSize);
+
+  QString strFileName("test.csv");
+  QFile file(strFileName);
+  QVERIFY(!file.exists() || file.remove());
+
+  operation()->setProperty("batchSize", 10);
+  operation()->setProperty("flushInterval", 50);
+  operation()->setProperty("queueSize", queueSize);
+
+  QVERIFY(start());
+
+  for (int i=0; i<2; ++i)
+    {
+      QVERIFY(sendObject("input0", QString("row%1").arg(i)));
+      QVERIFY(sendObject("input1", i));
+    }
+
+  // The partial batch must be written without new rows.
+  QString strExpected("\"row0\",\"0\"\n\"row1\",\"1\"\n");
+  QString strCsv;
+  for (int i=0; i<100 && strCsv != strExpected; ++i)
+    {
+      PiiDelay::msleep(20);
+      // The writer creates the file when the first batch is written.
+      if (file.open(QIODevice::ReadOnly))
+        {
+          strCsv = file.readAll();
+          file.close();
+        }
+    }
+  QCOMPARE(strCsv, strExpected);
+
+  QVERIFY(stop());
+  operation()->setProperty("flushInterval", 0);
+}
+
+void TestPiiDatabaseWriter::changeWhilePaused()
+{
+  QString strFileName("test.csv");
+  QFile file(strFileName);
+  QVERIFY(!file.exists() || file.remove());
+
+  operation()->setProperty("batchSize", 10);
+  operation()->setProperty("flushInterval", 0);
+  operation()->setProperty("queueSize", 0);
+
+  QVERIFY(start());
+  QVERIFY(sendObject("input0", QString("row0")));
+  QVERIFY(sendObject("input1", 0));
+  // Pending rows are written on pause.
+  QVERIFY(pause());
+
+  // Time-based flushing takes effect on resume.
+  operation()->setProperty("flushInterval", 50);
+  QVERIFY(start());
+  QVERIFY(sendObject("input0", QString("row1")));
+  QVERIFY(sendObject("input1", 1));
+
+  QString strExpected("\"row0\",\"0\"\n\"row1\",\"1\"\n");
+  QString strCsv;
+  for (int i=0; i<100 && strCsv != strExpected; ++i)
+    {
+      PiiDelay::msleep(20);
+      if (file.open(QIODevice::ReadOnly))
+        {
+          strCsv = file.readAll();
+          file.close();
+        }
+    }
+  QCOMPARE(strCsv, strExpected);
+
+  QVERIFY(stop());
+  operation()->setProperty("flushInterval", 0);
+}
+
 QTEST_MAIN(TestPiiDatabaseWriter)
@@ -30,6 +30,7 @@ private slots:
   void convolution();
   void fastCorrelation();
   void findPeaks();
+  void liftingDwt();
 };
 
 
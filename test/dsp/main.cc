@@ -17,6 +17,7 @@
 
 #include <PiiDsp.h>
 #include <PiiFft.h>
+#include <PiiWavelet.h>
 #include <PiiMatrixUtil.h>
 #include <QtTest>
 #include <iostream>
@@ -332,4 +333,56 @@ void TestPiiDsp::fastCorrelation()
   QCOMPARE(peak.column, 1);
 }
 
+void TestPiiDsp::liftingDwt()
+{
+  PiiMatrix<double> mat(4,6,
+                        1.0, 5.0, 2.0, 7.0, 3.0, 3.0,
+                        4.0, 2.0, 8.0, 1.0, 0.0, 6.0,
+                        9.0, 3.0, 1.0, 1.0, 2.0, 5.0,
+                        0.0, 7.0, 4.0, 6.0, 8.0, 2.0);
+  {
+    // Haar lifting equals convolution with even-sized input
+    QList<PiiMatrix<double> > lstConvolution(PiiDsp::dwt(mat, PiiDsp::Haar));
+    PiiMatrix<double> matBuffer(mat);
+    QVERIFY(PiiDsp::liftingDwt(matBuffer, PiiDsp::Haar, 1));
+    QList<PiiMatrix<double> > lstLifting(PiiDsp::dwtSubbands(matBuffer));
+    QCOMPARE(lstLifting.size(), 4);
+    for (int i=0; i<4; ++i)
+      QVERIFY(Pii::almostEqual(lstLifting[i], lstConvolution[i], 1e-10));
+  }
+  {
+    // Constant input has no details, and the approximation is scaled
+    // by two on each level.
+    PiiMatrix<float> matConstant(13,7);
+    matConstant = 1;
+    QVERIFY(PiiDsp::liftingDwt(matConstant, PiiDsp::Biorthogonal, 2, 2));
+    QList<PiiMatrix<float> > lstLevel1(PiiDsp::dwtSubbands(matConstant, 1));
+    QList<PiiMatrix<float> > lstLevel2(PiiDsp::dwtSubbands(matConstant, 2));
+    QCOMPARE(lstLevel1[3].rows(), 6);
+    QCOMPARE(lstLevel1[3].columns(), 3);
+    QCOMPARE(lstLevel2[0].rows(), 4);
+    QCOMPARE(lstLevel2[0].columns(), 2);
+    for (int i=1; i<4; ++i)
+      {
+        QVERIFY(Pii::almostEqual(lstLevel1[i], PiiMatrix<float>(lstLevel1[i].rows(), lstLevel1[i].columns()), 1e-5f));
+        QVERIFY(Pii::almostEqual(lstLevel2[i], PiiMatrix<float>(lstLevel2[i].rows(), lstLevel2[i].columns()), 1e-5f));
+      }
+    QVERIFY(Pii::almostEqual(lstLevel2[0], PiiMatrix<float>(4, 2, 4.0f, 4.0f, 4.0f, 4.0f, 4.0f, 4.0f, 4.0f, 4.0f), 1e-4f));
+  }
+  {
+    // Multi-threaded transform equals single-threaded
+    PiiMatrix<double> matLarge(97,131);
+    for (int r=0; r<matLarge.rows(); ++r)
+      for (int c=0; c<matLarge.columns(); ++c)
+        matLarge(r,c) = (r*31 + c*17) % 23;
+    PiiMatrix<double> matSingle(matLarge), matMulti(matLarge);
+    PiiDsp::liftingDwt(matSingle, PiiDsp::Daubechies, 2, 3, 1);
+    PiiDsp::liftingDwt(matMulti, PiiDsp::Daubechies, 2, 3, 4);
+    QVERIFY(Pii::equals(matSingle, matMulti));
+  }
+  PiiMatrix<double> matBuffer(mat);
+  QVERIFY(!PiiDsp::liftingDwt(matBuffer, PiiDsp::Daubechies, 5));
+  QVERIFY(Pii::equals(matBuffer, mat));
+}
+
 QTEST_MAIN(TestPiiDsp)
@@ -24,6 +24,7 @@ class TestPiiEngine : public QObject
 
 private slots:
   void usedPluginLibraryNames();
+  void lazyPlugins();
 };
 
 #endif //_TESTPIIENGINE_H
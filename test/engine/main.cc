@@ -18,6 +18,8 @@
 #include <QtTest>
 
 #include <PiiEngine.h>
+#include <QDir>
+#include <QFile>
 
 void TestPiiEngine::usedPluginLibraryNames()
 {
@@ -31,4 +33,34 @@ void TestPiiEngine::usedPluginLibraryNames()
   QCOMPARE(e.usedPluginLibraryNames(), QStringList() << "piibase" << "piiflowcontrol");
 }
 
+void TestPiiEngine::lazyPlugins()
+{
+  QString strManifest(QDir::tempPath() + "/testpiiengine_manifest.ini");
+  QFile::remove(strManifest);
+  PiiEngine::setPluginManifestFile(strManifest);
+  PiiEngine::unloadPlugin("piiflowcontrol", true);
+
+  // No manifest yet -> the plug-in must be loaded.
+  PiiEngine::registerPlugin("piiflowcontrol");
+  QVERIFY(PiiEngine::isLoaded("piiflowcontrol"));
+  QVERIFY(QFile::exists(strManifest));
+  PiiEngine::unloadPlugin("piiflowcontrol", true);
+
+  // Valid manifest -> classes are registered, library stays unloaded.
+  PiiEngine::registerPlugin("piiflowcontrol");
+  QVERIFY(!PiiEngine::isLoaded("piiflowcontrol"));
+  QVERIFY(PiiEngine::registeredClasses("PiiOperation").contains("PiiPisoOperation"));
+
+  {
+    // Creating an operation loads the library on demand.
+    PiiEngine e;
+    QVERIFY(e.createOperation("PiiPisoOperation") != 0);
+    QVERIFY(PiiEngine::isLoaded("piiflowcontrol"));
+    QVERIFY(!PiiEngine::registeredClasses().contains("PiiPisoOperation"));
+  }
+
+  PiiEngine::setPluginManifestFile(QString());
+  QFile::remove(strManifest);
+}
+
 QTEST_MAIN(TestPiiEngine)
@@ -33,6 +33,7 @@ private slots:
   void scaleLinearInterpolation();
   void scaleColor();
   void rotate();
+  void compactRemap();
   void colorChannel();
   void setColorChannel();
   void detectEdges();
@@ -43,6 +44,8 @@ private slots:
   void intFilter();
   void maxFilter();
   void minFilter();
+  void localStatistics();
+  void fastCorners();
 
   // Thresholding
   void threshold();
@@ -30,6 +30,8 @@
 #include <PiiMaskGenerator.h>
 #include <PiiColor.h>
 #include <PiiImageDistortions.h>
+#include <PiiLocalStatistics.h>
+#include <PiiFastCornerDetector.h>
 
 #include <functional>
 
@@ -879,6 +881,45 @@ void TestPiiImage::rotate()
                                                                     8,5,2)));
 }
 
+void TestPiiImage::compactRemap()
+{
+  PiiMatrix<uchar> mat(3,4,
+                       0, 10, 20, 30,
+                       40, 50, 60, 70,
+                       80, 90, 100, 110);
+  PiiMatrix<PiiPoint<double> > map(3,3);
+  map(0,0) = PiiPoint<double>(0, 0);
+  map(0,1) = PiiPoint<double>(0.5, 0.5);
+  map(0,2) = PiiPoint<double>(3, 2); // bottom right corner
+  map(1,0) = PiiPoint<double>(2.25, 1);
+  map(1,1) = PiiPoint<double>(-0.5, 1); // outside
+  map(1,2) = PiiPoint<double>(1, 2.5); // last row
+  map(2,0) = PiiPoint<double>(3.5, 0.5); // last column
+  map(2,1) = PiiPoint<double>(3.999, 2.999); // rounds past the corner
+  map(2,2) = PiiPoint<double>(1, 3); // outside
+
+  const PiiMatrix<uchar> matExpected(3,3,
+                                     0, 25, 110,
+                                     63, 0, 90,
+                                     50, 110, 0);
+  PiiCompactCoordinateMap compactMap(map, 3, 4);
+  for (int iThreads = 1; iThreads <= 2; ++iThreads)
+    {
+      PiiMatrix<uchar> matResult(PiiImage::remap(mat, compactMap, iThreads));
+      QVERIFY(Pii::equals(matResult, matExpected));
+      PiiMatrix<float> matFloatResult(PiiImage::remap(PiiMatrix<float>(mat), compactMap, iThreads));
+      QCOMPARE(matFloatResult(0,1), 25.0f);
+      QCOMPARE(matFloatResult(1,0), 62.5f);
+      QCOMPARE(matFloatResult(1,2), 90.0f);
+      QCOMPARE(matFloatResult(2,0), 50.0f);
+    }
+  // Tiling must not change the result.
+  compactMap.setTileSize(1);
+  QVERIFY(Pii::equals(PiiImage::remap(mat, compactMap), matExpected));
+  // Wrong source size produces a black image.
+  QVERIFY(Pii::equals(PiiImage::remap(PiiMatrix<uchar>(2,2), compactMap), PiiMatrix<uchar>(3,3)));
+}
+
 void TestPiiImage::colorChannel()
 {
   PiiMatrix<PiiColor4<> > img(4,4);
@@ -1260,7 +1301,57 @@ void TestPiiImage::histogram()
         }
     }
 
-
+  // Banked and threaded counting equals a single pass over the
+  // pixels. The image is tall enough to be split into three bands of
+  // rows.
+  PiiMatrix<int> matImage(PiiMatrix<int>::uninitialized(3800, 53));
+  PiiMatrix<bool> matMask(PiiMatrix<bool>::uninitialized(3800, 53));
+  for (int r=0; r<matImage.rows(); ++r)
+    for (int c=0; c<matImage.columns(); ++c)
+      {
+        matImage(r,c) = (r * 31 + c * c * 7) % 301;
+        matMask(r,c) = (r + c) % 3 != 0;
+      }
+  PiiMatrix<int> matFull(1, 256), matMasked(1, 256), matArea(1, 256);
+  for (int r=0; r<matImage.rows(); ++r)
+    for (int c=0; c<matImage.columns(); ++c)
+      if (matImage(r,c) < 256)
+        {
+          ++matFull(0, matImage(r,c));
+          if (matMask(r,c))
+            ++matMasked(0, matImage(r,c));
+          if (r >= 5 && r < 45 && c >= 3 && c < 33)
+            ++matArea(0, matImage(r,c));
+        }
+  QVERIFY(Pii::equals(PiiImage::histogram(matImage, 256), matFull));
+  QVERIFY(Pii::equals(PiiImage::histogram(matImage, matMask, 256), matMasked));
+  QVERIFY(Pii::equals(PiiImage::histogram(matImage, PiiRectangle<int>(3, 5, 30, 40), 256), matArea));
+  QCOMPARE(Pii::parallelBandCount(matImage.rows(), 3, Pii::reductionMinBandRows(matImage.columns())), 3);
+  for (int iThreads=0; iThreads<4; ++iThreads)
+    {
+      QVERIFY(Pii::equals(PiiImage::histogram(matImage, PiiImage::DefaultRoi(), 256, iThreads), matFull));
+      QVERIFY(Pii::equals(PiiImage::histogram(matImage, matMask, 256, iThreads), matMasked));
+    }
+  // A large histogram is counted in a single bank.
+  QCOMPARE(PiiImage::histogram(matImage, PiiImage::DefaultRoi(), 5000, 3).columns(), 5000);
+  QVERIFY(Pii::equals(PiiMatrix<int>(PiiImage::histogram(matImage, 5000)(0,0,1,256)), matFull));
+
+  PiiQuantizer<int> quantizer(PiiMatrix<int>(1,2, 100,200));
+  PiiMatrix<int> matQuantized(1, 3);
+  for (int r=0; r<matImage.rows(); ++r)
+    for (int c=0; c<matImage.columns(); ++c)
+      if (matMask(r,c))
+        ++matQuantized(0, quantizer.quantize(matImage(r,c)));
+  QVERIFY(Pii::equals(PiiImage::histogram(matImage, matMask, quantizer, 2), matQuantized));
+
+  PiiMatrix<int> matSmall(matImage.mapped(std::modulus<int>(), 64));
+  PiiMatrix<unsigned char> matBytes(matSmall);
+  QVERIFY(Pii::equals(PiiImage::histogram(matBytes, matMask, 256, 2),
+                      PiiImage::histogram(matSmall, matMask, 256)));
+
+  // Equalization with a precalculated histogram
+  QVERIFY(Pii::equals(PiiImage::equalize(matSmall, PiiImage::histogram(matSmall, 64)),
+                      PiiImage::equalize(matSmall, 64)));
 }
 void TestPiiImage::cumulative()
 {
@@ -2316,6 +2407,215 @@ void TestPiiImage::minFilter()
                        0,0,0,2,2,2,2,2);
 
   QVERIFY(Pii::equals(PiiImage::minFilter(img,3,5), res));
+
+  // Windows larger than the image are clamped to its size.
+  PiiMatrix<uchar> res2(7, 8,
+                        2,1,0,0,0,0,0,0,
+                        2,1,0,0,0,0,0,0,
+                        0,0,0,0,0,0,0,0,
+                        0,0,0,0,0,0,0,0,
+                        0,0,0,0,0,0,0,0,
+                        0,0,0,0,0,1,1,1,
+                        0,0,0,0,0,2,2,2);
+  QVERIFY(Pii::equals(PiiImage::minFilter(img,10,30), res2));
+}
+
+void TestPiiImage::localStatistics()
+{
+  PiiMatrix<uchar> img(4, 5,
+                       1,2,3,4,5,
+                       2,4,6,8,9,
+                       0,0,0,0,0,
+                       9,9,1,1,1);
+  PiiLocalStatistics<uchar> stats(img);
+  QCOMPARE(stats.rows(), 4);
+  QCOMPARE(stats.columns(), 5);
+  QCOMPARE(stats.sum(0, 0, 2, 2), 9LL);
+  QCOMPARE(stats.sumOfSquares(0, 0, 2, 2), 25LL);
+  QCOMPARE(stats.mean(0, 0, 4, 5), 3.25);
+  QCOMPARE(stats.variance(0, 0, 2, 2), 1.1875);
+  double dMean = 0;
+  QCOMPARE(stats.variance(2, 0, 3, 5, &dMean), 0.0);
+  QCOMPARE(dMean, 0.0);
+
+  // Windows are clipped at the borders
+  PiiMatrix<float> matMean(stats.meanImage<float>(3));
+  QCOMPARE(matMean(0,0), 2.25f);
+  QCOMPARE(matMean(1,1), 2.0f);
+  QCOMPARE(matMean(3,4), 0.5f);
+
+  PiiMatrix<float> matVar(stats.varianceImage<float>(1, 3));
+  QCOMPARE(matVar(2,2), 0.0f);
+  QCOMPARE(matVar(3,0), 0.0f);
+  QVERIFY(Pii::almostEqualRel(matVar(0,1), 2.0f/3, 1e-6f));
+
+  PiiMatrix<uchar> matContrast(PiiImage::localContrast(img, 3));
+  QCOMPARE(int(matContrast(0,0)), 3);
+  QCOMPARE(int(matContrast(2,2)), 9);
+  QCOMPARE(int(matContrast(3,4)), 1);
+
+  // Multi-threaded results equal single-threaded ones.
+  PiiMatrix<int> matLarge(123, 211);
+  for (int r=0; r<matLarge.rows(); ++r)
+    for (int c=0; c<matLarge.columns(); ++c)
+      matLarge(r,c) = (r*37 + c*101) % 255;
+  QVERIFY(Pii::equals(PiiImage::localMaximum(matLarge, 7, 9, 4), PiiImage::localMaximum(matLarge, 7, 9)));
+  QVERIFY(Pii::equals(PiiLocalStatistics<int>(matLarge, true, 4).varianceImage<double>(15),
+                      PiiLocalStatistics<int>(matLarge).varianceImage<double>(15)));
+}
+
+// Straightforward FAST-9 segment test for reference.
+static bool isFastCorner(const PiiMatrix<uchar>& img, int r, int c, int threshold)
+{
+  static const int aX[16] = { 0, 1, 2, 3, 3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1 };
+  static const int aY[16] = { 3, 3, 2, 1, 0, -1, -2, -3, -3, -3, -2, -1, 0, 1, 2, 3 };
+  for (int iSign=-1; iSign<=1; iSign += 2)
+    for (int iStart=0; iStart<16; ++iStart)
+      {
+        int i=0;
+        for (; i<9; ++i)
+          {
+            const int j = (iStart + i) % 16;
+            if (iSign * (int(img(r+aY[j], c+aX[j])) - int(img(r,c))) <= threshold)
+              break;
+          }
+        if (i == 9)
+          return true;
+      }
+  return false;
+}
+
+void TestPiiImage::fastCorners()
+{
+  PiiMatrix<uchar> img(64, 80);
+  for (int r=0; r<img.rows(); ++r)
+    for (int c=0; c<img.columns(); ++c)
+      img(r,c) = uchar(((r/8 + c/11) % 2) * 100 + (r*r*7 + c*13) % 61);
+
+  PiiFastCornerDetector detector(20);
+  detector.setNonMaximumSuppression(false);
+  QVector<double> vecScores;
+  PiiMatrix<int> matCorners(detector.detect(img, &vecScores));
+  QCOMPARE(vecScores.size(), matCorners.rows());
+  int iCorner = 0;
+  for (int r=3; r<img.rows()-3; ++r)
+    for (int c=3; c<img.columns()-3; ++c)
+      if (isFastCorner(img, r, c, 20))
+        {
+          QVERIFY(iCorner < matCorners.rows());
+          QCOMPARE(matCorners(iCorner,0), c);
+          QCOMPARE(matCorners(iCorner,1), r);
+          // The score is the largest threshold that still detects
+          // the corner.
+          const int iScore = int(vecScores[iCorner]);
+          QVERIFY(iScore >= 20);
+          QVERIFY(isFastCorner(img, r, c, iScore));
+          QVERIFY(iScore == 254 || !isFastCorner(img, r, c, iScore+1));
+          ++iCorner;
+        }
+  QCOMPARE(iCorner, matCorners.rows());
+  QVERIFY(iCorner > 0);
+
+  // Suppression retains local maxima only.
+  detector.setNonMaximumSuppression(true);
+  PiiMatrix<int> matSuppressed(detector.detect(img));
+  QVERIFY(matSuppressed.rows() > 0);
+  QVERIFY(matSuppressed.rows() < matCorners.rows());
+  detector.setThreadCount(3);
+  QVERIFY(Pii::equals(matSuppressed, detector.detect(img)));
+
+  // Reference corners (x,y) detected by the original fast9
+  // implementation in the top left corner of the image.
+  PiiMatrix<uchar> imgCorner(img(0,0,24,32));
+  PiiMatrix<int> matReference(25,2,
+                              10,5, 19,5, 13,6, 23,6, 19,7,
+                              3,8, 7,8, 26,8, 7,10, 12,10,
+                              16,12, 21,12, 7,14, 13,14, 24,14,
+                              12,16, 22,16, 4,17, 18,17, 28,17,
+                              9,18, 12,18, 20,18, 23,18, 10,20);
+  QVERIFY(Pii::equals(PiiImage::detectFastCorners(imgCorner, uchar(20)), matReference));
+  QVERIFY(Pii::equals(PiiImage::detectFastCorners(imgCorner, uchar(20), 2), matReference));
+  detector.setThreadCount(1);
+
+  // An image tall enough to be split into three bands of rows. The
+  // noise creates adjacent corners on all rows, and corners next to
+  // band seams need the scores of the neighboring band.
+  PiiMatrix<uchar> imgTall(PiiMatrix<uchar>::uninitialized(5000, 40));
+  for (int r=0; r<imgTall.rows(); ++r)
+    for (int c=0; c<imgTall.columns(); ++c)
+      imgTall(r,c) = uchar((r*r*7 + c*c*13 + r*c*5) % 251);
+  QCOMPARE(Pii::parallelBandCount(imgTall.rows(), 3, Pii::reductionMinBandRows(imgTall.columns())), 3);
+  detector.setThreadCount(3);
+  detector.setNonMaximumSuppression(false);
+  matCorners = detector.detect(imgTall, &vecScores);
+  PiiMatrix<int> matScores(imgTall.rows(), imgTall.columns());
+  iCorner = 0;
+  for (int r=3; r<imgTall.rows()-3; ++r)
+    for (int c=3; c<imgTall.columns()-3; ++c)
+      if (isFastCorner(imgTall, r, c, 20))
+        {
+          QVERIFY(iCorner < matCorners.rows());
+          QCOMPARE(matCorners(iCorner,0), c);
+          QCOMPARE(matCorners(iCorner,1), r);
+          const int iScore = int(vecScores[iCorner]);
+          QVERIFY(isFastCorner(imgTall, r, c, iScore));
+          QVERIFY(iScore == 254 || !isFastCorner(imgTall, r, c, iScore+1));
+          matScores(r,c) = iScore;
+          ++iCorner;
+        }
+  QCOMPARE(iCorner, matCorners.rows());
+
+  // Suppress corners whose 8-neighbors score at least as high.
+  QVector<int> vecSuppressed;
+  for (int r=3; r<imgTall.rows()-3; ++r)
+    for (int c=3; c<imgTall.columns()-3; ++c)
+      {
+        const int iScore = matScores(r,c);
+        bool bMaximum = iScore > 0;
+        for (int dr=-1; dr<=1 && bMaximum; ++dr)
+          for (int dc=-1; dc<=1; ++dc)
+            if ((dr != 0 || dc != 0) && matScores(r+dr,c+dc) >= iScore)
+              bMaximum = false;
+        if (bMaximum)
+          vecSuppressed << c << r;
+      }
+  QVERIFY(vecSuppressed.size() > 0);
+  detector.setNonMaximumSuppression(true);
+  matSuppressed = detector.detect(imgTall);
+  QCOMPARE(matSuppressed.rows(), vecSuppressed.size() / 2);
+  for (int i=0; i<matSuppressed.rows(); ++i)
+    {
+      QCOMPARE(matSuppressed(i,0), vecSuppressed[2*i]);
+      QCOMPARE(matSuppressed(i,1), vecSuppressed[2*i+1]);
+    }
+  detector.setThreadCount(1);
+  QVERIFY(Pii::equals(detector.detect(imgTall), matSuppressed));
+
+  // Grid selection
+  detector.setGridSize(16);
+  detector.setCornersPerCell(1);
+  PiiMatrix<int> matGrid(detector.detect(img));
+  QVERIFY(matGrid.rows() > 0);
+  QVERIFY(matGrid.rows() <= 4*5);
+  for (int i=0; i<matGrid.rows(); ++i)
+    for (int j=0; j<i; ++j)
+      QVERIFY(matGrid(i,0)/16 != matGrid(j,0)/16 || matGrid(i,1)/16 != matGrid(j,1)/16);
+  detector.setMaxCorners(3);
+  QCOMPARE(detector.detect(img, &vecScores).rows(), 3);
+  QVERIFY(vecScores[0] >= 20);
+
+  // Pyramid levels are mapped to the original coordinates.
+  detector = PiiFastCornerDetector(20);
+  detector.setLevels(2);
+  QVector<int> vecLevels;
+  matCorners = detector.detect(img, 0, &vecLevels);
+  QCOMPARE(vecLevels.size(), matCorners.rows());
+  QVERIFY(vecLevels.contains(1));
+  for (int i=0; i<matCorners.rows(); ++i)
+    {
+      QVERIFY(matCorners(i,0) >= 3 && matCorners(i,0) < img.columns()-3);
+      QVERIFY(matCorners(i,1) >= 3 && matCorners(i,1) < img.rows()-3);
+    }
 }
 
 struct GradientPicker
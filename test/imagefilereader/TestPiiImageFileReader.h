@@ -0,0 +1,49 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+
+#ifndef _TESTPIIIMAGEFILEREADER_H
+#define _TESTPIIIMAGEFILEREADER_H
+
+#include <PiiOperationTest.h>
+#include <PiiMatrix.h>
+#include <QStringList>
+#include <QMutex>
+
+class TestPiiImageFileReader : public PiiOperationTest
+{
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void cleanupTestCase();
+  void prefetch_data();
+  void prefetch();
+  void stopWhilePrefetching();
+
+  void capture(const QString& name, const PiiVariant& obj);
+
+private:
+  bool readAll(int prefetchCount, int decoderThreadCount);
+  int capturedCount();
+
+  QStringList _lstFiles;
+  QMutex _mutex;
+  QStringList _lstCapturedNames;
+  QList<PiiMatrix<unsigned char> > _lstCapturedImages;
+};
+
+
+#endif //_TESTPIIIMAGEFILEREADER_H
@@ -0,0 +1,154 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+
+#include "TestPiiImageFileReader.h"
+
+#include <PiiYdinTypes.h>
+#include <PiiTimer.h>
+#include <PiiSynchronized.h>
+#include <QtTest>
+#include <QImage>
+#include <QDir>
+
+void TestPiiImageFileReader::initTestCase()
+{
+  QVERIFY(createOperation("piiimage", "PiiImageFileReader"));
+
+  QVERIFY(QDir(".").mkdir("images"));
+  for (int i=0; i<12; ++i)
+    {
+      QImage img(20, 12, QImage::Format_RGB32);
+      for (int y=0; y<img.height(); ++y)
+        for (int x=0; x<img.width(); ++x)
+          img.setPixel(x, y, qRgb((x*13 + i*29) % 256, (y*7 + i*11) % 256, (x*y + i) % 256));
+      QString strName = QString("images/%1.png").arg(i, 2, 10, QChar('0'));
+      QVERIFY(img.save(strName));
+      _lstFiles << strName;
+    }
+
+  operation()->setProperty("fileNames", _lstFiles);
+  operation()->setProperty("imageType", "GrayScale");
+  operation()->setProperty("repeatCount", 2);
+
+  connect(this, SIGNAL(objectReceived(QString,PiiVariant)),
+          this, SLOT(capture(QString,PiiVariant)), Qt::DirectConnection);
+}
+
+void TestPiiImageFileReader::cleanupTestCase()
+{
+  for (int i=0; i<_lstFiles.size(); ++i)
+    QFile(_lstFiles[i]).remove();
+  QDir(".").rmdir("images");
+}
+
+void TestPiiImageFileReader::capture(const QString& name, const PiiVariant& obj)
+{
+  QMutexLocker lock(&_mutex);
+  if (name == "filename" && obj.type() == PiiYdin::QStringType)
+    _lstCapturedNames << obj.valueAs<QString>();
+  else if (name == "image" && obj.type() == PiiYdin::UnsignedCharMatrixType)
+    _lstCapturedImages << obj.valueAs<PiiMatrix<unsigned char> >();
+}
+
+int TestPiiImageFileReader::capturedCount()
+{
+  QMutexLocker lock(&_mutex);
+  return _lstCapturedNames.size();
+}
+
+bool TestPiiImageFileReader::readAll(int prefetchCount, int decoderThreadCount)
+{
+  synchronized (_mutex)
+    {
+      _lstCapturedNames.clear();
+      _lstCapturedImages.clear();
+    }
+  operation()->setProperty("prefetchCount", prefetchCount);
+  operation()->setProperty("decoderThreadCount", decoderThreadCount);
+  // The reader may run through all images before start() sees it
+  // running. The result is checked by waiting for the end instead.
+  start();
+  return operation()->wait(5000) && operation()->state() == PiiOperation::Stopped;
+}
+
+void TestPiiImageFileReader::prefetch_data()
+{
+  QTest::addColumn<int>("prefetchCount");
+  QTest::addColumn<int>("decoderThreadCount");
+
+  QTest::newRow("1 image, 1 thread") << 1 << 1;
+  QTest::newRow("4 images, 3 threads") << 4 << 3;
+  QTest::newRow("30 images, 8 threads") << 30 << 8;
+  QTest::newRow("8 images, all cores") << 8 << 0;
+}
+
+void TestPiiImageFileReader::prefetch()
+{
+  QFETCH(int, prefetchCount);
+  QFETCH(int, decoderThreadCount);
+
+  // Synchronous reference
+  QVERIFY(readAll(0, 0));
+  QStringList lstNames(_lstCapturedNames);
+  QList<PiiMatrix<unsigned char> > lstImages(_lstCapturedImages);
+  QCOMPARE(lstNames.size(), _lstFiles.size() * 2);
+  QCOMPARE(lstImages.size(), lstNames.size());
+  for (int i=0; i<lstNames.size(); ++i)
+    QCOMPARE(lstNames[i], _lstFiles[i % _lstFiles.size()]);
+
+  QVERIFY(readAll(prefetchCount, decoderThreadCount));
+  QCOMPARE(_lstCapturedNames, lstNames);
+  QCOMPARE(_lstCapturedImages.size(), lstImages.size());
+  for (int i=0; i<lstImages.size(); ++i)
+    QVERIFY(Pii::equals(_lstCapturedImages[i], lstImages[i]));
+}
+
+void TestPiiImageFileReader::stopWhilePrefetching()
+{
+  operation()->setProperty("repeatCount", 0);
+  operation()->setProperty("prefetchCount", 8);
+  operation()->setProperty("decoderThreadCount", 4);
+
+  for (int iRun=0; iRun<3; ++iRun)
+    {
+      synchronized (_mutex)
+        {
+          _lstCapturedNames.clear();
+          _lstCapturedImages.clear();
+        }
+      QVERIFY(start());
+      PiiTimer timer;
+      while (capturedCount() < 20 && timer.milliseconds() < 5000)
+        QTest::qWait(10);
+      QVERIFY(capturedCount() >= 20);
+
+      // Decoders must not block stopping even if the queue is full.
+      QVERIFY(stop());
+      QCOMPARE(int(operation()->state()), int(PiiOperation::Stopped));
+
+      // Each run must start over from the first image.
+      synchronized (_mutex)
+        {
+          QCOMPARE(_lstCapturedNames[0], _lstFiles[0]);
+          for (int i=1; i<_lstCapturedNames.size(); ++i)
+            QCOMPARE(_lstCapturedNames[i], _lstFiles[i % _lstFiles.size()]);
+        }
+    }
+
+  operation()->setProperty("repeatCount", 2);
+}
+
+QTEST_MAIN(TestPiiImageFileReader)
@@ -0,0 +1,212 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+
+#include "TestPiiImageFileWriter.h"
+
+#include <PiiMatrix.h>
+#include <PiiTimer.h>
+#include <QtTest>
+#include <QImage>
+#include <QDir>
+#include <QThread>
+
+#ifndef Q_OS_WIN
+#  include <sys/file.h>
+#endif
+
+#if QT_VERSION < 0x050000
+#  define FLOCK_SKIP QSKIP("File locking is not available", SkipAll)
+#else
+#  define FLOCK_SKIP QSKIP("File locking is not available")
+#endif
+
+namespace
+{
+  PiiMatrix<unsigned char> testImage(int index)
+  {
+    PiiMatrix<unsigned char> matImage(12, 16);
+    for (int r=0; r<matImage.rows(); ++r)
+      for (int c=0; c<matImage.columns(); ++c)
+        matImage(r,c) = (r*16 + c*3 + index*7) % 256;
+    return matImage;
+  }
+
+  QString fileName(int index)
+  {
+    return QString("written/img%1.bmp").arg(index, 6, 10, QChar('0'));
+  }
+
+  // Closes a file (and releases its lock) after a delay.
+  class DelayedClose : public QThread
+  {
+  public:
+    DelayedClose(QFile* file) : _pFile(file) {}
+
+  protected:
+    void run()
+    {
+      msleep(200);
+      _pFile->close();
+    }
+
+  private:
+    QFile* _pFile;
+  };
+}
+
+void TestPiiImageFileWriter::initTestCase()
+{
+  QVERIFY(createOperation("piiimage", "PiiImageFileWriter"));
+  QVERIFY(QDir(".").mkdir("written"));
+
+  operation()->setProperty("outputDirectory", "written");
+  operation()->setProperty("namePrefix", "img");
+  operation()->setProperty("extension", "bmp");
+  QVERIFY(connectInput("image"));
+}
+
+void TestPiiImageFileWriter::cleanupTestCase()
+{
+  removeFiles();
+  QDir(".").rmdir("written");
+}
+
+void TestPiiImageFileWriter::removeFiles()
+{
+  QDir dir("written");
+  QStringList lstFiles = dir.entryList(QDir::Files);
+  for (int i=0; i<lstFiles.size(); ++i)
+    dir.remove(lstFiles[i]);
+}
+
+void TestPiiImageFileWriter::writeBehind_data()
+{
+  QTest::addColumn<int>("queueSize");
+  QTest::addColumn<int>("encoderThreadCount");
+
+  QTest::newRow("synchronous") << 0 << 1;
+  QTest::newRow("1 image, 1 thread") << 1 << 1;
+  QTest::newRow("4 images, 2 threads") << 4 << 2;
+  QTest::newRow("16 images, all cores") << 16 << 0;
+}
+
+void TestPiiImageFileWriter::writeBehind()
+{
+  QFETCH(int, queueSize);
+  QFETCH(int, encoderThreadCount);
+
+  removeFiles();
+  operation()->setProperty("queueSize", queueSize);
+  operation()->setProperty("encoderThreadCount", encoderThreadCount);
+  operation()->setProperty("overflowPolicy", "BlockWhenFull");
+  operation()->setProperty("lockFiles", false);
+  QVERIFY(start());
+
+  const int iCount = 40;
+  for (int i=0; i<iCount; ++i)
+    {
+      QVERIFY(sendObject("image", testImage(i)));
+      QCOMPARE(outputValue("filename", QString()), fileName(i));
+    }
+
+  // Pending images must be written before the operation stops.
+  QVERIFY(stop());
+  QCOMPARE(operation()->property("queueDepth").toInt(), 0);
+  QCOMPARE(operation()->property("droppedImageCount").toInt(), 0);
+
+  for (int i=0; i<iCount; ++i)
+    {
+      QImage img;
+      QVERIFY(img.load(fileName(i)));
+      PiiMatrix<unsigned char> matExpected(testImage(i));
+      QCOMPARE(img.height(), matExpected.rows());
+      QCOMPARE(img.width(), matExpected.columns());
+      for (int r=0; r<img.height(); ++r)
+        for (int c=0; c<img.width(); ++c)
+          QCOMPARE(qGray(img.pixel(c,r)), int(matExpected(r,c)));
+    }
+}
+
+void TestPiiImageFileWriter::overflow_data()
+{
+  QTest::addColumn<QString>("overflowPolicy");
+  QTest::addColumn<int>("droppedImageCount");
+  QTest::addColumn<int>("droppedIndex");
+
+  QTest::newRow("block") << "BlockWhenFull" << 0 << -1;
+  QTest::newRow("drop oldest") << "DropOldest" << 1 << 1;
+  QTest::newRow("drop newest") << "DropNewest" << 1 << 3;
+}
+
+void TestPiiImageFileWriter::overflow()
+{
+#ifdef Q_OS_WIN
+  FLOCK_SKIP;
+#else
+  QFETCH(QString, overflowPolicy);
+  QFETCH(int, droppedImageCount);
+  QFETCH(int, droppedIndex);
+
+  removeFiles();
+  operation()->setProperty("queueSize", 2);
+  operation()->setProperty("encoderThreadCount", 1);
+  operation()->setProperty("overflowPolicy", overflowPolicy);
+  operation()->setProperty("lockFiles", true);
+
+  // Holding a lock to the first file stalls the only encoder thread.
+  QFile lockedFile(fileName(0));
+  QVERIFY(lockedFile.open(QIODevice::ReadWrite));
+  QVERIFY(flock(lockedFile.handle(), LOCK_EX) == 0);
+
+  QVERIFY(start());
+  QVERIFY(sendObject("image", testImage(0)));
+  PiiTimer timer;
+  while (operation()->property("queueDepth").toInt() != 0 && timer.milliseconds() < 2000)
+    QTest::qWait(5);
+  QCOMPARE(operation()->property("queueDepth").toInt(), 0);
+
+  // Fill the queue.
+  QVERIFY(sendObject("image", testImage(1)));
+  QVERIFY(sendObject("image", testImage(2)));
+  QCOMPARE(operation()->property("queueDepth").toInt(), 2);
+
+  if (droppedIndex == -1)
+    {
+      // Blocks until the encoder gets the lock and takes the next job.
+      DelayedClose closer(&lockedFile);
+      closer.start();
+      timer.restart();
+      QVERIFY(sendObject("image", testImage(3)));
+      QVERIFY(timer.milliseconds() >= 100);
+      closer.wait();
+    }
+  else
+    {
+      QVERIFY(sendObject("image", testImage(3)));
+      QCOMPARE(operation()->property("queueDepth").toInt(), 2);
+      lockedFile.close();
+    }
+  QCOMPARE(outputValue("filename", QString()), fileName(3));
+
+  QVERIFY(stop());
+  QCOMPARE(operation()->property("droppedImageCount").toInt(), droppedImageCount);
+  QVERIFY(QFileInfo(fileName(0)).size() > 0);
+  for (int i=1; i<4; ++i)
+    QCOMPARE(QFile::exists(fileName(i)), i != droppedIndex);
+#endif
+}
+
+QTEST_MAIN(TestPiiImageFileWriter)
@@ -0,0 +1,2 @@
+include(../unit_test.pri)
+LIBS += -lpiigui$$INTO_LIBV
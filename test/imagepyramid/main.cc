@@ -0,0 +1,98 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "TestPiiImagePyramid.h"
+
+#include <PiiImagePyramid.h>
+#include <QtTest>
+
+namespace
+{
+  // Polls the pyramid until the requested tile is ready.
+  bool waitForTile(PiiImagePyramid& pyramid, int level, int column, int row, QImage* tile)
+  {
+    for (int i=0; i<1000; ++i)
+      {
+        if (pyramid.tile(level, column, row, tile))
+          return true;
+        QTest::qWait(10);
+      }
+    return false;
+  }
+}
+
+void TestPiiImagePyramid::levels()
+{
+  PiiImagePyramid pyramid;
+  QCOMPARE(pyramid.levelCount(), 0);
+
+  pyramid.setImage(QImage(600, 300, QImage::Format_RGB32));
+  QCOMPARE(pyramid.levelCount(), 3);
+  QCOMPARE(pyramid.levelForScale(1.0), 0);
+  QCOMPARE(pyramid.levelForScale(0.5), 1);
+  QCOMPARE(pyramid.levelForScale(0.01), 2);
+  QCOMPARE(pyramid.tileArea(0, 2, 1), QRect(512, 256, 88, 44));
+  QCOMPARE(pyramid.tileArea(1, 1, 0), QRect(512, 0, 88, 300));
+  QCOMPARE(pyramid.tileArea(2, 0, 0), QRect(0, 0, 600, 300));
+}
+
+void TestPiiImagePyramid::tile()
+{
+  QImage image(600, 300, QImage::Format_RGB32);
+  for (int r=0; r<image.height(); ++r)
+    for (int c=0; c<image.width(); ++c)
+      image.setPixel(c, r, qRgb(c % 256, r % 256, (c + r) % 256));
+
+  PiiImagePyramid pyramid;
+  pyramid.setThreadCount(2);
+  pyramid.setImage(image);
+
+  QImage tile;
+  QVERIFY(waitForTile(pyramid, 0, 2, 1, &tile));
+  QCOMPARE(tile.size(), QSize(88, 44));
+  QVERIFY(tile == image.copy(512, 256, 88, 44));
+
+  QVERIFY(waitForTile(pyramid, 2, 0, 0, &tile));
+  QCOMPARE(tile.size(), QSize(150, 75));
+  // The coarse tiles cause the finer ones to be cached.
+  QVERIFY(pyramid.tile(1, 0, 0, &tile));
+  QCOMPARE(tile.size(), QSize(256, 150));
+}
+
+void TestPiiImagePyramid::changeImage()
+{
+  QImage red(4096, 4096, QImage::Format_RGB32), blue(4096, 4096, QImage::Format_RGB32);
+  red.fill(qRgb(255, 0, 0));
+  blue.fill(qRgb(0, 0, 255));
+
+  PiiImagePyramid pyramid;
+  pyramid.setThreadCount(1);
+  pyramid.setImage(red);
+  const int iTopLevel = pyramid.levelCount() - 1;
+  QImage tile;
+  QVERIFY(!pyramid.tile(iTopLevel, 0, 0, &tile));
+  // Let the worker start generating the top tile, which requires all
+  // tiles on the finer levels.
+  QTest::qWait(20);
+
+  // The same tile must be generated again for the new image even
+  // though the old one is still in progress.
+  pyramid.setImage(blue);
+  QVERIFY(!pyramid.tile(iTopLevel, 0, 0, &tile));
+  QVERIFY(waitForTile(pyramid, iTopLevel, 0, 0, &tile));
+  QCOMPARE(tile.pixel(0, 0), qRgb(0, 0, 255));
+}
+
+QTEST_MAIN(TestPiiImagePyramid)
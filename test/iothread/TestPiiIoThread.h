@@ -0,0 +1,61 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _TESTPIIIOTHREAD_H
+#define _TESTPIIIOTHREAD_H
+
+#include <QObject>
+#include <QMutex>
+#include <PiiEmulatorIoDriver.h>
+
+/**
+ * An emulator driver that records the batches of output edges passed
+ * to it by the I/O thread.
+ */
+class RecordingIoDriver : public PiiEmulatorIoDriver
+{
+public:
+  struct Batch
+  {
+    qint64 time;
+    QList<int> lstChannels;
+    QList<bool> lstStates;
+  };
+
+  RecordingIoDriver();
+
+  void setOutputStates(const QList<PiiIoChannel*>& channels, const QList<bool>& states);
+
+  PiiEmulatorIoChannel* outputChannel(int index);
+  QList<Batch> batches() const;
+  // Waits until at least *count* batches have been recorded.
+  bool waitForBatches(int count);
+
+private:
+  mutable QMutex _mutex;
+  QList<Batch> _lstBatches;
+};
+
+class TestPiiIoThread : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void edgeOrder();
+  void pulseMerge();
+  void pulseWidth();
+};
+
+#endif //_TESTPIIIOTHREAD_H
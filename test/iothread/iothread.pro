@@ -0,0 +1,4 @@
+include(../unit_test.pri)
+INCLUDEPATH += $$INTODIR/modules/io/plugin $$INTODIR/modules/io/emulator
+LIBS += -L$$INTODIR/modules/io/$$MODE -lpiiio \
+        -L$$INTODIR/modules/io/emulator/$$MODE -lpiiemulatoriodriver
@@ -0,0 +1,163 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "TestPiiIoThread.h"
+
+#include <QtTest>
+#include <PiiIoThread.h>
+#include <PiiDelay.h>
+
+RecordingIoDriver::RecordingIoDriver()
+{
+  for (int i=0; i<channelCount(); ++i)
+    outputChannel(i)->setChannelMode(PiiDefaultIoChannel::Output);
+}
+
+void RecordingIoDriver::setOutputStates(const QList<PiiIoChannel*>& channels, const QList<bool>& states)
+{
+  Batch batch;
+  batch.time = PiiIoThread::currentTime();
+  for (int i=0; i<channels.size(); ++i)
+    batch.lstChannels << static_cast<PiiDefaultIoChannel*>(channels[i])->channelIndex();
+  batch.lstStates = states;
+  _mutex.lock();
+  _lstBatches << batch;
+  _mutex.unlock();
+  PiiEmulatorIoDriver::setOutputStates(channels, states);
+}
+
+PiiEmulatorIoChannel* RecordingIoDriver::outputChannel(int index)
+{
+  return static_cast<PiiEmulatorIoChannel*>(channel(index));
+}
+
+QList<RecordingIoDriver::Batch> RecordingIoDriver::batches() const
+{
+  QMutexLocker lock(&_mutex);
+  return _lstBatches;
+}
+
+bool RecordingIoDriver::waitForBatches(int count)
+{
+  for (int i=0; i<200; ++i)
+    {
+      if (batches().size() >= count)
+        return true;
+      PiiDelay::msleep(10);
+    }
+  return false;
+}
+
+void TestPiiIoThread::edgeOrder()
+{
+  RecordingIoDriver driver;
+  PiiIoThread thread;
+  thread.start();
+
+  // Edges are added in random order but must fire in deadline order.
+  const qint64 iStart = PiiIoThread::currentTime() + 20000;
+  thread.sendSignal(&driver, driver.outputChannel(3), true, iStart + 30000, 0);
+  thread.sendSignal(&driver, driver.outputChannel(0), true, iStart, 0);
+  thread.sendSignal(&driver, driver.outputChannel(2), true, iStart + 20000, 0);
+  thread.sendSignal(&driver, driver.outputChannel(1), true, iStart + 10000, 0);
+  // Edges due at the same instant are passed in a single batch in
+  // the order they were added ...
+  thread.sendSignal(&driver, driver.outputChannel(5), true, iStart + 40000, 0);
+  thread.sendSignal(&driver, driver.outputChannel(4), true, iStart + 40000, 0);
+  // ... unless they change the same channel twice.
+  thread.sendSignal(&driver, driver.outputChannel(6), true, iStart + 50000, 0);
+  thread.sendSignal(&driver, driver.outputChannel(6), false, iStart + 50000, 0);
+
+  QVERIFY(driver.waitForBatches(7));
+  thread.stop();
+  thread.wait();
+
+  QList<RecordingIoDriver::Batch> lstBatches(driver.batches());
+  QCOMPARE(lstBatches.size(), 7);
+  for (int i=0; i<4; ++i)
+    {
+      QCOMPARE(lstBatches[i].lstChannels, QList<int>() << i);
+      QCOMPARE(lstBatches[i].lstStates, QList<bool>() << true);
+      // Never early
+      QVERIFY(lstBatches[i].time >= iStart + i * 10000);
+    }
+  QCOMPARE(lstBatches[4].lstChannels, QList<int>() << 5 << 4);
+  QCOMPARE(lstBatches[5].lstChannels, QList<int>() << 6);
+  QCOMPARE(lstBatches[5].lstStates, QList<bool>() << true);
+  QCOMPARE(lstBatches[6].lstChannels, QList<int>() << 6);
+  QCOMPARE(lstBatches[6].lstStates, QList<bool>() << false);
+  QVERIFY(!driver.outputChannel(6)->currentState());
+
+  PiiIoThread::TimingStatistics statistics(thread.timingStatistics());
+  QCOMPARE(statistics.iEdgeCount, qint64(8));
+  QVERIFY(statistics.iMinLatency >= 0);
+  QVERIFY(statistics.iMinLatency <= statistics.iMaxLatency);
+}
+
+void TestPiiIoThread::pulseMerge()
+{
+  RecordingIoDriver driver;
+  PiiEmulatorIoChannel* pChannel = driver.outputChannel(0);
+  PiiIoThread thread;
+  thread.start();
+
+  const qint64 iStart = PiiIoThread::currentTime() + 20000;
+  thread.sendSignal(&driver, pChannel, true, iStart, 20000);
+  // An identical pulse is ignored.
+  thread.sendSignal(&driver, pChannel, true, iStart, 20000);
+  // An overlapping pulse extends the first one.
+  thread.sendSignal(&driver, pChannel, true, iStart + 10000, 20000);
+
+  QVERIFY(driver.waitForBatches(2));
+  PiiDelay::msleep(50);
+  thread.stop();
+  thread.wait();
+
+  QList<RecordingIoDriver::Batch> lstBatches(driver.batches());
+  QCOMPARE(lstBatches.size(), 2);
+  QCOMPARE(lstBatches[0].lstStates, QList<bool>() << true);
+  QCOMPARE(lstBatches[1].lstStates, QList<bool>() << false);
+  QVERIFY(lstBatches[1].time >= iStart + 30000);
+  QCOMPARE(pChannel->transitionCount(), 2);
+  QVERIFY(pChannel->lastPulseWidth() > 25000);
+}
+
+void TestPiiIoThread::pulseWidth()
+{
+  // Uses the I/O thread shared by all drivers.
+  RecordingIoDriver driver;
+  PiiEmulatorIoChannel* pChannel = driver.outputChannel(1);
+  pChannel->setPulseWidth(5.0);
+  pChannel->setPulseDelay(10.0);
+  driver.resetTimingStatistics();
+
+  pChannel->activate();
+  QVERIFY(driver.waitForBatches(2));
+
+  QCOMPARE(pChannel->transitionCount(), 2);
+  QVERIFY(!pChannel->currentState());
+  // Both edges go through the same scheduling path, so their errors
+  // mostly cancel out.
+  QVERIFY(qAbs(pChannel->lastPulseWidth() - 5000) < 2000);
+
+  QVariantMap mapStatistics(driver.timingStatistics());
+  QCOMPARE(mapStatistics["edgeCount"].toInt(), 2);
+  const double dMean = mapStatistics["meanLatency"].toDouble();
+  QVERIFY(mapStatistics["minLatency"].toInt() <= dMean);
+  QVERIFY(dMean <= mapStatistics["maxLatency"].toInt());
+  QVERIFY(mapStatistics["stdDevLatency"].toDouble() >= 0);
+}
+
+QTEST_MAIN(TestPiiIoThread)
@@ -18,11 +18,80 @@
 #include <PiiMatching.h>
 #include <PiiMath.h>
 #include <PiiMatrixUtil.h>
+#include <PiiPoint.h>
 
 #include <iostream>
 #include <QtTest>
 #include <QDebug>
 
+namespace
+{
+  // The original, per-pair implementation of
+  // PiiMatching::shapeContextDescriptor() without scale invariance.
+  PiiMatrix<float> referenceShapeContext(const PiiMatrix<int>& boundaryPoints,
+                                         const PiiMatrix<int>& keyPoints,
+                                         int angles,
+                                         const QVector<double>& distances,
+                                         const QVector<double>& directions)
+  {
+    const int iColumns = angles * distances.size();
+    const int iKeyPoints = keyPoints.rows(), iDistances = distances.size();
+    int iBoundaryPoints = boundaryPoints.rows()-1;
+    PiiMatrix<float> matFeatures(iKeyPoints, iColumns);
+    if (boundaryPoints.rowAs<PiiPoint<int> >(0) != boundaryPoints.rowAs<PiiPoint<int> >(iBoundaryPoints))
+      ++iBoundaryPoints;
+
+    double dMaxDistance = distances.last();
+    double dAngleStep = 2*M_PI / qMax(1,angles);
+    const double* pDistances = distances.data();
+
+    for (int i=0; i<iKeyPoints; ++i)
+      {
+        float* pCurrentRow = matFeatures[i];
+        int x = keyPoints(i,0);
+        int y = keyPoints(i,1);
+        for (int j=0; j<iBoundaryPoints; ++j)
+          {
+            int dx = x-boundaryPoints(j,0);
+            int dy = y-boundaryPoints(j,1);
+            double dDistance = dx*dx + dy*dy;
+
+            if (dDistance < dMaxDistance && dDistance != 0)
+              {
+                int iDistanceIndex = 0;
+                for (int c=0; c<iDistances; ++c)
+                  {
+                    if (dDistance < pDistances[c])
+                      iDistanceIndex = c;
+                    else
+                      break;
+                  }
+
+                float dAngle = Pii::atan2((float)dy,(float)dx) + M_PI;
+                if (directions.size() > 0)
+                  {
+                    dAngle -= directions[i];
+                    if (dAngle < 0)
+                      dAngle += 2*M_PI;
+                    else if (dAngle > 2*M_PI)
+                      dAngle -= 2*M_PI;
+                  }
+
+                int iBinIndex = iDistances * int(dAngle / dAngleStep) + iDistanceIndex;
+                if (iBinIndex >= iColumns)
+                  iBinIndex = 0;
+                ++pCurrentRow[iBinIndex];
+              }
+          }
+        float fSum = Pii::accumulateN(pCurrentRow, iColumns, std::plus<float>(), 0.0f);
+        if (fSum != 0)
+          Pii::mapN(pCurrentRow, iColumns, std::bind2nd(std::multiplies<float>(), 1.0f/fSum));
+      }
+
+    return matFeatures;
+  }
+}
+
 void TestPiiMatching::boundaryDirections()
 {
 
@@ -83,6 +152,56 @@ void TestPiiMatching::shapeContextDescriptor()
     //Pii::printMatrix(std::cout, matFeatures, " ", "\n");
     //std::cout << std::endl;
   }
+  {
+    // The result must not depend on the number of threads.
+    PiiMatrix<int> matPoints(0,2);
+    for (int i=0; i<200; ++i)
+      matPoints.appendRow(Pii::round<int>(80*cos(i*M_PI/100) + 5*sin(i*0.7)),
+                          Pii::round<int>(60*sin(i*M_PI/100)));
+    PiiMatrix<int> matKeyPoints(0,2);
+    QVector<double> vecDirections;
+    for (int i=0; i<200; i += 7)
+      {
+        matKeyPoints.appendRow(matPoints[i]);
+        vecDirections << i*M_PI/100 - M_PI;
+      }
+    QVector<double> vecDistances = QVector<double>() << 25 << 100 << 400 << 1600 << INFINITY;
+    PiiMatrix<float> matFeatures = PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints,
+                                                                       12, vecDistances,
+                                                                       vecDirections);
+    QCOMPARE(matFeatures.rows(), matKeyPoints.rows());
+    QCOMPARE(matFeatures.columns(), 60);
+    QVERIFY(Pii::equals(matFeatures,
+                        PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints,
+                                                            12, vecDistances,
+                                                            vecDirections,
+                                                            PiiMatching::NonInvariant, 3)));
+
+    // Compare to the original implementation with ascending and
+    // descending distance limits, with and without rotation. The last
+    // limit is the maximum distance.
+    QVector<double> vecDescending = QVector<double>() << 1600 << 400 << 100 << INFINITY;
+    QVERIFY(Pii::equals(matFeatures,
+                        referenceShapeContext(matPoints, matKeyPoints, 12, vecDistances, vecDirections)));
+    QVERIFY(Pii::equals(PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints, 12, vecDistances),
+                        referenceShapeContext(matPoints, matKeyPoints, 12, vecDistances, QVector<double>())));
+    QVERIFY(Pii::equals(PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints, 12, vecDescending,
+                                                            vecDirections),
+                        referenceShapeContext(matPoints, matKeyPoints, 12, vecDescending, vecDirections)));
+    QVERIFY(Pii::equals(PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints, 7, vecDescending),
+                        referenceShapeContext(matPoints, matKeyPoints, 7, vecDescending, QVector<double>())));
+
+    vecDistances = QVector<double>() << 0.01 << 0.1 << 0.5 << 2;
+    matFeatures = PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints,
+                                                      8, vecDistances,
+                                                      QVector<double>(),
+                                                      PiiMatching::ScaleInvariant);
+    QVERIFY(Pii::equals(matFeatures,
+                        PiiMatching::shapeContextDescriptor(matPoints, matKeyPoints,
+                                                            8, vecDistances,
+                                                            QVector<double>(),
+                                                            PiiMatching::ScaleInvariant, 0)));
+  }
 }
 
 QTEST_MAIN(TestPiiMatching)
@@ -123,6 +123,8 @@ private slots:
   void cumulativeSumAlong();
   void cumulativeSum();
   void fastMovingAverage();
+  void statistics();
+  void parallelReductions();
 
   void setIdentity();
   void setDiagonal();
@@ -2300,6 +2300,85 @@ void TestPiiMath::cumulativeSum()
                                      0, 6, 15, 27)));
 }
 
+void TestPiiMath::statistics()
+{
+  {
+    PiiMatrix<int> mat(3, 2, 1, 1, -1, -1, 2, -2);
+    Pii::Statistics<int> stats = Pii::statistics<double>(mat);
+    QCOMPARE(stats.count(), 6);
+    QCOMPARE(stats.minimum(), -2);
+    QCOMPARE(stats.maximum(), 2);
+    QVERIFY(almostEqual(stats.sum(), 0.0));
+    QVERIFY(almostEqual(stats.sumOfSquares(), 12.0));
+    QVERIFY(almostEqual(stats.mean(), 0.0));
+    QVERIFY(almostEqual(stats.var(), 2.0));
+  }
+  {
+    // Large offset, small spread
+    PiiMatrix<double> mat(1000, 300);
+    for (int r=0; r<mat.rows(); ++r)
+      for (int c=0; c<mat.columns(); ++c)
+        mat(r,c) = 1e8 + ((r + c) % 3);
+    double dMean;
+    double dVar = Pii::var<double>(mat, &dMean);
+    for (int iThreads=1; iThreads<=4; ++iThreads)
+      {
+        Pii::Statistics<double> stats = Pii::statistics<double>(mat, iThreads);
+        QCOMPARE(stats.count(), 300000);
+        QCOMPARE(stats.minimum(), 1e8);
+        QCOMPARE(stats.maximum(), 1e8 + 2);
+        QVERIFY(Pii::almostEqualRel(stats.mean(), dMean, 1e-12));
+        QVERIFY(Pii::almostEqualRel(stats.var(), dVar, 1e-9));
+      }
+  }
+  {
+    // Compensated summation
+    PiiMatrix<float> mat(1000, 1000);
+    mat = 0.1f;
+    QVERIFY(qAbs(Pii::sum<float>(mat) - 1e5f) < 1.0f);
+  }
+  QCOMPARE(Pii::statistics<double>(PiiMatrix<int>()).count(), 0);
+}
+
+void TestPiiMath::parallelReductions()
+{
+  PiiMatrix<int> mat(517, 311);
+  for (int r=0; r<mat.rows(); ++r)
+    for (int c=0; c<mat.columns(); ++c)
+      mat(r,c) = (r * 31 + c * 17) % 101 - 50;
+
+  PiiMatrix<int> matSum(Pii::cumulativeSum<int>(mat, Pii::ZeroBorderCumulativeSum));
+  for (int iThreads=0; iThreads<=5; ++iThreads)
+    {
+      QVERIFY(Pii::equals(Pii::cumulativeSum<int>(mat, Pii::ZeroBorderCumulativeSum, iThreads), matSum));
+      QVERIFY(Pii::equals(Pii::cumulativeSum<int>(mat, Pii::OrdinaryCumulativeSum, iThreads),
+                          matSum(1,1,-1,-1)));
+    }
+
+  int iMin, iMax;
+  Pii::minMax(mat, &iMin, &iMax);
+  QCOMPARE(iMin, -50);
+  QCOMPARE(iMax, 50);
+  QCOMPARE(Pii::max(mat), 50);
+  QCOMPARE(Pii::min(mat), -50);
+  QCOMPARE(Pii::sum<int>(mat), matSum(mat.rows(), mat.columns()));
+
+  PiiMatrix<int> matSorted(1, mat.rows() * mat.columns());
+  std::copy(mat.begin(), mat.end(), matSorted.begin());
+  std::sort(matSorted.begin(), matSorted.end());
+  QCOMPARE(Pii::median(mat), matSorted(0, (matSorted.columns()-1)/2));
+  QCOMPARE(Pii::median(mat(0,0,2,2)), Pii::medianN(PiiMatrix<int>(mat(0,0,2,2)).begin(), 4));
+
+  PiiMatrix<double> matData(2000, 5);
+  for (int r=0; r<matData.rows(); ++r)
+    for (int c=0; c<matData.columns(); ++c)
+      matData(r,c) = std::sin(r * 0.37 + c) * (c + 1);
+  PiiMatrix<double> matCov(Pii::covariance(matData));
+  QVERIFY(Pii::almostEqual(Pii::covariance(matData, 0, 4), matCov, 1e-10));
+  for (int c=0; c<matData.columns(); ++c)
+    QVERIFY(Pii::almostEqualRel(matCov(c,c), Pii::var<double>(matData(0,c,-1,1)) * 2000.0 / 1999.0, 1e-10));
+}
+
 void TestPiiMath::fastMovingAverage()
 {
   PiiMatrix<int> matInput(3, 3,
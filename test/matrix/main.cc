@@ -533,12 +533,16 @@ void TestPiiMatrix::removeColumns()
 void TestPiiMatrix::assignment()
 {
   PiiMatrix<int> a(5,5);
+  QVERIFY(!a.isShared());
   PiiMatrix<int> b(a);
   // Should share the same memory location
   QCOMPARE(a.constRowBegin(0), b.constRowBegin(0));
+  QVERIFY(a.isShared());
   // Should detach a
   a(1,1) = 5;
   QVERIFY(a.constRowBegin(0) != b.constRowBegin(0));
+  QVERIFY(!a.isShared());
+  QVERIFY(!b.isShared());
   PiiMatrix<int> c(a(2,2,2,2));
   QCOMPARE(c.rows(), 2);
   QCOMPARE(c.columns(), 2);
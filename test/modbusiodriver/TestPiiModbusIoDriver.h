@@ -0,0 +1,78 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#ifndef _TESTPIIMODBUSIODRIVER_H
+#define _TESTPIIMODBUSIODRIVER_H
+
+#include <QObject>
+#include <QThread>
+#include <QMutex>
+#include <QVector>
+#include <PiiWaitCondition.h>
+
+class QTcpSocket;
+
+/**
+ * A minimal Modbus-TCP server that serves the read coils, read
+ * discrete inputs, write single coil and write multiple coils
+ * requests from memory and counts them. Each response can be
+ * delayed to simulate network and device latency.
+ */
+class ModbusStandIn : public QThread
+{
+public:
+  ModbusStandIn();
+
+  bool waitForListening();
+  int port() const { return _iPort; }
+  int requestCount() const;
+  void setDiscreteInput(int address, bool state);
+  bool coil(int address) const;
+  void setResponseDelay(int msecs);
+  int responseDelay() const;
+  void stop() { _bRunning = false; }
+
+protected:
+  void run();
+
+private:
+  bool read(QTcpSocket* socket, int bytes, QByteArray& data);
+  QByteArray respond(const QByteArray& request);
+
+  volatile bool _bRunning;
+  int _iPort;
+  int _iRequestCount;
+  int _iResponseDelay;
+  QVector<bool> _vecDiscreteInputs, _vecCoils;
+  mutable QMutex _mutex;
+  PiiWaitCondition _readyCondition;
+};
+
+class TestPiiModbusIoDriver : public QObject
+{
+  Q_OBJECT
+
+private slots:
+  void initTestCase();
+  void batchedPolling();
+  void coalescedWrites();
+  void cleanupTestCase();
+
+private:
+  ModbusStandIn _server;
+};
+
+
+#endif //_TESTPIIMODBUSIODRIVER_H
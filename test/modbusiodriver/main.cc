@@ -0,0 +1,263 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+#include "TestPiiModbusIoDriver.h"
+
+#include <QtTest>
+#include <QTcpServer>
+#include <QTcpSocket>
+
+#include <PiiModbusIoDriver.h>
+#include <PiiModbusIoChannel.h>
+#include <PiiTimer.h>
+
+ModbusStandIn::ModbusStandIn() :
+  _bRunning(true),
+  _iPort(-1),
+  _iRequestCount(0),
+  _iResponseDelay(0),
+  _vecDiscreteInputs(256),
+  _vecCoils(256)
+{}
+
+bool ModbusStandIn::waitForListening()
+{
+  _readyCondition.wait();
+  return _iPort != -1;
+}
+
+int ModbusStandIn::requestCount() const
+{
+  QMutexLocker lock(&_mutex);
+  return _iRequestCount;
+}
+
+void ModbusStandIn::setDiscreteInput(int address, bool state)
+{
+  QMutexLocker lock(&_mutex);
+  _vecDiscreteInputs[address] = state;
+}
+
+bool ModbusStandIn::coil(int address) const
+{
+  QMutexLocker lock(&_mutex);
+  return _vecCoils[address];
+}
+
+void ModbusStandIn::setResponseDelay(int msecs)
+{
+  QMutexLocker lock(&_mutex);
+  _iResponseDelay = msecs;
+}
+
+int ModbusStandIn::responseDelay() const
+{
+  QMutexLocker lock(&_mutex);
+  return _iResponseDelay;
+}
+
+void ModbusStandIn::run()
+{
+  QTcpServer server;
+  if (server.listen(QHostAddress::LocalHost, 0))
+    _iPort = server.serverPort();
+  _readyCondition.wakeOne();
+  if (_iPort == -1)
+    return;
+
+  while (_bRunning)
+    {
+      if (!server.waitForNewConnection(100))
+        continue;
+      QTcpSocket* pSocket = server.nextPendingConnection();
+      QByteArray aHeader, aPdu;
+      // MBAP header: transaction id, protocol id, length, unit id
+      while (read(pSocket, 7, aHeader))
+        {
+          int iLength = (uchar(aHeader[4]) << 8) | uchar(aHeader[5]);
+          if (iLength < 2 || !read(pSocket, iLength - 1, aPdu))
+            break;
+          QByteArray aResponse(respond(aPdu));
+          const int iDelay = responseDelay();
+          if (iDelay > 0)
+            msleep(iDelay);
+          aHeader[4] = char((aResponse.size() + 1) >> 8);
+          aHeader[5] = char(aResponse.size() + 1);
+          pSocket->write(aHeader + aResponse);
+          pSocket->waitForBytesWritten(1000);
+        }
+      delete pSocket;
+    }
+}
+
+bool ModbusStandIn::read(QTcpSocket* socket, int bytes, QByteArray& data)
+{
+  while (socket->bytesAvailable() < bytes)
+    if (!socket->waitForReadyRead(100) &&
+        (!_bRunning || socket->state() != QAbstractSocket::ConnectedState))
+      return false;
+  data = socket->read(bytes);
+  return true;
+}
+
+QByteArray ModbusStandIn::respond(const QByteArray& request)
+{
+  QMutexLocker lock(&_mutex);
+  ++_iRequestCount;
+
+  const uchar* pRequest = reinterpret_cast<const uchar*>(request.constData());
+  const int iFunction = pRequest[0];
+  const int iAddress = request.size() >= 3 ? (pRequest[1] << 8) | pRequest[2] : 0;
+  const int iCount = request.size() >= 5 ? (pRequest[3] << 8) | pRequest[4] : 0;
+  QByteArray aResponse;
+  aResponse.append(char(iFunction));
+
+  switch (iFunction)
+    {
+    case 1: // read coils
+    case 2: // read discrete inputs
+      {
+        const QVector<bool>& vecBits = iFunction == 1 ? _vecCoils : _vecDiscreteInputs;
+        if (iAddress + iCount > vecBits.size())
+          break;
+        QByteArray aBits((iCount + 7) / 8, 0);
+        for (int i=0; i<iCount; ++i)
+          if (vecBits[iAddress + i])
+            aBits[i/8] = char(aBits[i/8] | (1 << (i%8)));
+        aResponse.append(char(aBits.size()));
+        return aResponse + aBits;
+      }
+    case 5: // write single coil
+      if (iAddress >= _vecCoils.size())
+        break;
+      _vecCoils[iAddress] = iCount == 0xff00;
+      return request;
+    case 15: // write multiple coils
+      if (iAddress + iCount > _vecCoils.size() || request.size() < 6 + (iCount + 7) / 8)
+        break;
+      for (int i=0; i<iCount; ++i)
+        _vecCoils[iAddress + i] = (pRequest[6 + i/8] >> (i%8)) & 1;
+      return request.left(5);
+    }
+  // Illegal function or address
+  aResponse[0] = char(iFunction | 0x80);
+  const bool bKnownFunction = iFunction == 1 || iFunction == 2 || iFunction == 5 || iFunction == 15;
+  aResponse.append(char(bKnownFunction ? 2 : 1));
+  return aResponse;
+}
+
+void TestPiiModbusIoDriver::initTestCase()
+{
+  _server.start();
+  QVERIFY(_server.waitForListening());
+}
+
+void TestPiiModbusIoDriver::cleanupTestCase()
+{
+  _server.stop();
+  _server.wait();
+}
+
+void TestPiiModbusIoDriver::batchedPolling()
+{
+  PiiModbusIoDriver driver;
+  driver.selectUnit(QString("127.0.0.1:%1").arg(_server.port()));
+  QVERIFY(driver.initialize());
+
+  // 32 inputs in two contiguous address ranges: 0-23 and 100-107.
+  QList<PiiIoChannel*> lstInputs;
+  for (int i=0; i<32; ++i)
+    {
+      PiiModbusIoChannel* pChannel = static_cast<PiiModbusIoChannel*>(driver.channel(i));
+      pChannel->setChannelMode(PiiDefaultIoChannel::Input);
+      pChannel->setAddress(i < 24 ? i : 76 + i);
+      lstInputs << pChannel;
+    }
+  QSignalSpy spy3(driver.channel(3), SIGNAL(inputStateChanged(bool)));
+  QSignalSpy spy30(driver.channel(30), SIGNAL(inputStateChanged(bool)));
+
+  QVERIFY(driver.batchedPolling());
+  // Each round trip takes at least this long. Polling one input at a
+  // time would need 32 round trips.
+  const int iDelay = 20;
+  _server.setResponseDelay(iDelay);
+  int iRequests = _server.requestCount();
+  PiiTimer timer;
+  driver.checkInputStates(lstInputs);
+  qint64 iBatchedTime = timer.milliseconds();
+  _server.setResponseDelay(0);
+  QCOMPARE(_server.requestCount() - iRequests, 2);
+  QCOMPARE(driver.requestCount(), 2);
+  QVERIFY(iBatchedTime >= 2 * iDelay);
+  QVERIFY(iBatchedTime < 16 * iDelay);
+
+  // Input state changes reach the right channels.
+  _server.setDiscreteInput(3, true);
+  _server.setDiscreteInput(106, true);
+  driver.checkInputStates(lstInputs);
+  QCOMPARE(_server.requestCount() - iRequests, 4);
+  QCOMPARE(spy3.count(), 1);
+  QCOMPARE(spy30.count(), 1);
+  QCOMPARE(spy30[0][0].toBool(), true);
+
+  driver.setBatchedPolling(false);
+  _server.setDiscreteInput(3, false);
+  _server.setResponseDelay(iDelay);
+  timer.restart();
+  driver.checkInputStates(lstInputs);
+  qint64 iSingleTime = timer.milliseconds();
+  _server.setResponseDelay(0);
+  QCOMPARE(_server.requestCount() - iRequests, 36);
+  QCOMPARE(driver.requestCount(), 36);
+  QVERIFY(iSingleTime >= 32 * iDelay);
+  // Falling edges are not signalled by default.
+  QCOMPARE(spy3.count(), 1);
+}
+
+void TestPiiModbusIoDriver::coalescedWrites()
+{
+  PiiModbusIoDriver driver;
+  driver.selectUnit(QString("127.0.0.1:%1").arg(_server.port()));
+  QVERIFY(driver.initialize());
+
+  // Outputs at 200-207 and 210.
+  QList<PiiIoChannel*> lstOutputs;
+  QList<bool> lstStates;
+  for (int i=0; i<9; ++i)
+    {
+      PiiModbusIoChannel* pChannel = static_cast<PiiModbusIoChannel*>(driver.channel(i));
+      pChannel->setChannelMode(PiiDefaultIoChannel::Output);
+      pChannel->setAddress(i < 8 ? 200 + i : 210);
+      lstOutputs << pChannel;
+      lstStates << (i % 3 != 0);
+    }
+
+  int iRequests = _server.requestCount();
+  driver.setOutputStates(lstOutputs, lstStates);
+  // One request for 200-207, another for 210.
+  QCOMPARE(_server.requestCount() - iRequests, 2);
+  for (int i=0; i<9; ++i)
+    QCOMPARE(_server.coil(i < 8 ? 200 + i : 210), lstStates[i]);
+
+  for (int i=0; i<9; ++i)
+    lstStates[i] = !lstStates[i];
+  driver.setBatchedPolling(false);
+  driver.setOutputStates(lstOutputs, lstStates);
+  QCOMPARE(_server.requestCount() - iRequests, 11);
+  for (int i=0; i<9; ++i)
+    QCOMPARE(_server.coil(i < 8 ? 200 + i : 210), lstStates[i]);
+}
+
+QTEST_MAIN(TestPiiModbusIoDriver)
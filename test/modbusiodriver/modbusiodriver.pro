@@ -0,0 +1,6 @@
+include(../unit_test.pri)
+QT += network
+INCLUDEPATH += $$INTODIR/modules/io/plugin $$INTODIR/modules/io/modbus $$INTODIR/3rdparty/modbus/include
+LIBS += -L$$INTODIR/modules/io/$$MODE -lpiiio \
+        -L$$INTODIR/modules/io/modbus/$$MODE -lpiimodbusiodriver \
+        -L$$INTODIR/3rdparty/modbus/lib -lmodbus
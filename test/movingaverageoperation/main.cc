@@ -0,0 +1,227 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+
+#include "TestPiiMovingAverageOperation.h"
+
+#include <PiiMath.h>
+#include <QtTest>
+
+namespace
+{
+  // Brute-force reference that recalculates everything over the
+  // whole window.
+  class ReferenceWindow
+  {
+  public:
+    ReferenceWindow(int size) : _iSize(size) {}
+
+    void setSize(int size)
+    {
+      _iSize = size;
+      while (_lstValues.size() > _iSize)
+        _lstValues.removeFirst();
+    }
+
+    void add(int value)
+    {
+      _lstValues << value;
+      while (_lstValues.size() > _iSize)
+        _lstValues.removeFirst();
+    }
+
+    double mean() const
+    {
+      double dSum = 0;
+      for (int i=0; i<_lstValues.size(); ++i)
+        dSum += _lstValues[i];
+      return dSum / _lstValues.size();
+    }
+
+    double variance() const
+    {
+      double dMean = mean(), dSum = 0;
+      for (int i=0; i<_lstValues.size(); ++i)
+        dSum += (_lstValues[i] - dMean) * (_lstValues[i] - dMean);
+      return dSum / _lstValues.size();
+    }
+
+    int minimum() const
+    {
+      int iMin = _lstValues[0];
+      for (int i=1; i<_lstValues.size(); ++i)
+        iMin = qMin(iMin, _lstValues[i]);
+      return iMin;
+    }
+
+    int maximum() const
+    {
+      int iMax = _lstValues[0];
+      for (int i=1; i<_lstValues.size(); ++i)
+        iMax = qMax(iMax, _lstValues[i]);
+      return iMax;
+    }
+
+  private:
+    int _iSize;
+    QList<int> _lstValues;
+  };
+
+  // A descending run evicts the maximum and an ascending run the
+  // minimum on every step. The rest is scrambled.
+  int testValue(int index)
+  {
+    if (index < 12)
+      return 10 - index;
+    if (index < 24)
+      return index - 20;
+    return (index * 37 + 11) % 23 - 11;
+  }
+}
+
+void TestPiiMovingAverageOperation::initTestCase()
+{
+  QVERIFY(createOperation("piibase", "PiiMovingAverageOperation"));
+  connectAllInputs();
+}
+
+void TestPiiMovingAverageOperation::scalarWindow_data()
+{
+  QTest::addColumn<int>("windowSize");
+  QTest::addColumn<int>("resyncInterval");
+
+  QTest::newRow("1") << 1 << 1024;
+  QTest::newRow("3") << 3 << 1024;
+  QTest::newRow("5, resync") << 5 << 2;
+  QTest::newRow("16") << 16 << 1024;
+}
+
+void TestPiiMovingAverageOperation::scalarWindow()
+{
+  QFETCH(int, windowSize);
+  QFETCH(int, resyncInterval);
+
+  operation()->setProperty("windowSize", windowSize);
+  operation()->setProperty("resyncInterval", resyncInterval);
+  QVERIFY(start());
+
+  ReferenceWindow window(windowSize);
+  // The window wraps around several times.
+  for (int i=0; i<60; ++i)
+    {
+      const int iValue = testValue(i);
+      window.add(iValue);
+      QVERIFY(sendObject("input", iValue));
+      QVERIFY(Pii::abs(outputValue("average", 0.0f) - window.mean()) < 1e-4);
+      QVERIFY(Pii::abs(outputValue("variance", -1.0f) - window.variance()) < 1e-3);
+      QCOMPARE(outputValue("minimum", 0), window.minimum());
+      QCOMPARE(outputValue("maximum", 0), window.maximum());
+    }
+
+  QVERIFY(stop());
+}
+
+void TestPiiMovingAverageOperation::matrixWindow()
+{
+  operation()->setProperty("windowSize", 4);
+  operation()->setProperty("resyncInterval", 1024);
+  QVERIFY(start());
+
+  QList<ReferenceWindow> lstWindows;
+  for (int i=0; i<4; ++i)
+    lstWindows << ReferenceWindow(4);
+
+  for (int i=0; i<40; ++i)
+    {
+      PiiMatrix<int> matInput(2,2);
+      for (int j=0; j<4; ++j)
+        {
+          matInput(j/2, j%2) = testValue(i + j*7);
+          lstWindows[j].add(matInput(j/2, j%2));
+        }
+      QVERIFY(sendObject("input", matInput));
+
+      PiiMatrix<float> matAverage(outputValue("average", PiiMatrix<float>()));
+      PiiMatrix<float> matVariance(outputValue("variance", PiiMatrix<float>()));
+      PiiMatrix<int> matMinimum(outputValue("minimum", PiiMatrix<int>()));
+      PiiMatrix<int> matMaximum(outputValue("maximum", PiiMatrix<int>()));
+      QCOMPARE(matAverage.rows(), 2);
+      QCOMPARE(matVariance.rows(), 2);
+      QCOMPARE(matMinimum.rows(), 2);
+      QCOMPARE(matMaximum.rows(), 2);
+      for (int j=0; j<4; ++j)
+        {
+          QVERIFY(Pii::abs(matAverage(j/2, j%2) - lstWindows[j].mean()) < 1e-4);
+          QVERIFY(Pii::abs(matVariance(j/2, j%2) - lstWindows[j].variance()) < 1e-3);
+          QCOMPARE(matMinimum(j/2, j%2), lstWindows[j].minimum());
+          QCOMPARE(matMaximum(j/2, j%2), lstWindows[j].maximum());
+        }
+    }
+
+  QVERIFY(stop());
+}
+
+void TestPiiMovingAverageOperation::reset()
+{
+  operation()->setProperty("windowSize", 5);
+  QVERIFY(start());
+  for (int i=0; i<7; ++i)
+    QVERIFY(sendObject("input", testValue(i)));
+  QVERIFY(stop());
+
+  // Restarting must forget the old window.
+  QVERIFY(start());
+  QVERIFY(sendObject("input", -3));
+  QCOMPARE(outputValue("average", 0.0f), -3.0f);
+  QCOMPARE(outputValue("variance", -1.0f), 0.0f);
+  QCOMPARE(outputValue("minimum", 0), -3);
+  QCOMPARE(outputValue("maximum", 0), -3);
+
+  // A different type is accepted after a reset.
+  QVERIFY(stop());
+  QVERIFY(start());
+  QVERIFY(sendObject("input", 2.5));
+  QCOMPARE(outputValue("average", 0.0), 2.5);
+  QCOMPARE(outputValue("minimum", 0.0), 2.5);
+  QVERIFY(stop());
+}
+
+void TestPiiMovingAverageOperation::shrinkWindow()
+{
+  operation()->setProperty("windowSize", 6);
+  operation()->setProperty("resyncInterval", 1024);
+  QVERIFY(start());
+
+  ReferenceWindow window(6);
+  for (int i=0; i<20; ++i)
+    {
+      if (i == 10)
+        {
+          operation()->setProperty("windowSize", 2);
+          window.setSize(2);
+        }
+      const int iValue = testValue(i + 24);
+      window.add(iValue);
+      QVERIFY(sendObject("input", iValue));
+      QVERIFY(Pii::abs(outputValue("average", 0.0f) - window.mean()) < 1e-4);
+      QVERIFY(Pii::abs(outputValue("variance", -1.0f) - window.variance()) < 1e-3);
+      QCOMPARE(outputValue("minimum", 0), window.minimum());
+      QCOMPARE(outputValue("maximum", 0), window.maximum());
+    }
+
+  QVERIFY(stop());
+}
+
+QTEST_MAIN(TestPiiMovingAverageOperation)
@@ -0,0 +1,120 @@
+/* This file is part of Into.
+ * Copyright (C) Intopii 2013.
+ * All rights reserved.
+ *
+ * Licensees holding a commercial Into license may use this file in
+ * accordance with the commercial license agreement. Please see
+ * LICENSE.commercial for commercial licensing terms.
+ *
+ * Alternatively, this file may be used under the terms of the GNU
+ * Affero General Public License version 3 as published by the Free
+ * Software Foundation. In addition, Intopii gives you special rights
+ * to use Into as a part of open source software projects. Please
+ * refer to LICENSE.AGPL3 for details.
+ */
+
+
+#include "TestPiiMultiVariableHistogram.h"
+
+#include <PiiMath.h>
+#include <QtTest>
+
+namespace
+{
+  // Large enough to be split into several bands of rows. Some values
+  // are out of range and must be clamped.
+  const int iRows = 600, iColumns = 128;
+
+  int value(int channel, int r, int c)
+  {
+    switch (channel)
+      {
+      case 0: return (r/3 + c) % 6 - 1;
+      case 1: return (r*c + 7*r) % 8 - 1;
+      default: return (r + c/5) % 3;
+      }
+  }
+
+  PiiMatrix<int> referenceHistogram(bool joint)
+  {
+    const int aLevels[3] = { 4, 5, 3 };
+    PiiMatrix<int> matResult(1, joint ? 4*5*3 : 4+5+3);
+    for (int r=0; r<iRows; ++r)
+      for (int c=0; c<iColumns; ++c)
+        {
+          int iIndex = 0, iStep = 1, iOffset = 0;
+          for (int k=0; k<3; ++k)
+            {
+              const int iValue = qBound(0, value(k, r, c), aLevels[k]-1);
+              if (joint)
+                iIndex += iStep * iValue;
+              else
+                ++matResult(0, iOffset + iValue);
+              iStep *= aLevels[k];
+              iOffset += aLevels[k];
+            }
+          if (joint)
+            ++matResult(0, iIndex);
+        }
+    return matResult;
+  }
+}
+
+void TestPiiMultiVariableHistogram::initTestCase()
+{
+  QVERIFY(createOperation("piistatistics", "PiiMultiVariableHistogram"));
+  operation()->setProperty("levels", QVariantList() << 4 << 5 << 3);
+  // The second channel is sent as doubles scaled by two.
+  operation()->setProperty("scales", QVariantList() << 1 << 0.5 << 1);
+  connectAllInputs();
+}
+
+void TestPiiMultiVariableHistogram::threads_data()
+{
+  QTest::addColumn<QString>("distributionType");
+
+  QTest::newRow("joint") << "JointDistribution";
+  QTest::newRow("marginal") << "MarginalDistributions";
+}
+
+void TestPiiMultiVariableHistogram::threads()
+{
+  QFETCH(QString, distributionType);
+
+  operation()->setProperty("distributionType", distributionType);
+
+  PiiMatrix<int> matChannel0(PiiMatrix<int>::uninitialized(iRows, iColumns));
+  PiiMatrix<double> matChannel1(PiiMatrix<double>::uninitialized(iRows, iColumns));
+  PiiMatrix<int> matChannel2(PiiMatrix<int>::uninitialized(iRows, iColumns));
+  for (int r=0; r<iRows; ++r)
+    for (int c=0; c<iColumns; ++c)
+      {
+        matChannel0(r,c) = value(0, r, c);
+        matChannel1(r,c) = 2.0 * value(1, r, c);
+        matChannel2(r,c) = value(2, r, c);
+      }
+
+  const PiiMatrix<int> matReference(referenceHistogram(distributionType == "JointDistribution"));
+  PiiMatrix<int> matSingleThread;
+  const int aThreads[] = { 1, 3, 0 };
+  for (int i=0; i<3; ++i)
+    {
+      operation()->setProperty("histogramThreadCount", aThreads[i]);
+      QVERIFY(start());
+      QVERIFY(sendObject("matrix0", matChannel0));
+      QVERIFY(sendObject("matrix1", matChannel1));
+      QVERIFY(sendObject("matrix2", matChannel2));
+      PiiMatrix<int> matHistogram(outputValue("histogram", PiiMatrix<int>()));
+      QVERIFY(stop());
+
+      if (i == 0)
+        {
+          QVERIFY(Pii::equals(matHistogram, matReference));
+          matSingleThread = matHistogram;
+        }
+      else
+        QVERIFY(Pii::equals(matHistogram, matSingleThread));
+    }
+}
+
+QTEST_MAIN(TestPiiMultiVariableHistogram)
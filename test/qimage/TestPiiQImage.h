@@ -25,6 +25,7 @@ class TestPiiQImage : public QObject
 private slots:
   void imageToMatrix();
   void matrixToImage();
+  void toQImage();
 };
 
 #endif //_TESTPIIQIMAGEMATRIX_H
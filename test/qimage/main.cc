@@ -102,4 +102,59 @@ void TestPiiQImage::matrixToImage()
   }
 }
 
+void TestPiiQImage::toQImage()
+{
+  {
+    // Gray-scale matrix
+    PiiMatrix<unsigned char> matrix(4, 4,
+                                    'A', 'B', 'C', 'D',
+                                    'E', 'F', 'G', 'H',
+                                    'I', 'J', 'K', 'L',
+                                    'M', 'N', 'O', 'P');
+    QImage image(Pii::toQImage(matrix));
+    QCOMPARE(image.width(), 4);
+    QCOMPARE(image.height(), 4);
+    QCOMPARE(image.constScanLine(3)[3], (unsigned char)'P');
+#if QT_VERSION >= 0x050500
+    QCOMPARE(image.format(), QImage::Format_Grayscale8);
+    QVERIFY(image.constBits() == matrix.row(0));
+#endif
+    // Detaches matrix, image must retain old data
+    matrix(0,0) = 'X';
+    QCOMPARE(image.constScanLine(0)[0], (unsigned char)'A');
+    // Image must keep the data alive
+    matrix = PiiMatrix<unsigned char>();
+    QCOMPARE(image.constScanLine(1)[2], (unsigned char)'G');
+  }
+  {
+    // Color matrix
+    PiiMatrix<PiiColor4<unsigned char> > matrix(2, 2);
+    matrix(1,1) = PiiColor4<unsigned char>(1, 2, 3);
+    QImage image(Pii::toQImage(matrix));
+    QCOMPARE(image.format(), QImage::Format_RGB32);
+#if QT_VERSION >= 0x050000
+    QVERIFY(image.constBits() == reinterpret_cast<const uchar*>(matrix.row(0)));
+#endif
+    QCOMPARE(qRed(image.pixel(1,1)), 1);
+    QCOMPARE(qGreen(image.pixel(1,1)), 2);
+    QCOMPARE(qBlue(image.pixel(1,1)), 3);
+  }
+  {
+    // Unaligned submatrix must be copied
+    PiiMatrix<unsigned char> matrix(4, 4);
+    matrix(2,2) = 'a';
+    const PiiMatrix<unsigned char>& constMatrix = matrix;
+    QImage image(Pii::toQImage(constMatrix(1,1,3,3)));
+    QCOMPARE(image.width(), 3);
+    QCOMPARE(image.constScanLine(1)[1], (unsigned char)'a');
+  }
+  {
+    // Incompatible type is converted
+    PiiMatrix<float> matrix(1, 2, 0.0, 1.0);
+    QImage image(Pii::toQImage(matrix));
+    QCOMPARE(image.format(), QImage::Format_Indexed8);
+    QCOMPARE(image.constScanLine(0)[1], (unsigned char)255);
+  }
+}
+
 QTEST_MAIN(TestPiiQImage)
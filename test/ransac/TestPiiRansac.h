@@ -25,6 +25,8 @@ class TestPiiRansac : public QObject
 private slots:
   void RigidPlaneRansac();
   void CircleRansac();
+  void ParallelRansac();
+  void LowInlierFraction();
 };
 
 
@@ -136,4 +136,79 @@ void TestPiiRansac::CircleRansac()
   }
 }
 
+void TestPiiRansac::ParallelRansac()
+{
+  PiiMatrix<double> matPoints1(Pii::uniformRandomMatrix(2000, 2, -50, 50));
+  PiiMatrix<double> matModel(1,4, 2.0, 1.0, 10.0, -20.0);
+  PiiMatrix<double> matPoints2(PiiRigidPlaneRansac<double>::transform(matPoints1, matModel[0]));
+  // 75% outliers
+  for (int i=0; i<matPoints2.rows(); ++i)
+    {
+      if (i % 4 != 0)
+        {
+          matPoints2(i,0) += Pii::uniformRandom(-50, 50);
+          matPoints2(i,1) += Pii::uniformRandom(-50, 50);
+        }
+    }
+
+  for (int iTestSize = 0; iTestSize <= 2; ++iTestSize)
+    {
+      PiiRigidPlaneRansac<double> ransac(matPoints1, matPoints2);
+      ransac.setFittingThreshold(1);
+      ransac.setSelectionProbability(0.999);
+      ransac.setMaxIterations(10000);
+      ransac.setThreadCount(4);
+      ransac.setPreemptiveTestSize(iTestSize);
+      QVERIFY(ransac.findBestModel());
+      QVERIFY(ransac.inlierCount() >= 500);
+      PiiMatrix<double> matEstModel(ransac.bestModel());
+      QVERIFY(Pii::abs(matModel(0) - matEstModel(0)) < 0.01);
+      QVERIFY(Pii::abs(matModel(1) - matEstModel(1)) < 0.01);
+      QVERIFY(Pii::abs(matModel(2) - matEstModel(2)) < 1);
+      QVERIFY(Pii::abs(matModel(3) - matEstModel(3)) < 1);
+    }
+
+  {
+    PiiMatrix<double> matPoints(0, 2);
+    matPoints.reserve(1024);
+    for (double a = 0; a < 2 * M_PI; a += M_PI / 256)
+      {
+        matPoints.appendRow(5 + 10 * cos(a), -3 + 10 * sin(a));
+        matPoints.appendRow(Pii::uniformRandom(-20.0, 20.0), Pii::uniformRandom(-20.0, 20.0));
+      }
+    PiiCircleRansac<double> ransac(matPoints);
+    ransac.setFittingThreshold(0.1);
+    ransac.setThreadCount(0);
+    ransac.setPreemptiveTestSize(1);
+    QVERIFY(ransac.findBestModel());
+    PiiMatrix<double> matEstModel(ransac.bestModel());
+    QVERIFY(Pii::hypotenuse(matEstModel(0, 0) - 5, matEstModel(0, 1) + 3) < 0.2);
+    QVERIFY(Pii::abs(matEstModel(0, 2) - 10) < 0.2);
+  }
+}
+
+void TestPiiRansac::LowInlierFraction()
+{
+  // With only a few inliers in the first hypotheses, the estimated
+  // number of required iterations exceeds the range of int.
+  PiiMatrix<double> matPoints1(Pii::uniformRandomMatrix(100000, 2, -50, 50));
+  PiiMatrix<double> matModel(1,4, 2.0, 1.0, 10.0, -20.0);
+  PiiMatrix<double> matPoints2(PiiRigidPlaneRansac<double>::transform(matPoints1, matModel[0]));
+  // 90% outliers
+  for (int i=0; i<matPoints2.rows(); ++i)
+    {
+      if (i % 10 != 0)
+        {
+          matPoints2(i,0) += Pii::uniformRandom(-50, 50);
+          matPoints2(i,1) += Pii::uniformRandom(-50, 50);
+        }
+    }
+
+  PiiRigidPlaneRansac<double> ransac(matPoints1, matPoints2);
+  ransac.setFittingThreshold(0.001);
+  ransac.setMaxIterations(5000);
+  QVERIFY(ransac.findBestModel());
+  QCOMPARE(ransac.inlierCount(), 10000);
+}
+
 QTEST_MAIN(TestPiiRansac)
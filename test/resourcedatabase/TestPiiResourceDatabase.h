@@ -27,6 +27,8 @@ private slots:
   void initTestCase();
   void select();
   void subselect();
+  void removeStatements();
+  void customFilter();
 
 private:
   PiiResourceDatabase db;
@@ -134,4 +134,51 @@ void TestPiiResourceDatabase::subselect()
   QCOMPARE(lstResult[0], QString("PiiResourceDatabase"));
 }
 
+void TestPiiResourceDatabase::removeStatements()
+{
+  using namespace Pii;
+  PiiResourceDatabase db2;
+  QList<int> lstIds = db2.addStatements(QList<PiiResourceStatement>() <<
+                                        db2.resource("A", "my:parent", "B") <<
+                                        db2.literal("#", "my:evaluation", "true") <<
+                                        db2.resource("C", "my:parent", "B") <<
+                                        db2.resource("B", "my:parent", "A"));
+  QCOMPARE(lstIds.size(), 4);
+  QCOMPARE(db2.select(subject, attribute("my:parent") == "B"), QList<QString>() << "A" << "C");
+  QCOMPARE(db2.findFirst(subject == QString("#%1").arg(lstIds[0])), lstIds[1]);
+
+  db2.removeStatement(lstIds[0]);
+  QCOMPARE(db2.select(subject, attribute("my:parent") == "B"), QList<QString>() << "C");
+  QCOMPARE(db2.select(object == "B" || subject == "B").size(), 2);
+  QCOMPARE(db2.findFirst(statementId == lstIds[0]), -1);
+  QCOMPARE(db2.findFirst(statementId == lstIds[2]), lstIds[2]);
+
+  // The id of the removed last statement will be reused.
+  db2.removeStatement(lstIds[3]);
+  int id = db2.addStatement(db2.resource("D", "my:parent", "C"));
+  QCOMPARE(id, lstIds[3]);
+  QCOMPARE(db2.select(subject, predicate == "my:parent"), QList<QString>() << "C" << "D");
+  QCOMPARE(db2.select(subject == "B").size(), 0);
+
+  db2.removeStatements(db2.select(statementId, predicate == "my:parent"));
+  QCOMPARE(db2.statementCount(), 1);
+  QCOMPARE(db2.select(predicate == "my:parent").size(), 0);
+}
+
+struct IsDesigner
+{
+  bool operator() (const PiiResourceStatement& statement) const
+  {
+    return statement.predicate() == "my:designer";
+  }
+};
+
+void TestPiiResourceDatabase::customFilter()
+{
+  using namespace Pii;
+  // Custom function objects cannot use the indexes but must still work.
+  QCOMPARE(db.select(IsDesigner()).size(), 3);
+  QCOMPARE(db.findFirst(IsDesigner()), db.findFirst(predicate == "my:designer"));
+}
+
 QTEST_MAIN(TestPiiResourceDatabase)
@@ -29,6 +29,8 @@ public:
 private slots:
   void textArchive();
   void binaryArchive();
+  void mappedBinaryArchive();
+  void largeRawDataSize();
   void derivedTypes();
 
 private:
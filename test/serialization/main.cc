@@ -86,6 +86,9 @@ const int iVariantTesterMetaType = qRegisterMetaType<VariantTester>("VariantTest
 #include <iostream>
 
 #include <QtTest>
+#include <QFile>
+#include <QBuffer>
+#include <QDir>
 
 // HACK QtTest defines "lst2" to be 1121 in Qt 5.0.2. How cool.
 #ifdef lst2
@@ -280,5 +283,113 @@ void TestPiiSerialization::binaryArchive()
   anyArchive<PiiGenericBinaryInputArchive,PiiGenericBinaryOutputArchive>();
 }
 
+void TestPiiSerialization::mappedBinaryArchive()
+{
+  QString strFile(QDir::tempPath() + "/testpiiserialization_mapped.bin");
+  PiiMatrix<double> matrix(37, 13);
+  Pii::generate(matrix.begin(), matrix.end(), Pii::CountFunction<double>());
+  PiiMatrix<char> odd(3, 5);
+  odd = 'x';
+
+  try
+    {
+      {
+        QFile file(strFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        PiiGenericBinaryOutputArchive oa(&file, 64u);
+        oa << odd << matrix << QString("end");
+      }
+
+      PiiMatrix<double> matrix2;
+      {
+        QFile file(strFile);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        PiiGenericBinaryInputArchive ia(&file, true);
+        PiiMatrix<char> odd2;
+        QString strEnd;
+        ia >> odd2 >> matrix2 >> strEnd;
+        QVERIFY(Pii::equals(odd, odd2));
+        QCOMPARE(strEnd, QString("end"));
+      }
+      // The archive and the file are gone but the mapping is alive.
+      const PiiMatrix<double>& mapped = matrix2;
+      QVERIFY(Pii::equals(matrix, mapped));
+      QCOMPARE(reinterpret_cast<std::size_t>(mapped[0]) % 64, std::size_t(0));
+
+      // Modification detaches from the mapped data.
+      PiiMatrix<double> matrix3(matrix2);
+      matrix3(0,0) = -1;
+      QVERIFY(static_cast<const PiiMatrix<double>&>(matrix3)[0] != mapped[0]);
+      QCOMPARE(mapped(0,0), 0.0);
+
+      // Unaligned archives can still be read with memory mapping
+      // requested.
+      {
+        QFile file(strFile);
+        QVERIFY(file.open(QIODevice::WriteOnly));
+        PiiGenericBinaryOutputArchive oa(&file);
+        oa << matrix;
+      }
+      {
+        QFile file(strFile);
+        QVERIFY(file.open(QIODevice::ReadOnly));
+        PiiGenericBinaryInputArchive ia(&file, true);
+        PiiMatrix<double> matrix4;
+        ia >> matrix4;
+        QVERIFY(Pii::equals(matrix, matrix4));
+      }
+    }
+  catch (PiiSerializationException& ex)
+    {
+      QFAIL(("Serialization error: " + ex.message() + " at " +
+             ex.location() + ". Additional info: " + ex.info()).toLocal8Bit().constData());
+    }
+  QFile::remove(strFile);
+}
+
+// Records the size of the requested raw data block and refuses to
+// read it.
+class SizeProbeArchive : public PiiGenericBinaryInputArchive
+{
+public:
+  SizeProbeArchive(QIODevice* d) : PiiGenericBinaryInputArchive(d), iMappedSize(-1) {}
+
+  const void* mapRawData(qint64 size, PiiSharedObject*&)
+  {
+    iMappedSize = size;
+    PII_SERIALIZATION_ERROR(StreamError);
+  }
+
+  qint64 iMappedSize;
+};
+
+void TestPiiSerialization::largeRawDataSize()
+{
+  // 65536 x 16385 doubles takes more than 8 GiB. Only the header is
+  // written; the probe archive catches the requested size.
+  int iRows = 65536, iCols = 16385;
+  QBuffer buffer;
+  QVERIFY(buffer.open(QIODevice::WriteOnly));
+  {
+    PiiGenericBinaryOutputArchive oa(&buffer, 64u);
+    oa << PII_NVP("rows", iRows) << PII_NVP("cols", iCols);
+    oa.alignRawData();
+  }
+  buffer.close();
+
+  QVERIFY(buffer.open(QIODevice::ReadOnly));
+  SizeProbeArchive probe(&buffer);
+  PiiGenericInputArchive& ia = probe;
+  PiiMatrix<double> matrix;
+  try
+    {
+      ia >> matrix;
+      QFAIL("The probe archive must throw.");
+    }
+  catch (PiiSerializationException&) {}
+  QCOMPARE(probe.iMappedSize, qint64(iRows) * iCols * qint64(sizeof(double)));
+  QVERIFY(matrix.isEmpty());
+}
+
 QTEST_MAIN(TestPiiSerialization)
 
@@ -33,6 +33,7 @@ private slots:
   void proxyLoop();
   void connectedInputs();
   void root();
+  void resolvedInputs();
 
 private:
   PiiOutputSocket a;
@@ -98,4 +98,34 @@ void TestPiiSocket::root()
   QCOMPARE(PiiProxySocket::root(&a), &a);
 }
 
+void TestPiiSocket::resolvedInputs()
+{
+  QList<PiiAbstractInputSocket*> lstInputs = a.resolvedInputs();
+  QCOMPARE(lstInputs.size(), 3);
+  QVERIFY(lstInputs.contains(&b));
+  QVERIFY(lstInputs.contains(&e));
+  QVERIFY(lstInputs.contains(&h));
+  // Final inputs signal the real output directly.
+  QVERIFY(h.listener() != 0);
+  QCOMPARE(h.listener(), b.listener());
+
+  g.output()->disconnectInput(&h);
+  lstInputs = a.resolvedInputs();
+  QCOMPARE(lstInputs.size(), 2);
+  QVERIFY(!lstInputs.contains(&h));
+  QVERIFY(h.listener() == 0);
+
+  g.output()->connectInput(&h);
+  QCOMPARE(a.resolvedInputs().size(), 3);
+  QCOMPARE(h.listener(), b.listener());
+
+  c.output()->disconnectInput(d.input());
+  lstInputs = a.resolvedInputs();
+  QCOMPARE(lstInputs.size(), 2);
+  QVERIFY(lstInputs.contains(&e));
+  QVERIFY(h.listener() == 0);
+  c.output()->connectInput(d.input());
+  QCOMPARE(a.resolvedInputs().size(), 3);
+}
+
 QTEST_MAIN(TestPiiSocket)
@@ -3,6 +3,7 @@
 TEMPLATE = subdirs
 
 SUBDIRS = algorithm \
+          backgroundextractor \
           bits \
           boosting \
           camera \
@@ -27,6 +28,10 @@ SUBDIRS = algorithm \
           houghtransformoperation \
           httpserver \
           image \
+          imagefilereader \
+          imagefilewriter \
+          imagepyramid \
+          iothread \
           iterators \
           kdtree \
           kerneladatron \
@@ -39,7 +44,9 @@ SUBDIRS = algorithm \
           matrixcomposer \
           matrixdecompositions \
           matrixutil \
+          movingaverageoperation \
           multipartdecoder \
+          multivariablehistogram \
           operationcompound \
           optimization \
           perceptron \
@@ -72,3 +79,7 @@ SUBDIRS = algorithm \
 
 include(../qt5.pri)
 qt5: SUBDIRS += qml
+
+INTODIR = ..
+include($$INTODIR/extensions.pri)
+enabled(modbus): SUBDIRS += modbusiodriver
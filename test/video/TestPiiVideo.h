@@ -24,6 +24,9 @@ class TestPiiVideo : public QObject
 
 private slots:
   void getFrame();
+  void pipelinedFrames_data();
+  void pipelinedFrames();
+  void heldFramesNotReused();
   void saveNextColorFrame();
   void saveNextGrayFrame();
 };
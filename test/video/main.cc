@@ -37,6 +37,50 @@
 #  define AVCODEC_SKIP QSKIP("Avcoded support not enabled")
 #endif
 
+#ifndef PII_NO_AVCODEC
+namespace
+{
+  template <class T> uint frameHash(const PiiMatrix<T>& frame)
+  {
+    uint iHash = 2166136261u;
+    const int iBytes = frame.columns() * int(sizeof(T));
+    for (int r=0; r<frame.rows(); ++r)
+      {
+        const unsigned char* pRow = reinterpret_cast<const unsigned char*>(frame.row(r));
+        for (int i=0; i<iBytes; ++i)
+          iHash = (iHash ^ pRow[i]) * 16777619u;
+      }
+    return iHash;
+  }
+
+  // Decodes the whole video and returns a hash of each frame.
+  template <class T> QList<uint> frameHashes(const QString& fileName, int queueSize,
+                                             int decoderThreadCount, int skipFrames)
+  {
+    PiiVideoReader reader(fileName);
+    reader.setQueueSize(queueSize);
+    reader.setDecoderThreadCount(decoderThreadCount);
+    QList<uint> lstHashes;
+    try
+      {
+        reader.initialize();
+      }
+    catch (PiiVideoException&)
+      {
+        return lstHashes;
+      }
+    for (;;)
+      {
+        PiiMatrix<T> frame(reader.getFrame<T>(skipFrames));
+        if (frame.isEmpty())
+          break;
+        lstHashes << frameHash(frame);
+      }
+    return lstHashes;
+  }
+}
+#endif
+
 void TestPiiVideoFileReader::initTestCase()
 {
 #ifndef PII_NO_AVCODEC
@@ -182,6 +226,91 @@ void TestPiiVideo::getFrame()
 }
 
 
+void TestPiiVideo::pipelinedFrames_data()
+{
+  QTest::addColumn<int>("queueSize");
+  QTest::addColumn<int>("decoderThreadCount");
+  QTest::addColumn<int>("skipFrames");
+
+  QTest::newRow("queue 1") << 1 << 1 << 0;
+  QTest::newRow("queue 4") << 4 << 1 << 0;
+  QTest::newRow("queue 4, skip 1") << 4 << 1 << 1;
+  QTest::newRow("queue 8, all cores") << 8 << 0 << 0;
+}
+
+void TestPiiVideo::pipelinedFrames()
+{
+#ifndef PII_NO_AVCODEC
+  QFETCH(int, queueSize);
+  QFETCH(int, decoderThreadCount);
+  QFETCH(int, skipFrames);
+
+  QString strVideo = "data/ov14c1.avi";
+  QVERIFY(QFile::exists(strVideo));
+
+  // Decoding in the calling thread is the reference.
+  QList<uint> lstColor(frameHashes<PiiColor4<unsigned char> >(strVideo, 0, 1, skipFrames));
+  QList<uint> lstGray(frameHashes<unsigned char>(strVideo, 0, 1, skipFrames));
+  QVERIFY(lstColor.size() > 1);
+  QCOMPARE(lstGray.size(), lstColor.size());
+
+  QCOMPARE(frameHashes<PiiColor4<unsigned char> >(strVideo, queueSize, decoderThreadCount, skipFrames), lstColor);
+  QCOMPARE(frameHashes<unsigned char>(strVideo, queueSize, decoderThreadCount, skipFrames), lstGray);
+#else
+  AVCODEC_SKIP;
+#endif
+}
+
+void TestPiiVideo::heldFramesNotReused()
+{
+#ifndef PII_NO_AVCODEC
+  QString strVideo = "data/ov14c1.avi";
+  QVERIFY(QFile::exists(strVideo));
+
+  PiiVideoReader reader(strVideo);
+  reader.setQueueSize(2);
+  try
+    {
+      reader.initialize();
+    }
+  catch (PiiVideoException& ex)
+    {
+      QFAIL(qPrintable(ex.message()));
+    }
+
+  // The first frame is held all the time, and three latest ones in
+  // a sliding window. Released frames return to the pool.
+  // Data pointers are only accessed through const references
+  // because non-const access would detach the shared buffers.
+  QList<PiiMatrix<PiiColor4<unsigned char> > > lstHeld, lstCopies;
+  const QList<PiiMatrix<PiiColor4<unsigned char> > >& lstConstHeld = lstHeld;
+  for (int i=0; i<40; ++i)
+    {
+      const PiiMatrix<PiiColor4<unsigned char> > frame(reader.getFrame<PiiColor4<unsigned char> >());
+      if (frame.isEmpty())
+        break;
+      for (int j=0; j<lstConstHeld.size(); ++j)
+        {
+          QVERIFY(frame.row(0) != lstConstHeld[j].row(0));
+          QCOMPARE(frameHash(lstConstHeld[j]), frameHash(lstCopies[j]));
+        }
+
+      PiiMatrix<PiiColor4<unsigned char> > copy(frame);
+      copy.detach();
+      lstHeld << frame;
+      lstCopies << copy;
+      if (lstHeld.size() > 4)
+        {
+          lstHeld.removeAt(1);
+          lstCopies.removeAt(1);
+        }
+    }
+  QCOMPARE(lstHeld.size(), 4);
+#else
+  AVCODEC_SKIP;
+#endif
+}
+
 void TestPiiVideo::saveNextColorFrame()
 {
 #ifndef PII_NO_AVCODEC
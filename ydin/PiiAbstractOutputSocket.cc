@@ -81,6 +81,7 @@ void PiiAbstractOutputSocket::updateInput(PiiAbstractInputSocket* socket)
     {
       d->lstInputs.updateController(socket);
       d->inputUpdated(socket);
+      resolveRootInputs();
     }
 }
 
@@ -106,6 +107,7 @@ void PiiAbstractOutputSocket::connectInput(PiiAbstractInputSocket* input)
         pRootOutput->_d()->setOutputConnected(true);
 
       d->inputConnected(input);
+      resolveRootInputs();
     }
 }
 
@@ -137,6 +139,7 @@ void PiiAbstractOutputSocket::disconnectInputAt(int index)
         pRootOutput->_d()->setOutputConnected(true);
 
       d->inputDisconnected(input);
+      resolveRootInputs();
     }
 }
 
@@ -155,6 +158,15 @@ void PiiAbstractOutputSocket::reconnect(PiiAbstractOutputSocket* output, PiiAbst
     connectInput(input);
 }
 
+void PiiAbstractOutputSocket::resolveRootInputs()
+{
+  // A change in a proxy affects the routing of the real output at the
+  // start of the chain.
+  PiiAbstractOutputSocket* pRootOutput = PiiProxySocket::root(this);
+  if (pRootOutput != 0)
+    pRootOutput->_d()->resolveInputs();
+}
+
 void PiiAbstractOutputSocket::Data::inputConnected(PiiAbstractInputSocket*)
 {}
 
@@ -164,6 +176,9 @@ void PiiAbstractOutputSocket::Data::inputUpdated(PiiAbstractInputSocket*)
 void PiiAbstractOutputSocket::Data::inputDisconnected(PiiAbstractInputSocket*)
 {}
 
+void PiiAbstractOutputSocket::Data::resolveInputs()
+{}
+
 
 int PiiAbstractOutputSocket::InputList::indexOf(PiiAbstractInputSocket* input) const
 {
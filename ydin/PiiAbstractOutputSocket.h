@@ -163,6 +163,14 @@ protected:
      * The default implementation does nothing.
      */
     virtual void inputDisconnected(PiiAbstractInputSocket* input);
+    /*
+     * Called whenever a connection or an input controller changes
+     * anywhere in the chain of proxies that starts from this output.
+     * Outputs that deliver objects to the final (non-proxy) inputs
+     * directly should rebuild their routing here. The default
+     * implementation does nothing.
+     */
+    virtual void resolveInputs();
 
     // All connected input sockets.
     InputList lstInputs;
@@ -173,6 +181,7 @@ protected:
   /// @endhide
 private:
   void disconnectInputAt(int index);
+  void resolveRootInputs();
 };
 
 Q_DECLARE_METATYPE(PiiAbstractOutputSocket*)
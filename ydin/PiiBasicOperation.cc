@@ -61,8 +61,12 @@ void PiiBasicOperation::check(bool reset)
         d->lstInputs[i]->reset();
     }
 
+  // Route outputs directly to the final inputs behind proxies.
   for (int i=d->lstOutputs.size(); i--; )
-    d->lstOutputs[i]->reset();
+    {
+      d->lstOutputs[i]->resolveInputs();
+      d->lstOutputs[i]->reset();
+    }
 }
 
 void PiiBasicOperation::updateActivityMode(ActivityMode mode)
@@ -19,14 +19,19 @@
 #include <PiiUtil.h>
 #include <PiiFileUtil.h>
 #include "PiiPlugin.h"
+#include "PiiYdin.h"
 #include <PiiGenericTextOutputArchive.h>
 #include <PiiGenericBinaryOutputArchive.h>
 #include <PiiGenericTextInputArchive.h>
 #include <PiiGenericBinaryInputArchive.h>
+#include <PiiTimer.h>
 
 #include <QLibrary>
 #include <QFile>
 #include <QFileInfo>
+#include <QDateTime>
+#include <QSettings>
+#include <QSet>
 
 PII_DEFINE_VIRTUAL_METAOBJECT_FUNCTION(PiiEngine)
 PII_SERIALIZABLE_EXPORT(PiiEngine);
@@ -51,6 +56,154 @@ public:
 } *d;
 
 
+/* Lazy plug-in loading. The manifest cache is a QSettings ini file
+ * with one array entry per plug-in library.
+ */
+class PiiPluginManifest
+{
+public:
+  struct Entry
+  {
+    Entry() : iSize(-1) {}
+
+    QString strName, strPath, strFile, strModified, strIntoVersion;
+    qint64 iSize;
+    // lstSuperClasses[i] is a direct superclass of lstClasses[i]
+    QStringList lstClasses, lstSuperClasses, lstFactories;
+  };
+  typedef QHash<QString,Entry> EntryMap;
+
+  PiiPluginManifest() : iLoadTime(0) {}
+
+  static PiiPluginManifest* instance()
+  {
+    static PiiPluginManifest manifest;
+    return &manifest;
+  }
+
+  EntryMap read() const;
+  void write(const Entry& entry);
+  bool isValid(const Entry& entry, const QString& path) const;
+
+  QMutex mutex;
+  QString strFileName;
+  // Class name -> plug-in name for registered but unloaded plug-ins
+  QHash<QString,QString> hashClassPlugins;
+  // Class name -> direct superclasses
+  QHash<QString,QStringList> hashSuperClasses;
+  // Cumulative library load time in microseconds
+  qint64 iLoadTime;
+  QVariantMap mapStartupTimes;
+};
+
+PiiPluginManifest::EntryMap PiiPluginManifest::read() const
+{
+  EntryMap mapEntries;
+  if (strFileName.isEmpty() || !QFile::exists(strFileName))
+    return mapEntries;
+
+  QSettings settings(strFileName, QSettings::IniFormat);
+  int iCount = settings.beginReadArray("plugins");
+  for (int i=0; i<iCount; ++i)
+    {
+      settings.setArrayIndex(i);
+      Entry entry;
+      entry.strName = settings.value("name").toString();
+      entry.strPath = settings.value("path").toString();
+      entry.strFile = settings.value("file").toString();
+      entry.strModified = settings.value("modified").toString();
+      entry.iSize = settings.value("size", -1).toLongLong();
+      entry.strIntoVersion = settings.value("intoVersion").toString();
+      entry.lstClasses = settings.value("classes").toStringList();
+      entry.lstSuperClasses = settings.value("superClasses").toStringList();
+      entry.lstFactories = settings.value("factories").toStringList();
+      if (!entry.strName.isEmpty() &&
+          entry.lstClasses.size() == entry.lstSuperClasses.size())
+        mapEntries.insert(entry.strName, entry);
+    }
+  settings.endArray();
+  return mapEntries;
+}
+
+void PiiPluginManifest::write(const Entry& entry)
+{
+  // Rewrite the whole array. Plug-ins are loaded rarely enough to
+  // make this cheap.
+  EntryMap mapEntries(read());
+  mapEntries.insert(entry.strName, entry);
+
+  QSettings settings(strFileName, QSettings::IniFormat);
+  settings.remove("plugins");
+  settings.beginWriteArray("plugins", mapEntries.size());
+  int iIndex = 0;
+  for (EntryMap::const_iterator i = mapEntries.constBegin(); i != mapEntries.constEnd(); ++i, ++iIndex)
+    {
+      settings.setArrayIndex(iIndex);
+      settings.setValue("name", i->strName);
+      settings.setValue("path", i->strPath);
+      settings.setValue("file", i->strFile);
+      settings.setValue("modified", i->strModified);
+      settings.setValue("size", i->iSize);
+      settings.setValue("intoVersion", i->strIntoVersion);
+      settings.setValue("classes", i->lstClasses);
+      settings.setValue("superClasses", i->lstSuperClasses);
+      settings.setValue("factories", i->lstFactories);
+    }
+  settings.endArray();
+  settings.sync();
+  if (settings.status() != QSettings::NoError)
+    piiWarning(PiiEngine::tr("Cannot write plug-in manifest to %1.").arg(strFileName));
+}
+
+bool PiiPluginManifest::isValid(const Entry& entry, const QString& path) const
+{
+  if (entry.strIntoVersion != INTO_VERSION_STR ||
+      entry.strPath != path)
+    return false;
+  QFileInfo info(entry.strFile);
+  return info.exists() &&
+    info.size() == entry.iSize &&
+    info.lastModified().toString(Qt::ISODate) == entry.strModified;
+}
+
+// Installed as the class loader of PiiSerializationFactory.
+static bool loadRegisteredClass(const char* className)
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QString strPlugin;
+  {
+    QMutexLocker lock(&pManifest->mutex);
+    strPlugin = pManifest->hashClassPlugins.value(className);
+  }
+  if (strPlugin.isEmpty())
+    return false;
+
+  try
+    {
+      PiiEngine::ensurePlugin(strPlugin);
+    }
+  catch (PiiLoadException& ex)
+    {
+      piiWarning(ex.message());
+      return false;
+    }
+  return true;
+}
+
+static void removeRegisteredClasses(PiiPluginManifest* manifest, const QString& plugin)
+{
+  QMutableHashIterator<QString,QString> i(manifest->hashClassPlugins);
+  while (i.hasNext())
+    {
+      i.next();
+      if (i.value() == plugin)
+        {
+          manifest->hashSuperClasses.remove(i.key());
+          i.remove();
+        }
+    }
+}
+
 PiiEngine::PiiEngine()
 {
   Q_UNUSED(iEngineMetaType); // suppresses compiler warning
@@ -139,11 +292,31 @@ PiiEngine::Plugin PiiEngine::loadPlugin(const QString& name)
     QLibrary* pLib;
   };
 
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QString strManifestFile(pluginManifestFile());
+  // Record the state of the registries before loading so that the
+  // manifest can be built out of the difference.
+  int iStatementCount = 0;
+  QSet<QString> setFactories;
+  if (!strManifestFile.isEmpty())
+    {
+      iStatementCount = PiiYdin::resourceDatabase()->statementCount();
+      foreach (const char* pClassName, PiiSerializationFactory::keys())
+        setFactories << pClassName;
+    }
+
   // Load library
-  Unloader unloader(new QLibrary(pluginNameToPath(name)));
+  QString strPath(pluginNameToPath(name));
+  Unloader unloader(new QLibrary(strPath));
 
   unloader.pLib->setLoadHints(QLibrary::ExportExternalSymbolsHint);
-  if (!unloader.pLib->load())
+  PiiTimer loadTimer;
+  bool bLoaded = unloader.pLib->load();
+  {
+    QMutexLocker manifestLock(&pManifest->mutex);
+    pManifest->iLoadTime += loadTimer.microseconds();
+  }
+  if (!bLoaded)
     PII_THROW(PiiLoadException, tr("Cannot load the shared library \"%1\".\n"
                                    "Error message: %2").arg(name).arg(unloader.pLib->errorString()));
 
@@ -176,6 +349,39 @@ PiiEngine::Plugin PiiEngine::loadPlugin(const QString& name)
   Plugin plugin(unloader.release(), (*pNameFunc)(), pluginVersion);
   _pluginMap.insert(name, plugin);
 
+  if (!strManifestFile.isEmpty())
+    {
+      PiiPluginManifest::Entry entry;
+      entry.strName = name;
+      entry.strPath = strPath;
+      QFileInfo info(plugin.d->pLibrary->fileName());
+      entry.strFile = info.absoluteFilePath();
+      entry.strModified = info.lastModified().toString(Qt::ISODate);
+      entry.iSize = info.size();
+      entry.strIntoVersion = INTO_VERSION_STR;
+
+      // Statements are only ever appended during static
+      // initialization.
+      QList<PiiResourceStatement> lstStatements(PiiYdin::resourceDatabase()->statements());
+      for (int i=iStatementCount; i<lstStatements.size(); ++i)
+        {
+          const PiiResourceStatement& statement = lstStatements[i];
+          if (statement.type() == PiiResourceStatement::Resource &&
+              statement.predicate() == PiiYdin::classPredicate)
+            {
+              entry.lstClasses << statement.subject();
+              entry.lstSuperClasses << statement.object();
+            }
+        }
+      foreach (const char* pClassName, PiiSerializationFactory::keys())
+        if (!setFactories.contains(pClassName))
+          entry.lstFactories << pClassName;
+
+      QMutexLocker manifestLock(&pManifest->mutex);
+      removeRegisteredClasses(pManifest, name);
+      pManifest->write(entry);
+    }
+
   return plugin;
 }
 
@@ -358,9 +564,109 @@ void PiiEngine::ensurePlugins(const QStringList& plugins)
       PiiEngine::loadPlugin(strPlugin);
 }
 
+void PiiEngine::setPluginManifestFile(const QString& fileName)
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QMutexLocker lock(&pManifest->mutex);
+  pManifest->strFileName = fileName;
+  PiiSerializationFactory::setClassLoader(fileName.isEmpty() ? 0 : loadRegisteredClass);
+}
+
+QString PiiEngine::pluginManifestFile()
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QMutexLocker lock(&pManifest->mutex);
+  return pManifest->strFileName;
+}
+
+void PiiEngine::registerPlugin(const QString& plugin)
+{
+  registerPlugins(QStringList() << plugin);
+}
+
+void PiiEngine::registerPlugins(const QStringList& plugins)
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  PiiPluginManifest::EntryMap mapEntries;
+  {
+    QMutexLocker lock(&pManifest->mutex);
+    if (pManifest->strFileName.isEmpty())
+      {
+        lock.unlock();
+        ensurePlugins(plugins);
+        return;
+      }
+    mapEntries = pManifest->read();
+  }
+
+  foreach (QString strPlugin, plugins)
+    {
+      if (isLoaded(strPlugin))
+        continue;
+
+      PiiPluginManifest::EntryMap::const_iterator entry = mapEntries.constFind(strPlugin);
+      if (entry != mapEntries.constEnd() &&
+          pManifest->isValid(*entry, pluginNameToPath(strPlugin)))
+        {
+          QMutexLocker lock(&pManifest->mutex);
+          for (int i=0; i<entry->lstClasses.size(); ++i)
+            {
+              pManifest->hashClassPlugins.insert(entry->lstClasses[i], strPlugin);
+              pManifest->hashSuperClasses[entry->lstClasses[i]] << entry->lstSuperClasses[i];
+            }
+          foreach (QString strFactory, entry->lstFactories)
+            pManifest->hashClassPlugins.insert(strFactory, strPlugin);
+        }
+      else
+        // No valid manifest. Load the library and record a new one.
+        loadPlugin(strPlugin);
+    }
+}
+
+QStringList PiiEngine::registeredClasses(const QString& superClass)
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QMutexLocker lock(&pManifest->mutex);
+  QStringList lstResult;
+  for (QHash<QString,QStringList>::const_iterator i = pManifest->hashSuperClasses.constBegin();
+       i != pManifest->hashSuperClasses.constEnd(); ++i)
+    if (superClass.isEmpty() || i.value().contains(superClass))
+      lstResult << i.key();
+  return lstResult;
+}
+
+QVariantMap PiiEngine::startupTimes()
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QMutexLocker lock(&pManifest->mutex);
+  return pManifest->mapStartupTimes;
+}
+
+static qint64 libraryLoadTime()
+{
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QMutexLocker lock(&pManifest->mutex);
+  return pManifest->iLoadTime;
+}
+
+template <class Archive> static void readEngine(Archive& archive, QVariantMap& config, PiiEngine*& engine,
+                                                PiiTimer& timer, QVariantMap& times)
+{
+  archive >> PII_NVP("config", config);
+  times["readConfig"] = timer.restart();
+  PiiEngine::registerPlugins(config["plugins"].toStringList());
+  times["registerPlugins"] = timer.restart();
+  archive >> PII_NVP("engine", engine);
+  times["readEngine"] = timer.restart();
+}
+
 PiiEngine* PiiEngine::load(const QString& fileName,
                            QVariantMap* config)
 {
+  PiiTimer totalTimer, phaseTimer;
+  qint64 iLoadTime = libraryLoadTime();
+  QVariantMap mapTimes;
+
   QFile file(fileName);
   if (!file.open(QIODevice::ReadOnly))
     PII_THROW(PiiException, tr("Cannot open %1 for reading.").arg(fileName));
@@ -369,16 +675,12 @@ PiiEngine* PiiEngine::load(const QString& fileName,
   if (file.peek(PII_TEXT_ARCHIVE_ID_LEN) == PII_TEXT_ARCHIVE_ID)
     {
       PiiGenericTextInputArchive ia(&file);
-      ia >> PII_NVP("config", mapConfig);
-      ensurePlugins(mapConfig["plugins"].toStringList());
-      ia >> PII_NVP("engine", pEngine);
+      readEngine(ia, mapConfig, pEngine, phaseTimer, mapTimes);
     }
   else if (file.peek(PII_BINARY_ARCHIVE_ID_LEN) == PII_BINARY_ARCHIVE_ID)
     {
       PiiGenericBinaryInputArchive ia(&file);
-      ia >> PII_NVP("config", mapConfig);
-      ensurePlugins(mapConfig["plugins"].toStringList());
-      ia >> PII_NVP("engine", pEngine);
+      readEngine(ia, mapConfig, pEngine, phaseTimer, mapTimes);
     }
   else
     PII_SERIALIZATION_ERROR(UnrecognizedArchiveFormat);
@@ -386,6 +688,13 @@ PiiEngine* PiiEngine::load(const QString& fileName,
   if (config != 0)
     *config = mapConfig;
 
+  mapTimes["loadLibraries"] = libraryLoadTime() - iLoadTime;
+  mapTimes["total"] = totalTimer.microseconds();
+
+  PiiPluginManifest* pManifest = PiiPluginManifest::instance();
+  QMutexLocker lock(&pManifest->mutex);
+  pManifest->mapStartupTimes = mapTimes;
+
   return pEngine;
 }
 
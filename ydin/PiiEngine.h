@@ -201,6 +201,92 @@ public:
    */
   static void ensurePlugins(const QStringList& plugins);
 
+  /**
+   * Sets the name of the plug-in manifest cache file. The manifest
+   * records, for each plug-in library loaded while the cache is in
+   * use, the classes the library registers to the resource database,
+   * their superclasses and the serialization factories the library
+   * provides. Each entry is tagged with the location, size and
+   * modification time of the library file and the version of Into
+   * it was written with. The entry is written once, when the library
+   * is loaded, and ignored (and rewritten on the next load) if any of
+   * these has changed.
+   *
+   * Setting a non-empty file name makes [registerPlugin()] defer
+   * loading plug-ins until a class they provide is first needed.
+   * An empty file name (the default) disables the cache, and all
+   * plug-ins will be loaded immediately.
+   *
+   * ~~~(c++)
+   * PiiEngine::setPluginManifestFile(QDir::homePath() + "/.into-plugins.ini");
+   * // Only the plug-ins whose operations are actually used will be loaded.
+   * PiiEngine* pEngine = PiiEngine::load("counter_engine.cft");
+   * ~~~
+   */
+  static void setPluginManifestFile(const QString& fileName);
+  /**
+   * Returns the name of the plug-in manifest cache file.
+   */
+  static QString pluginManifestFile();
+
+  /**
+   * Registers *plugin* for lazy loading. If a valid entry for the
+   * plug-in is found in the [manifest cache](setPluginManifestFile()),
+   * the library will not be loaded. Instead, the classes it provides
+   * will be recorded, and the library will be loaded once any of them
+   * is needed, for example by PiiYdin::createResource() or when an
+   * instance is deserialized. If there is no valid manifest entry or
+   * the cache is disabled, this function works like [ensurePlugin()].
+   *
+   * Note that the resource database contains no information about a
+   * lazily registered plug-in until the plug-in has been loaded.
+   * Use [registeredClasses()] to find the classes a plug-in will
+   * provide.
+   *
+   * This function is thread-safe.
+   *
+   * @exception PiiLoadException& if the plug-in needs to be loaded
+   * but cannot be
+   */
+  static void registerPlugin(const QString& plugin);
+
+  /**
+   * Registers all plug-ins listed in *plugins* for lazy loading. The
+   * manifest cache will be read only once.
+   *
+   * @exception PiiLoadException& if any of the plug-ins needs to be
+   * loaded but cannot be
+   */
+  static void registerPlugins(const QStringList& plugins);
+
+  /**
+   * Returns the names of classes provided by lazily registered
+   * plug-ins that haven't been loaded yet. If *superClass* is
+   * non-empty, only direct subclasses of *superClass* will be
+   * returned.
+   */
+  static QStringList registeredClasses(const QString& superClass = QString());
+
+  /**
+   * Returns the time spent in each phase during the last call to
+   * [load()] as a map from a phase name to microseconds. The phases
+   * are:
+   *
+   * - `readConfig` - opening the file and reading the configuration.
+   *
+   * - `registerPlugins` - loading or registering the plug-ins listed
+   * in the configuration.
+   *
+   * - `readEngine` - deserializing the engine. This includes loading
+   * lazily registered plug-ins.
+   *
+   * - `loadLibraries` - total time spent in loading plug-in
+   * libraries during the two previous phases.
+   *
+   * - `total` - the total time spent in [load()].
+   */
+  static QVariantMap startupTimes();
+
   /**
    * Remove the named plugin. Either the full path or the base name
    * will do as *name*.
@@ -340,6 +426,11 @@ public:
    * be recognized or an error occurs when reading the engine
    * instance.
    *
+   * If a [plug-in manifest file](setPluginManifestFile()) has been
+   * set, the plug-ins listed in the configuration will be
+   * [registered](registerPlugin()) instead of being loaded, and only
+   * the ones the engine actually uses will be loaded.
+   *
    * ~~~(c++)
    * PiiVariantMap mapConfig;
    * PiiEngine* pEngine = PiiEngine::load("counter_engine.cft", &mapConfig);
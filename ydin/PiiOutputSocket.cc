@@ -17,6 +17,7 @@
 #include "PiiInputSocket.h"
 #include "PiiYdinTypes.h"
 #include "PiiOperation.h"
+#include "PiiProxySocket.h"
 
 #include <PiiUtil.h>
 #include <PiiSerializableExport.h> // MSVC
@@ -29,6 +30,7 @@ PiiOutputSocket::Data::Data() :
   PiiAbstractOutputSocket::Data(),
   iGroupId(0),
   freeInputCondition(PiiWaitCondition::NoQueue),
+  pInputListener(0),
   pFirstInput(0),
   pFirstController(0),
   bInterrupted(false),
@@ -47,30 +49,41 @@ bool PiiOutputSocket::Data::setOutputConnected(bool connected)
   return bConnected = PiiAbstractOutputSocket::Data::setOutputConnected(connected);
 }
 
-void PiiOutputSocket::Data::inputUpdated(PiiAbstractInputSocket*)
+PiiInputListener* PiiOutputSocket::Data::inputListener()
 {
-  if (lstInputs.size() > 0)
-    pFirstController = lstInputs.controllerAt(0);
+  return pInputListener != 0 ? pInputListener : this;
 }
 
-void PiiOutputSocket::Data::inputConnected(PiiAbstractInputSocket* input)
+void PiiOutputSocket::Data::resolveInputs()
 {
-  input->setListener(this);
-  // Run-time optimization
-  if (lstInputs.size() == 1)
+  InputList lstOldInputs(lstResolvedInputs);
+  lstResolvedInputs.clear();
+  PiiInputListener* pListener = inputListener();
+  // Go through all proxies and store the final inputs with their
+  // current controllers. The objects will be passed to them
+  // directly, and ready signals come straight back.
+  for (int i=0; i<lstInputs.size(); ++i)
     {
-      pFirstInput = input;
-      pFirstController = input->controller();
+      QList<PiiAbstractInputSocket*> lstFinalInputs(PiiProxySocket::connectedInputs(lstInputs.inputAt(i)));
+      for (int j=0; j<lstFinalInputs.size(); ++j)
+        {
+          lstResolvedInputs.append(lstFinalInputs[j]);
+          lstFinalInputs[j]->setListener(pListener);
+        }
+    }
+  // Inputs that are no longer reachable must not signal us.
+  for (int i=0; i<lstOldInputs.size(); ++i)
+    {
+      PiiAbstractInputSocket* pInput = lstOldInputs.inputAt(i);
+      if (lstResolvedInputs.indexOf(pInput) == -1 && pInput->listener() == pListener)
+        pInput->setListener(0);
     }
-  createFlagArray();
-}
 
-void PiiOutputSocket::Data::inputDisconnected(PiiAbstractInputSocket*)
-{
-  if (lstInputs.size() > 0)
+  // Run-time optimization
+  if (lstResolvedInputs.size() > 0)
     {
-      pFirstInput = lstInputs.inputAt(0);
-      pFirstController = lstInputs.controllerAt(0);
+      pFirstInput = lstResolvedInputs.inputAt(0);
+      pFirstController = lstResolvedInputs.controllerAt(0);
     }
   else
     {
@@ -84,10 +97,10 @@ void PiiOutputSocket::Data::createFlagArray()
 {
   //qDebug("PiiOutputSocket: creating flag array for %d connections.", d->lstInputs.size());
   delete[] pbInputCompleted;
-  if (lstInputs.size() > 0)
+  if (lstResolvedInputs.size() > 0)
     {
-      pbInputCompleted = new bool[lstInputs.size()];
-      Pii::fillN(pbInputCompleted, lstInputs.size(), false);
+      pbInputCompleted = new bool[lstResolvedInputs.size()];
+      Pii::fillN(pbInputCompleted, lstResolvedInputs.size(), false);
     }
   else
     pbInputCompleted = 0;
@@ -269,7 +282,7 @@ bool PiiOutputSocket::tryEmit(const PiiVariant& object)
     PII_THROW(PiiExecutionException, tr("Trying to send an invalid object."));
 
   PII_D;
-  const int iCnt = d->lstInputs.size();
+  const int iCnt = d->lstResolvedInputs.size();
 
   // Optimized emission for a single connected input
   if (iCnt == 1)
@@ -282,11 +295,11 @@ bool PiiOutputSocket::tryEmit(const PiiVariant& object)
     {
       if (!d->pbInputCompleted[i])
         bAllCompleted &= d->pbInputCompleted[i] =
-          d->lstInputs.controllerAt(i)->tryToReceive(d->lstInputs.inputAt(i), object);
+          d->lstResolvedInputs.controllerAt(i)->tryToReceive(d->lstResolvedInputs.inputAt(i), object);
     }
   if (bAllCompleted)
     {
-      Pii::fillN(d->pbInputCompleted, d->lstInputs.size(), false);
+      Pii::fillN(d->pbInputCompleted, iCnt, false);
       d->freeInputCondition.wakeAll();
     }
 
@@ -353,8 +366,23 @@ void PiiOutputSocket::endMany()
 
 void PiiOutputSocket::setInputListener(PiiInputListener* listener)
 {
-  if (listener == 0) listener = _d();
   PII_D;
-  for (int i=0; i<d->lstInputs.size(); ++i)
-    d->lstInputs.inputAt(i)->setListener(listener);
+  d->pInputListener = listener;
+  listener = d->inputListener();
+  for (int i=0; i<d->lstResolvedInputs.size(); ++i)
+    d->lstResolvedInputs.inputAt(i)->setListener(listener);
+}
+
+QList<PiiAbstractInputSocket*> PiiOutputSocket::resolvedInputs() const
+{
+  const PII_D;
+  QList<PiiAbstractInputSocket*> lstResult;
+  for (int i=0; i<d->lstResolvedInputs.size(); ++i)
+    lstResult << d->lstResolvedInputs.inputAt(i);
+  return lstResult;
+}
+
+void PiiOutputSocket::resolveInputs()
+{
+  _d()->resolveInputs();
 }
@@ -344,6 +344,25 @@ public:
    */
   void setInputListener(PiiInputListener* listener = 0);
 
+  /**
+   * Returns the inputs objects emitted through this socket are
+   * actually delivered to. Chains of proxies (see
+   * PiiOperationCompound) are resolved to the final, non-proxy inputs
+   * whenever connections change, and when the parent operation is
+   * checked. Objects are passed to the resolved inputs directly, and
+   * proxies are skipped at run time no matter how deeply compounds
+   * are nested.
+   */
+  QList<PiiAbstractInputSocket*> resolvedInputs() const;
+
+  /**
+   * Rebuilds the list of resolved inputs. This function is called
+   * automatically whenever a connection changes, and by
+   * PiiBasicOperation::check(). There is usually no need to call it
+   * explicitly.
+   */
+  void resolveInputs();
+
 protected:
   /// @hide
   struct ThreadInfo
@@ -373,16 +392,18 @@ protected:
 
     inline int queueIndex(Qt::HANDLE threadId) const;
     inline bool hasBufferedObjects(Qt::HANDLE activeThreadId) const;
-    void inputConnected(PiiAbstractInputSocket* input);
-    void inputDisconnected(PiiAbstractInputSocket* input);
-    void inputUpdated(PiiAbstractInputSocket* input);
+    void resolveInputs();
     void createFlagArray();
+    PiiInputListener* inputListener();
 
     int iGroupId;
     bool bConnected;
     // A wait condition that is used when some inputs aren't ready to
     // receive new objects.
     PiiWaitCondition freeInputCondition, *pFreeInputCondition;
+    // The final inputs behind proxies, with their controllers.
+    InputList lstResolvedInputs;
+    PiiInputListener* pInputListener;
     PiiAbstractInputSocket* pFirstInput;
     PiiInputController* pFirstController;
     bool bInterrupted;
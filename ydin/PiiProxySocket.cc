@@ -149,6 +149,9 @@ PiiInputController* PiiProxyInputSocket::controller() const
   return const_cast<Data*>(_d());
 }
 
+// PiiOutputSocket resolves proxy chains and passes objects to the
+// final inputs directly. This is only used if objects are sent to a
+// proxy through some other means.
 bool PiiProxyInputSocket::Data::tryToReceive(PiiAbstractInputSocket* /*sender*/, const PiiVariant& object) throw ()
 {
   bool bAllCompleted = true;
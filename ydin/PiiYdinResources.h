@@ -138,12 +138,21 @@ namespace PiiYdin
    * QObject* obj = PiiYdin::createResource<QObject>("MyClass");
    * ~~~
    *
+   * If no factory is registered for *name*, the class loader of
+   * PiiSerializationFactory will be asked to make the class
+   * available. With lazily registered plug-ins, this loads the
+   * library that provides *name*.
+   *
    * @see resourceName()
    * @see resourceDatabase()
    */
   template <class ParentType> ParentType* createResource(const char* name)
   {
     PiiSerializationFactory* pFactory = PiiSerializationFactory::factory(name);
+    // The resource may be provided by a plug-in that has been
+    // registered but not loaded yet (see PiiEngine::registerPlugin()).
+    if (pFactory == 0 && PiiSerializationFactory::loadClass(name))
+      pFactory = PiiSerializationFactory::factory(name);
 
     // Don't know how to create this resource.
     if (pFactory == 0)